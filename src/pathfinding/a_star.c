@@ -12,35 +12,136 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "pathfinding/open_set.h"
 #include "pathfinding/binary_heap.h"
 #include "pathfinding/a_star.h"
 #include "pathfinding/maze.h"
-
-// Private function prototypes.
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/maze_render.h"
+#include "pathfinding/search_context.h"
+
+// Definitions.
 // ----------------------------------------------------------------------------
 //
 
-static void a_star_inner_loop(binary_heap_t    *p_open_set,
-                              maze_grid_cell_t *p_end_node);
+/**
+ * @def A_STAR_TURN_NUM_ORIENTATIONS
+ * @brief Number of search states of each cell in @ref a_star_turn, one for
+ * each orientation the car can be in when it is centred in the cell.
+ */
+#define A_STAR_TURN_NUM_ORIENTATIONS 4u
+
+/**
+ * @def A_STAR_TURN_NO_STATE
+ * @brief Search state that the start state came from.
+ */
+#define A_STAR_TURN_NO_STATE MAZE_IDX_MAX
 
-static void insert_path_directions(char                     *p_maze_string,
-                                   const maze_grid_cell_t   *p_cell,
-                                   uint16_t                  str_num_cols,
-                                   maze_cardinal_direction_t in_direction,
-                                   maze_cardinal_direction_t out_direction);
+/**
+ * @def A_STAR_JPS_IS_HORIZONTAL(direction)
+ * @brief Checks if a cardinal direction is east or west.
+ */
+#define A_STAR_JPS_IS_HORIZONTAL(direction) \
+    (MAZE_EAST == (direction) || MAZE_WEST == (direction))
 
-static void insert_path_in_direction(char                     *p_maze_str,
-                                     uint16_t                  str_num_cols,
-                                     uint32_t                  node_row,
-                                     uint32_t                  node_col,
-                                     maze_cardinal_direction_t direction);
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
 
-static void insert_node_centre_char(char    *p_maze_string,
-                                    uint32_t row,
-                                    uint32_t col,
-                                    uint16_t str_num_cols,
-                                    char     symbol);
+static void a_star_begin(const maze_grid_t      *p_grid,
+                         search_context_t       *p_context,
+                         const maze_landmarks_t *p_landmarks,
+                         maze_idx_t              start_idx,
+                         maze_idx_t              end_idx);
+
+static uint32_t a_star_get_heuristic(const maze_grid_t      *p_grid,
+                                     const maze_landmarks_t *p_landmarks,
+                                     maze_idx_t              cell_idx,
+                                     maze_idx_t              end_idx);
+
+static uint32_t a_star_get_h_scale(const maze_grid_t      *p_grid,
+                                   const maze_landmarks_t *p_landmarks);
+
+static a_star_status_t a_star_inner_loop(const maze_grid_t      *p_grid,
+                                         search_context_t       *p_context,
+                                         const maze_landmarks_t *p_landmarks,
+                                         maze_idx_t              end_idx,
+                                         const a_star_budget_t  *p_budget);
+
+static bool a_star_is_budget_spent(const a_star_budget_t *p_budget,
+                                   uint32_t               num_expanded);
+
+static void a_star_write_back_path(maze_grid_t            *p_grid,
+                                   const search_context_t *p_context,
+                                   const maze_grid_cell_t *p_end_node);
+
+static void a_star_compact_inner_loop(const maze_compact_t *p_maze,
+                                      open_set_t           *p_open_set,
+                                      maze_idx_t           *p_g,
+                                      uint8_t              *p_came_from,
+                                      maze_idx_t            end_idx);
+
+static a_star_path_t *a_star_compact_get_path(const maze_compact_t *p_maze,
+                                              const maze_idx_t     *p_g,
+                                              const uint8_t *p_came_from,
+                                              maze_idx_t     end_idx);
+
+static void a_star_chunked_inner_loop(const maze_chunked_t *p_maze,
+                                      open_set_t           *p_open_set,
+                                      maze_idx_t           *p_g,
+                                      uint8_t              *p_came_from,
+                                      maze_idx_t            end_idx);
+
+static a_star_path_t *a_star_chunked_get_path(const maze_chunked_t *p_maze,
+                                              const maze_idx_t     *p_g,
+                                              const uint8_t *p_came_from,
+                                              maze_idx_t     end_idx);
+
+static uint32_t a_star_turn_get_turn_cost(const a_star_turn_costs_t *p_costs,
+                                          maze_cardinal_direction_t  from,
+                                          maze_cardinal_direction_t  to);
+
+static uint32_t a_star_turn_get_heuristic(
+    const a_star_turn_costs_t *p_costs,
+    const maze_point_t        *p_point,
+    maze_cardinal_direction_t  orientation,
+    const maze_point_t        *p_end_point);
+
+static a_star_path_t *a_star_turn_get_path(const maze_grid_t *p_grid,
+                                           const uint32_t    *p_g,
+                                           const maze_idx_t  *p_came_from,
+                                           maze_idx_t         end_state);
+
+static bool a_star_jps_is_forced(const maze_grid_cell_t   *p_prev_node,
+                                 const maze_grid_cell_t   *p_node,
+                                 maze_cardinal_direction_t direction,
+                                 maze_cardinal_direction_t side);
+
+static const maze_grid_cell_t *a_star_jps_jump_vertical(
+    const maze_grid_cell_t   *p_node,
+    maze_cardinal_direction_t direction,
+    const maze_grid_cell_t   *p_end_node);
+
+static const maze_grid_cell_t *a_star_jps_jump_horizontal(
+    const maze_grid_cell_t   *p_node,
+    maze_cardinal_direction_t direction,
+    const maze_grid_cell_t   *p_end_node);
+
+static a_star_path_t *a_star_jps_get_path(const maze_grid_t *p_grid,
+                                          const uint32_t    *p_g,
+                                          const maze_idx_t  *p_came_from,
+                                          const uint8_t     *p_directions,
+                                          maze_idx_t         end_idx);
+
+static a_star_path_t *a_star_jps_weighted(const maze_grid_t      *p_grid,
+                                          const maze_grid_cell_t *p_start_node,
+                                          const maze_grid_cell_t *p_end_node,
+                                          uint32_t *p_num_expanded);
 
 // Public functions.
 // ----------------------------------------------------------------------------
@@ -54,48 +155,244 @@ static void insert_node_centre_char(char    *p_maze_string,
  * @param[in] p_grid The grid maze.
  * @param[in] p_start_node Pointer to the start node.
  * @param[in] p_end_node Pointer to the end node.
+ *
+ * @note Only the nodes on the path are written to. Every other node reads as
+ * unreached after a new search epoch. @see a_star_ctx for a search that leaves
+ * the grid untouched.
  */
 void
 a_star (maze_grid_t      *p_grid,
         maze_grid_cell_t *p_start_node,
         maze_grid_cell_t *p_end_node)
 {
-    // Step 1: Initialise the open set heap.
+    // Step 1: Run the search in a context of its own.
+    //
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+    a_star_ctx(p_grid, &context, p_start_node, p_end_node);
+
+    // Step 2: Start a new grid epoch and write the path back into the grid, so
+    // that it can be read by @ref a_star_get_path.
+    //
+    maze_new_epoch(p_grid);
+    a_star_write_back_path(p_grid, &context, p_end_node);
+
+    // Step 3: Clean up.
+    //
+    search_context_destroy(&context);
+}
+
+/**
+ * @brief Runs the A* algorithm on a grid maze with the search values kept in a
+ * search context. The grid is only read, so several searches with their own
+ * contexts can run on the same grid at once.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to a search context created for the grid.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return true A path to the end node was found.
+ * @return false The end node is unreachable.
+ */
+bool
+a_star_ctx (const maze_grid_t      *p_grid,
+            search_context_t       *p_context,
+            const maze_grid_cell_t *p_start_node,
+            const maze_grid_cell_t *p_end_node)
+{
+    maze_idx_t end_idx = maze_get_cell_idx(p_grid, p_end_node);
+
+    // Step 1: Begin a new search and insert the start node.
+    //
+    a_star_ctx_start(p_grid, p_context, p_start_node, p_end_node);
+
+    // Step 2: Run the inner loop.
+    //
+    a_star_inner_loop(p_grid, p_context, NULL, end_idx, NULL);
+
+    return search_context_is_reached(p_context, end_idx);
+}
+
+/**
+ * @brief Runs the A* algorithm in a search context with the ALT heuristic:
+ * the larger of the Manhattan distance and the landmark bound. In mazes whose
+ * walls force long detours, this expands far fewer nodes than @ref a_star_ctx
+ * and finds a path of the same length.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to a search context created for the grid.
+ * @param[in] p_landmarks Pointer to the landmark tables of the grid, NULL for
+ * none. Tables that were invalidated and not updated give no bound.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return true A path to the end node was found.
+ * @return false The end node is unreachable.
+ */
+bool
+a_star_ctx_alt (const maze_grid_t      *p_grid,
+                search_context_t       *p_context,
+                const maze_landmarks_t *p_landmarks,
+                const maze_grid_cell_t *p_start_node,
+                const maze_grid_cell_t *p_end_node)
+{
+    maze_idx_t start_idx = maze_get_cell_idx(p_grid, p_start_node);
+    maze_idx_t end_idx   = maze_get_cell_idx(p_grid, p_end_node);
+
+    // Step 1: Begin a new search and insert the start node.
     //
-    binary_heap_t open_set;
-    open_set.p_array
-        = malloc(sizeof(binary_heap_node_t) * p_grid->rows * p_grid->columns);
-    open_set.capacity = p_grid->rows * p_grid->columns;
-    open_set.size     = 0;
+    a_star_begin(p_grid, p_context, p_landmarks, start_idx, end_idx);
 
-    // Step 2: Initialise g-values and h-values of all nodes to UINT16_MAX.
+    // Step 2: Run the inner loop.
     //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    a_star_inner_loop(p_grid, p_context, p_landmarks, end_idx, NULL);
+
+    return search_context_is_reached(p_context, end_idx);
+}
+
+/**
+ * @brief Begins an A* search in a search context without expanding any nodes,
+ * so that it can be run a piece at a time by @ref a_star_ctx_resume.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to a search context created for the grid.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ */
+void
+a_star_ctx_start (const maze_grid_t      *p_grid,
+                  search_context_t       *p_context,
+                  const maze_grid_cell_t *p_start_node,
+                  const maze_grid_cell_t *p_end_node)
+{
+    a_star_begin(p_grid,
+                 p_context,
+                 NULL,
+                 maze_get_cell_idx(p_grid, p_start_node),
+                 maze_get_cell_idx(p_grid, p_end_node));
+}
+
+/**
+ * @brief Runs a search begun by @ref a_star_ctx_start until it finishes or its
+ * budget runs out. The open set is kept in the context, so a paused search
+ * carries on from where it stopped the next time it is resumed, e.g. on the
+ * next tick of a control loop.
+ *
+ * @param[in] p_grid The grid maze. It must not change between calls.
+ * @param[in,out] p_context Pointer to the search context of the search.
+ * @param[in] p_end_node Pointer to the end node given to @ref
+ * a_star_ctx_start.
+ * @param[in] p_budget Pointer to the budget of this call, or NULL to run the
+ * search to the end.
+ * @return a_star_status_t Whether the search found the end node, found that it
+ * is unreachable, or paused. While it is paused, @ref a_star_ctx_get_frontier
+ * gives the most promising node so far.
+ *
+ * @note At least one node is expanded before the deadline is read, so that
+ * the search always makes progress.
+ */
+a_star_status_t
+a_star_ctx_resume (const maze_grid_t      *p_grid,
+                   search_context_t       *p_context,
+                   const maze_grid_cell_t *p_end_node,
+                   const a_star_budget_t  *p_budget)
+{
+    return a_star_inner_loop(p_grid,
+                             p_context,
+                             NULL,
+                             maze_get_cell_idx(p_grid, p_end_node),
+                             p_budget);
+}
+
+/**
+ * @brief Gets the node in the open set of a search with the lowest F-value.
+ * While the search is paused, this is its best guess at where the path to the
+ * end node goes, and its path can be read with @ref a_star_ctx_get_path.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to the search context of the search.
+ * @return const maze_grid_cell_t* Pointer to the node, NULL if the open set is
+ * empty.
+ */
+const maze_grid_cell_t *
+a_star_ctx_get_frontier (const maze_grid_t *p_grid,
+                         search_context_t  *p_context)
+{
+    if (open_set_is_empty(&p_context->open_set))
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
-        {
-            maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
-            p_cell->g = UINT16_MAX;
-            p_cell->h = UINT16_MAX;
-        }
+        return NULL;
+    }
+
+    return &p_grid->p_grid_array[open_set_peek(&p_context->open_set)];
+}
+
+/**
+ * @brief Gets the path found by @ref a_star_ctx from the start node to the end
+ * node (inclusive).
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_context Pointer to the search context used by the search.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return a_star_path_t* Pointer to the path, NULL if the end node was not
+ * reached or the path could not be allocated. The `p_came_from` field of each
+ * path cell points to the previous cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ */
+a_star_path_t *
+a_star_ctx_get_path (const maze_grid_t      *p_grid,
+                     const search_context_t *p_context,
+                     const maze_grid_cell_t *p_end_node)
+{
+    maze_idx_t cell_idx = maze_get_cell_idx(p_grid, p_end_node);
+
+    if (!search_context_is_reached(p_context, cell_idx))
+    {
+        return NULL;
     }
 
-    // Step 3: Insert the start node into the open set.
+    // Cell costs make G differ from the number of steps, so the path is
+    // counted first.
     //
-    uint32_t start_node_priority = maze_manhattan_dist(
-        &p_start_node->coordinates, &p_end_node->coordinates);
-    p_start_node->g = 0;
-    p_start_node->h = start_node_priority;
-    p_start_node->f = start_node_priority;
-    binary_heap_insert(&open_set, p_start_node, start_node_priority);
+    uint32_t path_length = 0;
+
+    for (maze_idx_t idx = cell_idx; SEARCH_CONTEXT_NO_CELL != idx;
+         idx            = p_context->p_came_from[idx])
+    {
+        path_length++;
+    }
+
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+
+    if (NULL == p_path || NULL == p_path_struct)
+    {
+        maze_free(p_path);
+        maze_free(p_path_struct);
+        return NULL;
+    }
 
-    // Step 4: Run the inner loop.
+    p_path_struct->length = path_length;
+    p_path_struct->p_path = p_path;
+
+    // Traverse the path backwards and store it in the path array in reverse.
     //
-    a_star_inner_loop(&open_set, p_end_node);
+    for (uint32_t reverse_index = path_length; 0 < reverse_index;
+         reverse_index--)
+    {
+        maze_grid_cell_t *p_cell = &p_path[reverse_index - 1];
+        *p_cell                  = p_grid->p_grid_array[cell_idx];
+        p_cell->f                = p_context->p_f[cell_idx];
+        p_cell->g                = p_context->p_g[cell_idx];
+        p_cell->h                = p_context->p_h[cell_idx];
+        p_cell->p_came_from
+            = (1 < reverse_index) ? &p_path[reverse_index - 2] : NULL;
+
+        cell_idx = p_context->p_came_from[cell_idx];
+    }
 
-    // Step 5: Clean up.
-    free(open_set.p_array);
+    return p_path_struct;
 }
 
 /**
@@ -109,9 +406,21 @@ a_star_get_path (maze_grid_cell_t *p_end_node)
 {
     uint32_t          path_length    = 0;
     maze_grid_cell_t *p_current_node = p_end_node;
-    path_length                      = p_current_node->p_came_from->g + 2;
-    maze_grid_cell_t *p_path = malloc(sizeof(maze_grid_cell_t) * path_length);
-    a_star_path_t    *p_path_struct = malloc(sizeof(a_star_path_t));
+
+    // Cell costs make G differ from the number of steps, so the path is
+    // counted back to the start node, the only node with a G-value of 0.
+    //
+    for (const maze_grid_cell_t *p_cell = p_end_node; 0 < p_cell->g;
+         p_cell                         = p_cell->p_came_from)
+    {
+        path_length++;
+    }
+
+    path_length++;
+
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
     p_path_struct->length           = path_length;
     p_path_struct->p_path           = p_path;
 
@@ -136,62 +445,19 @@ a_star_get_path (maze_grid_cell_t *p_end_node)
  * @param[in] p_path Pointer to the path.
  *
  * @return char* The string representation of the path.
- * @warning The string must be freed after use.
+ * @warning The string must be freed after use with @ref maze_free.
  */
 char *
 a_star_get_path_str (maze_grid_t *p_grid, a_star_path_t *p_path)
 {
-    char *p_maze_string = maze_get_string(p_grid);
-
-    // Initialise the pointers to the current and previous cells.
-    //
-    maze_grid_cell_t *p_cell
-        = &p_path->p_path[p_path->length - 1]; // Current cell.
-    maze_grid_cell_t *p_previous_cell = NULL;  // Previous cell.
-
-    uint16_t str_num_cols
-        = p_grid->columns * 4 + 2; // Number of columns in the string.
-
-    // For each node, find the direction that leads in and out of the node, then
-    // add to the string. Special cases are the start and end nodes. This
-    // handles the end node.
-    //
-    maze_cardinal_direction_t direction = maze_get_dir_from_to(
-        &p_cell->coordinates, &p_cell->p_came_from->coordinates);
-
-    insert_path_directions(
-        p_maze_string, p_cell, str_num_cols, direction, MAZE_NONE);
-
-    // Now for the rest of the path.
-    //
-    for (uint32_t index = p_path->length - 2; 0 < index; index--)
-    {
-        // Find the direction that leads in and out of the current cell, then
-        // add to the string.
-        //
-        p_previous_cell = p_cell;
-        p_cell          = &p_path->p_path[index];
-
-        maze_cardinal_direction_t in_direction = maze_get_dir_from_to(
-            &p_cell->coordinates, &p_cell->p_came_from->coordinates);
-        maze_cardinal_direction_t out_direction = maze_get_dir_from_to(
-            &p_cell->coordinates, &p_previous_cell->coordinates);
-
-        insert_path_directions(
-            p_maze_string, p_cell, str_num_cols, in_direction, out_direction);
-    }
-
-    // Now for the start node.
-    //
-    p_previous_cell = p_cell;
-    p_cell          = &p_path->p_path[0];
-
-    direction = maze_get_dir_from_to(&p_cell->coordinates,
-                                     &p_previous_cell->coordinates);
-
-    insert_path_directions(
-        p_maze_string, p_cell, str_num_cols, MAZE_NONE, direction);
-    return p_maze_string;
+    maze_render_overlay_t overlay = {
+        .p_navigator = NULL,
+        .p_path      = p_path->p_path,
+        .path_length = p_path->length,
+        .p_steps     = NULL,
+    };
+
+    return maze_render_to_string(p_grid, &overlay);
 }
 
 /**
@@ -207,13 +473,14 @@ a_star_get_path_str (maze_grid_t *p_grid, a_star_path_t *p_path)
 int16_t
 a_star_path_to_buffer (const a_star_path_t *p_path,
                        uint8_t             *p_buffer,
-                       uint16_t             buffer_size)
+                       size_t               buffer_size)
 {
     // Calculate the number of bytes required to store the path.
     //
-    uint16_t path_size   = p_path->length * 4u; // 2x uint16_t for each point.
-    uint16_t header_size = 4u; // 1x uint32_t for the length of the path.
-    uint16_t total_size  = path_size + header_size;
+    size_t path_size   = (size_t)p_path->length * 4u; // 2x uint16_t for each
+                                                      // point.
+    size_t header_size = 4u; // 1x uint32_t for the length of the path.
+    size_t total_size  = path_size + header_size;
 
     // Check if the buffer is large enough.
     //
@@ -257,41 +524,40 @@ a_star_path_to_buffer (const a_star_path_t *p_path,
  * navigator state in.
  * @param[in] buffer_size Size of the buffer. Checks if the buffer is large
  * enough.
- * @return int16_t -1 if the buffer is too small, the size of the buffer
+ * @return int32_t -1 if the buffer is too small, the size of the buffer
  * required otherwise.
  */
-int16_t
+int32_t
 a_star_maze_path_nav_to_buffer (maze_grid_t                  *p_grid,
                                 const a_star_path_t          *p_path,
                                 const maze_navigator_state_t *p_navigator,
                                 uint8_t                      *p_buffer,
-                                uint16_t                      buffer_size)
+                                size_t                        buffer_size)
 {
-    int16_t ret_val = 0;
+    int32_t ret_val = 0;
 
     // Step 1: Calculate the total size of the buffer required.
     //
-    uint16_t grid_header_size = 4u; // 2 x uint16_t for rows and columns.
-    uint16_t grid_size
-        = (p_grid->rows * p_grid->columns) / 2
-          + (p_grid->rows * p_grid->columns) % 2; // 4 bits per cell.
+    size_t grid_header_size = 4u; // 2 x uint16_t for rows and columns.
+    size_t num_cells        = MAZE_GRID_CELLS(p_grid);
+    size_t grid_size        = num_cells / 2 + num_cells % 2; // 4 bits per cell.
 
-    uint16_t path_size = 0u;
+    size_t path_size = 0u;
 
     if (NULL != p_path)
     {
-        path_size
-            = p_path->length * 4u + 4u; // 2x uint16_t for each point, 1x
-                                        // uint32_t for the length of the path.
+        path_size = (size_t)p_path->length * 4u
+                    + 4u; // 2x uint16_t for each point, 1x uint32_t for the
+                          // length of the path.
     }
 
-    uint16_t navigator_size = 13u; // 13 bytes for the navigator state.
+    size_t navigator_size = 13u; // 13 bytes for the navigator state.
 
-    uint16_t delimiter_size  = 2u; // 2x uint16_t for each delimiter.
-    uint16_t delimiters_size = 4u; // 2x delimiters for the total.
+    size_t delimiter_size  = 2u; // 2x uint16_t for each delimiter.
+    size_t delimiters_size = 4u; // 2x delimiters for the total.
 
-    uint16_t buffer_size_required = grid_header_size + grid_size + path_size
-                                    + navigator_size + delimiters_size;
+    size_t buffer_size_required = grid_header_size + grid_size + path_size
+                                  + navigator_size + delimiters_size;
 
     if (buffer_size < buffer_size_required)
     {
@@ -357,252 +623,1392 @@ a_star_maze_path_nav_to_buffer (maze_grid_t                  *p_grid,
         goto end;
     }
 
-    ret_val = (int16_t)buffer_size_required; // Return the size of the buffer
+    ret_val = (int32_t)buffer_size_required; // Return the size of the buffer
                                              // required.
 
 end:
     return ret_val;
 }
 
-// Private functions.
-// ----------------------------------------------------------------------------
-//
-
 /**
- * @brief Contains the inner loop of the A* algorithm.
+ * @brief Runs the A* algorithm on a compact maze. As the compact maze has no
+ * room for search values, they are kept in arrays that only live for the
+ * duration of the search.
  *
- * @param[in] p_open_set The open set heap which contains all unexplored nodes
- * adjacent to explored nodes.
- * @param[in] p_end_node Pointer to the end node.
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] start_idx Index of the start cell.
+ * @param[in] end_idx Index of the end cell.
+ * @return a_star_path_t* Path from the start cell to the end cell (inclusive),
+ * NULL if no path exists or an allocation failed. Only the coordinates,
+ * g-values and `p_came_from` fields of the path cells are set, where
+ * `p_came_from` points to the previous cell in the path.
  *
- * @see https://en.wikipedia.org/wiki/A*_search_algorithm#Pseudocode
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
  */
-static void
-a_star_inner_loop (binary_heap_t *p_open_set, maze_grid_cell_t *p_end_node)
+a_star_path_t *
+a_star_compact (const maze_compact_t *p_maze,
+                maze_idx_t            start_idx,
+                maze_idx_t            end_idx)
 {
-    while (p_open_set->size > 0)
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    // Step 1: Initialise the open set heap and the search arrays.
+    //
+    open_set_t open_set = open_set_create(num_cells);
+
+    maze_idx_t    *p_g         = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t       *p_came_from = maze_malloc(sizeof(uint8_t) * num_cells);
+    a_star_path_t *p_path      = NULL;
+
+    if (!open_set_is_valid(&open_set) || NULL == p_g || NULL == p_came_from)
     {
-        // Step 1: Get the node with the lowest F-value from the open set. If it
-        // is the end node, return.
-        binary_heap_node_t p_current_node = binary_heap_peek(p_open_set);
-        if (p_current_node.p_maze_node == p_end_node)
-        {
-            return;
-        }
+        goto end;
+    }
 
-        binary_heap_delete_min(p_open_set);
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_g[cell_idx]         = MAZE_IDX_MAX;
+        p_came_from[cell_idx] = MAZE_NONE;
+    }
 
-        for (uint8_t neighbour = 0; 4 > neighbour; neighbour++)
-        {
-            // Step 2: Ensure that the neighbour is not NULL.
-            //
-            if (NULL == p_current_node.p_maze_node->p_next[neighbour])
-            {
-                continue;
-            }
+    // Step 2: Insert the start cell into the open set.
+    //
+    maze_point_t start_point = maze_compact_get_point(p_maze, start_idx);
+    maze_point_t end_point   = maze_compact_get_point(p_maze, end_idx);
 
-            // Step 3: Calculate the tentative g-score.
-            //
-            uint32_t tentative_g_score = p_current_node.p_maze_node->g + 1;
-            maze_grid_cell_t *p_neighbour_node
-                = p_current_node.p_maze_node->p_next[neighbour];
+    p_g[start_idx] = 0;
+    open_set_push(
+        &open_set, start_idx, maze_manhattan_dist(&start_point, &end_point));
 
-            if (tentative_g_score < p_neighbour_node->g)
-            {
-                // Step 4: Update the g-score and h-score of the neighbour,
-                // since it is better than the previous value.
-                //
-                p_neighbour_node->g = tentative_g_score;
-                p_neighbour_node->h = maze_manhattan_dist(
-                    &p_current_node.p_maze_node->coordinates,
-                    &p_end_node->coordinates);
-                p_neighbour_node->f = p_neighbour_node->g + p_neighbour_node->h;
-
-                // Step 5: Check if the neighbour is in the open set. If not,
-                // add it.
-                //
-                uint16_t neighbour_index
-                    = binary_heap_get_node_idx(p_open_set, p_neighbour_node);
-                if (UINT16_MAX == neighbour_index)
-                {
-                    uint32_t neighbour_priority
-                        = p_current_node.p_maze_node->g
-                          + p_current_node.p_maze_node->h;
-
-                    binary_heap_insert(
-                        p_open_set,
-                        p_current_node.p_maze_node->p_next[neighbour],
-                        neighbour_priority);
-                }
-                // Otherwise, update the priority of the neighbour.
-                else
-                {
-                    p_open_set->p_array[neighbour_index].priority
-                        = p_neighbour_node->f;
-                    binary_heapify_up(p_open_set, neighbour_index);
-                }
+    // Step 3: Run the inner loop and retrieve the path.
+    //
+    a_star_compact_inner_loop(p_maze, &open_set, p_g, p_came_from, end_idx);
+    p_path = a_star_compact_get_path(p_maze, p_g, p_came_from, end_idx);
 
-                p_current_node.p_maze_node->p_next[neighbour]->p_came_from
-                    = p_current_node.p_maze_node;
-            }
-        }
-    }
+    // Step 4: Clean up.
+    //
+end:
+    open_set_destroy(&open_set);
+    maze_free(p_g);
+    maze_free(p_came_from);
+
+    return p_path;
 }
 
 /**
- * @brief Inserts the path directions and node centres into the maze string.
+ * @brief Runs the A* algorithm on a chunked maze. Only cells in allocated
+ * chunks are searched. Like @ref a_star_compact, the search values are kept in
+ * arrays that only live for the duration of the search.
  *
- * @param[in,out] p_maze_string Pointer to the maze string.
- * @param[in] p_cell Pointer to the current cell.
- * @param[in] str_num_cols Number of columns in the maze string.
- * @param[in] in_direction Direction that leads into the current cell.
- * @param[in] out_direction Direction that leads out of the current cell.
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] start_idx Index of the start cell.
+ * @param[in] end_idx Index of the end cell.
+ * @return a_star_path_t* Path from the start cell to the end cell (inclusive),
+ * NULL if no path exists or an allocation failed. The coordinates of the path
+ * cells are relative to the minimum corner of @ref maze_chunked_get_bounds,
+ * i.e. the same frame as @ref maze_chunked_serialise. Only the coordinates,
+ * g-values and `p_came_from` fields of the path cells are set.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
  */
-static void
-insert_path_directions (char                           *p_maze_string,
-                        const maze_grid_cell_t         *p_cell,
-                        const uint16_t                  str_num_cols,
-                        const maze_cardinal_direction_t in_direction,
-                        const maze_cardinal_direction_t out_direction)
+a_star_path_t *
+a_star_chunked (const maze_chunked_t *p_maze,
+                maze_idx_t            start_idx,
+                maze_idx_t            end_idx)
 {
-    uint32_t node_row = p_cell->coordinates.y * 2 + 1;
-    uint32_t node_col = p_cell->coordinates.x * 4 + 2;
-    if (in_direction != MAZE_NONE)
+    maze_idx_t num_cells = maze_chunked_get_num_cells(p_maze);
+
+    // Step 1: Initialise the open set heap and the search arrays.
+    //
+    open_set_t open_set = open_set_create(num_cells);
+
+    maze_idx_t    *p_g         = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t       *p_came_from = maze_malloc(sizeof(uint8_t) * num_cells);
+    a_star_path_t *p_path      = NULL;
+
+    if (!open_set_is_valid(&open_set) || NULL == p_g || NULL == p_came_from)
     {
-        insert_path_in_direction(
-            p_maze_string, str_num_cols, node_row, node_col, in_direction);
+        goto end;
     }
 
-    switch (in_direction)
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
     {
-        case MAZE_NONE:
-            // Deals with the start node.
-            insert_node_centre_char(
-                p_maze_string, node_row, node_col, str_num_cols, '%');
-            goto handle_end;
-        case MAZE_NORTH:
-            if (MAZE_SOUTH == out_direction)
-            {
-                insert_node_centre_char(
-                    p_maze_string, node_row, node_col, str_num_cols, '|');
-            }
-            else
-            {
-                goto handle_direction_change;
-            }
-            goto handle_end;
-        case MAZE_EAST:
-            if (MAZE_WEST == out_direction)
-            {
-                insert_node_centre_char(
-                    p_maze_string, node_row, node_col, str_num_cols, '-');
-            }
-            else
-            {
-                goto handle_direction_change;
-            }
-            goto handle_end;
-        case MAZE_SOUTH:
-            if (MAZE_NORTH == out_direction)
-            {
-                insert_node_centre_char(
-                    p_maze_string, node_row, node_col, str_num_cols, '|');
-            }
-            else
-            {
-                goto handle_direction_change;
-            }
-            goto handle_end;
-        case MAZE_WEST:
-            if (MAZE_EAST == out_direction)
-            {
-                insert_node_centre_char(
-                    p_maze_string, node_row, node_col, str_num_cols, '-');
-            }
-            else
-            {
-                goto handle_direction_change;
-            }
-            goto handle_end;
+        p_g[cell_idx]         = MAZE_IDX_MAX;
+        p_came_from[cell_idx] = MAZE_NONE;
     }
 
-    // Handle the case where the direction changes by inserting a 'O'.
+    // Step 2: Insert the start cell into the open set.
     //
-handle_direction_change:
-    insert_node_centre_char(
-        p_maze_string, node_row, node_col, str_num_cols, 'O');
+    maze_chunked_point_t start_point
+        = maze_chunked_get_point(p_maze, start_idx);
+    maze_chunked_point_t end_point = maze_chunked_get_point(p_maze, end_idx);
 
-    // Fallthrough to handle the end node.
+    p_g[start_idx] = 0;
+    open_set_push(
+        &open_set,
+        start_idx,
+        maze_chunked_manhattan_dist(&start_point, &end_point));
+
+    // Step 3: Run the inner loop and retrieve the path.
     //
-handle_end:
-    if (MAZE_NONE == out_direction)
-    {
-        // Deals with the end node.
-        insert_node_centre_char(
-            p_maze_string, node_row, node_col, str_num_cols, 'X');
-    }
+    a_star_chunked_inner_loop(p_maze, &open_set, p_g, p_came_from, end_idx);
+    p_path = a_star_chunked_get_path(p_maze, p_g, p_came_from, end_idx);
+
+    // Step 4: Clean up.
+    //
+end:
+    open_set_destroy(&open_set);
+    maze_free(p_g);
+    maze_free(p_came_from);
+
+    return p_path;
 }
 
 /**
- * @brief Inserts the path string in the given direction.
+ * @brief Gets the costs of the car's moves in encoder steps.
  *
- * @param[in,out] p_maze_str Pointer to the string containing the pretty printed
- * maze.
- * @param[in] str_num_cols Number of rows in the string.
- * @param[in] node_row Row of the node to add the path to.
- * @param[in] node_col Column of the node to add the path to.
- * @param[in] direction Direction to add the path in.
+ * @return a_star_turn_costs_t Costs from the constants in pid/pid.h.
  */
-static void
-insert_path_in_direction (char                           *p_maze_str,
-                          const uint16_t                  str_num_cols,
-                          const uint32_t                  node_row,
-                          const uint32_t                  node_col,
-                          const maze_cardinal_direction_t direction)
+a_star_turn_costs_t
+a_star_turn_get_default_costs (void)
+{
+    a_star_turn_costs_t costs = {
+        .move          = A_STAR_COST_MOVE,
+        .turn_90_deg   = A_STAR_COST_TURN_90_DEG,
+        .turn_180_deg  = A_STAR_COST_TURN_180_DEG,
+        .center_offset = A_STAR_COST_CENTER_OFFSET,
+    };
+
+    return costs;
+}
+
+/**
+ * @brief Runs the A* algorithm over the cells and orientations of the car, to
+ * find the path that takes the fewest encoder steps to drive rather than the
+ * one with the fewest cells. Every turn costs the centring offset and the
+ * turn, so a longer path with fewer turns can be faster.
+ *
+ * @param[in] p_grid The grid maze. It is only read.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] start_orientation Orientation of the car at the start node.
+ * @param[in] p_end_node Pointer to the end node. It can be reached in any
+ * orientation.
+ * @param[in] p_costs Pointer to the costs, or NULL for @ref
+ * a_star_turn_get_default_costs.
+ * @return a_star_path_t* Path from the start node to the end node (inclusive),
+ * NULL if no path exists. The g-value of each path cell is the number of
+ * encoder steps to drive to it, and its `p_came_from` field points to the
+ * previous cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ * @note The open set is always the binary heap, since the costs are not unit
+ * costs. Priorities saturate at MAZE_PRIORITY_MAX, so in the 16-bit build
+ * paths that cost more than that may not be the fastest.
+ */
+a_star_path_t *
+a_star_turn (const maze_grid_t         *p_grid,
+             const maze_grid_cell_t    *p_start_node,
+             maze_cardinal_direction_t  start_orientation,
+             const maze_grid_cell_t    *p_end_node,
+             const a_star_turn_costs_t *p_costs)
 {
-    switch (direction)
+    a_star_turn_costs_t default_costs = a_star_turn_get_default_costs();
+    size_t              num_states
+        = MAZE_GRID_CELLS(p_grid) * A_STAR_TURN_NUM_ORIENTATIONS;
+
+    if (NULL == p_costs)
+    {
+        p_costs = &default_costs;
+    }
+
+    if (MAZE_WEST < start_orientation || A_STAR_TURN_NO_STATE <= num_states)
+    {
+        return NULL;
+    }
+
+    // Step 1: Initialise the open set heap and the search arrays. A search
+    // state is a cell and the orientation that the car entered it in.
+    //
+    binary_heap_t  open_set    = binary_heap_create((maze_idx_t)num_states);
+    uint32_t      *p_g         = maze_malloc(sizeof(uint32_t) * num_states);
+    maze_idx_t    *p_came_from = maze_malloc(sizeof(maze_idx_t) * num_states);
+    a_star_path_t *p_path      = NULL;
+
+    if (NULL == open_set.p_array || NULL == open_set.p_positions
+        || NULL == p_g || NULL == p_came_from)
+    {
+        goto end;
+    }
+
+    for (size_t state = 0; num_states > state; state++)
     {
-        case MAZE_NORTH:
-            p_maze_str[(node_row - 1) * str_num_cols + node_col] = '|';
+        p_g[state]         = UINT32_MAX;
+        p_came_from[state] = A_STAR_TURN_NO_STATE;
+    }
+
+    // Step 2: Insert the start state into the open set.
+    //
+    const maze_point_t *p_end_point = &p_end_node->coordinates;
+    maze_idx_t          end_idx     = maze_get_cell_idx(p_grid, p_end_node);
+    maze_idx_t          start_state
+        = maze_get_cell_idx(p_grid, p_start_node) * A_STAR_TURN_NUM_ORIENTATIONS
+          + start_orientation;
+
+    p_g[start_state] = 0;
+    binary_heap_decrease_key_idx(
+        &open_set,
+        start_state,
+        (maze_priority_t)a_star_turn_get_heuristic(p_costs,
+                                                   &p_start_node->coordinates,
+                                                   start_orientation,
+                                                   p_end_point));
+
+    while (0 < open_set.size)
+    {
+        // Step 3: Get the state with the lowest F-value. If it is in the end
+        // node, the path is complete.
+        //
+        maze_idx_t current_state = binary_heap_peek(&open_set).cell_idx;
+        maze_idx_t current_idx   = current_state / A_STAR_TURN_NUM_ORIENTATIONS;
+        maze_cardinal_direction_t orientation
+            = current_state % A_STAR_TURN_NUM_ORIENTATIONS;
+
+        binary_heap_delete_min(&open_set);
+
+        if (current_idx == end_idx)
+        {
+            p_path = a_star_turn_get_path(
+                p_grid, p_g, p_came_from, current_state);
             break;
-        case MAZE_EAST:
-            for (uint32_t index = 0; 3 > index; index++)
+        }
+
+        const maze_grid_cell_t *p_current_node
+            = &p_grid->p_grid_array[current_idx];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_neighbour_node
+                = p_current_node->p_next[direction];
+
+            if (NULL == p_neighbour_node)
             {
-                p_maze_str[node_row * str_num_cols + node_col + index + 1]
-                    = '-';
+                continue;
             }
-            break;
-        case MAZE_SOUTH:
-            p_maze_str[(node_row + 1) * str_num_cols + node_col] = '|';
-            break;
-        case MAZE_WEST:
-            for (uint32_t index = 0; 3 > index; index++)
+
+            // Step 4: Turning to face the neighbour and moving into it leaves
+            // the car in the neighbour, facing the same way. The move is
+            // scaled by the cost of entering the neighbour.
+            //
+            maze_idx_t neighbour_idx
+                = maze_get_cell_idx(p_grid, p_neighbour_node);
+            maze_idx_t neighbour_state
+                = neighbour_idx * A_STAR_TURN_NUM_ORIENTATIONS + direction;
+            uint32_t tentative_g_score
+                = p_g[current_state]
+                  + a_star_turn_get_turn_cost(p_costs, orientation, direction)
+                  + p_costs->move * MAZE_CELL_COST(p_grid, neighbour_idx);
+
+            if (tentative_g_score >= p_g[neighbour_state])
             {
-                p_maze_str[node_row * str_num_cols + node_col + index - 3]
-                    = '-';
+                continue;
             }
-            break;
-        default:
-            break;
+
+            // Step 5: Add the neighbour state to the open set, or update its
+            // priority. The heuristic is admissible but may be inconsistent,
+            // so a closed state is reopened if a cheaper way to it is found.
+            //
+            uint32_t f_score
+                = tentative_g_score
+                  + a_star_turn_get_heuristic(p_costs,
+                                              &p_neighbour_node->coordinates,
+                                              direction,
+                                              p_end_point);
+
+            p_g[neighbour_state]         = tentative_g_score;
+            p_came_from[neighbour_state] = current_state;
+            binary_heap_decrease_key_idx(
+                &open_set,
+                neighbour_state,
+                (maze_priority_t)((MAZE_PRIORITY_MAX < f_score)
+                                      ? MAZE_PRIORITY_MAX
+                                      : f_score));
+        }
     }
+
+end:
+    binary_heap_destroy(&open_set);
+    maze_free(p_g);
+    maze_free(p_came_from);
+
+    return p_path;
 }
 
 /**
- * @brief Inserts the symbol into the centre of the node's cell for printing.
+ * @brief Runs Jump Point Search on a grid maze to find the shortest path
+ * between two nodes. Straight runs of open cells are skipped over, so only
+ * the nodes where a shortest path may turn are added to the open set.
+ *
+ * Among the shortest paths, horizontal moves are taken before vertical moves.
+ * A vertical run only stops where a horizontal move is forced by a wall, and
+ * a horizontal run stops where a vertical run from it would stop.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[out] p_num_expanded Number of nodes taken from the open set, or NULL.
+ * @return a_star_path_t* Path from the start node to the end node (inclusive)
+ * with every cell in between, NULL if no path exists. The `p_came_from` field
+ * of each path cell points to the previous cell in the path.
  *
- * @param[in,out] p_maze_string Pointer to the maze string.
- * @param[in] row Row of the node in coordinates of the maze string.
- * @param[in] col Column of the node in coordinates of the maze string.
- * @param[in] symbol Symbol to insert.
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ * @note The open set is always the binary heap, since a jump can raise the
+ * F-value by twice its length, which is more than the bucket queue can span.
+ * A run of cells is only skipped if every cell costs the same, so mazes with
+ * cell costs are searched cell by cell instead.
+ * @note JPS expands far fewer nodes than A*, but that does not make it faster
+ * in open rooms: every jump scans its run cell by cell, and every search
+ * fills arrays for every cell, where @ref a_star_ctx resets its context
+ * lazily. Benchmark part 6 compares the two.
+ * @see https://harabor.net/data/papers/harabor-grastien-aaai11.pdf
  */
-static void
-insert_node_centre_char (char          *p_maze_string,
-                         const uint32_t row,
-                         const uint32_t col,
-                         const uint16_t str_num_cols,
-                         const char     symbol)
+a_star_path_t *
+a_star_jps (const maze_grid_t      *p_grid,
+            const maze_grid_cell_t *p_start_node,
+            const maze_grid_cell_t *p_end_node,
+            uint32_t               *p_num_expanded)
 {
-    p_maze_string[row * str_num_cols + col] = symbol;
+    maze_idx_t num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+
+    if (NULL != p_grid->p_costs)
+    {
+        return a_star_jps_weighted(
+            p_grid, p_start_node, p_end_node, p_num_expanded);
+    }
+
+    // Step 1: Initialise the open set heap and the search arrays. The
+    // direction that a node was reached in decides which jumps leave it.
+    //
+    binary_heap_t  open_set     = binary_heap_create(num_cells);
+    uint32_t      *p_g          = maze_malloc(sizeof(uint32_t) * num_cells);
+    maze_idx_t    *p_came_from  = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t       *p_directions = maze_malloc(sizeof(uint8_t) * num_cells);
+    a_star_path_t *p_path       = NULL;
+    uint32_t       num_expanded = 0;
+
+    if (NULL == open_set.p_array || NULL == open_set.p_positions
+        || NULL == p_g || NULL == p_came_from || NULL == p_directions)
+    {
+        goto end;
+    }
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_g[cell_idx]          = UINT32_MAX;
+        p_came_from[cell_idx]  = SEARCH_CONTEXT_NO_CELL;
+        p_directions[cell_idx] = MAZE_NONE;
+    }
+
+    // Step 2: Insert the start node into the open set. Jump points with
+    // equal F-values are taken nearest to the end node first, when the
+    // priorities have room to order them by their H-values too.
+    //
+    const maze_point_t *p_end_point = &p_end_node->coordinates;
+    maze_idx_t          start_idx   = maze_get_cell_idx(p_grid, p_start_node);
+    maze_idx_t          end_idx     = maze_get_cell_idx(p_grid, p_end_node);
+    uint64_t            h_scale
+        = (uint64_t)MAZE_GRID_ROWS(p_grid) + MAZE_GRID_COLS(p_grid);
+
+    if ((num_cells + h_scale) * h_scale > MAZE_PRIORITY_MAX)
+    {
+        h_scale = 1;
+    }
+
+    p_g[start_idx] = 0;
+    binary_heap_decrease_key_idx(&open_set, start_idx, 0);
+
+    while (0 < open_set.size)
+    {
+        // Step 3: Get the node with the lowest F-value. If it is the end node,
+        // the path is complete.
+        //
+        maze_idx_t current_idx = binary_heap_peek(&open_set).cell_idx;
+        binary_heap_delete_min(&open_set);
+        num_expanded++;
+
+        if (current_idx == end_idx)
+        {
+            p_path = a_star_jps_get_path(
+                p_grid, p_g, p_came_from, p_directions, end_idx);
+            break;
+        }
+
+        // Step 4: Find the directions to jump in. The start node jumps in
+        // every direction. A node reached horizontally may also turn up or
+        // down, and a node reached vertically may only turn where it is
+        // forced to.
+        //
+        const maze_grid_cell_t *p_current_node
+            = &p_grid->p_grid_array[current_idx];
+        maze_cardinal_direction_t direction = p_directions[current_idx];
+        uint8_t                   jump_bitmask;
+
+        if (MAZE_NONE == direction)
+        {
+            jump_bitmask = 0xF;
+        }
+        else if (A_STAR_JPS_IS_HORIZONTAL(direction))
+        {
+            jump_bitmask
+                = (1u << direction) | (1u << MAZE_NORTH) | (1u << MAZE_SOUTH);
+        }
+        else
+        {
+            const maze_grid_cell_t *p_prev_node
+                = p_current_node->p_next[(direction + 2) % 4];
+            jump_bitmask = 1u << direction;
+
+            for (uint8_t side = MAZE_EAST; MAZE_WEST >= side; side += 2)
+            {
+                if (a_star_jps_is_forced(
+                        p_prev_node, p_current_node, direction, side))
+                {
+                    jump_bitmask |= 1u << side;
+                }
+            }
+        }
+
+        for (uint8_t jump_dir = 0; 4 > jump_dir; jump_dir++)
+        {
+            if (0 == (jump_bitmask & (1u << jump_dir)))
+            {
+                continue;
+            }
+
+            const maze_grid_cell_t *p_jump_node
+                = A_STAR_JPS_IS_HORIZONTAL(jump_dir)
+                      ? a_star_jps_jump_horizontal(
+                            p_current_node, jump_dir, p_end_node)
+                      : a_star_jps_jump_vertical(
+                            p_current_node, jump_dir, p_end_node);
+
+            if (NULL == p_jump_node)
+            {
+                continue;
+            }
+
+            // Step 5: Add the jump point to the open set, or update its
+            // priority. Jumps are straight, so their cost is the Manhattan
+            // distance.
+            //
+            maze_idx_t jump_idx = maze_get_cell_idx(p_grid, p_jump_node);
+            uint32_t   tentative_g_score
+                = p_g[current_idx]
+                  + maze_manhattan_dist(&p_current_node->coordinates,
+                                        &p_jump_node->coordinates);
+
+            if (tentative_g_score >= p_g[jump_idx])
+            {
+                continue;
+            }
+
+            uint32_t h_score
+                = maze_manhattan_dist(&p_jump_node->coordinates, p_end_point);
+            uint64_t priority
+                = (tentative_g_score + h_score) * h_scale
+                  + ((1 < h_scale) ? h_score : 0);
+
+            p_g[jump_idx]          = tentative_g_score;
+            p_came_from[jump_idx]  = current_idx;
+            p_directions[jump_idx] = jump_dir;
+            binary_heap_decrease_key_idx(
+                &open_set,
+                jump_idx,
+                (maze_priority_t)((MAZE_PRIORITY_MAX < priority)
+                                      ? MAZE_PRIORITY_MAX
+                                      : priority));
+        }
+    }
+
+end:
+    if (NULL != p_num_expanded)
+    {
+        *p_num_expanded = num_expanded;
+    }
+
+    binary_heap_destroy(&open_set);
+    maze_free(p_g);
+    maze_free(p_came_from);
+    maze_free(p_directions);
+
+    return p_path;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Begins a new search in a search context and inserts the start node
+ * into its open set.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to the search context.
+ * @param[in] p_landmarks Pointer to the landmark tables, NULL for none.
+ * @param[in] start_idx Index of the start node.
+ * @param[in] end_idx Index of the end node.
+ */
+static void
+a_star_begin (const maze_grid_t      *p_grid,
+              search_context_t       *p_context,
+              const maze_landmarks_t *p_landmarks,
+              maze_idx_t              start_idx,
+              maze_idx_t              end_idx)
+{
+    // Step 1: Begin a new search, which lazily resets every node.
+    //
+    search_context_begin(p_context);
+
+    // Step 2: Insert the start node into the open set.
+    //
+    uint32_t start_node_priority
+        = a_star_get_heuristic(p_grid, p_landmarks, start_idx, end_idx);
+    search_context_stamp(p_context, start_idx);
+    p_context->p_g[start_idx] = 0;
+    p_context->p_h[start_idx] = start_node_priority;
+    p_context->p_f[start_idx] = start_node_priority;
+    open_set_push(&p_context->open_set, start_idx, start_node_priority);
+}
+
+/**
+ * @brief Gets the H-value of a node: the Manhattan distance to the end node,
+ * raised to the landmark bound if there are landmark tables. Both are lower
+ * bounds, so the larger one is too. They count steps, and every step costs at
+ * least 1, so they stay lower bounds when cells have costs.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_landmarks Pointer to the landmark tables, NULL for none.
+ * @param[in] cell_idx Index of the node.
+ * @param[in] end_idx Index of the end node.
+ * @return uint32_t H-value of the node.
+ */
+static uint32_t
+a_star_get_heuristic (const maze_grid_t      *p_grid,
+                      const maze_landmarks_t *p_landmarks,
+                      maze_idx_t              cell_idx,
+                      maze_idx_t              end_idx)
+{
+    uint32_t h
+        = maze_manhattan_dist(&p_grid->p_grid_array[cell_idx].coordinates,
+                              &p_grid->p_grid_array[end_idx].coordinates);
+
+    if (NULL != p_landmarks)
+    {
+        uint32_t bound
+            = maze_landmarks_get_bound(p_landmarks, cell_idx, end_idx);
+        h = (bound > h) ? bound : h;
+    }
+
+    return h;
+}
+
+/**
+ * @brief Gets the multiplier of the F-value in the priority of a node, so that
+ * ties in F go to the node with the lower H-value. The landmark bound is exact
+ * along many paths, which leaves wide plateaus of equal F to break.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_landmarks Pointer to the landmark tables, NULL for none.
+ * @return uint32_t Multiplier, 1 for no tie-breaking: without landmarks, when
+ * the priorities would overflow, and with the bucket queue, whose ties already
+ * go to the deepest node.
+ */
+static uint32_t
+a_star_get_h_scale (const maze_grid_t      *p_grid,
+                    const maze_landmarks_t *p_landmarks)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    (void)p_grid;
+    (void)p_landmarks;
+    return 1;
+#else
+    if (NULL == p_landmarks)
+    {
+        return 1;
+    }
+
+    // F is below the number of cells times one more than the largest cost,
+    // since G is at most a path through every cell and H at most its length.
+    //
+    uint64_t max_f
+        = (uint64_t)MAZE_GRID_CELLS(p_grid) * (p_grid->max_cost + 1u);
+    uint64_t h_scale
+        = (uint64_t)MAZE_GRID_ROWS(p_grid) + MAZE_GRID_COLS(p_grid);
+
+    if ((max_f + 1u) * h_scale > MAZE_PRIORITY_MAX)
+    {
+        h_scale = MAZE_PRIORITY_MAX / (max_f + 1u);
+    }
+
+    return (2u > h_scale) ? 1u : (uint32_t)h_scale;
+#endif
+}
+
+/**
+ * @brief Contains the inner loop of the A* algorithm.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_context Pointer to the search context. Its open set
+ * contains all unexplored nodes adjacent to explored nodes.
+ * @param[in] p_landmarks Pointer to the landmark tables, NULL for none.
+ * @param[in] end_idx Index of the end node.
+ * @param[in] p_budget Pointer to the budget of the loop, or NULL for none.
+ * @return a_star_status_t State of the search when the loop stopped.
+ *
+ * @see https://en.wikipedia.org/wiki/A*_search_algorithm#Pseudocode
+ */
+static a_star_status_t
+a_star_inner_loop (const maze_grid_t      *p_grid,
+                   search_context_t       *p_context,
+                   const maze_landmarks_t *p_landmarks,
+                   maze_idx_t              end_idx,
+                   const a_star_budget_t  *p_budget)
+{
+    open_set_t *p_open_set   = &p_context->open_set;
+    uint32_t    num_expanded = 0; // Nodes expanded in this call.
+    uint32_t    h_scale      = a_star_get_h_scale(p_grid, p_landmarks);
+
+    while (!open_set_is_empty(p_open_set))
+    {
+        // Step 1: Get the node with the lowest F-value from the open set. If it
+        // is the end node, return. Otherwise pause if the budget is spent,
+        // leaving the node in the open set.
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+        if (current_idx == end_idx)
+        {
+            return A_STAR_STATUS_FOUND;
+        }
+
+        if (NULL != p_budget && a_star_is_budget_spent(p_budget, num_expanded))
+        {
+            return A_STAR_STATUS_PAUSED;
+        }
+
+        open_set_pop(p_open_set);
+        p_context->num_expanded++;
+        num_expanded++;
+
+        const maze_grid_cell_t *p_current_node
+            = &p_grid->p_grid_array[current_idx];
+
+        for (uint8_t neighbour = 0; 4 > neighbour; neighbour++)
+        {
+            // Step 2: Ensure that the neighbour is not NULL.
+            //
+            const maze_grid_cell_t *p_neighbour_node
+                = p_current_node->p_next[neighbour];
+
+            if (NULL == p_neighbour_node)
+            {
+                continue;
+            }
+
+            // Step 3: Calculate the tentative g-score from the cost of
+            // entering the neighbour.
+            //
+            maze_idx_t neighbour_idx
+                = maze_get_cell_idx(p_grid, p_neighbour_node);
+            uint32_t tentative_g_score
+                = p_context->p_g[current_idx]
+                  + MAZE_CELL_COST(p_grid, neighbour_idx);
+            search_context_stamp(p_context, neighbour_idx);
+
+            if (tentative_g_score >= p_context->p_g[neighbour_idx])
+            {
+                continue;
+            }
+
+            // Step 4: Update the g-score and h-score of the neighbour, since
+            // it is better than the previous value.
+            //
+            p_context->p_g[neighbour_idx] = tentative_g_score;
+            p_context->p_h[neighbour_idx] = a_star_get_heuristic(
+                p_grid, p_landmarks, neighbour_idx, end_idx);
+            p_context->p_f[neighbour_idx]
+                = tentative_g_score + p_context->p_h[neighbour_idx];
+            p_context->p_came_from[neighbour_idx] = current_idx;
+
+            // Step 5: Check if the neighbour is in the open set. If not, add
+            // it. Otherwise, update its priority. Ties in F go to the lower H,
+            // which is saturated below the multiplier.
+            //
+            uint32_t tie_breaker = 0;
+
+            if (1u < h_scale)
+            {
+                tie_breaker = (p_context->p_h[neighbour_idx] < h_scale)
+                                  ? p_context->p_h[neighbour_idx]
+                                  : h_scale - 1u;
+            }
+
+            open_set_push(p_open_set,
+                          neighbour_idx,
+                          OPEN_SET_PRIORITY(
+                              (uint64_t)p_context->p_f[neighbour_idx] * h_scale
+                              + tie_breaker));
+        }
+    }
+
+    return A_STAR_STATUS_NO_PATH;
+}
+
+/**
+ * @brief Checks whether a search has spent its budget. The clock is only read
+ * every @ref A_STAR_CLOCK_INTERVAL expansions, since reading it can cost more
+ * than an expansion.
+ *
+ * @param[in] p_budget Pointer to the budget.
+ * @param[in] num_expanded Number of nodes expanded against the budget.
+ * @return true If the search should pause.
+ * @return false Otherwise.
+ */
+static bool
+a_star_is_budget_spent (const a_star_budget_t *p_budget,
+                        uint32_t               num_expanded)
+{
+    if (0 < p_budget->max_expanded && p_budget->max_expanded <= num_expanded)
+    {
+        return true;
+    }
+
+    return NULL != p_budget->p_get_time_us && 0 < num_expanded
+           && 0 == num_expanded % A_STAR_CLOCK_INTERVAL
+           && p_budget->p_get_time_us() >= p_budget->deadline_us;
+}
+
+/**
+ * @brief Writes the path found by @ref a_star_ctx into the grid. The nodes on
+ * the path are stamped with the grid's epoch, and their search values and
+ * `p_came_from` fields are set.
+ *
+ * @param[in,out] p_grid The grid maze.
+ * @param[in] p_context Pointer to the search context used by the search.
+ * @param[in] p_end_node Pointer to the end node.
+ */
+static void
+a_star_write_back_path (maze_grid_t            *p_grid,
+                        const search_context_t *p_context,
+                        const maze_grid_cell_t *p_end_node)
+{
+    maze_idx_t cell_idx = maze_get_cell_idx(p_grid, p_end_node);
+
+    if (!search_context_is_reached(p_context, cell_idx))
+    {
+        return;
+    }
+
+    while (SEARCH_CONTEXT_NO_CELL != cell_idx)
+    {
+        maze_grid_cell_t *p_cell        = &p_grid->p_grid_array[cell_idx];
+        maze_idx_t        came_from_idx = p_context->p_came_from[cell_idx];
+
+        maze_stamp_cell(p_grid, p_cell);
+        p_cell->f = p_context->p_f[cell_idx];
+        p_cell->g = p_context->p_g[cell_idx];
+        p_cell->h = p_context->p_h[cell_idx];
+
+        if (SEARCH_CONTEXT_NO_CELL != came_from_idx)
+        {
+            p_cell->p_came_from = &p_grid->p_grid_array[came_from_idx];
+        }
+
+        cell_idx = came_from_idx;
+    }
+}
+
+/**
+ * @brief Contains the inner loop of the A* algorithm for compact mazes.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in,out] p_open_set The open set heap of cell indices.
+ * @param[in,out] p_g Array of g-values indexed by cell.
+ * @param[in,out] p_came_from Array of directions from the previous cell into
+ * each cell, MAZE_NONE if the cell has not been reached.
+ * @param[in] end_idx Index of the end cell.
+ */
+static void
+a_star_compact_inner_loop (const maze_compact_t *p_maze,
+                           open_set_t           *p_open_set,
+                           maze_idx_t           *p_g,
+                           uint8_t              *p_came_from,
+                           maze_idx_t            end_idx)
+{
+    maze_point_t end_point = maze_compact_get_point(p_maze, end_idx);
+
+    while (!open_set_is_empty(p_open_set))
+    {
+        // Step 1: Get the cell with the lowest F-value from the open set. If it
+        // is the end cell, return.
+        //
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+        if (current_idx == end_idx)
+        {
+            return;
+        }
+
+        open_set_pop(p_open_set);
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            // Step 2: Ensure that there is no wall in the way.
+            //
+            maze_idx_t neighbour_idx
+                = maze_compact_get_next_idx(p_maze, current_idx, direction);
+
+            if (MAZE_COMPACT_NO_CELL == neighbour_idx)
+            {
+                continue;
+            }
+
+            // Step 3: Update the neighbour if the tentative g-score is better.
+            //
+            maze_idx_t tentative_g_score = p_g[current_idx] + 1;
+
+            if (tentative_g_score >= p_g[neighbour_idx])
+            {
+                continue;
+            }
+
+            p_g[neighbour_idx]         = tentative_g_score;
+            p_came_from[neighbour_idx] = direction;
+
+            maze_point_t neighbour_point
+                = maze_compact_get_point(p_maze, neighbour_idx);
+            maze_priority_t neighbour_f
+                = tentative_g_score
+                  + maze_manhattan_dist(&neighbour_point, &end_point);
+
+            // Step 4: Add the neighbour to the open set, or update its
+            // priority if it is already in it.
+            //
+            open_set_push(
+                p_open_set, neighbour_idx, neighbour_f);
+        }
+    }
+}
+
+/**
+ * @brief Builds the path to the end cell of a compact maze search.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] p_g Array of g-values indexed by cell.
+ * @param[in] p_came_from Array of directions into each cell.
+ * @param[in] end_idx Index of the end cell.
+ * @return a_star_path_t* Path to the end cell, NULL if it was not reached or
+ * the path could not be allocated.
+ */
+static a_star_path_t *
+a_star_compact_get_path (const maze_compact_t *p_maze,
+                         const maze_idx_t     *p_g,
+                         const uint8_t        *p_came_from,
+                         maze_idx_t            end_idx)
+{
+    if (MAZE_IDX_MAX == p_g[end_idx])
+    {
+        return NULL;
+    }
+
+    uint32_t          path_length = p_g[end_idx] + 1u;
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+
+    if (NULL == p_path || NULL == p_path_struct)
+    {
+        maze_free(p_path);
+        maze_free(p_path_struct);
+        return NULL;
+    }
+
+    memset(p_path, 0, sizeof(maze_grid_cell_t) * path_length);
+    p_path_struct->length = path_length;
+    p_path_struct->p_path = p_path;
+
+    // Traverse the path backwards by reversing the direction into each cell.
+    //
+    maze_idx_t cell_idx = end_idx;
+    for (uint32_t reverse_index = path_length; 0 < reverse_index;
+         reverse_index--)
+    {
+        maze_grid_cell_t *p_cell = &p_path[reverse_index - 1];
+        p_cell->coordinates      = maze_compact_get_point(p_maze, cell_idx);
+        p_cell->g                = reverse_index - 1;
+        p_cell->p_came_from
+            = (1 < reverse_index) ? &p_path[reverse_index - 2] : NULL;
+
+        if (MAZE_NONE != p_came_from[cell_idx])
+        {
+            cell_idx = maze_compact_get_idx_in_dir(
+                p_maze, cell_idx, (p_came_from[cell_idx] + 2) % 4);
+        }
+    }
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Contains the inner loop of the A* algorithm for chunked mazes.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in,out] p_open_set The open set heap of cell indices.
+ * @param[in,out] p_g Array of g-values indexed by cell.
+ * @param[in,out] p_came_from Array of directions from the previous cell into
+ * each cell, MAZE_NONE if the cell has not been reached.
+ * @param[in] end_idx Index of the end cell.
+ */
+static void
+a_star_chunked_inner_loop (const maze_chunked_t *p_maze,
+                           open_set_t           *p_open_set,
+                           maze_idx_t           *p_g,
+                           uint8_t              *p_came_from,
+                           maze_idx_t            end_idx)
+{
+    maze_chunked_point_t end_point = maze_chunked_get_point(p_maze, end_idx);
+
+    while (!open_set_is_empty(p_open_set))
+    {
+        // Step 1: Get the cell with the lowest F-value from the open set. If it
+        // is the end cell, return.
+        //
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+        if (current_idx == end_idx)
+        {
+            return;
+        }
+
+        open_set_pop(p_open_set);
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            // Step 2: Ensure that there is no wall in the way.
+            //
+            maze_idx_t neighbour_idx
+                = maze_chunked_get_next_idx(p_maze, current_idx, direction);
+
+            if (MAZE_CHUNKED_NO_CELL == neighbour_idx)
+            {
+                continue;
+            }
+
+            // Step 3: Update the neighbour if the tentative g-score is better.
+            //
+            maze_idx_t tentative_g_score = p_g[current_idx] + 1;
+
+            if (tentative_g_score >= p_g[neighbour_idx])
+            {
+                continue;
+            }
+
+            p_g[neighbour_idx]         = tentative_g_score;
+            p_came_from[neighbour_idx] = direction;
+
+            maze_chunked_point_t neighbour_point
+                = maze_chunked_get_point(p_maze, neighbour_idx);
+            maze_priority_t neighbour_f
+                = tentative_g_score
+                  + maze_chunked_manhattan_dist(&neighbour_point, &end_point);
+
+            // Step 4: Add the neighbour to the open set, or update its
+            // priority if it is already in it.
+            //
+            open_set_push(
+                p_open_set, neighbour_idx, neighbour_f);
+        }
+    }
+}
+
+/**
+ * @brief Builds the path to the end cell of a chunked maze search.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] p_g Array of g-values indexed by cell.
+ * @param[in] p_came_from Array of directions into each cell.
+ * @param[in] end_idx Index of the end cell.
+ * @return a_star_path_t* Path to the end cell, NULL if it was not reached or
+ * the path could not be allocated.
+ */
+static a_star_path_t *
+a_star_chunked_get_path (const maze_chunked_t *p_maze,
+                         const maze_idx_t     *p_g,
+                         const uint8_t        *p_came_from,
+                         maze_idx_t            end_idx)
+{
+    if (MAZE_IDX_MAX == p_g[end_idx])
+    {
+        return NULL;
+    }
+
+    maze_chunked_point_t min_point;
+    maze_chunked_point_t max_point;
+    maze_chunked_get_bounds(p_maze, &min_point, &max_point);
+
+    uint32_t          path_length = p_g[end_idx] + 1u;
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+
+    if (NULL == p_path || NULL == p_path_struct)
+    {
+        maze_free(p_path);
+        maze_free(p_path_struct);
+        return NULL;
+    }
+
+    memset(p_path, 0, sizeof(maze_grid_cell_t) * path_length);
+    p_path_struct->length = path_length;
+    p_path_struct->p_path = p_path;
+
+    // Traverse the path backwards by reversing the direction into each cell.
+    //
+    maze_idx_t cell_idx = end_idx;
+    for (uint32_t reverse_index = path_length; 0 < reverse_index;
+         reverse_index--)
+    {
+        maze_grid_cell_t    *p_cell = &p_path[reverse_index - 1];
+        maze_chunked_point_t point  = maze_chunked_get_point(p_maze, cell_idx);
+
+        p_cell->coordinates.x = (uint16_t)(point.x - min_point.x);
+        p_cell->coordinates.y = (uint16_t)(point.y - min_point.y);
+        p_cell->g             = reverse_index - 1;
+        p_cell->p_came_from
+            = (1 < reverse_index) ? &p_path[reverse_index - 2] : NULL;
+
+        if (MAZE_NONE != p_came_from[cell_idx])
+        {
+            cell_idx = maze_chunked_get_idx_in_dir(
+                p_maze, cell_idx, (p_came_from[cell_idx] + 2) % 4);
+        }
+    }
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Gets the cost of turning the car from one orientation to another.
+ *
+ * @param[in] p_costs Pointer to the costs.
+ * @param[in] from Orientation before the turn.
+ * @param[in] to Orientation after the turn.
+ * @return uint32_t Cost of centring and turning, 0 if there is no turn.
+ */
+static uint32_t
+a_star_turn_get_turn_cost (const a_star_turn_costs_t *p_costs,
+                           maze_cardinal_direction_t  from,
+                           maze_cardinal_direction_t  to)
+{
+    uint8_t quarter_turns = (uint8_t)((to - from + 4) % 4);
+
+    if (0 == quarter_turns)
+    {
+        return 0;
+    }
+
+    if (2 == quarter_turns)
+    {
+        return p_costs->center_offset + p_costs->turn_180_deg;
+    }
+
+    return p_costs->center_offset + p_costs->turn_90_deg;
+}
+
+/**
+ * @brief Gets a lower bound of the cost to drive from a state to the end node.
+ * Every cell of the Manhattan distance must be moved, and at least one turn is
+ * needed if the car must move along both axes or does not face a way it must
+ * move.
+ *
+ * @param[in] p_costs Pointer to the costs.
+ * @param[in] p_point Pointer to the coordinates of the cell of the state.
+ * @param[in] orientation Orientation of the state.
+ * @param[in] p_end_point Pointer to the coordinates of the end node.
+ * @return uint32_t Admissible estimate of the cost.
+ */
+static uint32_t
+a_star_turn_get_heuristic (const a_star_turn_costs_t *p_costs,
+                           const maze_point_t        *p_point,
+                           maze_cardinal_direction_t  orientation,
+                           const maze_point_t        *p_end_point)
+{
+    uint32_t h = maze_manhattan_dist(p_point, p_end_point) * p_costs->move;
+
+    // Step 1: Find the directions that the car must move in.
+    //
+    bool is_moving[4] = {
+        [MAZE_NORTH] = p_end_point->y < p_point->y,
+        [MAZE_EAST]  = p_end_point->x > p_point->x,
+        [MAZE_SOUTH] = p_end_point->y > p_point->y,
+        [MAZE_WEST]  = p_end_point->x < p_point->x,
+    };
+    bool is_two_axes = (is_moving[MAZE_NORTH] || is_moving[MAZE_SOUTH])
+                       && (is_moving[MAZE_EAST] || is_moving[MAZE_WEST]);
+    bool is_at_end   = 0 == maze_manhattan_dist(p_point, p_end_point);
+
+    // Step 2: Add the cheapest turn if one is unavoidable.
+    //
+    if (!is_at_end && (is_two_axes || !is_moving[orientation]))
+    {
+        h += p_costs->center_offset
+             + ((p_costs->turn_90_deg < p_costs->turn_180_deg)
+                    ? p_costs->turn_90_deg
+                    : p_costs->turn_180_deg);
+    }
+
+    return h;
+}
+
+/**
+ * @brief Gets the path found by @ref a_star_turn from the start node to the
+ * end node (inclusive).
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_g Costs of the search states.
+ * @param[in] p_came_from State that each state was reached from.
+ * @param[in] end_state Search state in the end node that was reached first.
+ * @return a_star_path_t* Pointer to the path.
+ */
+static a_star_path_t *
+a_star_turn_get_path (const maze_grid_t *p_grid,
+                      const uint32_t    *p_g,
+                      const maze_idx_t  *p_came_from,
+                      maze_idx_t         end_state)
+{
+    uint32_t path_length = 0;
+
+    for (maze_idx_t state = end_state; A_STAR_TURN_NO_STATE != state;
+         state            = p_came_from[state])
+    {
+        path_length++;
+    }
+
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_path;
+
+    // Traverse the path backwards and store it in the path array in reverse.
+    //
+    maze_idx_t state = end_state;
+    for (uint32_t reverse_index = path_length; 0 < reverse_index;
+         reverse_index--)
+    {
+        maze_grid_cell_t *p_cell = &p_path[reverse_index - 1];
+        *p_cell = p_grid->p_grid_array[state / A_STAR_TURN_NUM_ORIENTATIONS];
+        p_cell->f = p_g[state];
+        p_cell->g = p_g[state];
+        p_cell->h = 0;
+        p_cell->p_came_from
+            = (1 < reverse_index) ? &p_path[reverse_index - 2] : NULL;
+
+        state = p_came_from[state];
+    }
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Checks if a node reached vertically must turn to one side, because
+ * the neighbour on that side cannot be reached as quickly by moving
+ * horizontally first from the previous node.
+ *
+ * @param[in] p_prev_node Pointer to the previous node.
+ * @param[in] p_node Pointer to the node.
+ * @param[in] direction Vertical direction from the previous node to the node.
+ * @param[in] side Horizontal direction of the neighbour.
+ * @return true If the neighbour on that side is a forced neighbour.
+ * @return false Otherwise.
+ */
+static bool
+a_star_jps_is_forced (const maze_grid_cell_t   *p_prev_node,
+                      const maze_grid_cell_t   *p_node,
+                      maze_cardinal_direction_t direction,
+                      maze_cardinal_direction_t side)
+{
+    if (NULL == p_node->p_next[side])
+    {
+        return false;
+    }
+
+    const maze_grid_cell_t *p_prev_side_node = p_prev_node->p_next[side];
+
+    return NULL == p_prev_side_node
+           || NULL == p_prev_side_node->p_next[direction];
+}
+
+/**
+ * @brief Moves vertically from a node until the end node or a node with a
+ * forced neighbour is found.
+ *
+ * @param[in] p_node Pointer to the node to jump from.
+ * @param[in] direction Vertical direction of the jump.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return const maze_grid_cell_t* Pointer to the jump point, NULL if a wall
+ * is reached first.
+ */
+static const maze_grid_cell_t *
+a_star_jps_jump_vertical (const maze_grid_cell_t   *p_node,
+                          maze_cardinal_direction_t direction,
+                          const maze_grid_cell_t   *p_end_node)
+{
+    const maze_grid_cell_t *p_prev_node = p_node;
+    p_node                              = p_node->p_next[direction];
+
+    while (NULL != p_node)
+    {
+        if (p_node == p_end_node
+            || a_star_jps_is_forced(p_prev_node, p_node, direction, MAZE_EAST)
+            || a_star_jps_is_forced(p_prev_node, p_node, direction, MAZE_WEST))
+        {
+            return p_node;
+        }
+
+        p_prev_node = p_node;
+        p_node      = p_node->p_next[direction];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Moves horizontally from a node until the end node or a node that a
+ * vertical jump can leave from is found.
+ *
+ * @param[in] p_node Pointer to the node to jump from.
+ * @param[in] direction Horizontal direction of the jump.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return const maze_grid_cell_t* Pointer to the jump point, NULL if a wall
+ * is reached first.
+ */
+static const maze_grid_cell_t *
+a_star_jps_jump_horizontal (const maze_grid_cell_t   *p_node,
+                            maze_cardinal_direction_t direction,
+                            const maze_grid_cell_t   *p_end_node)
+{
+    p_node = p_node->p_next[direction];
+
+    while (NULL != p_node)
+    {
+        if (p_node == p_end_node
+            || NULL != a_star_jps_jump_vertical(p_node, MAZE_NORTH, p_end_node)
+            || NULL != a_star_jps_jump_vertical(p_node, MAZE_SOUTH, p_end_node))
+        {
+            return p_node;
+        }
+
+        p_node = p_node->p_next[direction];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Gets the path found by @ref a_star_jps, filling in the cells between
+ * the jump points.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_g G-values of the jump points.
+ * @param[in] p_came_from Jump point that each jump point was reached from.
+ * @param[in] p_directions Direction that each jump point was reached in.
+ * @param[in] end_idx Index of the end node.
+ * @return a_star_path_t* Pointer to the path.
+ */
+static a_star_path_t *
+a_star_jps_get_path (const maze_grid_t *p_grid,
+                     const uint32_t    *p_g,
+                     const maze_idx_t  *p_came_from,
+                     const uint8_t     *p_directions,
+                     maze_idx_t         end_idx)
+{
+    uint32_t          path_length = p_g[end_idx] + 1u;
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_path;
+
+    const maze_grid_cell_t *p_node      = &p_grid->p_grid_array[end_idx];
+    const maze_point_t     *p_end_point = &p_node->coordinates;
+    maze_idx_t              jump_idx    = end_idx;
+
+    // Traverse the path backwards and store it in the path array in reverse,
+    // stepping back along the jump into each jump point.
+    //
+    for (uint32_t reverse_index = path_length; 0 < reverse_index;
+         reverse_index--)
+    {
+        maze_grid_cell_t *p_cell = &p_path[reverse_index - 1];
+        *p_cell                  = *p_node;
+        p_cell->g                = reverse_index - 1;
+        p_cell->h = maze_manhattan_dist(&p_node->coordinates, p_end_point);
+        p_cell->f = p_cell->g + p_cell->h;
+        p_cell->p_came_from
+            = (1 < reverse_index) ? &p_path[reverse_index - 2] : NULL;
+
+        if (1 == reverse_index)
+        {
+            break;
+        }
+
+        maze_idx_t cell_idx = maze_get_cell_idx(p_grid, p_node);
+
+        if (cell_idx == p_came_from[jump_idx])
+        {
+            jump_idx = cell_idx;
+        }
+
+        p_node = p_node->p_next[(p_directions[jump_idx] + 2) % 4];
+    }
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Stands in for @ref a_star_jps on mazes with cell costs, by running a
+ * plain A* search in a search context of its own.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[out] p_num_expanded Number of nodes taken from the open set, or NULL.
+ * @return a_star_path_t* Path from the start node to the end node (inclusive),
+ * NULL if no path exists.
+ */
+static a_star_path_t *
+a_star_jps_weighted (const maze_grid_t      *p_grid,
+                     const maze_grid_cell_t *p_start_node,
+                     const maze_grid_cell_t *p_end_node,
+                     uint32_t               *p_num_expanded)
+{
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+    a_star_path_t *p_path = NULL;
+
+    if (a_star_ctx(p_grid, &context, p_start_node, p_end_node))
+    {
+        p_path = a_star_ctx_get_path(p_grid, &context, p_end_node);
+    }
+
+    if (NULL != p_num_expanded)
+    {
+        *p_num_expanded = context.num_expanded;
+    }
+
+    search_context_destroy(&context);
+
+    return p_path;
 }
 
 // End of pathfinding/a_star.c
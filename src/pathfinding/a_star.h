@@ -11,9 +11,15 @@
 #ifndef A_STAR_H // Include guard.
 #define A_STAR_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "pathfinding/binary_heap.h"
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/search_context.h"
 
 #ifndef NDEBUG
 /**
@@ -27,6 +33,33 @@
 #define DEBUG_PRINT(...)
 #endif
 
+/**
+ * @defgroup a_star_turn_costs Turn-Aware A* Costs
+ * @brief Default costs of @ref a_star_turn in encoder steps. They are the
+ * constants in pid/pid.h, which the library cannot include.
+ * @{
+ */
+
+/** @brief Number of encoder steps to move 1 cell. */
+#define A_STAR_COST_MOVE 25
+/** @brief Number of encoder steps to turn 90 deg. */
+#define A_STAR_COST_TURN_90_DEG 18
+/** @brief Number of encoder steps to turn 180 deg. */
+#define A_STAR_COST_TURN_180_DEG 36
+/** @brief Number of encoder steps to centre the car before a turn. */
+#define A_STAR_COST_CENTER_OFFSET 5
+/**
+ * @} */ // End of a_star_turn_costs group.
+
+/**
+ * @def A_STAR_CLOCK_INTERVAL
+ * @brief Number of nodes that a search with a deadline expands between reads
+ * of the clock.
+ */
+#ifndef A_STAR_CLOCK_INTERVAL
+#define A_STAR_CLOCK_INTERVAL 32u
+#endif
+
 // Type definitions.
 // ----------------------------------------------------------------------------
 //
@@ -42,6 +75,48 @@ typedef struct a_star_path
     maze_grid_cell_t *p_path; ///< Pointer to the first node in the path.
 } a_star_path_t;
 
+/**
+ * @brief Function that reads a clock in microseconds, e.g. time_us_64 on the
+ * Pico.
+ *
+ * @return uint64_t Current time in microseconds.
+ */
+typedef uint64_t (*a_star_clock_t)(void);
+
+/**
+ * @brief Struct containing how much of a search @ref a_star_ctx_resume may
+ * run before it pauses. @see a_star_budget
+ */
+typedef struct a_star_budget
+{
+    uint32_t       max_expanded;  ///< Nodes to expand, 0 for no limit.
+    uint64_t       deadline_us;   ///< Time in microseconds to pause at.
+    a_star_clock_t p_get_time_us; ///< Clock that the deadline is read against,
+                                  ///< NULL for no deadline.
+} a_star_budget_t;
+
+/**
+ * @brief Enum of the states that @ref a_star_ctx_resume can return in.
+ */
+typedef enum a_star_status
+{
+    A_STAR_STATUS_FOUND   = 0, ///< The end node was reached.
+    A_STAR_STATUS_NO_PATH = 1, ///< The end node is unreachable.
+    A_STAR_STATUS_PAUSED  = 2  ///< The budget ran out first.
+} a_star_status_t;
+
+/**
+ * @brief Struct containing the costs of driving in encoder steps, used by
+ * @ref a_star_turn. @see a_star_turn_costs
+ */
+typedef struct a_star_turn_costs
+{
+    uint32_t move;          ///< Cost to move 1 cell.
+    uint32_t turn_90_deg;   ///< Cost to turn 90 deg.
+    uint32_t turn_180_deg;  ///< Cost to turn 180 deg.
+    uint32_t center_offset; ///< Cost to centre the car before a turn.
+} a_star_turn_costs_t;
+
 // Public functions.
 // ----------------------------------------------------------------------------
 //
@@ -50,20 +125,69 @@ void a_star(maze_grid_t      *p_grid,
             maze_grid_cell_t *p_start_node,
             maze_grid_cell_t *p_end_node);
 
+bool a_star_ctx(const maze_grid_t      *p_grid,
+                search_context_t       *p_context,
+                const maze_grid_cell_t *p_start_node,
+                const maze_grid_cell_t *p_end_node);
+
+bool a_star_ctx_alt(const maze_grid_t      *p_grid,
+                    search_context_t       *p_context,
+                    const maze_landmarks_t *p_landmarks,
+                    const maze_grid_cell_t *p_start_node,
+                    const maze_grid_cell_t *p_end_node);
+
+void a_star_ctx_start(const maze_grid_t      *p_grid,
+                      search_context_t       *p_context,
+                      const maze_grid_cell_t *p_start_node,
+                      const maze_grid_cell_t *p_end_node);
+
+a_star_status_t a_star_ctx_resume(const maze_grid_t      *p_grid,
+                                  search_context_t       *p_context,
+                                  const maze_grid_cell_t *p_end_node,
+                                  const a_star_budget_t  *p_budget);
+
+const maze_grid_cell_t *a_star_ctx_get_frontier(const maze_grid_t *p_grid,
+                                                search_context_t  *p_context);
+
+a_star_path_t *a_star_ctx_get_path(const maze_grid_t      *p_grid,
+                                   const search_context_t *p_context,
+                                   const maze_grid_cell_t *p_end_node);
+
 a_star_path_t *a_star_get_path(maze_grid_cell_t *p_end_node);
 
 char *a_star_get_path_str(maze_grid_t *p_grid, a_star_path_t *p_path);
 
 int16_t a_star_path_to_buffer(const a_star_path_t *p_path,
                               uint8_t             *p_buffer,
-                              uint16_t             buffer_size);
+                              size_t               buffer_size);
 
-int16_t a_star_maze_path_nav_to_buffer(
+int32_t a_star_maze_path_nav_to_buffer(
     maze_grid_t                  *p_grid,
     const a_star_path_t          *p_path,
     const maze_navigator_state_t *p_navigator,
     uint8_t                      *p_buffer,
-    uint16_t                      buffer_size);
+    size_t                        buffer_size);
+
+a_star_path_t *a_star_compact(const maze_compact_t *p_maze,
+                              maze_idx_t            start_idx,
+                              maze_idx_t            end_idx);
+
+a_star_path_t *a_star_chunked(const maze_chunked_t *p_maze,
+                              maze_idx_t            start_idx,
+                              maze_idx_t            end_idx);
+
+a_star_turn_costs_t a_star_turn_get_default_costs(void);
+
+a_star_path_t *a_star_turn(const maze_grid_t         *p_grid,
+                           const maze_grid_cell_t    *p_start_node,
+                           maze_cardinal_direction_t start_orientation,
+                           const maze_grid_cell_t    *p_end_node,
+                           const a_star_turn_costs_t *p_costs);
+
+a_star_path_t *a_star_jps(const maze_grid_t      *p_grid,
+                          const maze_grid_cell_t *p_start_node,
+                          const maze_grid_cell_t *p_end_node,
+                          uint32_t               *p_num_expanded);
 
 #endif // A_STAR_H
 
@@ -0,0 +1,370 @@
+/**
+ * @file a_star_batch.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for batches of A* searches. The queries are split into
+ * one contiguous range per worker. A worker takes queries from the front of
+ * its own range, and once it runs dry it steals the back half of the largest
+ * range left, so workers only contend for a lock when one of them runs dry.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef MAZE_THREADS
+#include <pthread.h>
+#endif
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/a_star_batch.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the state of a batch shared by its workers.
+ */
+typedef struct a_star_batch_state
+{
+    const maze_grid_t          *p_grid;      ///< Grid maze that is searched.
+    const maze_landmarks_t     *p_landmarks; ///< Landmark tables, or NULL.
+    const a_star_query_t       *p_queries;   ///< Queries of the batch.
+    a_star_path_t             **pp_paths;    ///< Path of each query.
+    struct a_star_batch_worker *p_workers;   ///< Workers of the batch.
+    uint8_t                     num_workers; ///< Number of workers.
+} a_star_batch_state_t;
+
+/**
+ * @brief This struct contains a worker of a batch: its search context, which
+ * is reused for every query it runs, and the range of queries it has left.
+ */
+typedef struct a_star_batch_worker
+{
+    a_star_batch_state_t *p_state;   ///< State of the batch.
+    search_context_t      context;   ///< Search values of the worker.
+    uint32_t              next;      ///< Next query of the range.
+    uint32_t              end;       ///< End of the range (exclusive).
+    uint32_t              num_found; ///< Paths found by the worker.
+#ifdef MAZE_THREADS
+    pthread_mutex_t mutex;   ///< Guards the range.
+    pthread_t       thread;  ///< Thread of the worker.
+    bool            is_busy; ///< Whether the thread was started.
+#endif
+} a_star_batch_worker_t;
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void *a_star_batch_run_worker(void *p_arg);
+
+static bool a_star_batch_take_query(a_star_batch_worker_t *p_worker,
+                                    uint32_t              *p_query_idx);
+
+static bool a_star_batch_steal(a_star_batch_worker_t *p_worker);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Finds the path of every query of a batch. The calling thread works on
+ * the batch too, so one thread runs it without starting any others.
+ *
+ * @param[in] p_grid The grid maze. It is only read.
+ * @param[in] p_landmarks Pointer to the landmark tables of the grid for the
+ * ALT heuristic, NULL for the Manhattan distance. They are only read.
+ * @param[in] p_queries Array of queries.
+ * @param[in] num_queries Number of queries.
+ * @param[out] pp_paths Array of the path of each query, written to NULL for
+ * queries whose end node is unreachable, or that were not searched because no
+ * search context could be allocated.
+ * @param[in] num_threads Number of threads to run on, from 1 to @ref
+ * A_STAR_BATCH_MAX_THREADS. It is ignored unless MAZE_THREADS is defined.
+ * @return uint32_t Number of paths found.
+ *
+ * @warning Each path and its array of cells must be freed with @ref
+ * maze_free. The allocator must be thread-safe if the batch runs on more than
+ * one thread, as the C heap is.
+ */
+uint32_t
+a_star_batch (const maze_grid_t      *p_grid,
+              const maze_landmarks_t *p_landmarks,
+              const a_star_query_t   *p_queries,
+              uint32_t                num_queries,
+              a_star_path_t         **pp_paths,
+              uint8_t                 num_threads)
+{
+    uint32_t num_found = 0;
+
+#ifdef MAZE_THREADS
+    if (0 == num_threads)
+    {
+        num_threads = 1;
+    }
+
+    if (A_STAR_BATCH_MAX_THREADS < num_threads)
+    {
+        num_threads = A_STAR_BATCH_MAX_THREADS;
+    }
+
+    if (num_queries < num_threads)
+    {
+        num_threads = (0 < num_queries) ? (uint8_t)num_queries : 1u;
+    }
+#else
+    num_threads = 1;
+#endif
+
+    // Step 1: Give each worker a search context and an equal range of the
+    // queries. Every path starts as NULL, in case no worker can search.
+    //
+    a_star_batch_state_t state = {
+        .p_grid      = p_grid,
+        .p_landmarks = p_landmarks,
+        .p_queries   = p_queries,
+        .pp_paths    = pp_paths,
+        .p_workers   = maze_malloc(sizeof(a_star_batch_worker_t) * num_threads),
+        .num_workers = num_threads,
+    };
+
+    for (uint32_t query_idx = 0; num_queries > query_idx; query_idx++)
+    {
+        pp_paths[query_idx] = NULL;
+    }
+
+    if (NULL == state.p_workers)
+    {
+        return 0;
+    }
+
+    for (uint8_t worker = 0; num_threads > worker; worker++)
+    {
+        a_star_batch_worker_t *p_worker = &state.p_workers[worker];
+
+        p_worker->p_state = &state;
+        p_worker->context
+            = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+        p_worker->next
+            = (uint32_t)((uint64_t)num_queries * worker / num_threads);
+        p_worker->end
+            = (uint32_t)((uint64_t)num_queries * (worker + 1u) / num_threads);
+        p_worker->num_found = 0;
+#ifdef MAZE_THREADS
+        pthread_mutex_init(&p_worker->mutex, NULL);
+        p_worker->is_busy = false;
+#endif
+    }
+
+    // Step 2: Start a thread for every worker but the first, which runs on
+    // this thread. The range of a worker without a search context, or whose
+    // thread cannot be started, is stolen by the others.
+    //
+#ifdef MAZE_THREADS
+    for (uint8_t worker = 1; num_threads > worker; worker++)
+    {
+        a_star_batch_worker_t *p_worker = &state.p_workers[worker];
+
+        if (search_context_is_valid(&p_worker->context))
+        {
+            int error = pthread_create(
+                &p_worker->thread, NULL, &a_star_batch_run_worker, p_worker);
+            p_worker->is_busy = 0 == error;
+        }
+    }
+#endif
+
+    if (search_context_is_valid(&state.p_workers[0].context))
+    {
+        a_star_batch_run_worker(&state.p_workers[0]);
+    }
+
+    // Step 3: Wait for the workers, and clean up.
+    //
+    for (uint8_t worker = 0; num_threads > worker; worker++)
+    {
+        a_star_batch_worker_t *p_worker = &state.p_workers[worker];
+
+#ifdef MAZE_THREADS
+        if (p_worker->is_busy)
+        {
+            pthread_join(p_worker->thread, NULL);
+        }
+
+        pthread_mutex_destroy(&p_worker->mutex);
+#endif
+        num_found += p_worker->num_found;
+        search_context_destroy(&p_worker->context);
+    }
+
+    maze_free(state.p_workers);
+
+    return num_found;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Runs queries until every range of the batch is empty.
+ *
+ * @param[in,out] p_arg Pointer to the worker.
+ * @return void* NULL.
+ */
+static void *
+a_star_batch_run_worker (void *p_arg)
+{
+    a_star_batch_worker_t      *p_worker  = p_arg;
+    const a_star_batch_state_t *p_state   = p_worker->p_state;
+    uint32_t                    query_idx = 0;
+
+    while (a_star_batch_take_query(p_worker, &query_idx))
+    {
+        const a_star_query_t *p_query = &p_state->p_queries[query_idx];
+        a_star_path_t        *p_path  = NULL;
+
+        if (a_star_ctx_alt(p_state->p_grid,
+                           &p_worker->context,
+                           p_state->p_landmarks,
+                           p_query->p_start_node,
+                           p_query->p_end_node))
+        {
+            p_path = a_star_ctx_get_path(
+                p_state->p_grid, &p_worker->context, p_query->p_end_node);
+            p_worker->num_found += NULL != p_path;
+        }
+
+        p_state->pp_paths[query_idx] = p_path;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Takes the next query from the range of a worker, stealing a range
+ * from another worker if its own is empty.
+ *
+ * @param[in,out] p_worker Pointer to the worker.
+ * @param[out] p_query_idx Pointer to the index of the query taken.
+ * @return true If a query was taken.
+ * @return false If every range is empty.
+ */
+static bool
+a_star_batch_take_query (a_star_batch_worker_t *p_worker,
+                         uint32_t              *p_query_idx)
+{
+    do
+    {
+        bool is_taken = false;
+
+#ifdef MAZE_THREADS
+        pthread_mutex_lock(&p_worker->mutex);
+#endif
+        if (p_worker->next < p_worker->end)
+        {
+            *p_query_idx = p_worker->next;
+            p_worker->next++;
+            is_taken = true;
+        }
+#ifdef MAZE_THREADS
+        pthread_mutex_unlock(&p_worker->mutex);
+#endif
+
+        if (is_taken)
+        {
+            return true;
+        }
+    } while (a_star_batch_steal(p_worker));
+
+    return false;
+}
+
+/**
+ * @brief Moves the back half of the largest range of the other workers into
+ * the empty range of a worker. No two locks are held at once, so workers that
+ * steal from each other cannot deadlock.
+ *
+ * @param[in,out] p_worker Pointer to the worker, whose range is empty.
+ * @return true If a range was stolen.
+ * @return false If every other range is empty.
+ */
+static bool
+a_star_batch_steal (a_star_batch_worker_t *p_worker)
+{
+#ifdef MAZE_THREADS
+    a_star_batch_state_t *p_state = p_worker->p_state;
+
+    while (true)
+    {
+        // Step 1: Find the largest range. The ranges keep changing, so this
+        // is only a guess that is checked under the lock of the victim.
+        //
+        a_star_batch_worker_t *p_victim      = NULL;
+        uint32_t               max_remaining = 0;
+
+        for (uint8_t worker = 0; p_state->num_workers > worker; worker++)
+        {
+            a_star_batch_worker_t *p_other = &p_state->p_workers[worker];
+
+            pthread_mutex_lock(&p_other->mutex);
+            uint32_t remaining = p_other->end - p_other->next;
+            pthread_mutex_unlock(&p_other->mutex);
+
+            if (p_other != p_worker && remaining > max_remaining)
+            {
+                p_victim      = p_other;
+                max_remaining = remaining;
+            }
+        }
+
+        if (NULL == p_victim)
+        {
+            return false;
+        }
+
+        // Step 2: Split off the back half of its range, rounding up so that a
+        // single query can be stolen.
+        //
+        uint32_t stolen_next = 0;
+        uint32_t stolen_end  = 0;
+
+        pthread_mutex_lock(&p_victim->mutex);
+        if (p_victim->next < p_victim->end)
+        {
+            uint32_t remaining = p_victim->end - p_victim->next;
+            stolen_end         = p_victim->end;
+            stolen_next        = stolen_end - (remaining + 1u) / 2u;
+            p_victim->end      = stolen_next;
+        }
+        pthread_mutex_unlock(&p_victim->mutex);
+
+        if (stolen_next == stolen_end)
+        {
+            continue;
+        }
+
+        pthread_mutex_lock(&p_worker->mutex);
+        p_worker->next = stolen_next;
+        p_worker->end  = stolen_end;
+        pthread_mutex_unlock(&p_worker->mutex);
+
+        return true;
+    }
+#else
+    (void)p_worker;
+    return false;
+#endif
+}
+
+// End of pathfinding/a_star_batch.c
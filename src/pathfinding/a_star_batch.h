@@ -0,0 +1,62 @@
+/**
+ * @file a_star_batch.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for batches of A* searches on one grid maze. Each worker
+ * keeps one search context for all of its queries, and the queries are shared
+ * out by work stealing, so a batch of thousands of paths allocates no search
+ * values after it starts and keeps every core busy.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#ifndef A_STAR_BATCH_H // Include guard.
+#define A_STAR_BATCH_H
+
+#include <stdint.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/a_star.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def A_STAR_BATCH_MAX_THREADS
+ * @brief Largest number of threads that a batch runs on, including the
+ * calling thread. Batches only run on more than one thread if MAZE_THREADS is
+ * defined.
+ */
+#ifndef A_STAR_BATCH_MAX_THREADS
+#define A_STAR_BATCH_MAX_THREADS 64u
+#endif
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains one query of a batch. @see a_star_query
+ */
+typedef struct a_star_query
+{
+    const maze_grid_cell_t *p_start_node; ///< Node to search from.
+    const maze_grid_cell_t *p_end_node;   ///< Node to search to.
+} a_star_query_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+uint32_t a_star_batch(const maze_grid_t      *p_grid,
+                      const maze_landmarks_t *p_landmarks,
+                      const a_star_query_t   *p_queries,
+                      uint32_t                num_queries,
+                      a_star_path_t         **pp_paths,
+                      uint8_t                 num_threads);
+
+#endif // A_STAR_BATCH_H
+
+// End of pathfinding/a_star_batch.h
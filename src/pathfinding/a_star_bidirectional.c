@@ -0,0 +1,540 @@
+/**
+ * @file a_star_bidirectional.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the bidirectional A* search. The two searches expand
+ * in rounds, and only read each other's values between rounds, so that they
+ * can run on two threads without locks around the search values.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef MAZE_THREADS
+#include <pthread.h>
+#endif
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/open_set.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/a_star_bidirectional.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains one of the two searches.
+ */
+typedef struct a_star_bidirectional_side
+{
+    const maze_grid_t *p_grid;      ///< Grid maze that is searched.
+    search_context_t  *p_context;   ///< Search values of this search.
+    maze_idx_t         goal_idx;    ///< Node that this search heads towards.
+    bool               is_backward; ///< Whether this search runs from the end
+                                    ///< node, so that each move it makes is
+                                    ///< paid for by the node it leaves.
+    uint32_t           batch;       ///< Nodes to expand in each round.
+    maze_idx_t        *p_changed;   ///< Nodes whose G-values changed in the
+                                    ///< last round.
+    uint32_t           num_changed; ///< Number of changed nodes.
+} a_star_bidirectional_side_t;
+
+#ifdef MAZE_THREADS
+/**
+ * @brief This struct contains the state shared with the thread that runs the
+ * search from the end node. The main thread requests a round, and the worker
+ * completes it.
+ */
+typedef struct a_star_bidirectional_worker
+{
+    a_star_bidirectional_side_t *p_side;        ///< Search of the worker.
+    pthread_mutex_t              mutex;         ///< Guards the counters.
+    pthread_cond_t               cond;          ///< Signals a counter change.
+    uint32_t                     num_requested; ///< Rounds requested.
+    uint32_t                     num_completed; ///< Rounds completed.
+    bool                         is_stopping;   ///< The search has ended.
+} a_star_bidirectional_worker_t;
+#endif
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void a_star_bidirectional_begin(a_star_bidirectional_side_t *p_side,
+                                       maze_idx_t start_idx);
+
+static void a_star_bidirectional_expand(a_star_bidirectional_side_t *p_side);
+
+static uint32_t a_star_bidirectional_get_min_f(
+    a_star_bidirectional_side_t *p_side);
+
+static a_star_path_t *a_star_bidirectional_get_path(
+    const maze_grid_t      *p_grid,
+    const search_context_t *p_forward,
+    const search_context_t *p_backward,
+    maze_idx_t              meet_idx,
+    uint32_t                path_cost);
+
+#ifdef MAZE_THREADS
+static void *a_star_bidirectional_run_worker(void *p_arg);
+#endif
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Runs A* from the start node and from the end node at the same time,
+ * and splices the two halves of the shortest path together where they meet.
+ *
+ * The searches stop once the cheapest path through a node reached by both is
+ * no more than the lowest F-value of one of the open sets. Each F-value is a
+ * lower bound on the paths through its open set, and every path that has not
+ * been found yet passes through both open sets, so no shorter path is left.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in,out] p_forward Pointer to the search context from the start node.
+ * @param[in,out] p_backward Pointer to the search context from the end node.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[in] is_threaded Whether to run the search from the end node on a
+ * thread of its own. It is ignored unless MAZE_THREADS is defined.
+ * @return a_star_path_t* Path from the start node to the end node (inclusive),
+ * NULL if no path exists. The `p_came_from` field of each path cell points to
+ * the previous cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ * @note The number of nodes expanded by each search is left in the
+ * `num_expanded` field of its context.
+ */
+a_star_path_t *
+a_star_bidirectional (const maze_grid_t      *p_grid,
+                      search_context_t       *p_forward,
+                      search_context_t       *p_backward,
+                      const maze_grid_cell_t *p_start_node,
+                      const maze_grid_cell_t *p_end_node,
+                      bool                    is_threaded)
+{
+    maze_idx_t start_idx = maze_get_cell_idx(p_grid, p_start_node);
+    maze_idx_t end_idx   = maze_get_cell_idx(p_grid, p_end_node);
+    uint32_t   batch     = A_STAR_BIDIRECTIONAL_BATCH;
+
+#ifdef MAZE_THREADS
+    if (is_threaded)
+    {
+        batch = A_STAR_BIDIRECTIONAL_THREADED_BATCH;
+    }
+#else
+    (void)is_threaded;
+#endif
+
+    // Step 1: Begin both searches. Each node expanded can change the G-value
+    // of its 4 neighbours, so the lists of changed nodes hold 4 per node.
+    //
+    a_star_bidirectional_side_t sides[2] = {
+        { p_grid, p_forward, end_idx, false, batch, NULL, 0 },
+        { p_grid, p_backward, start_idx, true, batch, NULL, 0 },
+    };
+    a_star_path_t *p_path    = NULL;
+    uint32_t       best_cost = UINT32_MAX;
+    maze_idx_t     meet_idx  = SEARCH_CONTEXT_NO_CELL;
+
+    sides[0].p_changed = maze_malloc(sizeof(maze_idx_t) * 4u * batch);
+    sides[1].p_changed = maze_malloc(sizeof(maze_idx_t) * 4u * batch);
+
+    if (NULL == sides[0].p_changed || NULL == sides[1].p_changed)
+    {
+        goto end;
+    }
+
+    a_star_bidirectional_begin(&sides[0], start_idx);
+    a_star_bidirectional_begin(&sides[1], end_idx);
+
+#ifdef MAZE_THREADS
+    a_star_bidirectional_worker_t worker = { .p_side        = &sides[1],
+                                             .num_requested = 0,
+                                             .num_completed = 0,
+                                             .is_stopping   = false };
+    pthread_t                     thread;
+
+    if (is_threaded)
+    {
+        pthread_mutex_init(&worker.mutex, NULL);
+        pthread_cond_init(&worker.cond, NULL);
+
+        if (0
+            != pthread_create(
+                &thread, NULL, &a_star_bidirectional_run_worker, &worker))
+        {
+            pthread_mutex_destroy(&worker.mutex);
+            pthread_cond_destroy(&worker.cond);
+            is_threaded = false;
+        }
+    }
+#endif
+
+    while (true)
+    {
+        // Step 2: Check the nodes changed in the last round for the cheapest
+        // path through a node that both searches have reached.
+        //
+        for (uint8_t side = 0; 2 > side; side++)
+        {
+            for (uint32_t idx = 0; sides[side].num_changed > idx; idx++)
+            {
+                maze_idx_t cell_idx = sides[side].p_changed[idx];
+
+                if (!search_context_is_reached(p_forward, cell_idx)
+                    || !search_context_is_reached(p_backward, cell_idx))
+                {
+                    continue;
+                }
+
+                uint32_t cost
+                    = p_forward->p_g[cell_idx] + p_backward->p_g[cell_idx];
+
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    meet_idx  = cell_idx;
+                }
+            }
+        }
+
+        // Step 3: Stop once no path through the open sets can be cheaper.
+        // This also stops when either open set is empty.
+        //
+        uint32_t min_f_forward  = a_star_bidirectional_get_min_f(&sides[0]);
+        uint32_t min_f_backward = a_star_bidirectional_get_min_f(&sides[1]);
+
+        if (best_cost <= min_f_forward || best_cost <= min_f_backward)
+        {
+            break;
+        }
+
+        // Step 4: Expand a round of nodes from each end.
+        //
+#ifdef MAZE_THREADS
+        if (is_threaded)
+        {
+            pthread_mutex_lock(&worker.mutex);
+            worker.num_requested++;
+            pthread_cond_signal(&worker.cond);
+            pthread_mutex_unlock(&worker.mutex);
+
+            a_star_bidirectional_expand(&sides[0]);
+
+            pthread_mutex_lock(&worker.mutex);
+            while (worker.num_completed != worker.num_requested)
+            {
+                pthread_cond_wait(&worker.cond, &worker.mutex);
+            }
+            pthread_mutex_unlock(&worker.mutex);
+            continue;
+        }
+#endif
+
+        a_star_bidirectional_expand(&sides[0]);
+        a_star_bidirectional_expand(&sides[1]);
+    }
+
+#ifdef MAZE_THREADS
+    if (is_threaded)
+    {
+        pthread_mutex_lock(&worker.mutex);
+        worker.is_stopping = true;
+        pthread_cond_signal(&worker.cond);
+        pthread_mutex_unlock(&worker.mutex);
+
+        pthread_join(thread, NULL);
+        pthread_mutex_destroy(&worker.mutex);
+        pthread_cond_destroy(&worker.cond);
+    }
+#endif
+
+    // Step 5: Splice the two halves of the path together.
+    //
+    if (SEARCH_CONTEXT_NO_CELL != meet_idx)
+    {
+        p_path = a_star_bidirectional_get_path(
+            p_grid, p_forward, p_backward, meet_idx, best_cost);
+    }
+
+end:
+    maze_free(sides[0].p_changed);
+    maze_free(sides[1].p_changed);
+
+    return p_path;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Begins one of the searches, with its start node in the open set and
+ * in the list of changed nodes.
+ *
+ * @param[in,out] p_side Pointer to the search.
+ * @param[in] start_idx Index of the node that the search starts from.
+ */
+static void
+a_star_bidirectional_begin (a_star_bidirectional_side_t *p_side,
+                            maze_idx_t                   start_idx)
+{
+    search_context_t   *p_context = p_side->p_context;
+    const maze_point_t *p_goal_point
+        = &p_side->p_grid->p_grid_array[p_side->goal_idx].coordinates;
+    uint32_t priority = maze_manhattan_dist(
+        &p_side->p_grid->p_grid_array[start_idx].coordinates, p_goal_point);
+
+    search_context_begin(p_context);
+    search_context_stamp(p_context, start_idx);
+    p_context->p_g[start_idx] = 0;
+    p_context->p_h[start_idx] = priority;
+    p_context->p_f[start_idx] = priority;
+    open_set_push(&p_context->open_set, start_idx, priority);
+
+    p_side->p_changed[0] = start_idx;
+    p_side->num_changed  = 1;
+}
+
+/**
+ * @brief Expands a round of nodes of one of the searches, and lists the nodes
+ * whose G-values changed. The round ends early if the goal node of the search
+ * would be expanded next.
+ *
+ * @param[in,out] p_side Pointer to the search.
+ */
+static void
+a_star_bidirectional_expand (a_star_bidirectional_side_t *p_side)
+{
+    const maze_grid_t  *p_grid     = p_side->p_grid;
+    search_context_t   *p_context  = p_side->p_context;
+    open_set_t         *p_open_set = &p_context->open_set;
+    const maze_point_t *p_goal_point
+        = &p_grid->p_grid_array[p_side->goal_idx].coordinates;
+
+    p_side->num_changed = 0;
+
+    for (uint32_t round_idx = 0;
+         p_side->batch > round_idx && !open_set_is_empty(p_open_set);
+         round_idx++)
+    {
+        // Step 1: Get the node with the lowest F-value from the open set.
+        //
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+
+        if (current_idx == p_side->goal_idx)
+        {
+            return;
+        }
+
+        open_set_pop(p_open_set);
+        p_context->num_expanded++;
+
+        const maze_grid_cell_t *p_current_node
+            = &p_grid->p_grid_array[current_idx];
+
+        for (uint8_t neighbour = 0; 4 > neighbour; neighbour++)
+        {
+            // Step 2: Update the neighbour if it is cheaper to reach through
+            // the current node. A move costs as much as the node it enters,
+            // which is the current node when searching from the end node.
+            //
+            const maze_grid_cell_t *p_neighbour_node
+                = p_current_node->p_next[neighbour];
+
+            if (NULL == p_neighbour_node)
+            {
+                continue;
+            }
+
+            maze_idx_t neighbour_idx
+                = maze_get_cell_idx(p_grid, p_neighbour_node);
+            uint32_t tentative_g_score
+                = p_context->p_g[current_idx]
+                  + MAZE_CELL_COST(p_grid,
+                                   p_side->is_backward ? current_idx
+                                                       : neighbour_idx);
+            search_context_stamp(p_context, neighbour_idx);
+
+            if (tentative_g_score >= p_context->p_g[neighbour_idx])
+            {
+                continue;
+            }
+
+            p_context->p_g[neighbour_idx] = tentative_g_score;
+            p_context->p_h[neighbour_idx] = maze_manhattan_dist(
+                &p_neighbour_node->coordinates, p_goal_point);
+            p_context->p_f[neighbour_idx]
+                = tentative_g_score + p_context->p_h[neighbour_idx];
+            p_context->p_came_from[neighbour_idx] = current_idx;
+            open_set_push(p_open_set,
+                          neighbour_idx,
+                          OPEN_SET_PRIORITY(p_context->p_f[neighbour_idx]));
+
+            // Step 3: List the neighbour, so that the other search can check
+            // it after the round.
+            //
+            p_side->p_changed[p_side->num_changed] = neighbour_idx;
+            p_side->num_changed++;
+        }
+    }
+}
+
+/**
+ * @brief Gets the lowest F-value in the open set of one of the searches.
+ *
+ * @param[in,out] p_side Pointer to the search.
+ * @return uint32_t Lowest F-value, UINT32_MAX if the open set is empty.
+ */
+static uint32_t
+a_star_bidirectional_get_min_f (a_star_bidirectional_side_t *p_side)
+{
+    search_context_t *p_context = p_side->p_context;
+
+    if (open_set_is_empty(&p_context->open_set))
+    {
+        return UINT32_MAX;
+    }
+
+    return p_context->p_f[open_set_peek(&p_context->open_set)];
+}
+
+/**
+ * @brief Splices the path from the start node to the meeting node and the
+ * path from the meeting node to the end node.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_forward Pointer to the search context from the start node.
+ * @param[in] p_backward Pointer to the search context from the end node.
+ * @param[in] meet_idx Index of the meeting node.
+ * @param[in] path_cost Cost of the path.
+ * @return a_star_path_t* Pointer to the path.
+ */
+static a_star_path_t *
+a_star_bidirectional_get_path (const maze_grid_t      *p_grid,
+                               const search_context_t *p_forward,
+                               const search_context_t *p_backward,
+                               maze_idx_t              meet_idx,
+                               uint32_t                path_cost)
+{
+    // Step 1: Count the nodes of each half. Cell costs make the G-values
+    // differ from the number of moves.
+    //
+    uint32_t meet_index  = 0;
+    uint32_t path_length = 1u;
+
+    for (maze_idx_t idx = p_forward->p_came_from[meet_idx];
+         SEARCH_CONTEXT_NO_CELL != idx;
+         idx = p_forward->p_came_from[idx])
+    {
+        meet_index++;
+    }
+
+    for (maze_idx_t idx = p_backward->p_came_from[meet_idx];
+         SEARCH_CONTEXT_NO_CELL != idx;
+         idx = p_backward->p_came_from[idx])
+    {
+        path_length++;
+    }
+
+    path_length += meet_index;
+
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_path;
+
+    // Step 2: The first half is traversed backwards from the meeting node, and
+    // the second half forwards from the node after it. The G-value of a node
+    // in the second half is what is left of the cost after its backward cost.
+    //
+    maze_idx_t cell_idx = meet_idx;
+
+    for (uint32_t reverse_index = meet_index + 1u; 0 < reverse_index;
+         reverse_index--)
+    {
+        p_path[reverse_index - 1]   = p_grid->p_grid_array[cell_idx];
+        p_path[reverse_index - 1].g = p_forward->p_g[cell_idx];
+        cell_idx                    = p_forward->p_came_from[cell_idx];
+    }
+
+    cell_idx = p_backward->p_came_from[meet_idx];
+
+    for (uint32_t index = meet_index + 1u; path_length > index; index++)
+    {
+        p_path[index]   = p_grid->p_grid_array[cell_idx];
+        p_path[index].g = path_cost - p_backward->p_g[cell_idx];
+        cell_idx        = p_backward->p_came_from[cell_idx];
+    }
+
+    // Step 3: Set the other values of the cells along the path.
+    //
+    const maze_point_t *p_end_point = &p_path[path_length - 1].coordinates;
+
+    for (uint32_t index = 0; path_length > index; index++)
+    {
+        maze_grid_cell_t *p_cell = &p_path[index];
+        p_cell->h = maze_manhattan_dist(&p_cell->coordinates, p_end_point);
+        p_cell->f = p_cell->g + p_cell->h;
+        p_cell->p_came_from = (0 < index) ? &p_path[index - 1] : NULL;
+    }
+
+    return p_path_struct;
+}
+
+#ifdef MAZE_THREADS
+/**
+ * @brief Runs the rounds of the search from the end node as they are
+ * requested, until the search ends.
+ *
+ * @param[in,out] p_arg Pointer to the worker state.
+ * @return void* NULL.
+ */
+static void *
+a_star_bidirectional_run_worker (void *p_arg)
+{
+    a_star_bidirectional_worker_t *p_worker = p_arg;
+
+    pthread_mutex_lock(&p_worker->mutex);
+
+    while (true)
+    {
+        while (!p_worker->is_stopping
+               && p_worker->num_completed == p_worker->num_requested)
+        {
+            pthread_cond_wait(&p_worker->cond, &p_worker->mutex);
+        }
+
+        if (p_worker->is_stopping)
+        {
+            break;
+        }
+
+        pthread_mutex_unlock(&p_worker->mutex);
+        a_star_bidirectional_expand(p_worker->p_side);
+        pthread_mutex_lock(&p_worker->mutex);
+
+        p_worker->num_completed++;
+        pthread_cond_signal(&p_worker->cond);
+    }
+
+    pthread_mutex_unlock(&p_worker->mutex);
+
+    return NULL;
+}
+#endif
+
+// End of pathfinding/a_star_bidirectional.c
@@ -0,0 +1,66 @@
+/**
+ * @file a_star_bidirectional.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the bidirectional A* search. One search runs from the
+ * start node and one from the end node, and the path is spliced together where
+ * they meet, so on large maps the two cones that are expanded are much smaller
+ * than the one cone of A*.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef A_STAR_BIDIRECTIONAL_H // Include guard.
+#define A_STAR_BIDIRECTIONAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def A_STAR_BIDIRECTIONAL_BATCH
+ * @brief Number of nodes each search expands before the searches check where
+ * they meet.
+ */
+#ifndef A_STAR_BIDIRECTIONAL_BATCH
+#define A_STAR_BIDIRECTIONAL_BATCH 32u
+#endif
+
+/**
+ * @def A_STAR_BIDIRECTIONAL_THREADED_BATCH
+ * @brief Number of nodes each search expands between checks when the searches
+ * run on two threads. It is larger so that the threads wait for each other
+ * less often.
+ */
+#ifndef A_STAR_BIDIRECTIONAL_THREADED_BATCH
+#define A_STAR_BIDIRECTIONAL_THREADED_BATCH 1024u
+#endif
+
+/**
+ * @def MAZE_THREADS
+ * @brief Define to let @ref a_star_bidirectional run the search from the end
+ * node on a POSIX thread. Only the host build has threads.
+ */
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+a_star_path_t *a_star_bidirectional(const maze_grid_t      *p_grid,
+                                    search_context_t       *p_forward,
+                                    search_context_t       *p_backward,
+                                    const maze_grid_cell_t *p_start_node,
+                                    const maze_grid_cell_t *p_end_node,
+                                    bool                    is_threaded);
+
+#endif // A_STAR_BIDIRECTIONAL_H
+
+// End of pathfinding/a_star_bidirectional.h
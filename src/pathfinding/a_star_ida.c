@@ -0,0 +1,444 @@
+/**
+ * @file a_star_ida.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the memory-bounded IDA* search. The whole search
+ * lives in one block of a size fixed before it starts: the stack of the
+ * depth-first search, a transposition table and one bit per node that records
+ * which nodes have been expanded.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_path.h"
+#include "pathfinding/a_star_ida.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains one node on the path of the depth-first search.
+ */
+typedef struct a_star_ida_frame
+{
+    uint32_t   g;         ///< Cost of the path to the node.
+    maze_idx_t cell_idx;  ///< Index of the node.
+    uint8_t    direction; ///< Next direction to move in from the node.
+} a_star_ida_frame_t;
+
+/**
+ * @brief This struct contains an entry of the transposition table, which holds
+ * the cheapest cost that a node has been reached at in this iteration.
+ */
+typedef struct a_star_ida_entry
+{
+    uint32_t   g;        ///< Cost of the node, UINT32_MAX if it is empty.
+    maze_idx_t cell_idx; ///< Index of the node.
+} a_star_ida_entry_t;
+
+/**
+ * @brief This struct contains the state of an IDA* search.
+ */
+typedef struct a_star_ida_search
+{
+    const maze_grid_t  *p_grid;     ///< Grid maze that is searched.
+    const maze_point_t *p_end;      ///< Point of the end node.
+    maze_idx_t          end_idx;    ///< Index of the end node.
+    a_star_ida_frame_t *p_stack;    ///< Path of the depth-first search.
+    a_star_ida_entry_t *p_table;    ///< Transposition table.
+    uint8_t            *p_expanded; ///< Bit for each node that has been
+                                    ///< expanded.
+    a_star_ida_stats_t *p_stats;    ///< Counts of the search.
+} a_star_ida_search_t;
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint32_t a_star_ida_iterate(a_star_ida_search_t *p_search,
+                                   maze_idx_t           start_idx,
+                                   uint32_t             bound,
+                                   uint32_t            *p_next_bound);
+
+static bool a_star_ida_is_transposed(const a_star_ida_search_t *p_search,
+                                     maze_idx_t                 cell_idx,
+                                     uint32_t                   g);
+
+static void a_star_ida_push(a_star_ida_search_t *p_search,
+                            uint32_t             depth,
+                            maze_idx_t           cell_idx,
+                            uint32_t             g);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Finds the cheapest path between two nodes with IDA*, in no more
+ * memory than a ceiling.
+ *
+ * Each iteration is a depth-first search that cuts off every path whose
+ * F-value is over a bound, and the next iteration raises the bound to the
+ * lowest F-value that was cut off. The bound never passes the cost of the
+ * cheapest path, so the first path found is the cheapest. Instead of an open
+ * set of every node, the search keeps only its current path, and the nodes
+ * near the start are expanded again in every iteration.
+ *
+ * After one bit per node, half of the ceiling holds the stack and the path
+ * that is returned, and the rest holds the transposition table, which cuts off
+ * nodes that have already been reached as cheaply in this iteration. A smaller
+ * ceiling gives a shallower stack and a smaller table, and so more nodes that
+ * are expanded again.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[in] max_bytes Most bytes that the search and the path may allocate.
+ * @param[out] p_path Pointer to the path from the start node to the end node.
+ * It has no steps if no path was found.
+ * @param[out] p_stats Pointer to the counts of the search, may be NULL.
+ * @return true If a path was found.
+ * @return false If no path exists, none fits in the stack or the ceiling is
+ * too small for one bit per node.
+ *
+ * @warning The path must be destroyed by @ref maze_path_destroy.
+ * @note The grid maze is only read, so searches on one maze may run on many
+ * threads at once.
+ */
+bool
+a_star_ida (const maze_grid_t      *p_grid,
+            const maze_grid_cell_t *p_start_node,
+            const maze_grid_cell_t *p_end_node,
+            size_t                  max_bytes,
+            maze_path_t            *p_path,
+            a_star_ida_stats_t     *p_stats)
+{
+    a_star_ida_stats_t stats          = { 0 };
+    size_t             num_cells      = MAZE_GRID_CELLS(p_grid);
+    size_t             expanded_bytes = (num_cells + 7u) / 8u;
+    size_t             max_frames     = 0;
+    size_t             num_entries    = 0;
+    uint32_t           num_frames     = 0;
+
+    *p_path = maze_path_create(&p_start_node->coordinates, 0);
+
+    // Step 1: Give half of what is left after the expanded bits to the stack
+    // and the path, which takes a quarter of a byte for each frame, and the
+    // rest to the table. Neither needs more than one slot for each node.
+    //
+    if (max_bytes >= expanded_bytes)
+    {
+        size_t half = (max_bytes - expanded_bytes) / 2u;
+
+        max_frames = MAZE_PATH_STEPS_PER_BYTE * half
+                     / (MAZE_PATH_STEPS_PER_BYTE * sizeof(a_star_ida_frame_t)
+                        + 1u);
+
+        if (num_cells < max_frames)
+        {
+            max_frames = num_cells;
+        }
+    }
+
+    if (0 < max_frames)
+    {
+        size_t rest_bytes = max_bytes - expanded_bytes
+                            - max_frames * sizeof(a_star_ida_frame_t)
+                            - MAZE_PATH_GET_NUM_BYTES(max_frames - 1u);
+
+        num_entries = rest_bytes / sizeof(a_star_ida_entry_t);
+
+        if (num_cells < num_entries)
+        {
+            num_entries = num_cells;
+        }
+    }
+
+    size_t block_bytes = num_entries * sizeof(a_star_ida_entry_t)
+                         + max_frames * sizeof(a_star_ida_frame_t)
+                         + expanded_bytes;
+    uint8_t *p_block = (0 < max_frames) ? maze_malloc(block_bytes) : NULL;
+
+    if (NULL == p_block)
+    {
+        stats.is_truncated = true;
+        goto end;
+    }
+
+    stats.max_steps   = (uint32_t)max_frames - 1u;
+    stats.num_entries = (uint32_t)num_entries;
+    stats.num_bytes   = block_bytes;
+
+    // Step 2: Lay out the table, the stack and the expanded bits in the
+    // block, in order of alignment.
+    //
+    size_t              table_bytes = num_entries * sizeof(a_star_ida_entry_t);
+    a_star_ida_search_t search      = {
+        .p_grid     = p_grid,
+        .p_end      = &p_end_node->coordinates,
+        .end_idx    = maze_get_cell_idx(p_grid, p_end_node),
+        .p_stack    = (a_star_ida_frame_t *)(p_block + table_bytes),
+        .p_table    = (a_star_ida_entry_t *)p_block,
+        .p_expanded = p_block + block_bytes - expanded_bytes,
+        .p_stats    = &stats,
+    };
+
+    for (size_t byte = 0; expanded_bytes > byte; byte++)
+    {
+        search.p_expanded[byte] = 0;
+    }
+
+    // Step 3: Search under a rising bound until the end node is reached or
+    // no path was cut off.
+    //
+    maze_idx_t start_idx = maze_get_cell_idx(p_grid, p_start_node);
+    uint32_t   bound
+        = maze_manhattan_dist(&p_start_node->coordinates, search.p_end);
+
+    while (0 == num_frames && UINT32_MAX != bound)
+    {
+        uint32_t next_bound = UINT32_MAX;
+
+        stats.num_iterations++;
+        num_frames = a_star_ida_iterate(&search, start_idx, bound, &next_bound);
+        bound      = next_bound;
+    }
+
+    // Step 4: Copy the directions of the moves on the stack to the path.
+    //
+    if (0 < num_frames)
+    {
+        *p_path = maze_path_create(&p_start_node->coordinates, num_frames - 1u);
+
+        if (1 < num_frames && NULL == p_path->p_steps)
+        {
+            p_path->num_steps = 0;
+            num_frames        = 0;
+        }
+
+        for (uint32_t step = 0; num_frames > step + 1u; step++)
+        {
+            maze_path_set_step(
+                p_path,
+                step,
+                (maze_cardinal_direction_t)(search.p_stack[step].direction
+                                            - 1u));
+        }
+
+        if (0 < num_frames)
+        {
+            stats.path_cost = search.p_stack[num_frames - 1u].g;
+            stats.num_bytes += MAZE_PATH_GET_NUM_BYTES(num_frames - 1u);
+        }
+    }
+
+    maze_free(p_block);
+
+end:
+    if (NULL != p_stats)
+    {
+        *p_stats = stats;
+    }
+
+    return 0 < num_frames;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Runs one depth-first search of IDA*.
+ *
+ * @param[in,out] p_search Pointer to the search.
+ * @param[in] start_idx Index of the start node.
+ * @param[in] bound Highest F-value of a node that is searched.
+ * @param[out] p_next_bound Pointer to the lowest F-value over the bound, left
+ * as is if none was cut off.
+ * @return uint32_t Number of frames on the stack when the end node is reached,
+ * 0 if it was not.
+ *
+ * @note The direction of each frame is one past the move to the next frame.
+ */
+static uint32_t
+a_star_ida_iterate (a_star_ida_search_t *p_search,
+                    maze_idx_t           start_idx,
+                    uint32_t             bound,
+                    uint32_t            *p_next_bound)
+{
+    const maze_grid_t  *p_grid     = p_search->p_grid;
+    a_star_ida_frame_t *p_stack    = p_search->p_stack;
+    uint32_t            max_frames = p_search->p_stats->max_steps + 1u;
+    uint32_t            num_frames = 1;
+
+    // Step 1: Forget the costs of the last iteration.
+    //
+    for (uint32_t entry = 0; p_search->p_stats->num_entries > entry; entry++)
+    {
+        p_search->p_table[entry].g = UINT32_MAX;
+    }
+
+    a_star_ida_push(p_search, 0, start_idx, 0);
+
+    if (p_search->end_idx == start_idx)
+    {
+        return num_frames;
+    }
+
+    while (0 < num_frames)
+    {
+        a_star_ida_frame_t *p_frame = &p_stack[num_frames - 1u];
+
+        // Step 2: Backtrack once every direction has been tried.
+        //
+        if (4u <= p_frame->direction)
+        {
+            num_frames--;
+            continue;
+        }
+
+        const maze_grid_cell_t *p_next
+            = p_grid->p_grid_array[p_frame->cell_idx]
+                  .p_next[p_frame->direction++];
+
+        if (NULL == p_next)
+        {
+            continue;
+        }
+
+        // Step 3: Never move straight back to the previous node.
+        //
+        maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+        if (1u < num_frames && p_stack[num_frames - 2u].cell_idx == next_idx)
+        {
+            continue;
+        }
+
+        // Step 4: Cut off the node if it is over the bound or has been
+        // reached as cheaply already.
+        //
+        uint32_t g = p_frame->g + MAZE_CELL_COST(p_grid, next_idx);
+        uint32_t f
+            = g + maze_manhattan_dist(&p_next->coordinates, p_search->p_end);
+
+        if (bound < f)
+        {
+            if (*p_next_bound > f)
+            {
+                *p_next_bound = f;
+            }
+
+            continue;
+        }
+
+        if (a_star_ida_is_transposed(p_search, next_idx, g))
+        {
+            continue;
+        }
+
+        if (max_frames == num_frames)
+        {
+            p_search->p_stats->is_truncated = true;
+            continue;
+        }
+
+        // Step 5: Move to the node.
+        //
+        a_star_ida_push(p_search, num_frames, next_idx, g);
+        num_frames++;
+
+        if (p_search->end_idx == next_idx)
+        {
+            return num_frames;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Checks whether a node has been reached at no more than a cost in this
+ * iteration.
+ *
+ * @param[in] p_search Pointer to the search.
+ * @param[in] cell_idx Index of the node.
+ * @param[in] g Cost of the path to the node.
+ * @return true If the node can be cut off.
+ * @return false If it has not, or its entry was taken by another node.
+ */
+static bool
+a_star_ida_is_transposed (const a_star_ida_search_t *p_search,
+                          maze_idx_t                 cell_idx,
+                          uint32_t                   g)
+{
+    uint32_t num_entries = p_search->p_stats->num_entries;
+
+    if (0 == num_entries)
+    {
+        return false;
+    }
+
+    const a_star_ida_entry_t *p_entry
+        = &p_search->p_table[cell_idx % num_entries];
+
+    return cell_idx == p_entry->cell_idx && g >= p_entry->g;
+}
+
+/**
+ * @brief Pushes a node on the stack, records its cost in the table and counts
+ * its expansion.
+ *
+ * @param[in,out] p_search Pointer to the search.
+ * @param[in] depth Index of the new frame.
+ * @param[in] cell_idx Index of the node.
+ * @param[in] g Cost of the path to the node.
+ */
+static void
+a_star_ida_push (a_star_ida_search_t *p_search,
+                 uint32_t             depth,
+                 maze_idx_t           cell_idx,
+                 uint32_t             g)
+{
+    a_star_ida_stats_t *p_stats = p_search->p_stats;
+    uint8_t             bit     = (uint8_t)(1u << (cell_idx % 8u));
+
+    p_search->p_stack[depth].g         = g;
+    p_search->p_stack[depth].cell_idx  = cell_idx;
+    p_search->p_stack[depth].direction = 0;
+
+    if (0 < p_stats->num_entries)
+    {
+        a_star_ida_entry_t *p_entry
+            = &p_search->p_table[cell_idx % p_stats->num_entries];
+
+        p_entry->g        = g;
+        p_entry->cell_idx = cell_idx;
+    }
+
+    // The end node is never expanded.
+    //
+    if (p_search->end_idx == cell_idx)
+    {
+        return;
+    }
+
+    if (0 != (p_search->p_expanded[cell_idx / 8u] & bit))
+    {
+        p_stats->num_reexpanded++;
+    }
+
+    p_search->p_expanded[cell_idx / 8u] |= bit;
+    p_stats->num_expanded++;
+}
+
+// End of pathfinding/a_star_ida.c
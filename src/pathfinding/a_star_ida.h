@@ -0,0 +1,62 @@
+/**
+ * @file a_star_ida.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the memory-bounded IDA* search. It runs depth-first
+ * searches under a rising cost bound instead of keeping an open set, and all
+ * of its memory fits in a ceiling given by the caller, so it can plan while
+ * the WiFi buffers and task stacks hold most of the heap. Nodes are expanded
+ * again in each iteration, which is counted.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef A_STAR_IDA_H // Include guard.
+#define A_STAR_IDA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_path.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the counts of an IDA* search. @see a_star_ida
+ */
+typedef struct a_star_ida_stats
+{
+    uint32_t num_expanded;   ///< Nodes expanded over all iterations.
+    uint32_t num_reexpanded; ///< Expansions of nodes that had already been
+                             ///< expanded, in an earlier iteration or on
+                             ///< another branch.
+    uint32_t num_iterations; ///< Depth-first searches run.
+    uint32_t max_steps;      ///< Most steps that fit on the search stack.
+    uint32_t num_entries;    ///< Entries of the transposition table.
+    uint32_t path_cost;      ///< Cost of the path found, 0 if none was.
+    size_t   num_bytes;      ///< Bytes allocated, including the path.
+    bool     is_truncated;   ///< Some branch was cut off because the stack
+                             ///< was full, or the search did not fit at all,
+                             ///< so a path may have been missed or be dearer
+                             ///< than the cheapest one.
+} a_star_ida_stats_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+bool a_star_ida(const maze_grid_t      *p_grid,
+                const maze_grid_cell_t *p_start_node,
+                const maze_grid_cell_t *p_end_node,
+                size_t                  max_bytes,
+                maze_path_t            *p_path,
+                a_star_ida_stats_t     *p_stats);
+
+#endif // A_STAR_IDA_H
+
+// End of pathfinding/a_star_ida.h
@@ -16,11 +16,61 @@
 #include <stdint.h>
 #include "pathfinding/binary_heap.h"
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void insert_node(binary_heap_t *p_heap, binary_heap_node_t new_node);
+static void swap_nodes(binary_heap_t *p_heap,
+                       maze_idx_t     index_a,
+                       maze_idx_t     index_b);
+static void update_position(binary_heap_t *p_heap, maze_idx_t index);
 
 // Public functions.
 // ----------------------------------------------------------------------------
 //
 
+/**
+ * @brief Creates an indexed binary heap of cell indices.
+ *
+ * @param[in] capacity Maximum number of nodes, which is also the number of
+ * cell indices.
+ * @return binary_heap_t Empty indexed heap.
+ *
+ * @warning The heap must be destroyed by @ref binary_heap_destroy.
+ */
+binary_heap_t
+binary_heap_create (maze_idx_t capacity)
+{
+    binary_heap_t heap = {
+        .p_array     = maze_malloc(sizeof(binary_heap_node_t) * capacity),
+        .capacity    = capacity,
+        .size        = 0,
+        .p_positions = maze_calloc(capacity, sizeof(maze_idx_t)),
+    };
+
+    return heap;
+}
+
+/**
+ * @brief Destroys a binary heap by freeing its arrays.
+ *
+ * @param[in,out] p_heap Pointer to the binary heap.
+ */
+void
+binary_heap_destroy (binary_heap_t *p_heap)
+{
+    maze_free(p_heap->p_array);
+    maze_free(p_heap->p_positions);
+
+    p_heap->p_array     = NULL;
+    p_heap->p_positions = NULL;
+    p_heap->capacity    = 0;
+    p_heap->size        = 0;
+}
+
 /**
  * @brief Moves the node at the given index down the binary heap to maintain the
  * heap property. This in effect raises the node to the correct position.
@@ -29,7 +79,7 @@
  * @param[in] index Index of the node to be heapified up.
  */
 void
-binary_heapify_up (binary_heap_t *p_heap, uint16_t index)
+binary_heapify_up (binary_heap_t *p_heap, maze_idx_t index)
 {
     // @note These early returns are not necessary, but they make the code
     // easier to read.
@@ -44,7 +94,7 @@ binary_heapify_up (binary_heap_t *p_heap, uint16_t index)
     // Step 2: Get the parent index. In a binary heap, the parent index is
     // always (index - 1) / 2.
     //
-    uint16_t parent_index = (index - 1) / 2;
+    maze_idx_t parent_index = (index - 1) / 2;
 
     // Step 3: Check if the parent node has a lower or equal priority than the
     // current node. If it is, the heap property is satisfied and we can return.
@@ -63,10 +113,7 @@ binary_heapify_up (binary_heap_t *p_heap, uint16_t index)
     {
         // Step 4: Swap the parent node with the current node.
         //
-        binary_heap_node_t temp_node
-            = p_heap->p_array[parent_index]; // Save the parent node.
-        p_heap->p_array[parent_index] = p_heap->p_array[index]; // Swap.
-        p_heap->p_array[index]        = temp_node;              // Swap.
+        swap_nodes(p_heap, parent_index, index);
 
         // Step 5: Heapify up the parent node.
         // Update the index to the parent's index and recalculate the node's new
@@ -85,7 +132,7 @@ binary_heapify_up (binary_heap_t *p_heap, uint16_t index)
  * @param[in] index Index of the node to be heapified down.
  */
 void
-binary_heapify_down (binary_heap_t *p_heap, uint16_t index)
+binary_heapify_down (binary_heap_t *p_heap, maze_idx_t index)
 {
     for (;;)
     {
@@ -93,10 +140,10 @@ binary_heapify_down (binary_heap_t *p_heap, uint16_t index)
         // heap, the indices are known to be 2 * index + 1..=2 for the left and
         // right respectively.
         //
-        uint16_t left_index  = 2 * index + 1;  // Calculate the left index.
-        uint16_t right_index = 2 * index + 2;  // Calculate the right index.
-        uint16_t smallest_child_index = index; // Assume that the current node
-                                               // is the smallest.
+        maze_idx_t left_index  = 2 * index + 1; // Calculate the left index.
+        maze_idx_t right_index = 2 * index + 2; // Calculate the right index.
+        maze_idx_t smallest_child_index = index; // Assume that the current
+                                                 // node is the smallest.
 
         // Step 2: Find the smallest value amongst the node and its children,
         // and assign the index to `smallest_child_index`.
@@ -125,9 +172,7 @@ binary_heapify_down (binary_heap_t *p_heap, uint16_t index)
 
         // Step 4: Otherwise, swap the current node with the smallest child.
         //
-        binary_heap_node_t temp_node = p_heap->p_array[index];
-        p_heap->p_array[index]       = p_heap->p_array[smallest_child_index];
-        p_heap->p_array[smallest_child_index] = temp_node;
+        swap_nodes(p_heap, index, smallest_child_index);
 
         // Step 5: Update the index to the smallest child's index for the next
         // iteration.
@@ -146,31 +191,18 @@ binary_heapify_down (binary_heap_t *p_heap, uint16_t index)
 void
 binary_heap_insert (binary_heap_t    *p_heap,
                     maze_grid_cell_t *p_maze_node,
-                    uint16_t          priority)
+                    maze_priority_t   priority)
 {
-    // Step 1: Check if the heap is full.
-    //
-    if (p_heap->size == p_heap->capacity)
-    {
-        // If not in debug mode, don't print this message.
-        DEBUG_PRINT("Heap is full!\n");
-        return;
-    }
-
-    // Step 2: Create a new heap node.
+    // Step 1: Create a new heap node.
     //
     binary_heap_node_t new_node;
     new_node.p_maze_node = p_maze_node;
     new_node.priority    = priority;
+    new_node.cell_idx    = BINARY_HEAP_NOT_FOUND;
 
-    // Step 3: Insert it at the end of the array.
-    //
-    p_heap->p_array[p_heap->size] = new_node;
-    p_heap->size++;
-
-    // Step 4: Heapify up.
+    // Step 2: Insert it into the heap.
     //
-    binary_heapify_up(p_heap, p_heap->size - 1);
+    insert_node(p_heap, new_node);
 }
 
 /**
@@ -189,6 +221,7 @@ binary_heap_delete_min (binary_heap_t *p_heap)
     // Step 2: Move the last node to the root and delete the last node.
     //
     p_heap->p_array[0] = p_heap->p_array[p_heap->size - 1];
+    update_position(p_heap, 0);
     // Delete the last node by setting it to NULL.
     p_heap->p_array[p_heap->size - 1].p_maze_node = NULL;
     p_heap->p_array[p_heap->size - 1].priority    = 0;
@@ -222,21 +255,22 @@ binary_heap_peek (binary_heap_t *p_heap)
 
 /**
  * @brief Finds the index of a given node in the binary heap if it exists.
- * Otherwise, returns UINT16_MAX.
+ * Otherwise, returns BINARY_HEAP_NOT_FOUND.
  *
  * @param[in] p_heap Pointer to the binary heap.
  * @param[in] p_maze_node Pointer to the node to be searched for.
- * @return uint16_t Index of the node if it exists, otherwise UINT16_MAX.
+ * @return maze_idx_t Index of the node if it exists, otherwise
+ * BINARY_HEAP_NOT_FOUND.
  */
-uint16_t
+maze_idx_t
 binary_heap_get_node_idx (const binary_heap_t    *p_heap,
                           const maze_grid_cell_t *p_maze_node)
 {
     // Assume that the node is in the heap.
     //
-    uint16_t return_index = UINT16_MAX;
+    maze_idx_t return_index = BINARY_HEAP_NOT_FOUND;
 
-    for (uint16_t index = 0; p_heap->size > index; index++)
+    for (maze_idx_t index = 0; p_heap->size > index; index++)
     {
         if (p_heap->p_array[index].p_maze_node == p_maze_node)
         {
@@ -248,4 +282,226 @@ binary_heap_get_node_idx (const binary_heap_t    *p_heap,
     return return_index;
 }
 
+/**
+ * @brief Inserts a cell of an index-based maze into the binary heap with a
+ * given priority.
+ *
+ * @param[in,out] p_heap Pointer to the binary min-heap.
+ * @param[in] cell_idx Index of the cell to be inserted.
+ * @param[in] priority Priority of the cell to be inserted.
+ */
+void
+binary_heap_insert_idx (binary_heap_t  *p_heap,
+                        maze_idx_t      cell_idx,
+                        maze_priority_t priority)
+{
+    binary_heap_node_t new_node;
+    new_node.p_maze_node = NULL;
+    new_node.priority    = priority;
+    new_node.cell_idx    = cell_idx;
+
+    insert_node(p_heap, new_node);
+}
+
+/**
+ * @brief Finds the position of a cell of an index-based maze in the binary
+ * heap if it exists. Otherwise, returns BINARY_HEAP_NOT_FOUND. This is O(1)
+ * for an indexed heap and a linear scan otherwise.
+ *
+ * @param[in] p_heap Pointer to the binary heap.
+ * @param[in] cell_idx Index of the cell to be searched for.
+ * @return maze_idx_t Position of the cell in the heap if it exists, otherwise
+ * BINARY_HEAP_NOT_FOUND.
+ */
+maze_idx_t
+binary_heap_get_cell_idx_pos (const binary_heap_t *p_heap, maze_idx_t cell_idx)
+{
+    maze_idx_t return_index = BINARY_HEAP_NOT_FOUND;
+
+    // The position of a cell that has left the heap is stale, so check that
+    // the node there still holds the cell.
+    //
+    if (NULL != p_heap->p_positions)
+    {
+        maze_idx_t position = p_heap->p_positions[cell_idx];
+
+        if (p_heap->size > position
+            && p_heap->p_array[position].cell_idx == cell_idx)
+        {
+            return_index = position;
+        }
+
+        return return_index;
+    }
+
+    for (maze_idx_t index = 0; p_heap->size > index; index++)
+    {
+        if (p_heap->p_array[index].cell_idx == cell_idx)
+        {
+            return_index = index;
+            break;
+        }
+    }
+
+    return return_index;
+}
+
+/**
+ * @brief Inserts a cell of an index-based maze into the binary heap, or lowers
+ * its priority if it is already in the heap. This is O(log n) for an indexed
+ * heap.
+ *
+ * @param[in,out] p_heap Pointer to the binary min-heap.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] priority New priority of the cell. It must not be greater than
+ * the priority the cell already has.
+ */
+void
+binary_heap_decrease_key_idx (binary_heap_t  *p_heap,
+                              maze_idx_t      cell_idx,
+                              maze_priority_t priority)
+{
+    maze_idx_t position = binary_heap_get_cell_idx_pos(p_heap, cell_idx);
+
+    if (BINARY_HEAP_NOT_FOUND == position)
+    {
+        binary_heap_insert_idx(p_heap, cell_idx, priority);
+        return;
+    }
+
+    p_heap->p_array[position].priority = priority;
+    binary_heapify_up(p_heap, position);
+}
+
+/**
+ * @brief Inserts a cell of an index-based maze into the binary heap, or
+ * changes its priority if it is already in the heap. Unlike @ref
+ * binary_heap_decrease_key_idx, the priority can also be raised.
+ *
+ * @param[in,out] p_heap Pointer to the binary min-heap.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] priority New priority of the cell.
+ */
+void
+binary_heap_update_key_idx (binary_heap_t  *p_heap,
+                            maze_idx_t      cell_idx,
+                            maze_priority_t priority)
+{
+    maze_idx_t position = binary_heap_get_cell_idx_pos(p_heap, cell_idx);
+
+    if (BINARY_HEAP_NOT_FOUND == position)
+    {
+        binary_heap_insert_idx(p_heap, cell_idx, priority);
+        return;
+    }
+
+    p_heap->p_array[position].priority = priority;
+    binary_heapify_up(p_heap, position);
+    binary_heapify_down(p_heap, position);
+}
+
+/**
+ * @brief Removes a cell of an index-based maze from the binary heap, if it is
+ * in the heap.
+ *
+ * @param[in,out] p_heap Pointer to the binary min-heap.
+ * @param[in] cell_idx Index of the cell.
+ */
+void
+binary_heap_remove_idx (binary_heap_t *p_heap, maze_idx_t cell_idx)
+{
+    maze_idx_t position = binary_heap_get_cell_idx_pos(p_heap, cell_idx);
+
+    if (BINARY_HEAP_NOT_FOUND == position)
+    {
+        return;
+    }
+
+    // Step 1: Move the last node into the hole and delete the last node.
+    //
+    p_heap->size--;
+
+    if (p_heap->size == position)
+    {
+        return;
+    }
+
+    p_heap->p_array[position] = p_heap->p_array[p_heap->size];
+    update_position(p_heap, position);
+
+    // Step 2: The moved node may belong above or below the hole.
+    //
+    binary_heapify_up(p_heap, position);
+    binary_heapify_down(p_heap, position);
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Inserts a heap node at the end of the heap and heapifies it up.
+ *
+ * @param[in,out] p_heap Pointer to the binary min-heap.
+ * @param[in] new_node Node to be inserted.
+ */
+static void
+insert_node (binary_heap_t *p_heap, binary_heap_node_t new_node)
+{
+    // Step 1: Check if the heap is full.
+    //
+    if (p_heap->size == p_heap->capacity)
+    {
+        // If not in debug mode, don't print this message.
+        DEBUG_PRINT("Heap is full!\n");
+        return;
+    }
+
+    // Step 2: Insert it at the end of the array.
+    //
+    p_heap->p_array[p_heap->size] = new_node;
+    update_position(p_heap, p_heap->size);
+    p_heap->size++;
+
+    // Step 3: Heapify up.
+    //
+    binary_heapify_up(p_heap, p_heap->size - 1);
+}
+
+/**
+ * @brief Swaps two nodes of the binary heap and updates their positions.
+ *
+ * @param[in,out] p_heap Pointer to the binary heap.
+ * @param[in] index_a Position of the first node.
+ * @param[in] index_b Position of the second node.
+ */
+static void
+swap_nodes (binary_heap_t *p_heap, maze_idx_t index_a, maze_idx_t index_b)
+{
+    binary_heap_node_t temp_node = p_heap->p_array[index_a];
+    p_heap->p_array[index_a]     = p_heap->p_array[index_b];
+    p_heap->p_array[index_b]     = temp_node;
+
+    update_position(p_heap, index_a);
+    update_position(p_heap, index_b);
+}
+
+/**
+ * @brief Records the position of the node at an index of an indexed heap.
+ * Nothing is done for heaps that are not indexed, or for nodes of grid cells.
+ *
+ * @param[in,out] p_heap Pointer to the binary heap.
+ * @param[in] index Position of the node.
+ */
+static void
+update_position (binary_heap_t *p_heap, maze_idx_t index)
+{
+    maze_idx_t cell_idx = p_heap->p_array[index].cell_idx;
+
+    if (NULL != p_heap->p_positions && BINARY_HEAP_NOT_FOUND != cell_idx)
+    {
+        p_heap->p_positions[cell_idx] = index;
+    }
+}
+
 // End of pathfinding/binary_heap.c
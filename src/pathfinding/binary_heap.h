@@ -33,6 +33,12 @@
 #define DEBUG_PRINT(...)
 #endif
 
+/**
+ * @def BINARY_HEAP_NOT_FOUND
+ * @brief Position returned when a node is not in the binary heap.
+ */
+#define BINARY_HEAP_NOT_FOUND MAZE_IDX_MAX
+
 // Type definitions.
 // ----------------------------------------------------------------------------
 //
@@ -43,10 +49,11 @@
  */
 typedef struct binary_heap_node
 {
-    uint16_t priority; ///< Priority of the node. This is the F-value of the
-                       ///< node.
+    maze_priority_t priority; ///< Priority of the node. This is the F-value
+                              ///< of the node.
     maze_grid_cell_t *p_maze_node; ///< Pointer to a node in the maze.
-
+    maze_idx_t cell_idx; ///< Index of the cell for index-based mazes such as
+                         ///< @ref maze_compact_t. Unused otherwise.
 } binary_heap_node_t;
 
 /**
@@ -54,34 +61,62 @@ typedef struct binary_heap_node
  *
  * @warning The array is 0-indexed, so capacity and size are always 1 greater
  * than their respective index maximums.
+ *
+ * @note A heap created by @ref binary_heap_create is indexed: it keeps the
+ * position of every cell index, so finding a cell is O(1) instead of a scan.
+ * Cell indices must then be below the capacity.
  */
 typedef struct binary_heap
 {
     binary_heap_node_t *p_array; ///< Pointer to the first element of the array.
-    uint16_t capacity; ///< Maximum number of nodes that can be stored in
-                       ///< the binary heap.
+    maze_idx_t capacity; ///< Maximum number of nodes that can be stored in
+                         ///< the binary heap.
 
-    uint16_t size; ///< Current number of nodes in the binary heap.
+    maze_idx_t size; ///< Current number of nodes in the binary heap.
+    maze_idx_t *p_positions; ///< Position of each cell index in the heap, or
+                             ///< NULL if the heap is not indexed. Positions
+                             ///< of cells no longer in the heap are stale.
 } binary_heap_t;
 
 // Public functions.
 // ----------------------------------------------------------------------------
 //
 
-void binary_heapify_up(binary_heap_t *p_heap, uint16_t index);
+binary_heap_t binary_heap_create(maze_idx_t capacity);
+
+void binary_heap_destroy(binary_heap_t *p_heap);
 
-void binary_heapify_down(binary_heap_t *p_heap, uint16_t index);
+void binary_heapify_up(binary_heap_t *p_heap, maze_idx_t index);
+
+void binary_heapify_down(binary_heap_t *p_heap, maze_idx_t index);
 
 void binary_heap_insert(binary_heap_t    *p_heap,
                         maze_grid_cell_t *p_maze_node,
-                        uint16_t          priority);
+                        maze_priority_t   priority);
 
 maze_grid_cell_t *binary_heap_delete_min(binary_heap_t *p_heap);
 
 binary_heap_node_t binary_heap_peek(binary_heap_t *p_heap);
 
-uint16_t binary_heap_get_node_idx(const binary_heap_t    *p_heap,
-                                  const maze_grid_cell_t *p_maze_node);
+maze_idx_t binary_heap_get_node_idx(const binary_heap_t    *p_heap,
+                                    const maze_grid_cell_t *p_maze_node);
+
+void binary_heap_insert_idx(binary_heap_t  *p_heap,
+                            maze_idx_t      cell_idx,
+                            maze_priority_t priority);
+
+maze_idx_t binary_heap_get_cell_idx_pos(const binary_heap_t *p_heap,
+                                        maze_idx_t           cell_idx);
+
+void binary_heap_decrease_key_idx(binary_heap_t  *p_heap,
+                                  maze_idx_t      cell_idx,
+                                  maze_priority_t priority);
+
+void binary_heap_update_key_idx(binary_heap_t  *p_heap,
+                                maze_idx_t      cell_idx,
+                                maze_priority_t priority);
+
+void binary_heap_remove_idx(binary_heap_t *p_heap, maze_idx_t cell_idx);
 
 #endif // BINARY_HEAP_H
 
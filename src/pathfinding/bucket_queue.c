@@ -0,0 +1,283 @@
+/**
+ * @file bucket_queue.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the bucket priority queue of cell indices.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/bucket_queue.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def GET_BUCKET(priority)
+ * @brief Gets the bucket of a priority in the ring of buckets.
+ */
+#define GET_BUCKET(priority) ((priority) & (BUCKET_QUEUE_NUM_BUCKETS - 1u))
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void unlink_cell(bucket_queue_t *p_queue, maze_idx_t cell_idx);
+static void seek_min(bucket_queue_t *p_queue);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates an empty bucket queue.
+ *
+ * @param[in] capacity Number of cell indices.
+ * @return bucket_queue_t Empty bucket queue.
+ *
+ * @warning The queue must be destroyed by @ref bucket_queue_destroy.
+ */
+bucket_queue_t
+bucket_queue_create (maze_idx_t capacity)
+{
+    bucket_queue_t queue = {
+        .p_heads = maze_malloc(sizeof(maze_idx_t) * BUCKET_QUEUE_NUM_BUCKETS),
+        .p_next  = maze_malloc(sizeof(maze_idx_t) * capacity),
+        .p_prev  = maze_malloc(sizeof(maze_idx_t) * capacity),
+        .p_priorities = maze_malloc(sizeof(maze_priority_t) * capacity),
+        .capacity     = capacity,
+        .size         = 0,
+        .min_priority = 0,
+    };
+
+    if (NULL == queue.p_heads || NULL == queue.p_next || NULL == queue.p_prev
+        || NULL == queue.p_priorities)
+    {
+        return queue;
+    }
+
+    for (uint32_t bucket = 0; BUCKET_QUEUE_NUM_BUCKETS > bucket; bucket++)
+    {
+        queue.p_heads[bucket] = BUCKET_QUEUE_NO_CELL;
+    }
+
+    for (maze_idx_t cell_idx = 0; capacity > cell_idx; cell_idx++)
+    {
+        queue.p_prev[cell_idx] = BUCKET_QUEUE_NOT_QUEUED;
+    }
+
+    return queue;
+}
+
+/**
+ * @brief Destroys a bucket queue by freeing its arrays.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue.
+ */
+void
+bucket_queue_destroy (bucket_queue_t *p_queue)
+{
+    maze_free(p_queue->p_heads);
+    maze_free(p_queue->p_next);
+    maze_free(p_queue->p_prev);
+    maze_free(p_queue->p_priorities);
+
+    p_queue->p_heads      = NULL;
+    p_queue->p_next       = NULL;
+    p_queue->p_prev       = NULL;
+    p_queue->p_priorities = NULL;
+    p_queue->capacity     = 0;
+    p_queue->size         = 0;
+}
+
+/**
+ * @brief Removes every cell from the bucket queue. This takes time in the
+ * number of buckets and queued cells, not the capacity.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue.
+ */
+void
+bucket_queue_clear (bucket_queue_t *p_queue)
+{
+    for (uint32_t bucket = 0;
+         BUCKET_QUEUE_NUM_BUCKETS > bucket && 0 < p_queue->size;
+         bucket++)
+    {
+        maze_idx_t cell_idx = p_queue->p_heads[bucket];
+
+        while (BUCKET_QUEUE_NO_CELL != cell_idx)
+        {
+            p_queue->p_prev[cell_idx] = BUCKET_QUEUE_NOT_QUEUED;
+            cell_idx                  = p_queue->p_next[cell_idx];
+            p_queue->size--;
+        }
+
+        p_queue->p_heads[bucket] = BUCKET_QUEUE_NO_CELL;
+    }
+
+    p_queue->min_priority = 0;
+}
+
+/**
+ * @brief Inserts a cell at the front of the bucket of its priority. If the
+ * cell is already queued, it is moved to the bucket of the new priority.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] priority Priority of the cell.
+ */
+void
+bucket_queue_push (bucket_queue_t *p_queue,
+                   maze_idx_t      cell_idx,
+                   maze_priority_t priority)
+{
+    // Step 1: Take the cell out of its old bucket.
+    //
+    if (bucket_queue_is_queued(p_queue, cell_idx))
+    {
+        if (p_queue->p_priorities[cell_idx] == priority)
+        {
+            return;
+        }
+
+        unlink_cell(p_queue, cell_idx);
+    }
+
+    // Step 2: Push it onto the front of the bucket of the new priority.
+    //
+    maze_idx_t *p_head = &p_queue->p_heads[GET_BUCKET(priority)];
+
+    p_queue->p_priorities[cell_idx] = priority;
+    p_queue->p_next[cell_idx]       = *p_head;
+    p_queue->p_prev[cell_idx]       = BUCKET_QUEUE_NO_CELL;
+
+    if (BUCKET_QUEUE_NO_CELL != *p_head)
+    {
+        p_queue->p_prev[*p_head] = cell_idx;
+    }
+
+    *p_head = cell_idx;
+
+    // Step 3: Move the cursor down if the cell comes first.
+    //
+    if (0 == p_queue->size || priority < p_queue->min_priority)
+    {
+        p_queue->min_priority = priority;
+    }
+
+    p_queue->size++;
+}
+
+/**
+ * @brief Gets the last inserted cell with the lowest priority without
+ * removing it.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue. The cursor may move.
+ * @return maze_idx_t Index of the cell, or BUCKET_QUEUE_NO_CELL if the queue
+ * is empty.
+ */
+maze_idx_t
+bucket_queue_peek (bucket_queue_t *p_queue)
+{
+    if (0 == p_queue->size)
+    {
+        return BUCKET_QUEUE_NO_CELL;
+    }
+
+    seek_min(p_queue);
+    return p_queue->p_heads[GET_BUCKET(p_queue->min_priority)];
+}
+
+/**
+ * @brief Removes the last inserted cell with the lowest priority.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue.
+ * @return maze_idx_t Index of the cell, or BUCKET_QUEUE_NO_CELL if the queue
+ * is empty.
+ */
+maze_idx_t
+bucket_queue_pop (bucket_queue_t *p_queue)
+{
+    maze_idx_t cell_idx = bucket_queue_peek(p_queue);
+
+    if (BUCKET_QUEUE_NO_CELL != cell_idx)
+    {
+        unlink_cell(p_queue, cell_idx);
+    }
+
+    return cell_idx;
+}
+
+/**
+ * @brief Checks if a cell is in the bucket queue.
+ *
+ * @param[in] p_queue Pointer to the bucket queue.
+ * @param[in] cell_idx Index of the cell.
+ * @return true If the cell is queued.
+ * @return false Otherwise.
+ */
+bool
+bucket_queue_is_queued (const bucket_queue_t *p_queue, maze_idx_t cell_idx)
+{
+    return BUCKET_QUEUE_NOT_QUEUED != p_queue->p_prev[cell_idx];
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Removes a queued cell from its bucket.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue.
+ * @param[in] cell_idx Index of the cell.
+ */
+static void
+unlink_cell (bucket_queue_t *p_queue, maze_idx_t cell_idx)
+{
+    uint32_t   bucket = GET_BUCKET(p_queue->p_priorities[cell_idx]);
+    maze_idx_t prev   = p_queue->p_prev[cell_idx];
+    maze_idx_t next   = p_queue->p_next[cell_idx];
+
+    if (BUCKET_QUEUE_NO_CELL == prev)
+    {
+        p_queue->p_heads[bucket] = next;
+    }
+    else
+    {
+        p_queue->p_next[prev] = next;
+    }
+
+    if (BUCKET_QUEUE_NO_CELL != next)
+    {
+        p_queue->p_prev[next] = prev;
+    }
+
+    p_queue->p_prev[cell_idx] = BUCKET_QUEUE_NOT_QUEUED;
+    p_queue->size--;
+}
+
+/**
+ * @brief Moves the cursor up to the lowest bucket that is not empty.
+ *
+ * @param[in,out] p_queue Pointer to the bucket queue. It must not be empty.
+ */
+static void
+seek_min (bucket_queue_t *p_queue)
+{
+    while (BUCKET_QUEUE_NO_CELL
+           == p_queue->p_heads[GET_BUCKET(p_queue->min_priority)])
+    {
+        p_queue->min_priority++;
+    }
+}
+
+// End of pathfinding/bucket_queue.c
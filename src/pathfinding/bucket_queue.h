@@ -0,0 +1,102 @@
+/**
+ * @file bucket_queue.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the bucket priority queue (Dial's queue) of cell
+ * indices. Cells are kept in buckets indexed by priority, and a cursor moves
+ * up to the lowest bucket that is not empty, so every operation is O(1)
+ * amortised when edges have small integer costs. Each bucket is a stack, so
+ * ties go to the last inserted cell, which is the deepest one in A*.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef BUCKET_QUEUE_H // Include guard.
+#define BUCKET_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def BUCKET_QUEUE_NUM_BUCKETS
+ * @brief Number of buckets. The buckets are reused in a ring, so the
+ * priorities in the queue at any time must span fewer than this many values.
+ * A* with unit costs and the Manhattan distance spans 3, and a floodfill 2.
+ * It must be a power of two.
+ */
+#ifndef BUCKET_QUEUE_NUM_BUCKETS
+#define BUCKET_QUEUE_NUM_BUCKETS 256u
+#endif
+
+#if 0 != (BUCKET_QUEUE_NUM_BUCKETS & (BUCKET_QUEUE_NUM_BUCKETS - 1u))
+#error "BUCKET_QUEUE_NUM_BUCKETS must be a power of two."
+#endif
+
+/**
+ * @def BUCKET_QUEUE_NO_CELL
+ * @brief Cell index that ends a bucket, or that marks an empty bucket.
+ */
+#define BUCKET_QUEUE_NO_CELL MAZE_IDX_MAX
+
+/**
+ * @def BUCKET_QUEUE_NOT_QUEUED
+ * @brief Previous cell of cells that are not in the queue.
+ */
+#define BUCKET_QUEUE_NOT_QUEUED (MAZE_IDX_MAX - 1u)
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains a bucket queue of the cells of a maze. Each
+ * bucket is a doubly linked list threaded through arrays indexed by cell, so
+ * the priority of a queued cell can be lowered in O(1).
+ *
+ * @warning Cell indices must be below the capacity, which must be below
+ * @ref BUCKET_QUEUE_NOT_QUEUED.
+ */
+typedef struct bucket_queue
+{
+    maze_idx_t *p_heads; ///< First cell of each bucket, or NO_CELL.
+    maze_idx_t *p_next;  ///< Next cell in the bucket of each cell.
+    maze_idx_t *p_prev;  ///< Previous cell in the bucket of each cell, NO_CELL
+                         ///< for the first cell and NOT_QUEUED for cells that
+                         ///< are not in the queue.
+    maze_priority_t *p_priorities; ///< Priority of each queued cell.
+    maze_idx_t       capacity;     ///< Number of cell indices.
+    maze_idx_t       size;         ///< Number of queued cells.
+    maze_priority_t  min_priority; ///< No queued cell has a lower priority.
+} bucket_queue_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+bucket_queue_t bucket_queue_create(maze_idx_t capacity);
+
+void bucket_queue_destroy(bucket_queue_t *p_queue);
+
+void bucket_queue_clear(bucket_queue_t *p_queue);
+
+void bucket_queue_push(bucket_queue_t *p_queue,
+                       maze_idx_t      cell_idx,
+                       maze_priority_t priority);
+
+maze_idx_t bucket_queue_peek(bucket_queue_t *p_queue);
+
+maze_idx_t bucket_queue_pop(bucket_queue_t *p_queue);
+
+bool bucket_queue_is_queued(const bucket_queue_t *p_queue,
+                            maze_idx_t            cell_idx);
+
+#endif // BUCKET_QUEUE_H
+
+// End of pathfinding/bucket_queue.h
@@ -0,0 +1,486 @@
+/**
+ * @file d_star_lite.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the D* Lite incremental planner.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/d_star_lite.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void     reset_planner(d_star_lite_t *p_planner);
+static uint32_t get_heuristic(const d_star_lite_t *p_planner,
+                              maze_idx_t           cell_idx);
+static uint32_t calculate_key(const d_star_lite_t *p_planner,
+                              maze_idx_t           cell_idx);
+static void     update_cell(d_star_lite_t *p_planner, maze_idx_t cell_idx);
+static void     update_neighbours(d_star_lite_t *p_planner,
+                                  maze_idx_t     cell_idx);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a D* Lite planner from the start node to the end node. No
+ * plan is made until @ref d_star_lite_plan is called.
+ *
+ * @param[in] p_grid Pointer to the grid maze. It must outlive the planner.
+ * @param[in] p_start_node Pointer to the node of the navigator.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return d_star_lite_t Planner.
+ *
+ * @warning The planner must be destroyed by @ref d_star_lite_destroy.
+ */
+d_star_lite_t
+d_star_lite_create (const maze_grid_t      *p_grid,
+                    const maze_grid_cell_t *p_start_node,
+                    const maze_grid_cell_t *p_end_node)
+{
+    maze_idx_t    num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    d_star_lite_t planner   = {
+        .p_grid       = p_grid,
+        .p_g          = maze_malloc(sizeof(uint32_t) * num_cells),
+        .p_rhs        = maze_malloc(sizeof(uint32_t) * num_cells),
+        .open_set     = binary_heap_create(num_cells),
+        .start_idx    = maze_get_cell_idx(p_grid, p_start_node),
+        .end_idx      = maze_get_cell_idx(p_grid, p_end_node),
+        .key_modifier = 0,
+        .num_expanded = 0,
+    };
+
+    if (NULL != planner.p_g && NULL != planner.p_rhs
+        && NULL != planner.open_set.p_array
+        && NULL != planner.open_set.p_positions)
+    {
+        reset_planner(&planner);
+    }
+
+    return planner;
+}
+
+/**
+ * @brief Destroys a D* Lite planner by freeing its arrays.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ */
+void
+d_star_lite_destroy (d_star_lite_t *p_planner)
+{
+    maze_free(p_planner->p_g);
+    maze_free(p_planner->p_rhs);
+    binary_heap_destroy(&p_planner->open_set);
+
+    p_planner->p_g   = NULL;
+    p_planner->p_rhs = NULL;
+}
+
+/**
+ * @brief Repairs the planner after the walls of a node have changed, e.g. by
+ * @ref maze_nav_modify_walls, or its cost has, e.g. by @ref
+ * maze_set_cell_cost. Only the node and its four adjacent nodes are updated
+ * here, and the changes spread on the next @ref d_star_lite_plan.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ * @param[in] p_node Pointer to the node whose walls have changed.
+ */
+void
+d_star_lite_update_walls (d_star_lite_t          *p_planner,
+                          const maze_grid_cell_t *p_node)
+{
+    // The node and the nodes that it is or was adjacent to may have a
+    // different lookahead now.
+    //
+    maze_idx_t cell_idx = maze_get_cell_idx(p_planner->p_grid, p_node);
+    update_cell(p_planner, cell_idx);
+    update_neighbours(p_planner, cell_idx);
+}
+
+/**
+ * @brief Moves the navigator of the planner to a node. The key modifier is
+ * raised by the distance moved, so that the keys already in the open set stay
+ * lower bounds.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ * @param[in] p_node Pointer to the node of the navigator.
+ */
+void
+d_star_lite_move (d_star_lite_t *p_planner, const maze_grid_cell_t *p_node)
+{
+    const maze_grid_t *p_grid   = p_planner->p_grid;
+    maze_idx_t         cell_idx = maze_get_cell_idx(p_grid, p_node);
+
+    p_planner->key_modifier += get_heuristic(p_planner, cell_idx);
+    p_planner->start_idx = cell_idx;
+
+    // Keys are at most a distance, a heuristic and the key modifier. Start
+    // again if they could overflow the priorities.
+    //
+    uint64_t max_key = (uint64_t)MAZE_GRID_CELLS(p_grid) * p_grid->max_cost
+                       + MAZE_GRID_ROWS(p_grid) + MAZE_GRID_COLS(p_grid)
+                       + p_planner->key_modifier;
+
+    if (MAZE_PRIORITY_MAX < max_key)
+    {
+        reset_planner(p_planner);
+    }
+}
+
+/**
+ * @brief Makes the distance of the navigator's node to the end node correct,
+ * expanding only the nodes that are locally inconsistent.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ * @return true If the end node can be reached from the navigator's node.
+ * @return false Otherwise.
+ */
+bool
+d_star_lite_plan (d_star_lite_t *p_planner)
+{
+    binary_heap_t *p_open_set = &p_planner->open_set;
+    maze_idx_t     start_idx  = p_planner->start_idx;
+
+    p_planner->num_expanded = 0;
+
+    while (0 < p_open_set->size)
+    {
+        // Step 1: Stop once the navigator's node is consistent and every key
+        // is greater than its key. Keys equal to its key are expanded, since
+        // the second component of the keys is not kept.
+        //
+        binary_heap_node_t top_node = binary_heap_peek(p_open_set);
+        maze_idx_t         cell_idx = top_node.cell_idx;
+
+        if (top_node.priority > calculate_key(p_planner, start_idx)
+            && p_planner->p_g[start_idx] == p_planner->p_rhs[start_idx])
+        {
+            break;
+        }
+
+        // Step 2: A key that has grown since the node was queued is raised.
+        //
+        uint32_t new_key = calculate_key(p_planner, cell_idx);
+
+        if (top_node.priority < new_key)
+        {
+            binary_heap_update_key_idx(
+                p_open_set, cell_idx, (maze_priority_t)new_key);
+            continue;
+        }
+
+        p_planner->num_expanded++;
+
+        // Step 3: An overconsistent node takes its lookahead. Otherwise, it
+        // is underconsistent, so it is made unreachable and queued again if
+        // its lookahead is still finite.
+        //
+        if (p_planner->p_g[cell_idx] > p_planner->p_rhs[cell_idx])
+        {
+            p_planner->p_g[cell_idx] = p_planner->p_rhs[cell_idx];
+            binary_heap_remove_idx(p_open_set, cell_idx);
+        }
+        else
+        {
+            p_planner->p_g[cell_idx] = D_STAR_LITE_INFINITY;
+            update_cell(p_planner, cell_idx);
+        }
+
+        update_neighbours(p_planner, cell_idx);
+    }
+
+    return D_STAR_LITE_INFINITY != p_planner->p_g[start_idx];
+}
+
+/**
+ * @brief Gets the direction of the next move from the navigator's node along a
+ * shortest path.
+ *
+ * @param[in] p_planner Pointer to the planner after @ref d_star_lite_plan.
+ * @return maze_cardinal_direction_t Direction of the next move, or MAZE_NONE
+ * if the end node cannot be reached or has been reached.
+ */
+maze_cardinal_direction_t
+d_star_lite_get_next_dir (const d_star_lite_t *p_planner)
+{
+    const maze_grid_cell_t *p_node
+        = &p_planner->p_grid->p_grid_array[p_planner->start_idx];
+    maze_cardinal_direction_t direction = MAZE_NONE;
+    uint32_t                  min_g     = D_STAR_LITE_INFINITY;
+
+    if (p_planner->start_idx == p_planner->end_idx)
+    {
+        return MAZE_NONE;
+    }
+
+    for (uint8_t i = 0; 4 > i; i++)
+    {
+        if (NULL == p_node->p_next[i])
+        {
+            continue;
+        }
+
+        maze_idx_t neighbour_idx
+            = maze_get_cell_idx(p_planner->p_grid, p_node->p_next[i]);
+        uint32_t neighbour_g = p_planner->p_g[neighbour_idx];
+
+        if (D_STAR_LITE_INFINITY == neighbour_g)
+        {
+            continue;
+        }
+
+        neighbour_g += MAZE_CELL_COST(p_planner->p_grid, neighbour_idx);
+
+        if (neighbour_g < min_g)
+        {
+            min_g     = neighbour_g;
+            direction = i;
+        }
+    }
+
+    return direction;
+}
+
+/**
+ * @brief Maps out the maze like @ref floodfill_map_maze, but replans with D*
+ * Lite after every move instead of flooding the maze again.
+ *
+ * @param[in,out] p_grid Pointer to the initialised maze with no walls.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[in,out] p_navigator Pointer to the navigator state.
+ * @param[in] p_explore_func Pointer to the function that will explore the maze.
+ * It may only change the walls of the navigator's node.
+ * @param[in] p_move_navigator Pointer to the function that will move the
+ * navigator.
+ *
+ * @note Unknown walls are assumed open, so if the end node cannot be reached
+ * in the map, it cannot be reached in the maze and the navigator stops.
+ */
+void
+d_star_lite_map_maze (maze_grid_t               *p_grid,
+                      const maze_grid_cell_t    *p_end_node,
+                      maze_navigator_state_t    *p_navigator,
+                      floodfill_explore_func_t   p_explore_func,
+                      floodfill_move_navigator_t p_move_navigator)
+{
+    d_star_lite_t planner
+        = d_star_lite_create(p_grid, p_navigator->p_current_node, p_end_node);
+
+    while (p_navigator->p_current_node != p_end_node)
+    {
+        // Step 1: Explore the current node, and repair the planner only if a
+        // wall was found.
+        //
+        maze_grid_cell_t *p_current_node = p_navigator->p_current_node;
+        maze_grid_cell_t *p_old_next[4];
+
+        for (uint8_t i = 0; 4 > i; i++)
+        {
+            p_old_next[i] = p_current_node->p_next[i];
+        }
+
+        p_explore_func(p_grid, p_navigator, p_navigator->orientation);
+
+        for (uint8_t i = 0; 4 > i; i++)
+        {
+            if (p_old_next[i] != p_current_node->p_next[i])
+            {
+                d_star_lite_update_walls(&planner, p_current_node);
+                break;
+            }
+        }
+
+        // Step 2: Replan and move along the shortest path.
+        //
+        if (!d_star_lite_plan(&planner))
+        {
+            break;
+        }
+
+        p_move_navigator(p_navigator, d_star_lite_get_next_dir(&planner));
+        d_star_lite_move(&planner, p_navigator->p_current_node);
+    }
+
+    d_star_lite_destroy(&planner);
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Forgets every distance and queues the end node, as in a new planner.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ */
+static void
+reset_planner (d_star_lite_t *p_planner)
+{
+    maze_idx_t num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_planner->p_grid);
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_planner->p_g[cell_idx]   = D_STAR_LITE_INFINITY;
+        p_planner->p_rhs[cell_idx] = D_STAR_LITE_INFINITY;
+    }
+
+    p_planner->open_set.size             = 0;
+    p_planner->key_modifier              = 0;
+    p_planner->p_rhs[p_planner->end_idx] = 0;
+
+    binary_heap_update_key_idx(
+        &p_planner->open_set,
+        p_planner->end_idx,
+        (maze_priority_t)calculate_key(p_planner, p_planner->end_idx));
+}
+
+/**
+ * @brief Gets the Manhattan distance from the navigator's node to a node.
+ *
+ * @param[in] p_planner Pointer to the planner.
+ * @param[in] cell_idx Index of the node.
+ * @return uint32_t Heuristic distance.
+ */
+static uint32_t
+get_heuristic (const d_star_lite_t *p_planner, maze_idx_t cell_idx)
+{
+    const maze_grid_cell_t *p_cells = p_planner->p_grid->p_grid_array;
+
+    return maze_manhattan_dist(&p_cells[p_planner->start_idx].coordinates,
+                               &p_cells[cell_idx].coordinates);
+}
+
+/**
+ * @brief Calculates the first component of the key of a node.
+ *
+ * @param[in] p_planner Pointer to the planner.
+ * @param[in] cell_idx Index of the node.
+ * @return uint32_t Key of the node, D_STAR_LITE_INFINITY if both its g-value
+ * and lookahead are infinite.
+ */
+static uint32_t
+calculate_key (const d_star_lite_t *p_planner, maze_idx_t cell_idx)
+{
+    uint32_t min_g = (p_planner->p_g[cell_idx] < p_planner->p_rhs[cell_idx])
+                         ? p_planner->p_g[cell_idx]
+                         : p_planner->p_rhs[cell_idx];
+
+    if (D_STAR_LITE_INFINITY == min_g)
+    {
+        return D_STAR_LITE_INFINITY;
+    }
+
+    return min_g + get_heuristic(p_planner, cell_idx) + p_planner->key_modifier;
+}
+
+/**
+ * @brief Recalculates the lookahead of a node from its open neighbours, and
+ * queues the node if it is locally inconsistent.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ * @param[in] cell_idx Index of the node.
+ */
+static void
+update_cell (d_star_lite_t *p_planner, maze_idx_t cell_idx)
+{
+    // Step 1: The lookahead is the lowest g-value next to it plus the cost of
+    // entering that node.
+    //
+    if (cell_idx != p_planner->end_idx)
+    {
+        const maze_grid_cell_t *p_node
+            = &p_planner->p_grid->p_grid_array[cell_idx];
+        uint32_t rhs = D_STAR_LITE_INFINITY;
+
+        for (uint8_t i = 0; 4 > i; i++)
+        {
+            if (NULL == p_node->p_next[i])
+            {
+                continue;
+            }
+
+            maze_idx_t neighbour_idx
+                = maze_get_cell_idx(p_planner->p_grid, p_node->p_next[i]);
+            uint32_t neighbour_g = p_planner->p_g[neighbour_idx];
+
+            if (D_STAR_LITE_INFINITY == neighbour_g)
+            {
+                continue;
+            }
+
+            neighbour_g += MAZE_CELL_COST(p_planner->p_grid, neighbour_idx);
+
+            if (neighbour_g < rhs)
+            {
+                rhs = neighbour_g;
+            }
+        }
+
+        p_planner->p_rhs[cell_idx] = rhs;
+    }
+
+    // Step 2: Queue the node if it is inconsistent, otherwise dequeue it.
+    //
+    if (p_planner->p_g[cell_idx] != p_planner->p_rhs[cell_idx])
+    {
+        binary_heap_update_key_idx(
+            &p_planner->open_set,
+            cell_idx,
+            (maze_priority_t)calculate_key(p_planner, cell_idx));
+    }
+    else
+    {
+        binary_heap_remove_idx(&p_planner->open_set, cell_idx);
+    }
+}
+
+/**
+ * @brief Updates the four nodes adjacent to a node, whether or not there are
+ * walls between them.
+ *
+ * @param[in,out] p_planner Pointer to the planner.
+ * @param[in] cell_idx Index of the node.
+ */
+static void
+update_neighbours (d_star_lite_t *p_planner, maze_idx_t cell_idx)
+{
+    const maze_grid_t *p_grid  = p_planner->p_grid;
+    maze_idx_t         columns = MAZE_GRID_COLS(p_grid);
+    maze_idx_t         row     = cell_idx / columns;
+    maze_idx_t         col     = cell_idx % columns;
+
+    if (0 < row)
+    {
+        update_cell(p_planner, cell_idx - columns);
+    }
+
+    if (columns - 1 > col)
+    {
+        update_cell(p_planner, cell_idx + 1);
+    }
+
+    if (MAZE_GRID_ROWS(p_grid) - 1 > row)
+    {
+        update_cell(p_planner, cell_idx + columns);
+    }
+
+    if (0 < col)
+    {
+        update_cell(p_planner, cell_idx - 1);
+    }
+}
+
+// End of pathfinding/d_star_lite.c
@@ -0,0 +1,88 @@
+/**
+ * @file d_star_lite.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the D* Lite incremental planner. It keeps the
+ * distances of the cells to the end cell between plans, so that after the
+ * navigator discovers walls only the cells whose distances changed are
+ * repaired, instead of flooding the whole maze again.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @see http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf
+ */
+
+#ifndef D_STAR_LITE_H // Include guard.
+#define D_STAR_LITE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/floodfill.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def D_STAR_LITE_INFINITY
+ * @brief Distance of cells that cannot reach the end cell.
+ */
+#define D_STAR_LITE_INFINITY UINT32_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the state of the D* Lite planner. The search
+ * runs from the end cell to the navigator, so its g-values are the distances
+ * to the end cell and stay valid as the navigator moves. @see d_star_lite
+ *
+ * @note Priorities are only the first component of the D* Lite keys, and a
+ * plan runs until every key is greater than the key of the navigator's cell.
+ */
+typedef struct d_star_lite
+{
+    const maze_grid_t *p_grid;       ///< Grid maze that the plans are made on.
+    uint32_t          *p_g;          ///< Distance of each cell to the end cell.
+    uint32_t          *p_rhs;        ///< One-step lookahead of each g-value.
+    binary_heap_t      open_set;     ///< Locally inconsistent cells.
+    maze_idx_t         start_idx;    ///< Cell of the navigator.
+    maze_idx_t         end_idx;      ///< End cell.
+    uint32_t           key_modifier; ///< Sum of the heuristic distances moved.
+    uint32_t           num_expanded; ///< Cells expanded by the last plan.
+} d_star_lite_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+d_star_lite_t d_star_lite_create(const maze_grid_t      *p_grid,
+                                 const maze_grid_cell_t *p_start_node,
+                                 const maze_grid_cell_t *p_end_node);
+
+void d_star_lite_destroy(d_star_lite_t *p_planner);
+
+void d_star_lite_update_walls(d_star_lite_t          *p_planner,
+                              const maze_grid_cell_t *p_node);
+
+void d_star_lite_move(d_star_lite_t          *p_planner,
+                      const maze_grid_cell_t *p_node);
+
+bool d_star_lite_plan(d_star_lite_t *p_planner);
+
+maze_cardinal_direction_t d_star_lite_get_next_dir(
+    const d_star_lite_t *p_planner);
+
+void d_star_lite_map_maze(maze_grid_t               *p_grid,
+                          const maze_grid_cell_t    *p_end_node,
+                          maze_navigator_state_t    *p_navigator,
+                          floodfill_explore_func_t   p_explore_func,
+                          floodfill_move_navigator_t p_move_navigator);
+
+#endif // D_STAR_LITE_H
+
+// End of pathfinding/d_star_lite.h
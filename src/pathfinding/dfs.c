@@ -17,16 +17,26 @@
 #include <string.h>
 
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
 #include "pathfinding/floodfill.h"
-#include "pathfinding/binary_heap.h"
+#include "pathfinding/open_set.h"
+#include "pathfinding/search_context.h"
 #include "pathfinding/dfs.h"
 
 // Private function prototypes.
 // ----------------------------------------------------------------------------
 //
 
-static void reachable_floodfill(binary_heap_t          *p_reachable_set,
-                                maze_navigator_state_t *p_navigator);
+static bool reachable_floodfill(const maze_grid_t      *p_grid,
+                                search_context_t       *p_context,
+                                const maze_grid_cell_t *p_from_node);
+
+static bool reachable_bfs_compact(const maze_compact_t *p_maze,
+                                  maze_idx_t           *p_queue,
+                                  uint8_t              *p_seen,
+                                  maze_idx_t            cell_idx);
 
 // Public function definitions.
 // ----------------------------------------------------------------------------
@@ -50,23 +60,30 @@ dfs_depth_first_search (maze_grid_t               *p_grid,
 {
     // Step 1: Initialise is_visited to false.
     //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
             maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
             p_cell->is_visited = false;
         }
     }
     p_start_node->is_visited = true;
 
+    // The search context for the reachability checks is allocated once for
+    // the whole run.
+    //
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+
     // Step 2: Get the next node to explore.
     //
     const maze_grid_cell_t   *p_next_node = NULL;
     maze_cardinal_direction_t direction   = MAZE_NONE;
 
-    while (!dfs_is_all_reachable_visited(p_grid, p_navigator))
+    while (!dfs_is_all_reachable_visited_ctx(
+        p_grid, &context, p_navigator->p_current_node))
     {
         // Step 3: Explore the current node
         //
@@ -117,6 +134,8 @@ dfs_depth_first_search (maze_grid_t               *p_grid,
         p_move_navigator(p_navigator, direction);
         p_next_node = NULL;
     }
+
+    search_context_destroy(&context);
 }
 
 /**
@@ -132,57 +151,356 @@ bool
 dfs_is_all_reachable_visited (maze_grid_t            *p_grid,
                               maze_navigator_state_t *p_navigator)
 {
-    // Step 1: Declare the reachable set.
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+
+    bool is_visited = dfs_is_all_reachable_visited_ctx(
+        p_grid, &context, p_navigator->p_current_node);
+
+    search_context_destroy(&context);
+    return is_visited;
+}
+
+/**
+ * @brief Checks if all reachable nodes from a node have been visited, keeping
+ * the search values in a search context. The grid is only read.
+ *
+ * @param[in] p_grid Pointer to the grid.
+ * @param[in,out] p_context Pointer to a search context created for the grid.
+ * @param[in] p_from_node Pointer to the node to search from.
+ * @return true All reachable nodes have been visited.
+ * @return false Not all reachable nodes have been visited.
+ */
+bool
+dfs_is_all_reachable_visited_ctx (const maze_grid_t      *p_grid,
+                                  search_context_t       *p_context,
+                                  const maze_grid_cell_t *p_from_node)
+{
+    // Step 1: Begin a new search so that the g values of all nodes are
+    // UINT32_MAX.
+    //
+    search_context_begin(p_context);
+
+    // Step 2: Set the g-score of the node to search from to 0.
+    //
+    maze_idx_t from_idx = maze_get_cell_idx(p_grid, p_from_node);
+    search_context_stamp(p_context, from_idx);
+    p_context->p_g[from_idx] = 0;
+
+    // Step 3: Conduct the floodfill, which stops early at the first reachable
+    // node that has not been visited.
+    //
+    return reachable_floodfill(p_grid, p_context, p_from_node);
+}
+
+/**
+ * @brief Conducts a depth first search on a compact maze. The walls returned by
+ * the explore function are applied to the maze, and the visited flags and
+ * backtracking directions are kept by the search itself.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in,out] p_navigator Pointer to the navigator state.
+ * @param[in] p_explore_func Function pointer to explore the current cell.
+ * @param[in] p_move_navigator Function pointer to move the navigator.
+ */
+void
+dfs_depth_first_search_compact (
+    maze_compact_t                    *p_maze,
+    maze_compact_navigator_t          *p_navigator,
+    floodfill_compact_explore_func_t   p_explore_func,
+    floodfill_compact_move_navigator_t p_move_navigator)
+{
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    // Step 1: Initialise the visited flags and backtracking directions. The
+    // queue and seen bits of the reachability checks are allocated once for
+    // the whole run.
     //
-    binary_heap_t reachable_set;
-    reachable_set.p_array
-        = malloc(sizeof(binary_heap_node_t) * p_grid->rows * p_grid->columns);
-    memset(reachable_set.p_array,
-           0,
-           sizeof(binary_heap_node_t) * p_grid->rows * p_grid->columns);
-    reachable_set.capacity = p_grid->rows * p_grid->columns;
-    reachable_set.size     = 0;
-
-    // Step 2: Initialise the f, g, and h values of all nodes.
-    for (size_t row = 0; p_grid->rows > row; row++)
+    uint8_t    *p_came_from = maze_malloc(sizeof(uint8_t) * num_cells);
+    maze_idx_t *p_queue     = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t    *p_seen      = maze_malloc(num_cells / 8u + 1u);
+
+    if (NULL == p_came_from || NULL == p_queue || NULL == p_seen)
     {
-        for (size_t col = 0; p_grid->columns > col; col++)
+        goto end;
+    }
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        maze_compact_set_visited(p_maze, cell_idx, false);
+        p_came_from[cell_idx] = MAZE_NONE;
+    }
+    maze_compact_set_visited(p_maze, p_navigator->start_idx, true);
+
+    while (!reachable_bfs_compact(
+        p_maze, p_queue, p_seen, p_navigator->current_idx))
+    {
+        // Step 2: Explore the current cell.
+        //
+        uint16_t wall_bitmask
+            = p_explore_func(p_maze, p_navigator, p_navigator->orientation);
+        maze_compact_modify_walls(
+            p_maze, p_navigator->current_idx, wall_bitmask, true, false);
+
+        // Step 3: Find an unvisited neighbour.
+        //
+        maze_cardinal_direction_t direction = MAZE_NONE;
+
+        for (uint8_t direction_idx = 0; 4 > direction_idx; direction_idx++)
         {
-            maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
-            p_cell->g = UINT32_MAX;
-            p_cell->h = UINT32_MAX;
-            p_cell->f = UINT32_MAX;
+            maze_idx_t neighbour_idx = maze_compact_get_next_idx(
+                p_maze, p_navigator->current_idx, direction_idx);
+
+            if (MAZE_COMPACT_NO_CELL == neighbour_idx
+                || maze_compact_is_visited(p_maze, neighbour_idx))
+            {
+                continue;
+            }
+
+            direction                  = direction_idx;
+            p_came_from[neighbour_idx] = (direction_idx + 2) % 4;
+            break;
+        }
+
+        // Step 4: Check if it is a dead end, and backtrack if so.
+        //
+        if (MAZE_NONE == direction)
+        {
+            direction = p_came_from[p_navigator->current_idx];
         }
+
+        // Nothing left to backtrack to. This can only happen if the mapped
+        // walls contradict the reachability check.
+        //
+        if (MAZE_NONE == direction)
+        {
+            break;
+        }
+
+        // Step 5: Move the robot to the next cell.
+        //
+        p_move_navigator(p_maze, p_navigator, direction);
+        maze_compact_set_visited(p_maze, p_navigator->current_idx, true);
+    }
+
+end:
+    maze_free(p_came_from);
+    maze_free(p_queue);
+    maze_free(p_seen);
+}
+
+/**
+ * @brief Checks if all reachable cells of a compact maze from a cell have been
+ * visited. As every move has the same cost, a breadth first search is enough.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell to search from.
+ * @return true All reachable cells have been visited.
+ * @return false Not all reachable cells have been visited, or the search
+ * arrays could not be allocated.
+ */
+bool
+dfs_is_all_reachable_visited_compact (const maze_compact_t *p_maze,
+                                      maze_idx_t            cell_idx)
+{
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    maze_idx_t *p_queue    = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t    *p_seen     = maze_malloc(num_cells / 8u + 1u);
+    bool        is_visited = false;
+
+    if (NULL != p_queue && NULL != p_seen)
+    {
+        is_visited = reachable_bfs_compact(p_maze, p_queue, p_seen, cell_idx);
     }
 
-    // Step 2: Set the g-score of the current node to 0.
+    maze_free(p_queue);
+    maze_free(p_seen);
+    return is_visited;
+}
+
+/**
+ * @brief Conducts a depth first search on a chunked maze. The maze only needs
+ * the chunk of the start cell up front. Every wall of a new chunk is set, and
+ * the gaps seen by the explore function allocate the chunks behind them, so
+ * the maze grows with the explored area.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] p_explore_func Function pointer to the explore function.
+ * @param[in] p_move_navigator Function pointer to the move navigator function.
+ *
+ * @note The backtracking directions are kept on a stack that grows with the
+ * depth of the search, as the number of cells is not known in advance.
+ */
+void
+dfs_depth_first_search_chunked (
+    maze_chunked_t                    *p_maze,
+    maze_chunked_navigator_t          *p_navigator,
+    floodfill_chunked_explore_func_t   p_explore_func,
+    floodfill_chunked_move_navigator_t p_move_navigator)
+{
+    // Step 1: Initialise the visited flags and the backtracking stack.
     //
-    maze_grid_cell_t *p_next_node = p_navigator->p_current_node;
-    p_next_node->g                = 0;
+    maze_idx_t num_cells = maze_chunked_get_num_cells(p_maze);
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        maze_chunked_set_visited(p_maze, cell_idx, false);
+    }
+    maze_chunked_set_visited(p_maze, p_navigator->current_idx, true);
 
-    // Step 3: Conduct the floodfill.
+    uint32_t stack_capacity = MAZE_CHUNK_CELLS;
+    uint32_t stack_size     = 0;
+    uint8_t *p_back_stack   = maze_malloc(stack_capacity);
+
+    while (NULL != p_back_stack)
+    {
+        // Step 2: Explore the current cell. Its walls and gaps are both known
+        // once it has been seen. Unseen cells have every wall set, so this
+        // must happen before checking what is left to visit.
+        //
+        uint16_t wall_bitmask
+            = p_explore_func(p_maze, p_navigator, p_navigator->orientation);
+        maze_chunked_modify_walls(p_maze,
+                                  p_navigator->current_idx,
+                                  MAZE_INVERT_BITMASK(wall_bitmask),
+                                  true,
+                                  true);
+
+        if (dfs_is_all_reachable_visited_chunked(p_maze,
+                                                 p_navigator->current_idx))
+        {
+            break;
+        }
+
+        // Step 3: Find an unvisited neighbour.
+        //
+        maze_cardinal_direction_t direction = MAZE_NONE;
+
+        for (uint8_t direction_idx = 0; 4 > direction_idx; direction_idx++)
+        {
+            maze_idx_t neighbour_idx = maze_chunked_get_next_idx(
+                p_maze, p_navigator->current_idx, direction_idx);
+
+            if (MAZE_CHUNKED_NO_CELL == neighbour_idx
+                || maze_chunked_is_visited(p_maze, neighbour_idx))
+            {
+                continue;
+            }
+
+            direction = direction_idx;
+            break;
+        }
+
+        // Step 4: Push the way back, or pop it if this is a dead end.
+        //
+        if (MAZE_NONE != direction)
+        {
+            if (stack_capacity == stack_size)
+            {
+                uint8_t *p_stack
+                    = maze_realloc(p_back_stack, stack_capacity * 2u);
+
+                if (NULL == p_stack)
+                {
+                    break;
+                }
+
+                p_back_stack = p_stack;
+                stack_capacity *= 2u;
+            }
+
+            p_back_stack[stack_size++] = (direction + 2) % 4;
+        }
+        else if (0 < stack_size)
+        {
+            direction = p_back_stack[--stack_size];
+        }
+        else
+        {
+            // Nothing left to backtrack to. This can only happen if the mapped
+            // walls contradict the reachability check.
+            //
+            break;
+        }
+
+        // Step 5: Move the robot to the next cell.
+        //
+        p_move_navigator(p_maze, p_navigator, direction);
+        maze_chunked_set_visited(p_maze, p_navigator->current_idx, true);
+    }
+
+    maze_free(p_back_stack);
+}
+
+/**
+ * @brief Checks if all reachable cells of a chunked maze from a cell have been
+ * visited. @see dfs_is_all_reachable_visited_compact.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell to search from.
+ * @return true All reachable cells have been visited.
+ * @return false Not all reachable cells have been visited, or the search
+ * arrays could not be allocated.
+ */
+bool
+dfs_is_all_reachable_visited_chunked (const maze_chunked_t *p_maze,
+                                      maze_idx_t            cell_idx)
+{
+    maze_idx_t num_cells = maze_chunked_get_num_cells(p_maze);
+
+    // Step 1: Declare the queue and the seen bits.
     //
-    reachable_floodfill(&reachable_set, p_navigator);
+    maze_idx_t *p_queue    = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    uint8_t    *p_seen     = maze_malloc(num_cells / 8u + 1u);
+    maze_idx_t  head       = 0;
+    maze_idx_t  tail       = 0;
+    bool        is_visited = true;
 
-    // Step 4: Check if all the nodes in the reachable set have been visited.
+    if (NULL == p_queue || NULL == p_seen)
+    {
+        maze_free(p_queue);
+        maze_free(p_seen);
+        return false;
+    }
+
+    memset(p_seen, 0, num_cells / 8u + 1u);
+
+    p_queue[tail++] = cell_idx;
+    p_seen[cell_idx / 8u] |= (uint8_t)(1u << (cell_idx % 8u));
+
+    // Step 2: Search until an unvisited cell is found.
     //
-    bool is_visited = true;
-    while (0 < reachable_set.size)
+    while (head < tail)
     {
-        const maze_grid_cell_t *p_current_node
-            = binary_heap_peek(&reachable_set).p_maze_node;
-        is_visited &= p_current_node->is_visited;
-        binary_heap_delete_min(&reachable_set);
-        // Step 5: If not visited, end early and return false.
-        //
-        if (!is_visited)
+        maze_idx_t current_idx = p_queue[head++];
+
+        if (!maze_chunked_is_visited(p_maze, current_idx))
+        {
+            is_visited = false;
+            break;
+        }
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
         {
-            goto end;
+            maze_idx_t neighbour_idx
+                = maze_chunked_get_next_idx(p_maze, current_idx, direction);
+
+            if (MAZE_CHUNKED_NO_CELL == neighbour_idx
+                || (p_seen[neighbour_idx / 8u]
+                    & (1u << (neighbour_idx % 8u))))
+            {
+                continue;
+            }
+
+            p_seen[neighbour_idx / 8u] |= (uint8_t)(1u << (neighbour_idx % 8u));
+            p_queue[tail++] = neighbour_idx;
         }
     }
-end:
-    free(reachable_set.p_array);
+
+    maze_free(p_queue);
+    maze_free(p_seen);
     return is_visited;
 }
 
@@ -191,83 +509,134 @@ end:
 //
 
 /**
- * @brief Performs floodfill to retrieve all the reachable nodes.
+ * @brief Performs floodfill over all the reachable nodes. A node is reached
+ * when it is stamped with a g-score in the current search, so no separate
+ * reachable set is needed.
  *
- * @param[out] p_reachable_set Pointer to the reachable set.
- * @param[in] p_navigator Pointer to the navigator state.
+ * @param[in] p_grid Pointer to the grid.
+ * @param[in,out] p_context Pointer to the search context.
+ * @param[in] p_from_node Pointer to the node to search from.
+ * @return true All reachable nodes other than the node searched from have been
+ * visited.
+ * @return false A reachable node has not been visited.
  */
-static void
-reachable_floodfill (binary_heap_t          *p_reachable_set,
-                     maze_navigator_state_t *p_navigator)
+static bool
+reachable_floodfill (const maze_grid_t      *p_grid,
+                     search_context_t       *p_context,
+                     const maze_grid_cell_t *p_from_node)
 {
-    // Step 1: Declare the open set.
+    // Step 1: Add the node to search from to the open set.
     //
-    binary_heap_t open_set
-        = { .p_array = NULL, .size = 0, .capacity = p_reachable_set->capacity };
-    open_set.p_array
-        = malloc(sizeof(binary_heap_node_t) * p_reachable_set->capacity);
-    memset(open_set.p_array,
-           0,
-           sizeof(binary_heap_node_t) * p_reachable_set->capacity);
-
-    // Step 2: Add the current node to the open set.
-    //
-    maze_grid_cell_t *p_next_node = p_navigator->p_current_node;
-    binary_heap_insert(&open_set, p_next_node, p_next_node->h);
+    open_set_t *p_open_set = &p_context->open_set;
+    open_set_push(
+        p_open_set, maze_get_cell_idx(p_grid, p_from_node), 0);
 
-    while (0 < open_set.size)
+    while (!open_set_is_empty(p_open_set))
     {
-        binary_heap_node_t p_current_node = binary_heap_peek(&open_set);
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+
+        open_set_pop(p_open_set);
 
-        binary_heap_delete_min(&open_set);
+        const maze_grid_cell_t *p_current_node
+            = &p_grid->p_grid_array[current_idx];
 
         for (uint8_t neighbour_dir = 0; 4 > neighbour_dir; neighbour_dir++)
         {
-            // Step 3: Ensure that the neighbour is not null.
+            // Step 2: Ensure that the neighbour is not null.
             //
-            maze_grid_cell_t *p_neighbour
-                = p_current_node.p_maze_node->p_next[neighbour_dir];
+            const maze_grid_cell_t *p_neighbour
+                = p_current_node->p_next[neighbour_dir];
             if (NULL == p_neighbour)
             {
                 continue;
             }
 
-            // Step 4: Ighnore neighbour g-scores that are smaller than the
-            // current g-score.
+            // Step 3: Ignore neighbours that have already been reached.
             //
-            uint32_t tentative_g_score = p_current_node.p_maze_node->g + 1;
+            maze_idx_t neighbour_idx = maze_get_cell_idx(p_grid, p_neighbour);
+            search_context_stamp(p_context, neighbour_idx);
 
-            if (p_neighbour->g < p_current_node.p_maze_node->g)
+            if (UINT32_MAX != p_context->p_g[neighbour_idx])
             {
                 continue;
             }
 
-            // Step 5: Ensure that the neighbour is not in the reachable set,
-            // then add it to the reachable set.
+            // Step 4: End early if the neighbour has not been visited.
+            // Otherwise, add it to the open set.
             //
-            uint16_t neighbour_index
-                = binary_heap_get_node_idx(p_reachable_set, p_neighbour);
-            p_neighbour->g = tentative_g_score;
-
-            if (UINT16_MAX == neighbour_index)
+            if (!p_neighbour->is_visited)
             {
-                binary_heap_insert(
-                    p_reachable_set, p_neighbour, p_neighbour->g);
+                return false;
             }
 
-            // Step 6: Ensure that the neighbour is not in the open set, then
-            // add it to the open set.
-            //
-            neighbour_index = binary_heap_get_node_idx(&open_set, p_neighbour);
+            p_context->p_g[neighbour_idx] = p_context->p_g[current_idx] + 1;
+            open_set_push(
+                p_open_set, neighbour_idx, p_context->p_g[neighbour_idx]);
+        }
+    }
 
-            if (UINT16_MAX == neighbour_index)
+    return true;
+}
+
+/**
+ * @brief Searches breadth first from a cell of a compact maze until a cell
+ * that has not been visited is found.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[out] p_queue Queue with room for every cell of the maze.
+ * @param[out] p_seen Seen bits with room for every cell of the maze.
+ * @param[in] cell_idx Index of the cell to search from.
+ * @return true All reachable cells have been visited.
+ * @return false A reachable cell has not been visited.
+ */
+static bool
+reachable_bfs_compact (const maze_compact_t *p_maze,
+                       maze_idx_t           *p_queue,
+                       uint8_t              *p_seen,
+                       maze_idx_t            cell_idx)
+{
+    maze_idx_t num_cells  = (maze_idx_t)p_maze->rows * p_maze->columns;
+    maze_idx_t head       = 0;
+    maze_idx_t tail       = 0;
+    bool       is_visited = true;
+
+    // Step 1: Clear the seen bits and queue the cell to search from.
+    //
+    memset(p_seen, 0, num_cells / 8u + 1u);
+
+    p_queue[tail++] = cell_idx;
+    p_seen[cell_idx / 8u] |= (uint8_t)(1u << (cell_idx % 8u));
+
+    // Step 2: Search until an unvisited cell is found.
+    //
+    while (head < tail)
+    {
+        maze_idx_t current_idx = p_queue[head++];
+
+        if (!maze_compact_is_visited(p_maze, current_idx))
+        {
+            is_visited = false;
+            break;
+        }
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t neighbour_idx
+                = maze_compact_get_next_idx(p_maze, current_idx, direction);
+
+            if (MAZE_COMPACT_NO_CELL == neighbour_idx
+                || (p_seen[neighbour_idx / 8u]
+                    & (1u << (neighbour_idx % 8u))))
             {
-                binary_heap_insert(&open_set, p_neighbour, p_neighbour->g);
+                continue;
             }
+
+            p_seen[neighbour_idx / 8u] |= (uint8_t)(1u << (neighbour_idx % 8u));
+            p_queue[tail++] = neighbour_idx;
         }
     }
 
-    free(open_set.p_array);
+    return is_visited;
 }
 // Private functions definitions
 // ----------------------------------------------------------------------------
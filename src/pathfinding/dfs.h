@@ -14,7 +14,10 @@
 
 #include <stdint.h>
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
 #include "pathfinding/floodfill.h"
+#include "pathfinding/search_context.h"
 
 // Public function prototypes.
 // ----------------------------------------------------------------------------
@@ -29,6 +32,28 @@ void dfs_depth_first_search(maze_grid_t               *p_grid,
 bool dfs_is_all_reachable_visited(maze_grid_t            *p_grid,
                                   maze_navigator_state_t *p_navigator);
 
+void dfs_depth_first_search_compact(
+    maze_compact_t                    *p_maze,
+    maze_compact_navigator_t          *p_navigator,
+    floodfill_compact_explore_func_t   p_explore_func,
+    floodfill_compact_move_navigator_t p_move_navigator);
+
+bool dfs_is_all_reachable_visited_ctx(const maze_grid_t      *p_grid,
+                                      search_context_t       *p_context,
+                                      const maze_grid_cell_t *p_from_node);
+
+bool dfs_is_all_reachable_visited_compact(const maze_compact_t *p_maze,
+                                          maze_idx_t            cell_idx);
+
+void dfs_depth_first_search_chunked(
+    maze_chunked_t                    *p_maze,
+    maze_chunked_navigator_t          *p_navigator,
+    floodfill_chunked_explore_func_t   p_explore_func,
+    floodfill_chunked_move_navigator_t p_move_navigator);
+
+bool dfs_is_all_reachable_visited_chunked(const maze_chunked_t *p_maze,
+                                          maze_idx_t            cell_idx);
+
 #endif // DFS_H
 
 /*** End of file main/pathfinding/dfs.h ***/
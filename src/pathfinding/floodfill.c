@@ -15,15 +15,30 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "pathfinding/maze.h"
-#include "pathfinding/binary_heap.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_dist_cache.h"
+#include "pathfinding/open_set.h"
+#include "pathfinding/search_context.h"
 #include "pathfinding/floodfill.h"
 
 // Private function prototypes.
 // ----------------------------------------------------------------------------
 //
 
-static void floodfill(binary_heap_t          *p_open_set,
-                      maze_navigator_state_t *p_navigator);
+static void floodfill(const maze_grid_t            *p_grid,
+                      search_context_t             *p_context,
+                      const maze_navigator_state_t *p_navigator);
+
+static maze_cardinal_direction_t floodfill_get_next_dir(
+    const maze_grid_t      *p_grid,
+    search_context_t       *p_context,
+    const maze_grid_cell_t *p_cell);
+
+static void floodfill_compact(const maze_compact_t           *p_maze,
+                              open_set_t                     *p_open_set,
+                              maze_idx_t                     *p_h,
+                              const maze_compact_navigator_t *p_navigator);
 
 // Public function definitions.
 // ----------------------------------------------------------------------------
@@ -38,15 +53,16 @@ static void floodfill(binary_heap_t          *p_open_set,
 void
 floodfill_init_maze_nowall (maze_grid_t *p_grid)
 {
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
             maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
             p_cell->f           = 0;
             p_cell->g           = 0;
             p_cell->h           = 0;
+            p_cell->epoch       = p_grid->epoch;
             p_cell->coordinates = (maze_point_t) { col, row };
             p_cell->p_came_from = NULL;
             p_cell->is_visited  = false;
@@ -72,91 +88,187 @@ floodfill_init_maze_nowall (maze_grid_t *p_grid)
 /**
  * @brief Runs the floodfill algorithm to map out the maze.
  *
+ * The distance field of the end node is kept for the whole run, and repaired
+ * around each node whose walls are found. If a field cannot hold every
+ * distance of the maze, which only happens on weighted grids in the 16-bit
+ * build, the maze is flooded into a search context after every move instead.
+ *
  * @param[in,out] p_grid Pointer to the initialised maze with no walls.
  * @param[in] p_end_node Pointer to the end node.
  * @param[in,out] p_navigator Pointer to the navigator state.
  * @param[in] p_explore_func Pointer to the function that will explore the maze.
+ * It may only change the walls of the navigator's node.
  * @param[in] p_move_navigator Pointer to the function that will move the
  * navigator.
+ * @return true If the navigator reached the end node.
+ * @return false If the distances could not be allocated, in which case the
+ * navigator is not moved.
  */
-void
+bool
 floodfill_map_maze (maze_grid_t               *p_grid,
                     const maze_grid_cell_t    *p_end_node,
                     maze_navigator_state_t    *p_navigator,
                     floodfill_explore_func_t   p_explore_func,
                     floodfill_move_navigator_t p_move_navigator)
 {
-    // Initialise the flood array.
-    //
+    bool              is_exact   = maze_dist_cache_is_exact(p_grid);
+    uint8_t           num_fields = is_exact ? 1 : 0;
+    maze_dist_cache_t cache      = maze_dist_cache_create(p_grid, num_fields);
+    search_context_t  context    = { 0 };
+    bool              is_ready   = is_exact;
 
-    // Like in A*, initialise the f, g, and h values of all nodes.
+    if (!is_exact)
+    {
+        context  = search_context_create((maze_idx_t)MAZE_GRID_CELLS(p_grid));
+        is_ready = search_context_is_valid(&context);
+    }
+
+    // Start the inner loop.
     //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    while (is_ready && p_navigator->p_current_node != p_end_node)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        // Explore the current node, and repair the field only if a wall was
+        // found.
+        //
+        maze_grid_cell_t *p_current_node = p_navigator->p_current_node;
+        maze_grid_cell_t *p_old_next[4];
+
+        for (uint8_t i = 0; 4 > i; i++)
         {
-            maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+            p_old_next[i] = p_current_node->p_next[i];
+        }
+
+        p_explore_func(p_grid, p_navigator, p_navigator->orientation);
 
-            p_cell->h = UINT32_MAX;
-            p_cell->g = UINT32_MAX;
-            p_cell->f = UINT32_MAX;
+        for (uint8_t i = 0; is_exact && 4 > i; i++)
+        {
+            if (p_old_next[i] != p_current_node->p_next[i])
+            {
+                maze_dist_cache_update_walls(&cache, p_current_node);
+                break;
+            }
+        }
+
+        // Get the next node to explore: the first neighbour on a shortest
+        // path to the end node.
+        //
+        maze_cardinal_direction_t direction = MAZE_NONE;
+
+        if (is_exact)
+        {
+            const maze_dist_field_t *p_field
+                = maze_dist_cache_get(&cache, p_end_node);
+
+            if (NULL == p_field)
+            {
+                is_ready = false;
+                break;
+            }
+
+            direction
+                = maze_dist_cache_get_next_dir(&cache, p_field, p_current_node);
+        }
+        else
+        {
+            floodfill(p_grid, &context, p_navigator);
+            direction
+                = floodfill_get_next_dir(p_grid, &context, p_current_node);
         }
+
+        if (MAZE_NONE == direction)
+        {
+            // We have reached a dead end. We need to backtrack.
+            //
+            direction = (p_navigator->orientation + 2) % 4;
+        }
+
+        // Move the robot to the next node.
+        //
+        p_move_navigator(p_navigator, direction);
     }
 
-    // Start the inner loop.
+    search_context_destroy(&context);
+    maze_dist_cache_destroy(&cache);
+
+    return is_ready;
+}
+
+/**
+ * @brief Runs the floodfill algorithm to map out a compact maze. The walls
+ * returned by the explore function are applied to the maze before every flood.
+ *
+ * @param[in,out] p_maze Pointer to the initialised compact maze with no walls.
+ * @param[in,out] p_navigator Pointer to the navigator state.
+ * @param[in] p_explore_func Pointer to the function that will explore the maze.
+ * @param[in] p_move_navigator Pointer to the function that will move the
+ * navigator.
+ * @return true If the navigator reached the end cell.
+ * @return false If the flood arrays could not be allocated, in which case the
+ * navigator is not moved.
+ */
+bool
+floodfill_map_maze_compact (maze_compact_t                    *p_maze,
+                            maze_compact_navigator_t          *p_navigator,
+                            floodfill_compact_explore_func_t   p_explore_func,
+                            floodfill_compact_move_navigator_t p_move_navigator)
+{
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    // Initialise the flood array and the h-values. Unlike the grid version,
+    // these are allocated once for the whole run.
     //
-    while (p_navigator->p_current_node != p_end_node)
+    open_set_t flood_array = open_set_create(num_cells);
+
+    maze_idx_t *p_h      = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    bool        is_ready = open_set_is_valid(&flood_array) && NULL != p_h;
+
+    while (is_ready && p_navigator->current_idx != p_navigator->end_idx)
     {
-        // Explore the current node.
+        // Explore the current cell and record its walls.
         //
-        p_explore_func(p_grid, p_navigator, p_navigator->orientation);
+        uint16_t wall_bitmask
+            = p_explore_func(p_maze, p_navigator, p_navigator->orientation);
+        maze_compact_modify_walls(
+            p_maze, p_navigator->current_idx, wall_bitmask, true, false);
+
+        open_set_clear(&flood_array);
+        floodfill_compact(p_maze, &flood_array, p_h, p_navigator);
 
-        // ! Possible to allocate this out of the loop?
-        binary_heap_t flood_array;
-        flood_array.p_array  = malloc(sizeof(binary_heap_node_t) * p_grid->rows
-                                     * p_grid->columns);
-        flood_array.capacity = p_grid->rows * p_grid->columns;
-        flood_array.size     = 0;
-        floodfill(&flood_array, p_navigator);
-        // Get the next node to explore.
+        // Get the next cell to explore.
         //
-        maze_grid_cell_t         *p_next_node = NULL;
-        maze_cardinal_direction_t direction   = MAZE_NONE;
+        maze_cardinal_direction_t direction = MAZE_NONE;
 
         for (uint8_t i = 0; 4 > i; i++)
         {
-            maze_grid_cell_t *p_neighbour
-                = p_navigator->p_current_node->p_next[i];
+            maze_idx_t neighbour_idx = maze_compact_get_next_idx(
+                p_maze, p_navigator->current_idx, i);
 
-            if (NULL == p_neighbour)
+            if (MAZE_COMPACT_NO_CELL == neighbour_idx)
             {
                 continue;
             }
 
-            if (p_neighbour->h < p_navigator->p_current_node->h)
+            if (p_h[neighbour_idx] < p_h[p_navigator->current_idx])
             {
-                p_next_node = p_neighbour;
-                direction   = i;
+                direction = i;
                 break;
             }
         }
 
-        if (NULL == p_next_node)
+        if (MAZE_NONE == direction)
         {
             // We have reached a dead end. We need to backtrack.
             //
             direction = (p_navigator->orientation + 2) % 4;
         }
 
-        // Move the robot to the next node.
-        //
-        p_move_navigator(p_navigator, direction);
-        maze_clear_heuristics(p_grid);
-        // Free the flood array.
-        //
-        free(flood_array.p_array);
+        p_move_navigator(p_maze, p_navigator, direction);
     }
+
+    open_set_destroy(&flood_array);
+    maze_free(p_h);
+
+    return is_ready;
 }
 
 // Private Functions.
@@ -164,76 +276,182 @@ floodfill_map_maze (maze_grid_t               *p_grid,
 //
 
 /**
- * @brief Runs the floodfill algorithm to produce h-values for all nodes. Runs
- * every time the robot moves.
+ * @brief Runs the floodfill algorithm to produce h-values for all nodes closer
+ * to the end node than the navigator. The h-values are kept in the search
+ * context, in 32 bits, so they hold the cost of any path of the maze.
  *
- * @param[in,out] p_open_set Pointer to the open set.
- * @param[in,out] p_navigator Pointer to the navigator state.
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in,out] p_context Pointer to the search context.
+ * @param[in] p_navigator Pointer to the navigator state.
  */
 static void
-floodfill (binary_heap_t *p_open_set, maze_navigator_state_t *p_navigator)
+floodfill (const maze_grid_t            *p_grid,
+           search_context_t             *p_context,
+           const maze_navigator_state_t *p_navigator)
 {
+    open_set_t *p_open_set = &p_context->open_set;
+    maze_idx_t  current_idx
+        = maze_get_cell_idx(p_grid, p_navigator->p_current_node);
+
     // First, update the flood array from the end node. We only update the h
     // value here.
     //
-    maze_grid_cell_t *p_flood_node = p_navigator->p_end_node;
-    p_flood_node->h                = 0;
-
-    // Insert the start node into the flood array.
-    //
-    binary_heap_insert(p_open_set, p_flood_node, p_flood_node->h);
+    maze_idx_t flood_idx = maze_get_cell_idx(p_grid, p_navigator->p_end_node);
+    search_context_begin(p_context);
+    search_context_stamp(p_context, flood_idx);
+    p_context->p_h[flood_idx] = 0;
+    open_set_push(p_open_set, flood_idx, 0);
 
     // This should look similar to the A* algorithm except we are conditioning
-    // on the h-value.
+    // on the h-value. Stepping from a node onto its neighbour costs the
+    // neighbour's cost, so the flood adds the cost of the node it leaves.
     //
-    while (0 < p_open_set->size)
+    while (!open_set_is_empty(p_open_set))
     {
-        binary_heap_node_t p_current_node = binary_heap_peek(p_open_set);
+        maze_idx_t node_idx = open_set_pop(p_open_set);
 
-        if (p_current_node.p_maze_node == p_navigator->p_current_node)
+        if (node_idx == current_idx)
         {
             return;
         }
 
-        // Remove the current node from the open set.
-        //
-        binary_heap_delete_min(p_open_set);
+        const maze_grid_cell_t *p_node = &p_grid->p_grid_array[node_idx];
+        uint64_t                tentative_h_score
+            = (uint64_t)p_context->p_h[node_idx]
+              + MAZE_CELL_COST(p_grid, node_idx);
 
         for (uint8_t neighbour = 0; 4 > neighbour; neighbour++)
         {
-            maze_grid_cell_t *p_neighbour
-                = p_current_node.p_maze_node->p_next[neighbour];
+            const maze_grid_cell_t *p_neighbour = p_node->p_next[neighbour];
 
             if (NULL == p_neighbour)
             {
                 continue;
             }
 
-            uint32_t tentative_h_score = p_current_node.p_maze_node->h + 1;
-            maze_grid_cell_t *p_neighbour_node
-                = p_current_node.p_maze_node->p_next[neighbour];
+            maze_idx_t neighbour_idx = maze_get_cell_idx(p_grid, p_neighbour);
+            search_context_stamp(p_context, neighbour_idx);
 
-            if (tentative_h_score < p_neighbour_node->h)
+            if (tentative_h_score < p_context->p_h[neighbour_idx])
             {
-                p_neighbour_node->h = tentative_h_score;
+                p_context->p_h[neighbour_idx] = (uint32_t)tentative_h_score;
 
-                uint16_t neighbour_index
-                    = binary_heap_get_node_idx(p_open_set, p_neighbour_node);
+                open_set_push(p_open_set,
+                              neighbour_idx,
+                              OPEN_SET_PRIORITY(tentative_h_score));
+            }
+        }
+    }
+}
 
-                if (UINT16_MAX == neighbour_index)
-                {
-                    uint32_t neighbour_priority = p_neighbour_node->h;
-                    binary_heap_insert(
-                        p_open_set, p_neighbour_node, neighbour_priority);
-                }
-                else
-                {
-                    p_open_set->p_array[neighbour_index].priority
-                        = p_neighbour_node->h;
-                    binary_heapify_up(p_open_set, neighbour_index);
-                }
+/**
+ * @brief Gets the direction of the cheapest step from a cell towards the end
+ * node, after floodfill has run.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in,out] p_context Pointer to the flooded search context.
+ * @param[in] p_cell Pointer to the cell.
+ * @return maze_cardinal_direction_t Direction to step in, MAZE_NONE if the end
+ * node cannot be reached from the cell.
+ */
+static maze_cardinal_direction_t
+floodfill_get_next_dir (const maze_grid_t      *p_grid,
+                        search_context_t       *p_context,
+                        const maze_grid_cell_t *p_cell)
+{
+    maze_cardinal_direction_t direction = MAZE_NONE;
+    uint64_t                  best_h    = UINT32_MAX;
+    maze_idx_t                cell_idx  = maze_get_cell_idx(p_grid, p_cell);
+
+    search_context_stamp(p_context, cell_idx);
+
+    if (UINT32_MAX == p_context->p_h[cell_idx])
+    {
+        return MAZE_NONE;
+    }
+
+    // The neighbours closer to the end node than the cell were all taken out
+    // of the open set before it, so the cheapest of them is exact.
+    //
+    for (uint8_t i = 0; 4 > i; i++)
+    {
+        const maze_grid_cell_t *p_neighbour = p_cell->p_next[i];
+
+        if (NULL == p_neighbour)
+        {
+            continue;
+        }
+
+        maze_idx_t neighbour_idx = maze_get_cell_idx(p_grid, p_neighbour);
+        search_context_stamp(p_context, neighbour_idx);
+
+        uint64_t h = (uint64_t)p_context->p_h[neighbour_idx]
+                     + MAZE_CELL_COST(p_grid, neighbour_idx);
+
+        if (h < best_h)
+        {
+            best_h    = h;
+            direction = (maze_cardinal_direction_t)i;
+        }
+    }
+
+    return direction;
+}
+
+/**
+ * @brief Runs the floodfill algorithm on a compact maze to produce h-values for
+ * all cells closer to the end cell than the navigator.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in,out] p_open_set Pointer to the empty open set.
+ * @param[out] p_h Array of h-values indexed by cell.
+ * @param[in] p_navigator Pointer to the navigator state.
+ */
+static void
+floodfill_compact (const maze_compact_t           *p_maze,
+                   open_set_t                     *p_open_set,
+                   maze_idx_t                     *p_h,
+                   const maze_compact_navigator_t *p_navigator)
+{
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_h[cell_idx] = MAZE_IDX_MAX;
+    }
+
+    p_h[p_navigator->end_idx] = 0;
+    open_set_push(p_open_set, p_navigator->end_idx, 0);
+
+    while (!open_set_is_empty(p_open_set))
+    {
+        maze_idx_t current_idx = open_set_peek(p_open_set);
+
+        if (current_idx == p_navigator->current_idx)
+        {
+            return;
+        }
+
+        open_set_pop(p_open_set);
+
+        for (uint8_t neighbour = 0; 4 > neighbour; neighbour++)
+        {
+            maze_idx_t neighbour_idx
+                = maze_compact_get_next_idx(p_maze, current_idx, neighbour);
+
+            if (MAZE_COMPACT_NO_CELL == neighbour_idx)
+            {
+                continue;
+            }
+
+            maze_idx_t tentative_h_score = p_h[current_idx] + 1;
+
+            if (tentative_h_score < p_h[neighbour_idx])
+            {
+                p_h[neighbour_idx] = tentative_h_score;
 
-                p_neighbour_node->p_came_from = p_current_node.p_maze_node;
+                open_set_push(
+                    p_open_set, neighbour_idx, tentative_h_score);
             }
         }
     }
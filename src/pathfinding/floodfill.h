@@ -14,7 +14,10 @@
 #define FLOODFILL_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
 
 // Type definitions.
 // ----------------------------------------------------------------------------
@@ -46,18 +49,84 @@ typedef uint16_t (*floodfill_explore_func_t)(
 typedef void (*floodfill_move_navigator_t)(maze_navigator_state_t *p_navigator,
                                            maze_cardinal_direction_t direction);
 
+/**
+ * @typedef floodfill_compact_explore_func_t
+ * @brief Explores a compact maze. It is expected to return the walls that the
+ * robot sees, aligned to MAZE_NORTH. The caller applies them to the maze.
+ *
+ * @param p_maze Pointer to the compact maze.
+ * @param p_navigator Pointer to the navigator state.
+ * @param direction Direction to explore.
+ *
+ * @return uint16_t Returns a bitmask of the walls.
+ */
+typedef uint16_t (*floodfill_compact_explore_func_t)(
+    maze_compact_t           *p_maze,
+    maze_compact_navigator_t *p_navigator,
+    maze_cardinal_direction_t direction);
+
+/**
+ * @typedef floodfill_compact_move_navigator_t
+ * @brief Moves the navigator/robot in the specified direction in a compact
+ * maze.
+ *
+ * @param p_maze Pointer to the compact maze.
+ * @param p_navigator Pointer to the navigator state.
+ * @param direction Direction to move.
+ */
+typedef void (*floodfill_compact_move_navigator_t)(
+    maze_compact_t           *p_maze,
+    maze_compact_navigator_t *p_navigator,
+    maze_cardinal_direction_t direction);
+
+/**
+ * @typedef floodfill_chunked_explore_func_t
+ * @brief Explores a chunked maze. It is expected to return the walls that the
+ * robot sees, aligned to MAZE_NORTH. The caller applies them to the maze.
+ *
+ * @param p_maze Pointer to the chunked maze.
+ * @param p_navigator Pointer to the navigator state.
+ * @param direction Direction to explore.
+ *
+ * @return uint16_t Returns a bitmask of the walls.
+ */
+typedef uint16_t (*floodfill_chunked_explore_func_t)(
+    maze_chunked_t           *p_maze,
+    maze_chunked_navigator_t *p_navigator,
+    maze_cardinal_direction_t direction);
+
+/**
+ * @typedef floodfill_chunked_move_navigator_t
+ * @brief Moves the navigator/robot in the specified direction in a chunked
+ * maze.
+ *
+ * @param p_maze Pointer to the chunked maze.
+ * @param p_navigator Pointer to the navigator state.
+ * @param direction Direction to move.
+ */
+typedef void (*floodfill_chunked_move_navigator_t)(
+    maze_chunked_t           *p_maze,
+    maze_chunked_navigator_t *p_navigator,
+    maze_cardinal_direction_t direction);
+
 // Public function prototypes.
 // ----------------------------------------------------------------------------
 //
 
 void floodfill_init_maze_nowall(maze_grid_t *p_grid);
 
-void floodfill_map_maze(maze_grid_t               *p_grid,
+bool floodfill_map_maze(maze_grid_t               *p_grid,
                         const maze_grid_cell_t    *p_end_node,
                         maze_navigator_state_t    *p_navigator,
                         floodfill_explore_func_t   p_explore_func,
                         floodfill_move_navigator_t p_move_navigator);
 
+bool floodfill_map_maze_compact(
+    maze_compact_t                    *p_maze,
+    maze_compact_navigator_t          *p_navigator,
+    floodfill_compact_explore_func_t   p_explore_func,
+    floodfill_compact_move_navigator_t p_move_navigator);
+
 #endif
 
 // End of file pathfinding/floodfill.h
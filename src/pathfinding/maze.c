@@ -15,15 +15,12 @@
 #include <stdbool.h>
 #include <string.h>
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_render.h"
 
 // Private function prototypes.
 // ----------------------------------------------------------------------------
 //
-static maze_grid_cell_t *maze_get_cell_in_dir_from(
-    maze_grid_t              *p_grid,
-    maze_grid_cell_t         *p_current,
-    maze_cardinal_direction_t direction);
-
 static void set_wall_helper(maze_grid_t      *p_grid,
                             maze_grid_cell_t *p_current_node,
                             uint8_t           cardinal_direction);
@@ -32,13 +29,31 @@ static void unset_wall_helper(maze_grid_t      *p_grid,
                               maze_grid_cell_t *p_current_node,
                               uint8_t           cardinal_direction);
 
-static void draw_cell(const maze_grid_cell_t *p_cell,
-                      char                   *p_maze_string,
-                      uint16_t                relative_row);
-
 static maze_bitmask_compressed_t *serialised_to_compressed(
     const maze_gap_bitmask_t *p_bitmask);
 
+#ifdef MAZE_STATIC_CELLS
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Pool of grid arrays in the fixed-size build.
+ */
+static maze_grid_cell_t g_grid_pool[MAZE_STATIC_GRIDS][MAZE_STATIC_CELLS];
+
+/**
+ * @brief Whether each grid array of the pool is in use.
+ */
+static bool g_is_grid_used[MAZE_STATIC_GRIDS];
+
+/**
+ * @brief Pool of cost tables in the fixed-size build, one for each grid array
+ * of the pool.
+ */
+static uint8_t g_cost_pool[MAZE_STATIC_GRIDS][MAZE_STATIC_CELLS];
+#endif
+
 // Public functions.
 // ----------------------------------------------------------------------------
 //
@@ -51,14 +66,37 @@ static maze_bitmask_compressed_t *serialised_to_compressed(
  * @return maze_grid_t Empty maze. Indexed first by row, then column.
  *
  * @warning The maze must be destroyed by @ref destroy_maze.
+ * @note In the fixed-size build the grid array is taken from a static pool,
+ * and an empty maze is returned if the dimensions differ from
+ * @ref MAZE_STATIC_ROWS and @ref MAZE_STATIC_COLS or the pool is used up.
  */
 maze_grid_t
 maze_create (uint16_t rows, uint16_t columns)
 {
+#ifdef MAZE_STATIC_CELLS
+    maze_grid_cell_t *p_grid_array = NULL;
+
+    for (uint8_t idx = 0; MAZE_STATIC_GRIDS > idx; idx++)
+    {
+        if (MAZE_STATIC_ROWS == rows && MAZE_STATIC_COLS == columns
+            && !g_is_grid_used[idx])
+        {
+            g_is_grid_used[idx] = true;
+            p_grid_array        = g_grid_pool[idx];
+            break;
+        }
+    }
+
+    if (NULL == p_grid_array)
+    {
+        return (maze_grid_t) { NULL, 0, 0, 0, NULL, 1u };
+    }
+#else
     maze_grid_cell_t *p_grid_array
-        = malloc(sizeof(maze_grid_cell_t) * rows * columns);
+        = maze_malloc(sizeof(maze_grid_cell_t) * rows * columns);
+#endif
     memset(p_grid_array, 0, sizeof(maze_grid_cell_t) * rows * columns);
-    maze_grid_t grid = { p_grid_array, rows, columns };
+    maze_grid_t grid = { p_grid_array, rows, columns, 0, NULL, 1u };
     maze_initialise_empty_walled(&grid);
     return grid;
 }
@@ -73,18 +111,19 @@ maze_create (uint16_t rows, uint16_t columns)
 void
 maze_initialise_empty_walled (maze_grid_t *p_grid)
 {
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
             maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
             p_cell->coordinates = (maze_point_t) { col, row };
             p_cell->f           = 0;
             p_cell->g           = 0;
             p_cell->h           = 0;
             p_cell->p_came_from = NULL;
             p_cell->is_visited  = false;
+            p_cell->epoch       = p_grid->epoch;
             for (uint8_t direction = 0; 4 > direction; direction++)
             {
                 p_cell->p_next[direction] = NULL;
@@ -102,20 +141,74 @@ maze_initialise_empty_walled (maze_grid_t *p_grid)
 void
 maze_clear_heuristics (maze_grid_t *p_grid)
 {
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
             maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
             p_cell->f          = UINT32_MAX;
             p_cell->g          = UINT32_MAX;
             p_cell->h          = UINT32_MAX;
             p_cell->is_visited = false;
+            p_cell->epoch      = p_grid->epoch;
         }
     }
 }
 
+/**
+ * @brief Starts a new search epoch. Every cell's F, G and H values are treated
+ * as UINT32_MAX until the cell is stamped with @ref maze_stamp_cell, so a new
+ * search does not need to sweep the grid.
+ *
+ * @param[in,out] p_grid Pointer to the maze grid.
+ *
+ * @note The grid is only swept when the epoch counter wraps around.
+ */
+void
+maze_new_epoch (maze_grid_t *p_grid)
+{
+    p_grid->epoch++;
+
+    if (0 != p_grid->epoch)
+    {
+        return;
+    }
+
+    // The counter has wrapped, so old stamps could match again. Reset them.
+    //
+    size_t num_cells = MAZE_GRID_CELLS(p_grid);
+
+    for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_grid->p_grid_array[cell_idx].epoch = 0;
+    }
+
+    p_grid->epoch = 1;
+}
+
+/**
+ * @brief Stamps a cell with the current search epoch. If the cell was last
+ * written in an older epoch, its F, G and H values are reset to UINT32_MAX.
+ * This must be called before reading or writing the search values of a cell.
+ *
+ * @param[in] p_grid Pointer to the maze grid.
+ * @param[in,out] p_cell Pointer to the cell.
+ */
+void
+maze_stamp_cell (const maze_grid_t *p_grid, maze_grid_cell_t *p_cell)
+{
+    if (p_grid->epoch == p_cell->epoch)
+    {
+        return;
+    }
+
+    p_cell->f     = UINT32_MAX;
+    p_cell->g     = UINT32_MAX;
+    p_cell->h     = UINT32_MAX;
+    p_cell->epoch = p_grid->epoch;
+}
+
 /**
  * @brief Destroys the maze by freeing the memory allocated to the grid array.
  *
@@ -126,14 +219,128 @@ maze_destroy (maze_grid_t *p_grid)
 {
     if (NULL != p_grid->p_grid_array)
     {
-        free(p_grid->p_grid_array);
+#ifdef MAZE_STATIC_CELLS
+        for (uint8_t idx = 0; MAZE_STATIC_GRIDS > idx; idx++)
+        {
+            if (g_grid_pool[idx] == p_grid->p_grid_array)
+            {
+                g_is_grid_used[idx] = false;
+            }
+        }
+#else
+        maze_free(p_grid->p_grid_array);
+#endif
         p_grid->p_grid_array = NULL;
     }
 
+    maze_clear_cell_costs(p_grid);
     p_grid->rows    = 0;
     p_grid->columns = 0;
 }
 
+/**
+ * @brief Sets the cost of entering a cell, e.g. higher near an obstacle seen
+ * by the ultrasonic sensor or where the wheels slip. The cost table is created
+ * with every cell costing 1 the first time a cost other than 1 is set.
+ *
+ * @param[in,out] p_grid Pointer to the maze grid.
+ * @param[in] p_cell Pointer to the cell.
+ * @param[in] cost Cost of entering the cell, clamped to 1 to @ref
+ * MAZE_CELL_COST_MAX.
+ * @return true If the cost was set.
+ * @return false If the cost table could not be allocated.
+ *
+ * @note Planners that keep distances, e.g. @ref maze_dist_cache_t and @ref
+ * d_star_lite_t, must be told of the change as if the walls of the cell had
+ * changed.
+ */
+bool
+maze_set_cell_cost (maze_grid_t            *p_grid,
+                    const maze_grid_cell_t *p_cell,
+                    uint8_t                 cost)
+{
+    size_t num_cells = MAZE_GRID_CELLS(p_grid);
+
+    if (1u > cost)
+    {
+        cost = 1u;
+    }
+    else if (MAZE_CELL_COST_MAX < cost)
+    {
+        cost = MAZE_CELL_COST_MAX;
+    }
+
+    // Step 1: Keep the uniform fast path for as long as every cell costs 1.
+    //
+    if (NULL == p_grid->p_costs)
+    {
+        if (1u == cost)
+        {
+            return true;
+        }
+
+#ifdef MAZE_STATIC_CELLS
+        for (uint8_t idx = 0; MAZE_STATIC_GRIDS > idx; idx++)
+        {
+            if (g_grid_pool[idx] == p_grid->p_grid_array)
+            {
+                p_grid->p_costs = g_cost_pool[idx];
+            }
+        }
+#else
+        p_grid->p_costs = maze_malloc(sizeof(uint8_t) * num_cells);
+#endif
+
+        if (NULL == p_grid->p_costs)
+        {
+            return false;
+        }
+
+        memset(p_grid->p_costs, 1, sizeof(uint8_t) * num_cells);
+    }
+
+    // Step 2: Set the cost. The largest cost is only ever raised, since
+    // finding it again after a cost is lowered takes a sweep of the table.
+    //
+    p_grid->p_costs[maze_get_cell_idx(p_grid, p_cell)] = cost;
+
+    if (p_grid->max_cost < cost)
+    {
+        p_grid->max_cost = cost;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gets the cost of entering a cell.
+ *
+ * @param[in] p_grid Pointer to the maze grid.
+ * @param[in] p_cell Pointer to the cell.
+ * @return uint8_t Cost of entering the cell, 1 if no cost has been set.
+ */
+uint8_t
+maze_get_cell_cost (const maze_grid_t *p_grid, const maze_grid_cell_t *p_cell)
+{
+    return (uint8_t)MAZE_CELL_COST(p_grid, maze_get_cell_idx(p_grid, p_cell));
+}
+
+/**
+ * @brief Makes every cell cost 1 again by freeing the cost table, so that the
+ * searches take their uniform fast path.
+ *
+ * @param[in,out] p_grid Pointer to the maze grid.
+ */
+void
+maze_clear_cell_costs (maze_grid_t *p_grid)
+{
+#ifndef MAZE_STATIC_CELLS
+    maze_free(p_grid->p_costs);
+#endif
+    p_grid->p_costs  = NULL;
+    p_grid->max_cost = 1u;
+}
+
 /**
  * @brief Get the offset from the navigator's current direction to any other
  * possible direction.
@@ -202,62 +409,19 @@ maze_nav_modify_walls (maze_grid_t            *p_grid,
 }
 
 /**
- * @brief Get the string representation of the maze for pretty printing.
+ * @brief Get the string representation of the maze for pretty printing. Use
+ * @ref maze_render_to_file to stream large maps without building the string.
  * @param[in] p_grid Pointer to the maze grid.
  * @return char* Pointer to the string representation of the maze.
  *
- * @warning The string returned by this function must be freed.
+ * @warning The string returned by this function must be freed with
+ * @ref maze_free.
  *
  */
 char *
 maze_get_string (maze_grid_t *p_grid)
 {
-    uint16_t maze_string_length
-        = (p_grid->columns * 4 + 2) * (p_grid->rows * 2 + 1);
-    char *p_maze_string = malloc(sizeof(char) * maze_string_length);
-    memset(p_maze_string, 0, sizeof(char) * maze_string_length);
-
-    // Draw the maze. For each row draw the west wall, north wall, and the path.
-    //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
-    {
-        for (uint16_t relative_row = 0; relative_row < 3; relative_row++)
-        {
-            for (uint16_t col = 0; p_grid->columns > col; col++)
-            {
-                const maze_grid_cell_t *p_cell
-                    = &p_grid->p_grid_array[row * p_grid->columns + col];
-
-                draw_cell(p_cell, p_maze_string, relative_row);
-                if (p_grid->columns - 1 == col)
-                {
-                    switch (relative_row)
-                    {
-                        case 0:
-                            strcat(p_maze_string, "+\n");
-                            break;
-                        case 1:
-                            strcat(p_maze_string, "|\n");
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
-            // Draw the east wall of the maze. This is done outside of the loop
-            // for the columns.
-            //
-        }
-    }
-    // Draw the bottom border and east wall.
-    //
-    for (uint16_t col = 0; p_grid->columns > col; col++)
-    {
-        strcat(p_maze_string, "+---");
-    }
-    strcat(p_maze_string, "+");
-
-    return p_maze_string;
+    return maze_render_to_string(p_grid, NULL);
 }
 
 /**
@@ -296,9 +460,9 @@ maze_insert_nav_str (const maze_grid_t            *p_grid,
         default:
             break;
     }
-    uint16_t str_row      = row * 2 + 1;
-    uint16_t str_col      = col * 4 + 2;
-    uint16_t str_num_cols = p_grid->columns * 4 + 2;
+    size_t str_row      = (size_t)row * 2 + 1;
+    size_t str_col      = (size_t)col * 4 + 2;
+    size_t str_num_cols = (size_t)MAZE_GRID_COLS(p_grid) * 4 + 2;
 
     p_maze_str[str_row * str_num_cols + str_col] = navigator_char;
 }
@@ -371,8 +535,8 @@ maze_deserialise (maze_grid_t *p_grid, maze_gap_bitmask_t *p_no_walls_array)
 
     // Check that the dimensions are the same.
     //
-    if (p_grid->rows != p_no_walls_array->rows
-        || p_grid->columns != p_no_walls_array->columns)
+    if (MAZE_GRID_ROWS(p_grid) != p_no_walls_array->rows
+        || MAZE_GRID_COLS(p_grid) != p_no_walls_array->columns)
     {
         ret_val = -1;
         goto end;
@@ -380,14 +544,14 @@ maze_deserialise (maze_grid_t *p_grid, maze_gap_bitmask_t *p_no_walls_array)
 
     // Iterate through the array and set the walls.
     //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
-            maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
-            uint16_t no_walls_directions
-                = p_no_walls_array->p_bitmask[row * p_grid->columns + col];
+            size_t            cell_idx = row * MAZE_GRID_COLS(p_grid) + col;
+            maze_grid_cell_t *p_cell   = &p_grid->p_grid_array[cell_idx];
+            uint16_t          no_walls_directions
+                = p_no_walls_array->p_bitmask[cell_idx];
 
             // Set or unset the walls.
             //
@@ -422,22 +586,22 @@ maze_gap_bitmask_t
 maze_serialise (maze_grid_t *p_grid)
 {
     maze_gap_bitmask_t no_walls_array = {
-        .p_bitmask = malloc(sizeof(uint16_t) * p_grid->rows * p_grid->columns),
-        .rows      = p_grid->rows,
-        .columns   = p_grid->columns,
+        .p_bitmask = maze_malloc(sizeof(uint16_t) * MAZE_GRID_CELLS(p_grid)),
+        .rows      = MAZE_GRID_ROWS(p_grid),
+        .columns   = MAZE_GRID_COLS(p_grid),
     };
     memset(no_walls_array.p_bitmask,
            0,
-           sizeof(uint16_t) * p_grid->rows * p_grid->columns);
+           sizeof(uint16_t) * MAZE_GRID_CELLS(p_grid));
 
     // Iterate through the array and set the walls.
     //
-    for (uint16_t row = 0; p_grid->rows > row; row++)
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
     {
-        for (uint16_t col = 0; p_grid->columns > col; col++)
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
         {
             const maze_grid_cell_t *p_cell
-                = &p_grid->p_grid_array[row * p_grid->columns + col];
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
             uint8_t cardinal_direction = 0;
 
             // Check every direction and set the bitmask.
@@ -451,7 +615,7 @@ maze_serialise (maze_grid_t *p_grid)
                     cardinal_direction |= (1 << (direction));
                 }
             }
-            no_walls_array.p_bitmask[row * p_grid->columns + col]
+            no_walls_array.p_bitmask[row * MAZE_GRID_COLS(p_grid) + col]
                 = cardinal_direction;
         }
     }
@@ -473,20 +637,35 @@ maze_get_cell_at_coords (maze_grid_t *p_grid, const maze_point_t *p_coordinates)
 
     // Check if the coordinates are within the maze.
     //
-    if (p_grid->rows <= p_coordinates->y || p_grid->columns <= p_coordinates->x)
+    if (MAZE_GRID_ROWS(p_grid) <= p_coordinates->y
+        || MAZE_GRID_COLS(p_grid) <= p_coordinates->x)
     {
         goto end;
     }
 
     // Go y * columns + x cells from the start of the array.
     //
-    p_cell = &p_grid->p_grid_array[p_coordinates->y * p_grid->columns
+    p_cell = &p_grid->p_grid_array[p_coordinates->y * MAZE_GRID_COLS(p_grid)
                                    + p_coordinates->x];
 
 end:
     return p_cell;
 }
 
+/**
+ * @brief Gets the index of a cell in the grid array. This is the key used by
+ * index-based search data such as @ref search_context_t.
+ *
+ * @param[in] p_grid Pointer to the maze grid.
+ * @param[in] p_cell Pointer to a cell of the grid.
+ * @return maze_idx_t Index of the cell, row * columns + column.
+ */
+maze_idx_t
+maze_get_cell_idx (const maze_grid_t *p_grid, const maze_grid_cell_t *p_cell)
+{
+    return (maze_idx_t)(p_cell - p_grid->p_grid_array);
+}
+
 /**
  * @brief Get the cell in the specified direction from a specific cell.
  *
@@ -495,25 +674,33 @@ end:
  * @param[in] direction Cardinal direction to get the next cell from.
  *
  * @return maze_grid_cell_t* Pointer to the cell. NULL if the cell is out of
- * bounds.
+ * bounds or the direction is not a cardinal direction.
  */
 maze_grid_cell_t *
 maze_get_cell_in_dir (maze_grid_t              *p_grid,
                       maze_grid_cell_t         *p_from,
                       maze_cardinal_direction_t direction)
 {
-    int32_t row_diff = direction == MAZE_NORTH   ? -1
-                       : direction == MAZE_SOUTH ? 1
-                                                 : 0;
-    int32_t col_diff = direction == MAZE_EAST   ? 1
-                       : direction == MAZE_WEST ? -1
-                                                : 0;
+    static const int8_t row_offsets[4] = { -1, 0, 1, 0 };
+    static const int8_t col_offsets[4] = { 0, 1, 0, -1 };
 
-    maze_point_t coordinates = { p_from->coordinates.x + col_diff,
-                                 p_from->coordinates.y + row_diff };
+    if (MAZE_WEST < direction)
+    {
+        return NULL;
+    }
 
-    maze_grid_cell_t *p_cell = maze_get_cell_at_coords(p_grid, &coordinates);
-    return p_cell;
+    // Moving off the top or left edge wraps around to a large value, so one
+    // comparison per axis checks both edges.
+    //
+    uint16_t row = p_from->coordinates.y + row_offsets[direction];
+    uint16_t col = p_from->coordinates.x + col_offsets[direction];
+
+    if (MAZE_GRID_ROWS(p_grid) <= row || MAZE_GRID_COLS(p_grid) <= col)
+    {
+        return NULL;
+    }
+
+    return &p_grid->p_grid_array[(size_t)row * MAZE_GRID_COLS(p_grid) + col];
 }
 
 /**
@@ -559,53 +746,6 @@ maze_get_relative_dir (const maze_cardinal_direction_t direction_from,
 // ----------------------------------------------------------------------------
 //
 
-/**
- * @brief Get the cell in the cardinal direction from the current cell.
- *
- * @param[in] p_grid Pointer to the maze grid.
- * @param[in] p_current Pointer to the current cell.
- * @param[in] direction Cardinal direction to get the next cell from.
- *
- * @return maze_grid_cell_t* Pointer to the cell in the direction from the
- * current cell.
- */
-static maze_grid_cell_t *
-maze_get_cell_in_dir_from (maze_grid_t              *p_grid,
-                           maze_grid_cell_t         *p_current,
-                           maze_cardinal_direction_t direction)
-{
-    int8_t row_offset = 0;
-    int8_t col_offset = 0;
-
-    switch (direction)
-    {
-        case MAZE_NORTH:
-            row_offset = -1;
-            break;
-        case MAZE_EAST:
-            col_offset = 1;
-            break;
-        case MAZE_SOUTH:
-            row_offset = 1;
-            break;
-        case MAZE_WEST:
-            col_offset = -1;
-            break;
-        default:
-            break;
-    }
-
-    uint16_t row = p_current->coordinates.y + row_offset;
-    uint16_t col = p_current->coordinates.x + col_offset;
-
-    if (p_grid->rows <= row || p_grid->columns <= col)
-    {
-        return NULL;
-    }
-
-    return &p_grid->p_grid_array[row * p_grid->columns + col];
-}
-
 /**
  * @brief Serialises the maze into a uint8_t buffer.
  *
@@ -620,14 +760,14 @@ maze_get_cell_in_dir_from (maze_grid_t              *p_grid,
 int16_t
 maze_serialised_to_buffer (const maze_gap_bitmask_t *p_bitmask,
                            uint8_t                  *p_buffer,
-                           uint16_t                  buffer_size)
+                           size_t                    buffer_size)
 {
     // Check that the buffer is large enough.
     //
-    uint16_t num_compressed = (p_bitmask->rows * p_bitmask->columns) / 2
-                              + (p_bitmask->rows * p_bitmask->columns) % 2;
+    size_t num_cells      = (size_t)p_bitmask->rows * p_bitmask->columns;
+    size_t num_compressed = num_cells / 2 + num_cells % 2;
 
-    uint16_t header_size = 4; // 2 x uint8_t for rows and columns.
+    size_t header_size = 4; // 2 x uint8_t for rows and columns.
 
     if (buffer_size < num_compressed + header_size)
     {
@@ -651,7 +791,7 @@ maze_serialised_to_buffer (const maze_gap_bitmask_t *p_bitmask,
         p_buffer[idx + header_size] = p_compressed[idx].bits;
     }
 
-    free(p_compressed); // Free the compressed array. Prevents memory leak.
+    maze_free(p_compressed); // Free the compressed array. Prevents memory leak.
 
     return 0; // Success.
 }
@@ -673,12 +813,12 @@ maze_serialised_to_buffer (const maze_gap_bitmask_t *p_bitmask,
 int16_t
 maze_nav_to_buffer (const maze_navigator_state_t *p_navigator,
                     uint8_t                      *p_buffer,
-                    uint16_t                      buffer_size)
+                    size_t                        buffer_size)
 {
     // Puts the navigator's coordinates, orientation, current node, start node,
     // end node coordinates in that order.
     //
-    const uint16_t header_size
+    const size_t header_size
         = 13u; // 2 x uint16_t for coordinates, 1 x uint8_t for orientation, 4 x
                // uint16_t for start and end node coordinates. Value in bytes.
 
@@ -742,7 +882,7 @@ set_wall_helper (maze_grid_t      *p_grid,
 {
     p_current_node->p_next[cardinal_direction] = NULL;
     maze_grid_cell_t *p_next_node
-        = maze_get_cell_in_dir_from(p_grid, p_current_node, cardinal_direction);
+        = maze_get_cell_in_dir(p_grid, p_current_node, cardinal_direction);
 
     // Sanity check to ensure that the next node is not NULL.
     if (NULL != p_next_node)
@@ -765,7 +905,7 @@ unset_wall_helper (maze_grid_t      *p_grid,
                    uint8_t           cardinal_direction)
 {
     maze_grid_cell_t *p_next_node
-        = maze_get_cell_in_dir_from(p_grid, p_current_node, cardinal_direction);
+        = maze_get_cell_in_dir(p_grid, p_current_node, cardinal_direction);
 
     // Sanity check to ensure that the next node is not NULL.
     if (NULL != p_next_node)
@@ -775,59 +915,18 @@ unset_wall_helper (maze_grid_t      *p_grid,
     }
 }
 
-/**
- * @brief Draws the north and west walls of the cell.
- *
- * @param[in] p_cell Pointer to the cell.
- * @param[in,out] p_maze_string Pointer to the maze string being drawn.
- * @param[in] relative_row Relative row of the cell to the string row.
- *
- */
-static void
-draw_cell (const maze_grid_cell_t *p_cell,
-           char                   *p_maze_string,
-           uint16_t                relative_row)
-{
-    switch (relative_row)
-    {
-        case 0:
-            // Draw the North wall.
-            //
-            if (NULL == p_cell->p_next[MAZE_NORTH])
-            {
-                strcat(p_maze_string, "+---");
-            }
-            else
-            {
-                strcat(p_maze_string, "+   ");
-            }
-            break;
-        case 1:
-            // Draw the West wall.
-            //
-            if (NULL == p_cell->p_next[MAZE_WEST])
-            {
-                strcat(p_maze_string, "|   ");
-            }
-            else
-            {
-                strcat(p_maze_string, "    ");
-            }
-            break;
-        default:
-            break;
-    }
-}
-
 static maze_bitmask_compressed_t *
 serialised_to_compressed (const maze_gap_bitmask_t *p_bitmask)
 {
-    uint8_t                    num_cells = p_bitmask->rows * p_bitmask->columns;
-    maze_bitmask_compressed_t *p_compressed
-        = malloc(sizeof(maze_bitmask_compressed_t) * num_cells);
-    memset(p_compressed, 0, sizeof(maze_bitmask_compressed_t) * num_cells);
+    size_t num_cells      = (size_t)p_bitmask->rows * p_bitmask->columns;
+    size_t num_compressed = num_cells / 2 + num_cells % 2;
 
-    uint16_t num_compressed = num_cells / 2 + num_cells % 2;
+    // Two cells are packed into each compressed byte.
+    //
+    maze_bitmask_compressed_t *p_compressed
+        = maze_malloc(sizeof(maze_bitmask_compressed_t) * num_compressed);
+    memset(
+        p_compressed, 0, sizeof(maze_bitmask_compressed_t) * num_compressed);
 
     for (size_t cell = 0; num_compressed > cell; cell++)
     {
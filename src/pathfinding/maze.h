@@ -11,6 +11,7 @@
 
 #ifndef MAZE_H // Include guard.
 #define MAZE_H
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -25,10 +26,126 @@
  */
 #define MAZE_INVERT_BITMASK(x) ((0xFu - x) & 0xFu)
 
+/**
+ * @def MAZE_IDX_WIDTH
+ * @brief Width in bits of cell indices, cell counts and heap positions. Either
+ * 16 (default, for the Pico) or 32 (large simulation maps on the host).
+ */
+#ifndef MAZE_IDX_WIDTH
+#define MAZE_IDX_WIDTH 16
+#endif
+
+/**
+ * @def MAZE_PRIORITY_WIDTH
+ * @brief Width in bits of priority queue priorities. Defaults to
+ * @ref MAZE_IDX_WIDTH as F-values are bounded by twice the number of cells.
+ */
+#ifndef MAZE_PRIORITY_WIDTH
+#define MAZE_PRIORITY_WIDTH MAZE_IDX_WIDTH
+#endif
+
+#if 32 == MAZE_IDX_WIDTH
+#define MAZE_IDX_MAX UINT32_MAX
+#elif 16 == MAZE_IDX_WIDTH
+#define MAZE_IDX_MAX UINT16_MAX
+#else
+#error "MAZE_IDX_WIDTH must be 16 or 32."
+#endif
+
+#if 32 == MAZE_PRIORITY_WIDTH
+#define MAZE_PRIORITY_MAX UINT32_MAX
+#elif 16 == MAZE_PRIORITY_WIDTH
+#define MAZE_PRIORITY_MAX UINT16_MAX
+#else
+#error "MAZE_PRIORITY_WIDTH must be 16 or 32."
+#endif
+
+/**
+ * @def MAZE_STATIC_ROWS
+ * @brief Number of rows of the course in the fixed-size build. Define it with
+ * @ref MAZE_STATIC_COLS to give grids, strides and scratch buffers
+ * compile-time sizes, e.g. -DMAZE_STATIC_ROWS=6 -DMAZE_STATIC_COLS=4.
+ *
+ * @def MAZE_STATIC_COLS
+ * @brief Number of columns of the course in the fixed-size build.
+ */
+#if defined(MAZE_STATIC_ROWS) != defined(MAZE_STATIC_COLS)
+#error "MAZE_STATIC_ROWS and MAZE_STATIC_COLS must be defined together."
+#endif
+
+#ifdef MAZE_STATIC_ROWS
+/**
+ * @def MAZE_STATIC_CELLS
+ * @brief Number of cells of the course in the fixed-size build.
+ */
+#define MAZE_STATIC_CELLS (MAZE_STATIC_ROWS * MAZE_STATIC_COLS)
+
+/**
+ * @def MAZE_STATIC_GRIDS
+ * @brief Number of grid mazes that can exist at once in the fixed-size build,
+ * e.g. the map and the true maze in a simulation.
+ */
+#ifndef MAZE_STATIC_GRIDS
+#define MAZE_STATIC_GRIDS 2
+#endif
+
+/**
+ * @def MAZE_GRID_ROWS(p_grid)
+ * @brief Number of rows of a grid maze. This is a constant in the fixed-size
+ * build so that the compiler can fold the index arithmetic.
+ */
+#define MAZE_GRID_ROWS(p_grid) ((void)(p_grid), (uint16_t)MAZE_STATIC_ROWS)
+
+/**
+ * @def MAZE_GRID_COLS(p_grid)
+ * @brief Number of columns, and so the row stride, of a grid maze.
+ */
+#define MAZE_GRID_COLS(p_grid) ((void)(p_grid), (uint16_t)MAZE_STATIC_COLS)
+#else
+#define MAZE_GRID_ROWS(p_grid) ((p_grid)->rows)
+#define MAZE_GRID_COLS(p_grid) ((p_grid)->columns)
+#endif
+
+/**
+ * @def MAZE_GRID_CELLS(p_grid)
+ * @brief Number of cells of a grid maze.
+ */
+#define MAZE_GRID_CELLS(p_grid) \
+    ((size_t)MAZE_GRID_ROWS(p_grid) * MAZE_GRID_COLS(p_grid))
+
+/**
+ * @def MAZE_CELL_COST_MAX
+ * @brief Highest cost of entering a cell. Entering a cell costs at least 1, so
+ * the Manhattan distance stays a lower bound, and at most this, so that the
+ * F-values in the open set of A* span fewer values than the bucket queue has
+ * buckets.
+ */
+#define MAZE_CELL_COST_MAX 254u
+
+/**
+ * @def MAZE_CELL_COST(p_grid, cell_idx)
+ * @brief Cost of entering a cell of a grid maze. Grids without a cost table
+ * cost 1 per cell, which the searches test for before reading the table.
+ */
+#define MAZE_CELL_COST(p_grid, cell_idx) \
+    ((NULL == (p_grid)->p_costs) ? 1u : (uint32_t)(p_grid)->p_costs[cell_idx])
+
 // Type definitions.
 // ----------------------------------------------------------------------------
 //
 
+#if 32 == MAZE_IDX_WIDTH
+typedef uint32_t maze_idx_t; ///< Cell index, cell count or heap position.
+#else
+typedef uint16_t maze_idx_t; ///< Cell index, cell count or heap position.
+#endif
+
+#if 32 == MAZE_PRIORITY_WIDTH
+typedef uint32_t maze_priority_t; ///< Priority of a node in a queue.
+#else
+typedef uint16_t maze_priority_t; ///< Priority of a node in a queue.
+#endif
+
 /**
  * @brief This struct contains the coordinates of a point.
  *
@@ -102,6 +219,8 @@ typedef struct maze_grid_cell
         *p_came_from; ///< Pointer to the node that the current
                       ///< node came from for the A* algorithm.
     bool is_visited;  ///< Indicates if the node has been visited before.
+    uint32_t epoch;   ///< Search epoch in which the F, G and H values were
+                      ///< last written. @see maze_stamp_cell
 } maze_grid_cell_t;
 
 /**
@@ -115,6 +234,11 @@ typedef struct maze_grid
                                     ///< of the grid array.
     uint16_t rows;                  ///< Number of rows in the grid.
     uint16_t columns;               ///< Number of columns in the grid.
+    uint32_t epoch; ///< Current search epoch. Cells stamped with an older epoch
+                    ///< have F, G and H values of UINT32_MAX.
+    uint8_t *p_costs;  ///< Cost of entering each cell, or NULL when every cell
+                       ///< costs 1. @see maze_set_cell_cost
+    uint8_t  max_cost; ///< No cell costs more than this.
 } maze_grid_t;
 
 /**
@@ -164,8 +288,21 @@ void maze_initialise_empty_walled(maze_grid_t *p_grid);
 
 void maze_clear_heuristics(maze_grid_t *p_grid);
 
+void maze_new_epoch(maze_grid_t *p_grid);
+
+void maze_stamp_cell(const maze_grid_t *p_grid, maze_grid_cell_t *p_cell);
+
 void maze_destroy(maze_grid_t *p_grid);
 
+bool maze_set_cell_cost(maze_grid_t            *p_grid,
+                        const maze_grid_cell_t *p_cell,
+                        uint8_t                 cost);
+
+uint8_t maze_get_cell_cost(const maze_grid_t      *p_grid,
+                           const maze_grid_cell_t *p_cell);
+
+void maze_clear_cell_costs(maze_grid_t *p_grid);
+
 int8_t maze_get_nav_dir_offset(const maze_navigator_state_t *p_navigator);
 
 void maze_nav_modify_walls(maze_grid_t            *p_grid,
@@ -191,6 +328,9 @@ maze_gap_bitmask_t maze_serialise(maze_grid_t *p_grid);
 maze_grid_cell_t *maze_get_cell_at_coords(maze_grid_t        *p_grid,
                                           const maze_point_t *p_coordinates);
 
+maze_idx_t maze_get_cell_idx(const maze_grid_t      *p_grid,
+                             const maze_grid_cell_t *p_cell);
+
 maze_grid_cell_t *maze_get_cell_in_dir(maze_grid_t              *p_grid,
                                        maze_grid_cell_t         *p_from,
                                        maze_cardinal_direction_t direction);
@@ -200,11 +340,11 @@ uint32_t maze_manhattan_dist(const maze_point_t *p_point_a,
 
 int16_t maze_serialised_to_buffer(const maze_gap_bitmask_t *p_bitmask,
                                   uint8_t                  *p_buffer,
-                                  uint16_t                  buffer_size);
+                                  size_t                    buffer_size);
 
 int16_t maze_nav_to_buffer(const maze_navigator_state_t *p_navigator,
                            uint8_t                      *p_buffer,
-                           uint16_t                      buffer_size);
+                           size_t                        buffer_size);
 
 void maze_uint16_to_uint8_buffer(uint16_t value, uint8_t *p_buffer);
 
@@ -0,0 +1,301 @@
+/**
+ * @file maze_allocator.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the pluggable allocator of the pathfinding library.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding/maze_allocator.h"
+
+#ifdef MAZE_STATIC_ROWS
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_arena.h"
+#include "pathfinding/open_set.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_STATIC_WORKSPACE_SIZE
+ * @brief Size of the static workspace that every allocation of the library
+ * comes from in the fixed-size build. The default fits a search context, a
+ * path, a serialised maze and a rendered map of the course at once.
+ */
+#ifndef MAZE_STATIC_WORKSPACE_SIZE
+#define MAZE_STATIC_WORKSPACE_SIZE                                     \
+    (MAZE_STATIC_CELLS                                                 \
+         * (sizeof(uint32_t) * 4u + sizeof(maze_idx_t)                 \
+            + OPEN_SET_BYTES_PER_CELL + sizeof(maze_grid_cell_t)       \
+            + sizeof(uint16_t))                                        \
+     + (MAZE_STATIC_COLS * 4u + 2u) * (MAZE_STATIC_ROWS * 2u + 1u)     \
+     + OPEN_SET_FIXED_BYTES + 1024u)
+#endif
+
+/**
+ * @def DEFAULT_ALLOCATOR
+ * @brief Initialiser of the default allocator, which is the static arena in
+ * the fixed-size build.
+ */
+#define DEFAULT_ALLOCATOR                   \
+    {                                       \
+        .p_alloc   = maze_arena_alloc,      \
+        .p_realloc = maze_arena_realloc,    \
+        .p_free    = maze_arena_free,       \
+        .p_state   = &g_static_arena,       \
+    }
+#else
+/**
+ * @def DEFAULT_ALLOCATOR
+ * @brief Initialiser of the default allocator, which is the C heap.
+ */
+#define DEFAULT_ALLOCATOR             \
+    {                                 \
+        .p_alloc   = heap_alloc,      \
+        .p_realloc = heap_realloc,    \
+        .p_free    = heap_free,       \
+        .p_state   = NULL,            \
+    }
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void *heap_alloc(void *p_state, size_t size);
+static void *heap_realloc(void *p_state, void *p_block, size_t size);
+static void  heap_free(void *p_state, void *p_block);
+#endif
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+#ifdef MAZE_STATIC_ROWS
+/**
+ * @brief Static workspace of the fixed-size build, aligned for any block.
+ */
+static union
+{
+    uint8_t     bytes[MAZE_STATIC_WORKSPACE_SIZE];
+    uint64_t    align_int;
+    long double align_float;
+    void       *p_align;
+} g_workspace;
+
+/**
+ * @brief Arena over the static workspace.
+ */
+static maze_arena_t g_static_arena = {
+    .p_buffer      = g_workspace.bytes,
+    .capacity      = MAZE_STATIC_WORKSPACE_SIZE,
+    .used          = 0,
+    .peak          = 0,
+    .top           = MAZE_ARENA_NO_BLOCK,
+    .num_allocs    = 0,
+    .num_fallbacks = 0,
+};
+#endif
+
+/**
+ * @brief Allocator used by every allocation of the library.
+ *
+ * @warning Setting the allocator is not thread-safe. It should be set before
+ * a mapping run or planning query starts and restored after it ends.
+ */
+static maze_allocator_t g_allocator = DEFAULT_ALLOCATOR;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Gets the default allocator of the library.
+ *
+ * @return maze_allocator_t The heap allocator, or the allocator of the static
+ * arena in the fixed-size build.
+ */
+maze_allocator_t
+maze_allocator_get_default (void)
+{
+    maze_allocator_t allocator = DEFAULT_ALLOCATOR;
+
+    return allocator;
+}
+
+#ifdef MAZE_STATIC_ROWS
+/**
+ * @brief Gets the arena over the static workspace of the fixed-size build,
+ * e.g. to read its peak.
+ *
+ * @return struct maze_arena* Pointer to the static arena.
+ */
+struct maze_arena *
+maze_allocator_get_static_arena (void)
+{
+    return &g_static_arena;
+}
+#else
+/**
+ * @brief Gets the allocator that uses the C heap.
+ *
+ * @return maze_allocator_t Heap allocator.
+ */
+maze_allocator_t
+maze_allocator_get_heap (void)
+{
+    return maze_allocator_get_default();
+}
+#endif
+
+/**
+ * @brief Sets the allocator used by the library.
+ *
+ * @param[in] p_allocator Pointer to the new allocator. If NULL, the default
+ * allocator is used.
+ * @return maze_allocator_t Previous allocator, so that it can be restored.
+ *
+ * @warning Blocks must be freed by the allocator that allocated them, so
+ * everything allocated under an allocator should be freed before it is
+ * replaced.
+ */
+maze_allocator_t
+maze_allocator_set (const maze_allocator_t *p_allocator)
+{
+    maze_allocator_t previous = g_allocator;
+
+    if (NULL == p_allocator)
+    {
+        g_allocator = maze_allocator_get_default();
+    }
+    else
+    {
+        g_allocator = *p_allocator;
+    }
+
+    return previous;
+}
+
+/**
+ * @brief Allocates a block with the current allocator.
+ *
+ * @param[in] size Size of the block in bytes.
+ * @return void* Pointer to the block, or NULL if it could not be allocated.
+ */
+void *
+maze_malloc (size_t size)
+{
+    return g_allocator.p_alloc(g_allocator.p_state, size);
+}
+
+/**
+ * @brief Allocates a zeroed array with the current allocator.
+ *
+ * @param[in] num_elements Number of elements in the array.
+ * @param[in] element_size Size of each element in bytes.
+ * @return void* Pointer to the array, or NULL if it could not be allocated.
+ */
+void *
+maze_calloc (size_t num_elements, size_t element_size)
+{
+    if (0 != element_size && SIZE_MAX / element_size < num_elements)
+    {
+        return NULL;
+    }
+
+    size_t size    = num_elements * element_size;
+    void  *p_block = maze_malloc(size);
+
+    if (NULL != p_block)
+    {
+        memset(p_block, 0, size);
+    }
+
+    return p_block;
+}
+
+/**
+ * @brief Resizes a block with the current allocator.
+ *
+ * @param[in] p_block Pointer to the block, or NULL to allocate a new block.
+ * @param[in] size New size of the block in bytes.
+ * @return void* Pointer to the resized block, or NULL if it could not be
+ * resized. The old block is still valid if NULL is returned.
+ */
+void *
+maze_realloc (void *p_block, size_t size)
+{
+    return g_allocator.p_realloc(g_allocator.p_state, p_block, size);
+}
+
+/**
+ * @brief Frees a block with the current allocator. Every array returned by the
+ * library must be freed by this function.
+ *
+ * @param[in] p_block Pointer to the block. Nothing is done if it is NULL.
+ */
+void
+maze_free (void *p_block)
+{
+    if (NULL != p_block)
+    {
+        g_allocator.p_free(g_allocator.p_state, p_block);
+    }
+}
+
+#ifndef MAZE_STATIC_ROWS
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Allocates a block from the C heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] size Size of the block in bytes.
+ * @return void* Pointer to the block.
+ */
+static void *
+heap_alloc (void *p_state, size_t size)
+{
+    (void)p_state;
+    return malloc(size);
+}
+
+/**
+ * @brief Resizes a block from the C heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] p_block Pointer to the block.
+ * @param[in] size New size of the block in bytes.
+ * @return void* Pointer to the resized block.
+ */
+static void *
+heap_realloc (void *p_state, void *p_block, size_t size)
+{
+    (void)p_state;
+    return realloc(p_block, size);
+}
+
+/**
+ * @brief Frees a block from the C heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] p_block Pointer to the block.
+ */
+static void
+heap_free (void *p_state, void *p_block)
+{
+    (void)p_state;
+    free(p_block);
+}
+#endif
+
+// End of pathfinding/maze_allocator.c
@@ -0,0 +1,64 @@
+/**
+ * @file maze_allocator.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the pluggable allocator of the pathfinding library.
+ * Every allocation made by the library goes through the current allocator,
+ * which is the C heap unless another allocator, such as an arena, is set. In
+ * the fixed-size build the default is an arena over a static workspace, so
+ * the library never calls the heap.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_ALLOCATOR_H // Include guard.
+#define MAZE_ALLOCATOR_H
+
+#include <stddef.h>
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the functions of an allocator and the state
+ * passed to them. The functions have the same semantics as malloc, realloc and
+ * free.
+ */
+typedef struct maze_allocator
+{
+    void *(*p_alloc)(void *p_state, size_t size); ///< Allocates a block.
+    void *(*p_realloc)(void  *p_state,
+                       void  *p_block,
+                       size_t size); ///< Resizes a block.
+    void (*p_free)(void *p_state, void *p_block); ///< Frees a block.
+    void *p_state; ///< State of the allocator, e.g. an arena.
+} maze_allocator_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+maze_allocator_t maze_allocator_get_default(void);
+
+#ifdef MAZE_STATIC_ROWS
+struct maze_arena *maze_allocator_get_static_arena(void);
+#else
+maze_allocator_t maze_allocator_get_heap(void);
+#endif
+
+maze_allocator_t maze_allocator_set(const maze_allocator_t *p_allocator);
+
+void *maze_malloc(size_t size);
+
+void *maze_calloc(size_t num_elements, size_t element_size);
+
+void *maze_realloc(void *p_block, size_t size);
+
+void maze_free(void *p_block);
+
+#endif // MAZE_ALLOCATOR_H
+
+// End of pathfinding/maze_allocator.h
@@ -0,0 +1,302 @@
+/**
+ * @file maze_arena.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the arena allocator. Each block is preceded by a
+ * header holding its size and the offset of the block below it, so that freed
+ * blocks at the top of the arena can be given back.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_arena.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def ALIGN_UP
+ * @brief Rounds a size up to a multiple of @ref MAZE_ARENA_ALIGNMENT.
+ */
+#define ALIGN_UP(size) \
+    (((size) + MAZE_ARENA_ALIGNMENT - 1u) \
+     & ~(size_t)(MAZE_ARENA_ALIGNMENT - 1u))
+
+/**
+ * @def BLOCK_FREED
+ * @brief Bit of the block size set if the block has been freed. The size is
+ * always aligned, so the bit is otherwise unused.
+ */
+#define BLOCK_FREED 1u
+
+/**
+ * @brief This struct contains the header in front of every block.
+ */
+typedef struct arena_header
+{
+    size_t size; ///< Aligned size of the block, ORed with BLOCK_FREED.
+    size_t prev; ///< Offset of the header of the block below.
+} arena_header_t;
+
+/**
+ * @def HEADER_SIZE
+ * @brief Size of a block header, rounded up to keep blocks aligned.
+ */
+#define HEADER_SIZE ALIGN_UP(sizeof(arena_header_t))
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static bool is_in_arena(const maze_arena_t *p_arena, const void *p_block);
+static arena_header_t *get_header(maze_arena_t *p_arena, size_t offset);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Initialises an arena over a caller-owned buffer.
+ *
+ * @param[out] p_arena Pointer to the arena.
+ * @param[in] p_buffer Pointer to the buffer. It may be unaligned.
+ * @param[in] size Size of the buffer in bytes.
+ *
+ * @note The buffer must outlive every block allocated from the arena.
+ */
+void
+maze_arena_init (maze_arena_t *p_arena, void *p_buffer, size_t size)
+{
+    uintptr_t start   = (uintptr_t)p_buffer;
+    size_t    padding = ALIGN_UP(start) - start;
+
+    if (NULL == p_buffer || size < padding)
+    {
+        padding = 0;
+        size    = 0;
+    }
+
+    p_arena->p_buffer      = (uint8_t *)p_buffer + padding;
+    p_arena->capacity      = size - padding;
+    p_arena->peak          = 0;
+    p_arena->num_allocs    = 0;
+    p_arena->num_fallbacks = 0;
+    maze_arena_reset(p_arena);
+}
+
+/**
+ * @brief Frees every block in the arena at once. The statistics are kept, so
+ * the peak covers every run since the arena was initialised.
+ *
+ * @param[in,out] p_arena Pointer to the arena.
+ *
+ * @warning Blocks that fell back to the heap are not freed by this function.
+ */
+void
+maze_arena_reset (maze_arena_t *p_arena)
+{
+    p_arena->used = 0;
+    p_arena->top  = MAZE_ARENA_NO_BLOCK;
+}
+
+/**
+ * @brief Gets an allocator that allocates from the arena, to be passed to
+ * @ref maze_allocator_set.
+ *
+ * @param[in] p_arena Pointer to the arena.
+ * @return maze_allocator_t Allocator of the arena.
+ */
+maze_allocator_t
+maze_arena_get_allocator (maze_arena_t *p_arena)
+{
+    maze_allocator_t allocator = {
+        .p_alloc   = maze_arena_alloc,
+        .p_realloc = maze_arena_realloc,
+        .p_free    = maze_arena_free,
+        .p_state   = p_arena,
+    };
+
+    return allocator;
+}
+
+/**
+ * @brief Allocates a block from the top of the arena, or from the heap if the
+ * arena is full.
+ *
+ * @param[in,out] p_state Pointer to the arena.
+ * @param[in] size Size of the block in bytes.
+ * @return void* Pointer to the block.
+ *
+ * @note In the fixed-size build there is no heap, so NULL is returned if the
+ * arena is full. It is still counted in num_fallbacks.
+ */
+void *
+maze_arena_alloc (void *p_state, size_t size)
+{
+    maze_arena_t *p_arena = p_state;
+    size_t        aligned = ALIGN_UP(size);
+
+    if (aligned < size
+        || p_arena->capacity - p_arena->used < HEADER_SIZE
+        || p_arena->capacity - p_arena->used - HEADER_SIZE < aligned)
+    {
+        p_arena->num_fallbacks++;
+#ifdef MAZE_STATIC_ROWS
+        return NULL;
+#else
+        return malloc(size);
+#endif
+    }
+
+    arena_header_t *p_header = get_header(p_arena, p_arena->used);
+    p_header->size           = aligned;
+    p_header->prev           = p_arena->top;
+
+    p_arena->top = p_arena->used;
+    p_arena->used += HEADER_SIZE + aligned;
+    p_arena->num_allocs++;
+
+    if (p_arena->used > p_arena->peak)
+    {
+        p_arena->peak = p_arena->used;
+    }
+
+    return (uint8_t *)p_header + HEADER_SIZE;
+}
+
+/**
+ * @brief Resizes a block. The top block is grown or shrunk in place.
+ *
+ * @param[in,out] p_state Pointer to the arena.
+ * @param[in] p_block Pointer to the block.
+ * @param[in] size New size of the block in bytes.
+ * @return void* Pointer to the resized block.
+ */
+void *
+maze_arena_realloc (void *p_state, void *p_block, size_t size)
+{
+    maze_arena_t *p_arena = p_state;
+
+    if (NULL == p_block)
+    {
+        return maze_arena_alloc(p_arena, size);
+    }
+
+    if (!is_in_arena(p_arena, p_block))
+    {
+#ifdef MAZE_STATIC_ROWS
+        return NULL;
+#else
+        return realloc(p_block, size);
+#endif
+    }
+
+    size_t          offset   = (size_t)((uint8_t *)p_block - p_arena->p_buffer);
+    arena_header_t *p_header = get_header(p_arena, offset - HEADER_SIZE);
+    size_t          aligned  = ALIGN_UP(size);
+
+    // Step 1: Resize the top block in place if it fits.
+    //
+    if (p_arena->top == offset - HEADER_SIZE && aligned >= size
+        && p_arena->capacity - offset >= aligned)
+    {
+        p_header->size = aligned;
+        p_arena->used  = offset + aligned;
+
+        if (p_arena->used > p_arena->peak)
+        {
+            p_arena->peak = p_arena->used;
+        }
+
+        return p_block;
+    }
+
+    // Step 2: Otherwise, move the block.
+    //
+    void *p_new = maze_arena_alloc(p_arena, size);
+
+    if (NULL != p_new)
+    {
+        size_t old_size = p_header->size;
+        memcpy(p_new, p_block, old_size < size ? old_size : size);
+        maze_arena_free(p_arena, p_block);
+    }
+
+    return p_new;
+}
+
+/**
+ * @brief Frees a block. If it is the top block, its space and the space of
+ * any freed blocks below it is given back.
+ *
+ * @param[in,out] p_state Pointer to the arena.
+ * @param[in] p_block Pointer to the block.
+ */
+void
+maze_arena_free (void *p_state, void *p_block)
+{
+    maze_arena_t *p_arena = p_state;
+
+    if (!is_in_arena(p_arena, p_block))
+    {
+#ifndef MAZE_STATIC_ROWS
+        free(p_block);
+#endif
+        return;
+    }
+
+    size_t offset = (size_t)((uint8_t *)p_block - p_arena->p_buffer);
+    get_header(p_arena, offset - HEADER_SIZE)->size |= BLOCK_FREED;
+
+    while (MAZE_ARENA_NO_BLOCK != p_arena->top
+           && 0 != (get_header(p_arena, p_arena->top)->size & BLOCK_FREED))
+    {
+        p_arena->used = p_arena->top;
+        p_arena->top  = get_header(p_arena, p_arena->top)->prev;
+    }
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Checks if a block was allocated from the arena buffer.
+ *
+ * @param[in] p_arena Pointer to the arena.
+ * @param[in] p_block Pointer to the block.
+ * @return true If the block is in the buffer.
+ * @return false If the block is from the heap.
+ */
+static bool
+is_in_arena (const maze_arena_t *p_arena, const void *p_block)
+{
+    uintptr_t address = (uintptr_t)p_block;
+    uintptr_t start   = (uintptr_t)p_arena->p_buffer;
+
+    return start <= address && start + p_arena->capacity > address;
+}
+
+/**
+ * @brief Gets the block header at an offset of the arena buffer.
+ *
+ * @param[in] p_arena Pointer to the arena.
+ * @param[in] offset Offset of the header in bytes.
+ * @return arena_header_t* Pointer to the header.
+ */
+static arena_header_t *
+get_header (maze_arena_t *p_arena, size_t offset)
+{
+    return (arena_header_t *)(void *)(p_arena->p_buffer + offset);
+}
+
+// End of pathfinding/maze_arena.c
@@ -0,0 +1,80 @@
+/**
+ * @file maze_arena.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the arena allocator. An arena hands out blocks from
+ * one pre-reserved workspace, so a whole mapping run or planning query can be
+ * done without calling the heap.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_ARENA_H // Include guard.
+#define MAZE_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pathfinding/maze_allocator.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_ARENA_ALIGNMENT
+ * @brief Alignment of every block in the arena in bytes.
+ */
+#define MAZE_ARENA_ALIGNMENT 8u
+
+/**
+ * @def MAZE_ARENA_NO_BLOCK
+ * @brief Offset of the top block when the arena is empty.
+ */
+#define MAZE_ARENA_NO_BLOCK SIZE_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains a bump allocator over a caller-owned buffer.
+ *
+ * @note Blocks are freed in LIFO order: freeing the top block gives its space
+ * back, along with any blocks below it that were already freed. Other blocks
+ * are only marked as freed. If the buffer is full, blocks are taken from the
+ * heap instead and counted in num_fallbacks. The allocation functions are
+ * public so that an arena can be the default allocator, @see
+ * maze_allocator_set.
+ */
+typedef struct maze_arena
+{
+    uint8_t *p_buffer;      ///< Aligned start of the workspace.
+    size_t   capacity;      ///< Usable size of the workspace in bytes.
+    size_t   used;          ///< Number of bytes in use, including headers.
+    size_t   peak;          ///< Largest number of bytes ever in use.
+    size_t   top;           ///< Offset of the header of the top block.
+    size_t   num_allocs;    ///< Number of blocks allocated from the buffer.
+    size_t   num_fallbacks; ///< Number of blocks allocated from the heap.
+} maze_arena_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+void maze_arena_init(maze_arena_t *p_arena, void *p_buffer, size_t size);
+
+void maze_arena_reset(maze_arena_t *p_arena);
+
+maze_allocator_t maze_arena_get_allocator(maze_arena_t *p_arena);
+
+void *maze_arena_alloc(void *p_state, size_t size);
+
+void *maze_arena_realloc(void *p_state, void *p_block, size_t size);
+
+void maze_arena_free(void *p_state, void *p_block);
+
+#endif // MAZE_ARENA_H
+
+// End of pathfinding/maze_arena.h
@@ -0,0 +1,843 @@
+/**
+ * @file maze_chunked.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Contains the implementation of the growable chunked maze backend.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @par A chunk of 8x8 cells takes 76 bytes with 16-bit indices, so a course
+ * only pays for the chunks the navigator has entered or sensed instead of its
+ * bounding box. Each chunk keeps the slots of its neighbours, so moving across
+ * a chunk border does not need a hash table lookup.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_chunked.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def CHUNK_BIAS
+ * @brief Bias added to cell coordinates so that they are never negative.
+ */
+#define CHUNK_BIAS 32768
+
+/**
+ * @def CHUNK_MAX_COORD
+ * @brief Largest biased chunk coordinate.
+ */
+#define CHUNK_MAX_COORD (UINT16_MAX >> MAZE_CHUNK_SHIFT)
+
+/**
+ * @def INITIAL_CHUNK_CAPACITY
+ * @brief Number of chunks allocated when the maze is created.
+ */
+#define INITIAL_CHUNK_CAPACITY 4u
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_idx_t find_chunk(const maze_chunked_t *p_maze,
+                             uint16_t              chunk_x,
+                             uint16_t              chunk_y);
+
+static maze_idx_t add_chunk(maze_chunked_t *p_maze,
+                            uint16_t        chunk_x,
+                            uint16_t        chunk_y);
+
+static bool grow_lookup(maze_chunked_t *p_maze);
+
+static maze_idx_t get_lookup_pos(uint16_t   chunk_x,
+                                 uint16_t   chunk_y,
+                                 maze_idx_t lookup_capacity);
+
+static bool get_chunk_in_dir(uint16_t                  chunk_x,
+                             uint16_t                  chunk_y,
+                             maze_cardinal_direction_t direction,
+                             uint16_t                 *p_next_x,
+                             uint16_t                 *p_next_y);
+
+static uint8_t *get_cell(const maze_chunked_t *p_maze, maze_idx_t cell_idx);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates an empty chunked maze. The chunk containing the origin, i.e.
+ * the start cell at (0, 0), is allocated with every wall set.
+ *
+ * @return maze_chunked_t Chunked maze.
+ *
+ * @warning The maze must be destroyed by @ref maze_chunked_destroy.
+ */
+maze_chunked_t
+maze_chunked_create (void)
+{
+    maze_chunked_t maze = {
+        .p_chunks = maze_malloc(sizeof(maze_chunk_t) * INITIAL_CHUNK_CAPACITY),
+        .p_lookup = maze_malloc(sizeof(maze_idx_t) * INITIAL_CHUNK_CAPACITY),
+        .num_chunks      = 0,
+        .chunk_capacity  = INITIAL_CHUNK_CAPACITY,
+        .lookup_capacity = INITIAL_CHUNK_CAPACITY,
+    };
+
+    for (maze_idx_t pos = 0; maze.lookup_capacity > pos; pos++)
+    {
+        maze.p_lookup[pos] = MAZE_CHUNKED_NO_CHUNK;
+    }
+
+    maze_chunked_point_t origin = { 0, 0 };
+    maze_chunked_add_cell(&maze, &origin);
+
+    return maze;
+}
+
+/**
+ * @brief Destroys the maze by freeing the memory allocated to the chunks.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ */
+void
+maze_chunked_destroy (maze_chunked_t *p_maze)
+{
+    maze_free(p_maze->p_chunks);
+    maze_free(p_maze->p_lookup);
+
+    p_maze->p_chunks        = NULL;
+    p_maze->p_lookup        = NULL;
+    p_maze->num_chunks      = 0;
+    p_maze->chunk_capacity  = 0;
+    p_maze->lookup_capacity = 0;
+}
+
+/**
+ * @brief Gets the number of bytes allocated for the chunks and the hash table.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @return size_t Number of bytes allocated for the maze.
+ */
+size_t
+maze_chunked_get_size (const maze_chunked_t *p_maze)
+{
+    return sizeof(maze_chunk_t) * p_maze->chunk_capacity
+           + sizeof(maze_idx_t) * p_maze->lookup_capacity;
+}
+
+/**
+ * @brief Gets the number of cells in the allocated chunks. Per-cell arrays used
+ * with chunked cell indices must have this many elements, and must be
+ * reallocated if the maze grows.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @return maze_idx_t Number of cells.
+ */
+maze_idx_t
+maze_chunked_get_num_cells (const maze_chunked_t *p_maze)
+{
+    return p_maze->num_chunks * MAZE_CHUNK_CELLS;
+}
+
+/**
+ * @brief Gets the index of the cell at the specified coordinates.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] p_coordinates Pointer to the coordinates of the cell.
+ * @return maze_idx_t Index of the cell. MAZE_CHUNKED_NO_CELL if its chunk has
+ * not been allocated.
+ */
+maze_idx_t
+maze_chunked_get_idx (const maze_chunked_t       *p_maze,
+                      const maze_chunked_point_t *p_coordinates)
+{
+    uint16_t biased_x = (uint16_t)(p_coordinates->x + CHUNK_BIAS);
+    uint16_t biased_y = (uint16_t)(p_coordinates->y + CHUNK_BIAS);
+
+    maze_idx_t slot = find_chunk(p_maze,
+                                 biased_x >> MAZE_CHUNK_SHIFT,
+                                 biased_y >> MAZE_CHUNK_SHIFT);
+
+    if (MAZE_CHUNKED_NO_CHUNK == slot)
+    {
+        return MAZE_CHUNKED_NO_CELL;
+    }
+
+    return slot * MAZE_CHUNK_CELLS
+           + (biased_y % MAZE_CHUNK_SIZE) * MAZE_CHUNK_SIZE
+           + biased_x % MAZE_CHUNK_SIZE;
+}
+
+/**
+ * @brief Gets the index of the cell at the specified coordinates, allocating
+ * its chunk if needed. Every wall of a new chunk is set.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] p_coordinates Pointer to the coordinates of the cell.
+ * @return maze_idx_t Index of the cell. MAZE_CHUNKED_NO_CELL if the chunk
+ * could not be allocated.
+ */
+maze_idx_t
+maze_chunked_add_cell (maze_chunked_t             *p_maze,
+                       const maze_chunked_point_t *p_coordinates)
+{
+    maze_idx_t cell_idx = maze_chunked_get_idx(p_maze, p_coordinates);
+
+    if (MAZE_CHUNKED_NO_CELL != cell_idx)
+    {
+        return cell_idx;
+    }
+
+    uint16_t biased_x = (uint16_t)(p_coordinates->x + CHUNK_BIAS);
+    uint16_t biased_y = (uint16_t)(p_coordinates->y + CHUNK_BIAS);
+
+    maze_idx_t slot = add_chunk(p_maze,
+                                biased_x >> MAZE_CHUNK_SHIFT,
+                                biased_y >> MAZE_CHUNK_SHIFT);
+
+    if (MAZE_CHUNKED_NO_CHUNK == slot)
+    {
+        return MAZE_CHUNKED_NO_CELL;
+    }
+
+    return slot * MAZE_CHUNK_CELLS
+           + (biased_y % MAZE_CHUNK_SIZE) * MAZE_CHUNK_SIZE
+           + biased_x % MAZE_CHUNK_SIZE;
+}
+
+/**
+ * @brief Gets the coordinates of a cell from its index.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return maze_chunked_point_t Coordinates of the cell.
+ */
+maze_chunked_point_t
+maze_chunked_get_point (const maze_chunked_t *p_maze, maze_idx_t cell_idx)
+{
+    const maze_chunk_t *p_chunk
+        = &p_maze->p_chunks[cell_idx / MAZE_CHUNK_CELLS];
+    maze_idx_t local = cell_idx % MAZE_CHUNK_CELLS;
+
+    int32_t biased_x = (int32_t)p_chunk->chunk_x * MAZE_CHUNK_SIZE
+                       + local % MAZE_CHUNK_SIZE;
+    int32_t biased_y = (int32_t)p_chunk->chunk_y * MAZE_CHUNK_SIZE
+                       + local / MAZE_CHUNK_SIZE;
+
+    maze_chunked_point_t point = { (int16_t)(biased_x - CHUNK_BIAS),
+                                   (int16_t)(biased_y - CHUNK_BIAS) };
+    return point;
+}
+
+/**
+ * @brief Gets the index of the adjacent cell in the specified direction,
+ * regardless of walls.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the adjacent cell.
+ * @return maze_idx_t Index of the adjacent cell. MAZE_CHUNKED_NO_CELL if its
+ * chunk has not been allocated.
+ */
+maze_idx_t
+maze_chunked_get_idx_in_dir (const maze_chunked_t     *p_maze,
+                             maze_idx_t                cell_idx,
+                             maze_cardinal_direction_t direction)
+{
+    static const int8_t row_offsets[4] = { -1, 0, 1, 0 };
+    static const int8_t col_offsets[4] = { 0, 1, 0, -1 };
+
+    if (MAZE_WEST < direction)
+    {
+        return MAZE_CHUNKED_NO_CELL;
+    }
+
+    maze_idx_t slot  = cell_idx / MAZE_CHUNK_CELLS;
+    maze_idx_t local = cell_idx % MAZE_CHUNK_CELLS;
+    int8_t     row   = (int8_t)(local / MAZE_CHUNK_SIZE);
+    int8_t     col   = (int8_t)(local % MAZE_CHUNK_SIZE);
+
+    row += row_offsets[direction];
+    col += col_offsets[direction];
+
+    // Step 1: Stay in the same chunk if possible.
+    //
+    if (0 <= row && MAZE_CHUNK_SIZE > (uint8_t)row && 0 <= col
+        && MAZE_CHUNK_SIZE > (uint8_t)col)
+    {
+        return slot * MAZE_CHUNK_CELLS + row * MAZE_CHUNK_SIZE + col;
+    }
+
+    // Step 2: Otherwise, wrap around into the adjacent chunk.
+    //
+    slot = p_maze->p_chunks[slot].neighbours[direction];
+
+    if (MAZE_CHUNKED_NO_CHUNK == slot)
+    {
+        return MAZE_CHUNKED_NO_CELL;
+    }
+
+    return slot * MAZE_CHUNK_CELLS
+           + (row & (MAZE_CHUNK_SIZE - 1u)) * MAZE_CHUNK_SIZE
+           + (col & (MAZE_CHUNK_SIZE - 1u));
+}
+
+/**
+ * @brief Checks if there is a wall on a side of a cell.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ * @return true There is a wall.
+ * @return false There is a gap.
+ */
+bool
+maze_chunked_is_wall (const maze_chunked_t     *p_maze,
+                      maze_idx_t                cell_idx,
+                      maze_cardinal_direction_t direction)
+{
+    return 0 != ((*get_cell(p_maze, cell_idx) >> direction) & 1u);
+}
+
+/**
+ * @brief Gets the index of the cell that can be moved to in the specified
+ * direction.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction to move in.
+ * @return maze_idx_t Index of the next cell. MAZE_CHUNKED_NO_CELL if there is
+ * a wall in the way.
+ */
+maze_idx_t
+maze_chunked_get_next_idx (const maze_chunked_t     *p_maze,
+                           maze_idx_t                cell_idx,
+                           maze_cardinal_direction_t direction)
+{
+    if (maze_chunked_is_wall(p_maze, cell_idx, direction))
+    {
+        return MAZE_CHUNKED_NO_CELL;
+    }
+
+    return maze_chunked_get_idx_in_dir(p_maze, cell_idx, direction);
+}
+
+/**
+ * @brief Sets a wall on a side of a cell, and the matching wall of the
+ * adjacent cell if its chunk has been allocated.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ */
+void
+maze_chunked_set_wall (maze_chunked_t           *p_maze,
+                       maze_idx_t                cell_idx,
+                       maze_cardinal_direction_t direction)
+{
+    *get_cell(p_maze, cell_idx) |= (uint8_t)(1u << direction);
+
+    maze_idx_t next_idx
+        = maze_chunked_get_idx_in_dir(p_maze, cell_idx, direction);
+
+    if (MAZE_CHUNKED_NO_CELL != next_idx)
+    {
+        *get_cell(p_maze, next_idx) |= (uint8_t)(1u << ((direction + 2) % 4));
+    }
+}
+
+/**
+ * @brief Unsets a wall on a side of a cell, and the matching wall of the
+ * adjacent cell. The chunk of the adjacent cell is allocated if needed.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ *
+ * @note The wall stays set if the adjacent chunk could not be allocated.
+ */
+void
+maze_chunked_unset_wall (maze_chunked_t           *p_maze,
+                         maze_idx_t                cell_idx,
+                         maze_cardinal_direction_t direction)
+{
+    maze_idx_t next_idx
+        = maze_chunked_get_idx_in_dir(p_maze, cell_idx, direction);
+
+    if (MAZE_CHUNKED_NO_CELL == next_idx)
+    {
+        maze_chunked_point_t point = maze_chunked_get_point(p_maze, cell_idx);
+        int32_t              next_x
+            = point.x + (MAZE_EAST == direction) - (MAZE_WEST == direction);
+        int32_t next_y
+            = point.y + (MAZE_SOUTH == direction) - (MAZE_NORTH == direction);
+
+        if (INT16_MIN > next_x || INT16_MAX < next_x || INT16_MIN > next_y
+            || INT16_MAX < next_y)
+        {
+            return;
+        }
+
+        maze_chunked_point_t next_point = { (int16_t)next_x, (int16_t)next_y };
+        next_idx = maze_chunked_add_cell(p_maze, &next_point);
+
+        if (MAZE_CHUNKED_NO_CELL == next_idx)
+        {
+            return;
+        }
+    }
+
+    *get_cell(p_maze, cell_idx) &= (uint8_t)~(1u << direction);
+    *get_cell(p_maze, next_idx) &= (uint8_t)~(1u << ((direction + 2) % 4));
+}
+
+/**
+ * @brief Modifies the walls of a cell. This mirrors @ref maze_nav_modify_walls.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] aligned_wall_bitmask Bitmask of the walls to set or unset. This is
+ * aligned to MAZE_NORTH.
+ * @param[in] is_set True if the walls are to be set.
+ * @param[in] is_unset True if the walls are to be unset.
+ *
+ * @note both is_set and is_unset can be True. In this case, the
+ * entire cell's walls and gaps will be set.
+ */
+void
+maze_chunked_modify_walls (maze_chunked_t *p_maze,
+                           maze_idx_t      cell_idx,
+                           uint8_t         aligned_wall_bitmask,
+                           bool            is_set,
+                           bool            is_unset)
+{
+    if (!is_set && !is_unset)
+    {
+        return;
+    }
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        bool is_in_bitmask = aligned_wall_bitmask & (1 << direction);
+
+        if ((is_set ^ is_unset) && is_in_bitmask)
+        {
+            is_set ? maze_chunked_set_wall(p_maze, cell_idx, direction)
+                   : maze_chunked_unset_wall(p_maze, cell_idx, direction);
+        }
+        else if (is_set && is_unset)
+        {
+            is_in_bitmask
+                ? maze_chunked_unset_wall(p_maze, cell_idx, direction)
+                : maze_chunked_set_wall(p_maze, cell_idx, direction);
+        }
+    }
+}
+
+/**
+ * @brief Gets the gaps of a cell as a bitmask in the same format as @ref
+ * maze_serialise.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return uint8_t Bitmask of the gaps, aligned to MAZE_NORTH.
+ */
+uint8_t
+maze_chunked_get_gap_bitmask (const maze_chunked_t *p_maze, maze_idx_t cell_idx)
+{
+    uint8_t wall_bitmask = *get_cell(p_maze, cell_idx) & 0xFu;
+
+    return MAZE_INVERT_BITMASK(wall_bitmask);
+}
+
+/**
+ * @brief Checks if a cell has been visited.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return true The cell has been visited.
+ * @return false The cell has not been visited.
+ */
+bool
+maze_chunked_is_visited (const maze_chunked_t *p_maze, maze_idx_t cell_idx)
+{
+    return 0 != (*get_cell(p_maze, cell_idx) & MAZE_CHUNKED_VISITED);
+}
+
+/**
+ * @brief Sets or clears the visited flag of a cell.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] is_visited Value of the visited flag.
+ */
+void
+maze_chunked_set_visited (maze_chunked_t *p_maze,
+                          maze_idx_t      cell_idx,
+                          bool            is_visited)
+{
+    uint8_t *p_cell = get_cell(p_maze, cell_idx);
+
+    if (is_visited)
+    {
+        *p_cell |= MAZE_CHUNKED_VISITED;
+    }
+    else
+    {
+        *p_cell &= (uint8_t)~MAZE_CHUNKED_VISITED;
+    }
+}
+
+/**
+ * @brief Gets the manhattan distance between two points of a chunked maze.
+ *
+ * @param[in] p_point_a Pointer to the first point.
+ * @param[in] p_point_b Pointer to the second point.
+ * @return uint32_t Manhattan distance.
+ */
+uint32_t
+maze_chunked_manhattan_dist (const maze_chunked_point_t *p_point_a,
+                             const maze_chunked_point_t *p_point_b)
+{
+    int32_t x_diff = (int32_t)p_point_a->x - p_point_b->x;
+    int32_t y_diff = (int32_t)p_point_a->y - p_point_b->y;
+
+    return (uint32_t)((0 > x_diff ? -x_diff : x_diff)
+                      + (0 > y_diff ? -y_diff : y_diff));
+}
+
+/**
+ * @brief Gets the bounding box of the allocated chunks.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[out] p_min Coordinates of the north-west corner cell.
+ * @param[out] p_max Coordinates of the south-east corner cell.
+ */
+void
+maze_chunked_get_bounds (const maze_chunked_t *p_maze,
+                         maze_chunked_point_t *p_min,
+                         maze_chunked_point_t *p_max)
+{
+    uint16_t min_x = UINT16_MAX;
+    uint16_t min_y = UINT16_MAX;
+    uint16_t max_x = 0;
+    uint16_t max_y = 0;
+
+    for (maze_idx_t slot = 0; p_maze->num_chunks > slot; slot++)
+    {
+        const maze_chunk_t *p_chunk = &p_maze->p_chunks[slot];
+
+        min_x = (p_chunk->chunk_x < min_x) ? p_chunk->chunk_x : min_x;
+        min_y = (p_chunk->chunk_y < min_y) ? p_chunk->chunk_y : min_y;
+        max_x = (p_chunk->chunk_x > max_x) ? p_chunk->chunk_x : max_x;
+        max_y = (p_chunk->chunk_y > max_y) ? p_chunk->chunk_y : max_y;
+    }
+
+    p_min->x = (int16_t)((int32_t)min_x * MAZE_CHUNK_SIZE - CHUNK_BIAS);
+    p_min->y = (int16_t)((int32_t)min_y * MAZE_CHUNK_SIZE - CHUNK_BIAS);
+    p_max->x = (int16_t)((int32_t)max_x * MAZE_CHUNK_SIZE - CHUNK_BIAS
+                         + (MAZE_CHUNK_SIZE - 1));
+    p_max->y = (int16_t)((int32_t)max_y * MAZE_CHUNK_SIZE - CHUNK_BIAS
+                         + (MAZE_CHUNK_SIZE - 1));
+}
+
+/**
+ * @brief Serialises the bounding box of the maze into a bitmask array. @ref
+ * maze_serialise. The cell at index 0 is the minimum corner of @ref
+ * maze_chunked_get_bounds. Cells in chunks that have not been allocated have
+ * no gaps.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @return maze_gap_bitmask_t Bitmask array of maze gaps.
+ *
+ * @warning The bitmask array must be freed with @ref maze_free.
+ */
+maze_gap_bitmask_t
+maze_chunked_serialise (const maze_chunked_t *p_maze)
+{
+    maze_chunked_point_t min_point;
+    maze_chunked_point_t max_point;
+    maze_chunked_get_bounds(p_maze, &min_point, &max_point);
+
+    uint16_t rows    = (uint16_t)(max_point.y - min_point.y + 1);
+    uint16_t columns = (uint16_t)(max_point.x - min_point.x + 1);
+
+    maze_gap_bitmask_t no_walls_array = {
+        .p_bitmask = maze_malloc(sizeof(uint16_t) * rows * columns),
+        .rows      = rows,
+        .columns   = columns,
+    };
+
+    uint16_t *p_bitmask = no_walls_array.p_bitmask;
+
+    for (uint16_t row = 0; rows > row; row++)
+    {
+        for (uint16_t col = 0; columns > col; col++)
+        {
+            maze_chunked_point_t point = { (int16_t)(min_point.x + col),
+                                           (int16_t)(min_point.y + row) };
+            maze_idx_t cell_idx = maze_chunked_get_idx(p_maze, &point);
+
+            *p_bitmask++ = (MAZE_CHUNKED_NO_CELL == cell_idx)
+                               ? 0
+                               : maze_chunked_get_gap_bitmask(p_maze, cell_idx);
+        }
+    }
+
+    return no_walls_array;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Finds the slot of a chunk in the hash table.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] chunk_x Biased column of the chunk.
+ * @param[in] chunk_y Biased row of the chunk.
+ * @return maze_idx_t Slot of the chunk. MAZE_CHUNKED_NO_CHUNK if it has not
+ * been allocated.
+ */
+static maze_idx_t
+find_chunk (const maze_chunked_t *p_maze, uint16_t chunk_x, uint16_t chunk_y)
+{
+    maze_idx_t mask = p_maze->lookup_capacity - 1u;
+    maze_idx_t pos  = get_lookup_pos(chunk_x, chunk_y, p_maze->lookup_capacity);
+
+    // The table is never more than half full, so an empty entry is always
+    // found.
+    //
+    while (MAZE_CHUNKED_NO_CHUNK != p_maze->p_lookup[pos])
+    {
+        const maze_chunk_t *p_chunk = &p_maze->p_chunks[p_maze->p_lookup[pos]];
+
+        if (chunk_x == p_chunk->chunk_x && chunk_y == p_chunk->chunk_y)
+        {
+            return p_maze->p_lookup[pos];
+        }
+
+        pos = (pos + 1u) & mask;
+    }
+
+    return MAZE_CHUNKED_NO_CHUNK;
+}
+
+/**
+ * @brief Allocates a fully walled chunk, and links it to the adjacent chunks.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @param[in] chunk_x Biased column of the chunk.
+ * @param[in] chunk_y Biased row of the chunk.
+ * @return maze_idx_t Slot of the new chunk. MAZE_CHUNKED_NO_CHUNK if the maze
+ * is full or out of memory.
+ */
+static maze_idx_t
+add_chunk (maze_chunked_t *p_maze, uint16_t chunk_x, uint16_t chunk_y)
+{
+    if (MAZE_CHUNKED_MAX_CHUNKS <= p_maze->num_chunks)
+    {
+        return MAZE_CHUNKED_NO_CHUNK;
+    }
+
+    // Step 1: Make room for the chunk, doubling the arrays if needed.
+    //
+    if (p_maze->chunk_capacity == p_maze->num_chunks)
+    {
+        maze_idx_t capacity
+            = (MAZE_CHUNKED_MAX_CHUNKS / 2u < p_maze->chunk_capacity)
+                  ? MAZE_CHUNKED_MAX_CHUNKS
+                  : p_maze->chunk_capacity * 2u;
+        maze_chunk_t *p_chunks
+            = maze_realloc(p_maze->p_chunks, sizeof(maze_chunk_t) * capacity);
+
+        if (NULL == p_chunks)
+        {
+            return MAZE_CHUNKED_NO_CHUNK;
+        }
+
+        p_maze->p_chunks       = p_chunks;
+        p_maze->chunk_capacity = capacity;
+    }
+
+    if (p_maze->lookup_capacity < (p_maze->num_chunks + 1u) * 2u
+        && !grow_lookup(p_maze))
+    {
+        return MAZE_CHUNKED_NO_CHUNK;
+    }
+
+    // Step 2: Initialise the chunk with every wall set.
+    //
+    maze_idx_t    slot    = p_maze->num_chunks++;
+    maze_chunk_t *p_chunk = &p_maze->p_chunks[slot];
+
+    p_chunk->chunk_x = chunk_x;
+    p_chunk->chunk_y = chunk_y;
+    memset(p_chunk->cells, 0xF, sizeof(p_chunk->cells));
+
+    // Step 3: Link the chunk to its neighbours in both directions.
+    //
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        uint16_t   next_x    = 0;
+        uint16_t   next_y    = 0;
+        maze_idx_t next_slot = MAZE_CHUNKED_NO_CHUNK;
+
+        if (get_chunk_in_dir(chunk_x, chunk_y, direction, &next_x, &next_y))
+        {
+            next_slot = find_chunk(p_maze, next_x, next_y);
+        }
+
+        p_chunk->neighbours[direction] = next_slot;
+
+        if (MAZE_CHUNKED_NO_CHUNK != next_slot)
+        {
+            p_maze->p_chunks[next_slot].neighbours[(direction + 2) % 4] = slot;
+        }
+    }
+
+    // Step 4: Insert the chunk into the hash table.
+    //
+    maze_idx_t mask = p_maze->lookup_capacity - 1u;
+    maze_idx_t pos  = get_lookup_pos(chunk_x, chunk_y, p_maze->lookup_capacity);
+
+    while (MAZE_CHUNKED_NO_CHUNK != p_maze->p_lookup[pos])
+    {
+        pos = (pos + 1u) & mask;
+    }
+
+    p_maze->p_lookup[pos] = slot;
+
+    return slot;
+}
+
+/**
+ * @brief Doubles the size of the hash table and reinserts every chunk.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ * @return true The table was grown.
+ * @return false Out of memory. The table is unchanged.
+ */
+static bool
+grow_lookup (maze_chunked_t *p_maze)
+{
+    maze_idx_t  capacity = p_maze->lookup_capacity * 2u;
+    maze_idx_t *p_lookup = maze_malloc(sizeof(maze_idx_t) * capacity);
+
+    if (NULL == p_lookup)
+    {
+        return false;
+    }
+
+    for (maze_idx_t pos = 0; capacity > pos; pos++)
+    {
+        p_lookup[pos] = MAZE_CHUNKED_NO_CHUNK;
+    }
+
+    for (maze_idx_t slot = 0; p_maze->num_chunks > slot; slot++)
+    {
+        const maze_chunk_t *p_chunk = &p_maze->p_chunks[slot];
+        maze_idx_t          pos
+            = get_lookup_pos(p_chunk->chunk_x, p_chunk->chunk_y, capacity);
+
+        while (MAZE_CHUNKED_NO_CHUNK != p_lookup[pos])
+        {
+            pos = (pos + 1u) & (capacity - 1u);
+        }
+
+        p_lookup[pos] = slot;
+    }
+
+    maze_free(p_maze->p_lookup);
+    p_maze->p_lookup        = p_lookup;
+    p_maze->lookup_capacity = capacity;
+
+    return true;
+}
+
+/**
+ * @brief Gets the preferred position of a chunk in the hash table.
+ *
+ * @param[in] chunk_x Biased column of the chunk.
+ * @param[in] chunk_y Biased row of the chunk.
+ * @param[in] lookup_capacity Number of entries in the hash table.
+ * @return maze_idx_t Position in the hash table.
+ */
+static maze_idx_t
+get_lookup_pos (uint16_t chunk_x, uint16_t chunk_y, maze_idx_t lookup_capacity)
+{
+    uint32_t key = ((uint32_t)chunk_y << 16) | chunk_x;
+
+    key ^= key >> 16;
+    key *= 0x45D9F3Bu;
+    key ^= key >> 16;
+
+    return (maze_idx_t)(key & (lookup_capacity - 1u));
+}
+
+/**
+ * @brief Gets the coordinates of the adjacent chunk.
+ *
+ * @param[in] chunk_x Biased column of the chunk.
+ * @param[in] chunk_y Biased row of the chunk.
+ * @param[in] direction Cardinal direction of the adjacent chunk.
+ * @param[out] p_next_x Biased column of the adjacent chunk.
+ * @param[out] p_next_y Biased row of the adjacent chunk.
+ * @return true The adjacent chunk is within the coordinate range.
+ * @return false The chunk is on the edge of the coordinate range.
+ */
+static bool
+get_chunk_in_dir (uint16_t                  chunk_x,
+                  uint16_t                  chunk_y,
+                  maze_cardinal_direction_t direction,
+                  uint16_t                 *p_next_x,
+                  uint16_t                 *p_next_y)
+{
+    *p_next_x = chunk_x;
+    *p_next_y = chunk_y;
+
+    switch (direction)
+    {
+        case MAZE_NORTH:
+            *p_next_y = chunk_y - 1u;
+            return 0 != chunk_y;
+        case MAZE_EAST:
+            *p_next_x = chunk_x + 1u;
+            return CHUNK_MAX_COORD != chunk_x;
+        case MAZE_SOUTH:
+            *p_next_y = chunk_y + 1u;
+            return CHUNK_MAX_COORD != chunk_y;
+        case MAZE_WEST:
+            *p_next_x = chunk_x - 1u;
+            return 0 != chunk_x;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Gets a pointer to the bits of a cell.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return uint8_t* Pointer to the wall bitmask and flags of the cell.
+ */
+static uint8_t *
+get_cell (const maze_chunked_t *p_maze, maze_idx_t cell_idx)
+{
+    return &p_maze->p_chunks[cell_idx / MAZE_CHUNK_CELLS]
+                .cells[cell_idx % MAZE_CHUNK_CELLS];
+}
+
+// End of pathfinding/maze_chunked.c
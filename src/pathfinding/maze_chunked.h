@@ -0,0 +1,203 @@
+/**
+ * @file maze_chunked.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the growable chunked maze backend. The maze is made
+ * of fixed-size chunks that are allocated when a cell in them is first
+ * entered or sensed, so the size of the course does not need to be known in
+ * advance and memory grows with the explored area.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_CHUNKED_H // Include guard.
+#define MAZE_CHUNKED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_CHUNK_SHIFT
+ * @brief Log2 of the width of a chunk in cells.
+ */
+#define MAZE_CHUNK_SHIFT 3u
+
+/**
+ * @def MAZE_CHUNK_SIZE
+ * @brief Width and height of a chunk in cells.
+ */
+#define MAZE_CHUNK_SIZE (1u << MAZE_CHUNK_SHIFT)
+
+/**
+ * @def MAZE_CHUNK_CELLS
+ * @brief Number of cells in a chunk.
+ */
+#define MAZE_CHUNK_CELLS (MAZE_CHUNK_SIZE * MAZE_CHUNK_SIZE)
+
+/**
+ * @def MAZE_CHUNKED_NO_CELL
+ * @brief Index returned when a cell does not exist or cannot be reached.
+ */
+#define MAZE_CHUNKED_NO_CELL MAZE_IDX_MAX
+
+/**
+ * @def MAZE_CHUNKED_NO_CHUNK
+ * @brief Slot of a chunk that has not been allocated.
+ */
+#define MAZE_CHUNKED_NO_CHUNK MAZE_IDX_MAX
+
+/**
+ * @def MAZE_CHUNKED_MAX_CHUNKS
+ * @brief Maximum number of chunks, so that every cell index fits in
+ * @ref maze_idx_t.
+ */
+#define MAZE_CHUNKED_MAX_CHUNKS (MAZE_IDX_MAX / MAZE_CHUNK_CELLS)
+
+/**
+ * @def MAZE_CHUNKED_VISITED
+ * @brief Cell bit set if the cell has been visited while mapping. The low
+ * nibble of a cell is its wall bitmask.
+ */
+#define MAZE_CHUNKED_VISITED 0x10u
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the coordinates of a cell relative to the cell
+ * the map was started from. Negative coordinates are to the north and west.
+ */
+typedef struct maze_chunked_point
+{
+    int16_t x; ///< X-coordinate or column.
+    int16_t y; ///< Y-coordinate or row.
+} maze_chunked_point_t;
+
+/**
+ * @brief This struct contains a chunk of cells.
+ *
+ * @note Chunk coordinates are biased by 32768 cells so that they are never
+ * negative, i.e. chunk_x is (x + 32768) / MAZE_CHUNK_SIZE.
+ */
+typedef struct maze_chunk
+{
+    uint16_t   chunk_x;       ///< Biased column of the chunk.
+    uint16_t   chunk_y;       ///< Biased row of the chunk.
+    maze_idx_t neighbours[4]; ///< Slot of the adjacent chunk, indexed by the
+                              ///< direction enum. MAZE_CHUNKED_NO_CHUNK if it
+                              ///< has not been allocated.
+    uint8_t cells[MAZE_CHUNK_CELLS]; ///< Cells by row, then column. Bit d is
+                                     ///< set if there is a wall in the
+                                     ///< direction d.
+} maze_chunk_t;
+
+/**
+ * @brief This struct contains a sparse maze made of chunks. The cell at local
+ * coordinates (col, row) of the chunk in slot s has the index
+ * s * MAZE_CHUNK_CELLS + row * MAZE_CHUNK_SIZE + col.
+ *
+ * @note Every wall of a new chunk is set, and unsetting a wall allocates the
+ * chunk on the other side. Walls are kept symmetric. Cell indices stay valid
+ * as the maze grows.
+ */
+typedef struct maze_chunked
+{
+    maze_chunk_t *p_chunks;   ///< Chunks in the order they were allocated.
+    maze_idx_t   *p_lookup;   ///< Hash table from chunk coordinates to slots.
+    maze_idx_t    num_chunks; ///< Number of allocated chunks.
+    maze_idx_t    chunk_capacity;  ///< Number of chunks with room in p_chunks.
+    maze_idx_t    lookup_capacity; ///< Number of entries in the hash table.
+                                   ///< This is a power of 2.
+} maze_chunked_t;
+
+/**
+ * @brief This struct contains the state of a navigator in a chunked maze.
+ * Cells are referred to by their index instead of pointers.
+ */
+typedef struct maze_chunked_navigator
+{
+    maze_idx_t current_idx; ///< Index of the current location of the
+                            ///< navigator.
+    maze_idx_t start_idx;   ///< Index of the start cell of the maze.
+    maze_idx_t end_idx;     ///< Index of the end cell of the maze.
+    maze_cardinal_direction_t orientation; ///< Orientation of the navigator.
+} maze_chunked_navigator_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+maze_chunked_t maze_chunked_create(void);
+
+void maze_chunked_destroy(maze_chunked_t *p_maze);
+
+size_t maze_chunked_get_size(const maze_chunked_t *p_maze);
+
+maze_idx_t maze_chunked_get_num_cells(const maze_chunked_t *p_maze);
+
+maze_idx_t maze_chunked_get_idx(const maze_chunked_t       *p_maze,
+                                const maze_chunked_point_t *p_coordinates);
+
+maze_idx_t maze_chunked_add_cell(maze_chunked_t             *p_maze,
+                                 const maze_chunked_point_t *p_coordinates);
+
+maze_chunked_point_t maze_chunked_get_point(const maze_chunked_t *p_maze,
+                                            maze_idx_t            cell_idx);
+
+maze_idx_t maze_chunked_get_idx_in_dir(const maze_chunked_t     *p_maze,
+                                       maze_idx_t                cell_idx,
+                                       maze_cardinal_direction_t direction);
+
+bool maze_chunked_is_wall(const maze_chunked_t     *p_maze,
+                          maze_idx_t                cell_idx,
+                          maze_cardinal_direction_t direction);
+
+maze_idx_t maze_chunked_get_next_idx(const maze_chunked_t     *p_maze,
+                                     maze_idx_t                cell_idx,
+                                     maze_cardinal_direction_t direction);
+
+void maze_chunked_set_wall(maze_chunked_t           *p_maze,
+                           maze_idx_t                cell_idx,
+                           maze_cardinal_direction_t direction);
+
+void maze_chunked_unset_wall(maze_chunked_t           *p_maze,
+                             maze_idx_t                cell_idx,
+                             maze_cardinal_direction_t direction);
+
+void maze_chunked_modify_walls(maze_chunked_t *p_maze,
+                               maze_idx_t      cell_idx,
+                               uint8_t         aligned_wall_bitmask,
+                               bool            is_set,
+                               bool            is_unset);
+
+uint8_t maze_chunked_get_gap_bitmask(const maze_chunked_t *p_maze,
+                                     maze_idx_t            cell_idx);
+
+bool maze_chunked_is_visited(const maze_chunked_t *p_maze,
+                             maze_idx_t            cell_idx);
+
+void maze_chunked_set_visited(maze_chunked_t *p_maze,
+                              maze_idx_t      cell_idx,
+                              bool            is_visited);
+
+uint32_t maze_chunked_manhattan_dist(const maze_chunked_point_t *p_point_a,
+                                     const maze_chunked_point_t *p_point_b);
+
+void maze_chunked_get_bounds(const maze_chunked_t *p_maze,
+                             maze_chunked_point_t *p_min,
+                             maze_chunked_point_t *p_max);
+
+maze_gap_bitmask_t maze_chunked_serialise(const maze_chunked_t *p_maze);
+
+#endif // MAZE_CHUNKED_H
+
+// End of pathfinding/maze_chunked.h
@@ -0,0 +1,543 @@
+/**
+ * @file maze_compact.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Contains the implementation of the compact wall-bitmask maze backend.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @par A 64x64 maze needs about 1 KiB for its walls and 512 B for the visited
+ * flags, compared to roughly 160 KiB for the equivalent @ref maze_grid_t on a
+ * 32-bit target.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint8_t *get_wall_bit(const maze_compact_t     *p_maze,
+                             maze_idx_t                cell_idx,
+                             maze_cardinal_direction_t direction,
+                             uint8_t                  *p_bit_mask);
+
+static bool is_border_wall(const maze_compact_t     *p_maze,
+                           maze_idx_t                cell_idx,
+                           maze_cardinal_direction_t direction);
+
+static size_t get_num_bytes(size_t num_bits);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a compact maze with the specified number of rows and columns.
+ * Every wall is set, like @ref maze_create.
+ *
+ * @param[in] rows Number of rows in the maze.
+ * @param[in] columns Number of columns in the maze.
+ * @return maze_compact_t Fully walled maze.
+ *
+ * @warning The maze must be destroyed by @ref maze_compact_destroy.
+ */
+maze_compact_t
+maze_compact_create (uint16_t rows, uint16_t columns)
+{
+    size_t horizontal_bytes = get_num_bytes((size_t)(rows + 1u) * columns);
+    size_t vertical_bytes   = get_num_bytes((size_t)rows * (columns + 1u));
+    size_t visited_bytes    = get_num_bytes((size_t)rows * columns);
+
+    maze_compact_t maze = {
+        .p_horizontal_walls = maze_malloc(horizontal_bytes),
+        .p_vertical_walls   = maze_malloc(vertical_bytes),
+        .p_visited          = maze_malloc(visited_bytes),
+        .rows               = rows,
+        .columns            = columns,
+    };
+
+    memset(maze.p_horizontal_walls, 0xFF, horizontal_bytes);
+    memset(maze.p_vertical_walls, 0xFF, vertical_bytes);
+    memset(maze.p_visited, 0, visited_bytes);
+
+    return maze;
+}
+
+/**
+ * @brief Destroys the maze by freeing the memory allocated to the bit arrays.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ */
+void
+maze_compact_destroy (maze_compact_t *p_maze)
+{
+    maze_free(p_maze->p_horizontal_walls);
+    maze_free(p_maze->p_vertical_walls);
+    maze_free(p_maze->p_visited);
+
+    p_maze->p_horizontal_walls = NULL;
+    p_maze->p_vertical_walls   = NULL;
+    p_maze->p_visited          = NULL;
+    p_maze->rows               = 0;
+    p_maze->columns            = 0;
+}
+
+/**
+ * @brief Removes every interior wall and clears the visited flags. The outer
+ * border stays walled. This is the compact equivalent of @ref
+ * floodfill_init_maze_nowall.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ */
+void
+maze_compact_init_nowall (maze_compact_t *p_maze)
+{
+    memset(p_maze->p_visited,
+           0,
+           get_num_bytes((size_t)p_maze->rows * p_maze->columns));
+
+    for (uint16_t row = 0; p_maze->rows > row; row++)
+    {
+        for (uint16_t col = 0; p_maze->columns > col; col++)
+        {
+            maze_idx_t cell_idx = (maze_idx_t)row * p_maze->columns + col;
+
+            // Only the north and west walls need to be removed, as every
+            // interior wall is the north or west wall of some cell.
+            //
+            maze_compact_unset_wall(p_maze, cell_idx, MAZE_NORTH);
+            maze_compact_unset_wall(p_maze, cell_idx, MAZE_WEST);
+        }
+    }
+}
+
+/**
+ * @brief Gets the number of bytes used by the bit arrays of the maze.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @return size_t Number of bytes allocated for the maze.
+ */
+size_t
+maze_compact_get_size (const maze_compact_t *p_maze)
+{
+    size_t num_bytes
+        = get_num_bytes((size_t)(p_maze->rows + 1u) * p_maze->columns)
+          + get_num_bytes((size_t)p_maze->rows * (p_maze->columns + 1u))
+          + get_num_bytes((size_t)p_maze->rows * p_maze->columns);
+    return num_bytes;
+}
+
+/**
+ * @brief Gets the index of the cell at the specified coordinates.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] p_coordinates Pointer to the coordinates.
+ * @return maze_idx_t Index of the cell, MAZE_COMPACT_NO_CELL if the coordinates
+ * are out of bounds.
+ */
+maze_idx_t
+maze_compact_get_idx (const maze_compact_t *p_maze,
+                      const maze_point_t   *p_coordinates)
+{
+    if (p_maze->rows <= p_coordinates->y || p_maze->columns <= p_coordinates->x)
+    {
+        return MAZE_COMPACT_NO_CELL;
+    }
+
+    return (maze_idx_t)p_coordinates->y * p_maze->columns + p_coordinates->x;
+}
+
+/**
+ * @brief Gets the coordinates of a cell from its index.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return maze_point_t Coordinates of the cell.
+ */
+maze_point_t
+maze_compact_get_point (const maze_compact_t *p_maze, maze_idx_t cell_idx)
+{
+    maze_point_t point = { cell_idx % p_maze->columns,
+                           cell_idx / p_maze->columns };
+    return point;
+}
+
+/**
+ * @brief Gets the index of the adjacent cell in the specified direction,
+ * regardless of walls.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the adjacent cell.
+ * @return maze_idx_t Index of the adjacent cell, MAZE_COMPACT_NO_CELL if it is
+ * out of bounds.
+ */
+maze_idx_t
+maze_compact_get_idx_in_dir (const maze_compact_t     *p_maze,
+                             maze_idx_t                cell_idx,
+                             maze_cardinal_direction_t direction)
+{
+    uint16_t row = cell_idx / p_maze->columns;
+    uint16_t col = cell_idx % p_maze->columns;
+
+    switch (direction)
+    {
+        case MAZE_NORTH:
+            return (0 == row) ? MAZE_COMPACT_NO_CELL
+                              : cell_idx - p_maze->columns;
+        case MAZE_EAST:
+            return (p_maze->columns - 1 == col) ? MAZE_COMPACT_NO_CELL
+                                                : cell_idx + 1;
+        case MAZE_SOUTH:
+            return (p_maze->rows - 1 == row) ? MAZE_COMPACT_NO_CELL
+                                             : cell_idx + p_maze->columns;
+        case MAZE_WEST:
+            return (0 == col) ? MAZE_COMPACT_NO_CELL : cell_idx - 1;
+        default:
+            return MAZE_COMPACT_NO_CELL;
+    }
+}
+
+/**
+ * @brief Checks if there is a wall on a side of a cell.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ * @return true There is a wall.
+ * @return false There is a gap.
+ */
+bool
+maze_compact_is_wall (const maze_compact_t     *p_maze,
+                      maze_idx_t                cell_idx,
+                      maze_cardinal_direction_t direction)
+{
+    uint8_t        bit_mask = 0;
+    const uint8_t *p_byte
+        = get_wall_bit(p_maze, cell_idx, direction, &bit_mask);
+
+    return 0 != (*p_byte & bit_mask);
+}
+
+/**
+ * @brief Gets the index of the cell that can be moved to in the specified
+ * direction. This is the compact equivalent of `p_next`.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction to move in.
+ * @return maze_idx_t Index of the next cell, MAZE_COMPACT_NO_CELL if there is a
+ * wall in the way.
+ */
+maze_idx_t
+maze_compact_get_next_idx (const maze_compact_t     *p_maze,
+                           maze_idx_t                cell_idx,
+                           maze_cardinal_direction_t direction)
+{
+    if (maze_compact_is_wall(p_maze, cell_idx, direction))
+    {
+        return MAZE_COMPACT_NO_CELL;
+    }
+
+    return maze_compact_get_idx_in_dir(p_maze, cell_idx, direction);
+}
+
+/**
+ * @brief Sets a wall on a side of a cell. This also sets the wall for the
+ * adjacent cell as the bit is shared.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ */
+void
+maze_compact_set_wall (maze_compact_t           *p_maze,
+                       maze_idx_t                cell_idx,
+                       maze_cardinal_direction_t direction)
+{
+    uint8_t  bit_mask = 0;
+    uint8_t *p_byte   = get_wall_bit(p_maze, cell_idx, direction, &bit_mask);
+
+    *p_byte |= bit_mask;
+}
+
+/**
+ * @brief Unsets a wall on a side of a cell. Walls on the outer border of the
+ * maze cannot be unset.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ */
+void
+maze_compact_unset_wall (maze_compact_t           *p_maze,
+                         maze_idx_t                cell_idx,
+                         maze_cardinal_direction_t direction)
+{
+    if (is_border_wall(p_maze, cell_idx, direction))
+    {
+        return;
+    }
+
+    uint8_t  bit_mask = 0;
+    uint8_t *p_byte   = get_wall_bit(p_maze, cell_idx, direction, &bit_mask);
+
+    *p_byte &= (uint8_t)~bit_mask;
+}
+
+/**
+ * @brief Modifies the walls of a cell. This mirrors @ref maze_nav_modify_walls.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] aligned_wall_bitmask Bitmask of the walls to set or unset. This is
+ * aligned to MAZE_NORTH.
+ * @param[in] is_set True if the walls are to be set.
+ * @param[in] is_unset True if the walls are to be unset.
+ *
+ * @note both is_set and is_unset can be True. In this case, the
+ * entire cell's walls and gaps will be set.
+ */
+void
+maze_compact_modify_walls (maze_compact_t *p_maze,
+                           maze_idx_t      cell_idx,
+                           uint8_t         aligned_wall_bitmask,
+                           bool            is_set,
+                           bool            is_unset)
+{
+    if (!is_set && !is_unset)
+    {
+        return;
+    }
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        bool is_in_bitmask = aligned_wall_bitmask & (1 << direction);
+
+        if ((is_set ^ is_unset) && is_in_bitmask)
+        {
+            is_set ? maze_compact_set_wall(p_maze, cell_idx, direction)
+                   : maze_compact_unset_wall(p_maze, cell_idx, direction);
+        }
+        else if (is_set && is_unset)
+        {
+            is_in_bitmask
+                ? maze_compact_unset_wall(p_maze, cell_idx, direction)
+                : maze_compact_set_wall(p_maze, cell_idx, direction);
+        }
+    }
+}
+
+/**
+ * @brief Gets the gaps of a cell as a bitmask in the same format as @ref
+ * maze_serialise.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return uint8_t Bitmask of the gaps, aligned to MAZE_NORTH.
+ */
+uint8_t
+maze_compact_get_gap_bitmask (const maze_compact_t *p_maze, maze_idx_t cell_idx)
+{
+    uint8_t gap_bitmask = 0;
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        if (!maze_compact_is_wall(p_maze, cell_idx, direction))
+        {
+            gap_bitmask |= (1 << direction);
+        }
+    }
+
+    return gap_bitmask;
+}
+
+/**
+ * @brief Checks if a cell has been visited.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @return true The cell has been visited.
+ * @return false The cell has not been visited.
+ */
+bool
+maze_compact_is_visited (const maze_compact_t *p_maze, maze_idx_t cell_idx)
+{
+    return 0 != (p_maze->p_visited[cell_idx / 8u] & (1u << (cell_idx % 8u)));
+}
+
+/**
+ * @brief Sets or clears the visited flag of a cell.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] is_visited Value of the visited flag.
+ */
+void
+maze_compact_set_visited (maze_compact_t *p_maze,
+                          maze_idx_t      cell_idx,
+                          bool            is_visited)
+{
+    uint8_t bit_mask = (uint8_t)(1u << (cell_idx % 8u));
+
+    if (is_visited)
+    {
+        p_maze->p_visited[cell_idx / 8u] |= bit_mask;
+    }
+    else
+    {
+        p_maze->p_visited[cell_idx / 8u] &= (uint8_t)~bit_mask;
+    }
+}
+
+/**
+ * @brief Deserialises the maze from a bitmask array. @ref maze_deserialise.
+ *
+ * @param[in,out] p_maze Pointer to the compact maze.
+ * @param[in] p_no_walls_array Pointer to the bitmask array of maze gaps.
+ * @return int16_t 0 if successful, -1 otherwise.
+ */
+int16_t
+maze_compact_deserialise (maze_compact_t           *p_maze,
+                          const maze_gap_bitmask_t *p_no_walls_array)
+{
+    if (NULL == p_no_walls_array || p_maze->rows != p_no_walls_array->rows
+        || p_maze->columns != p_no_walls_array->columns)
+    {
+        return -1;
+    }
+
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        maze_compact_modify_walls(p_maze,
+                                  cell_idx,
+                                  p_no_walls_array->p_bitmask[cell_idx],
+                                  true,
+                                  true);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Serialises the maze into a bitmask array. @ref maze_serialise.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @return maze_gap_bitmask_t Bitmask array of maze gaps.
+ *
+ * @warning The bitmask array must be freed with @ref maze_free.
+ */
+maze_gap_bitmask_t
+maze_compact_serialise (const maze_compact_t *p_maze)
+{
+    maze_gap_bitmask_t no_walls_array = {
+        .p_bitmask = maze_malloc(sizeof(uint16_t) * p_maze->rows
+                                 * p_maze->columns),
+        .rows      = p_maze->rows,
+        .columns   = p_maze->columns,
+    };
+
+    maze_idx_t num_cells = (maze_idx_t)p_maze->rows * p_maze->columns;
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        no_walls_array.p_bitmask[cell_idx]
+            = maze_compact_get_gap_bitmask(p_maze, cell_idx);
+    }
+
+    return no_walls_array;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Gets the byte and bit that store a wall of a cell. North and south
+ * walls are in the horizontal array, east and west walls in the vertical array.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ * @param[out] p_bit_mask Mask of the bit within the returned byte.
+ * @return uint8_t* Pointer to the byte containing the wall bit.
+ */
+static uint8_t *
+get_wall_bit (const maze_compact_t     *p_maze,
+              maze_idx_t                cell_idx,
+              maze_cardinal_direction_t direction,
+              uint8_t                  *p_bit_mask)
+{
+    uint16_t row = cell_idx / p_maze->columns;
+    uint16_t col = cell_idx % p_maze->columns;
+
+    uint8_t *p_array = NULL;
+    size_t   bit_idx = 0;
+
+    switch (direction)
+    {
+        case MAZE_NORTH:
+            p_array = p_maze->p_horizontal_walls;
+            bit_idx = (size_t)row * p_maze->columns + col;
+            break;
+        case MAZE_SOUTH:
+            p_array = p_maze->p_horizontal_walls;
+            bit_idx = (size_t)(row + 1u) * p_maze->columns + col;
+            break;
+        case MAZE_WEST:
+            p_array = p_maze->p_vertical_walls;
+            bit_idx = (size_t)row * (p_maze->columns + 1u) + col;
+            break;
+        case MAZE_EAST:
+        default:
+            p_array = p_maze->p_vertical_walls;
+            bit_idx = (size_t)row * (p_maze->columns + 1u) + col + 1u;
+            break;
+    }
+
+    *p_bit_mask = (uint8_t)(1u << (bit_idx % 8u));
+    return &p_array[bit_idx / 8u];
+}
+
+/**
+ * @brief Checks if a wall is on the outer border of the maze.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ * @return true The wall is on the outer border.
+ * @return false The wall is between two cells.
+ */
+static bool
+is_border_wall (const maze_compact_t     *p_maze,
+                maze_idx_t                cell_idx,
+                maze_cardinal_direction_t direction)
+{
+    return MAZE_COMPACT_NO_CELL
+           == maze_compact_get_idx_in_dir(p_maze, cell_idx, direction);
+}
+
+/**
+ * @brief Gets the number of bytes needed to store a number of bits.
+ *
+ * @param[in] num_bits Number of bits.
+ * @return size_t Number of bytes.
+ */
+static size_t
+get_num_bytes (size_t num_bits)
+{
+    return num_bits / 8u + ((0u != num_bits % 8u) ? 1u : 0u);
+}
+
+// End of pathfinding/maze_compact.c
@@ -0,0 +1,130 @@
+/**
+ * @file maze_compact.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the compact wall-bitmask maze backend. Walls are
+ * stored once in shared edge-bit arrays and coordinates are derived from the
+ * cell index.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_COMPACT_H // Include guard.
+#define MAZE_COMPACT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_COMPACT_NO_CELL
+ * @brief Index returned when a cell does not exist or cannot be reached.
+ */
+#define MAZE_COMPACT_NO_CELL MAZE_IDX_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains a maze whose walls are stored as bits. Each wall
+ * between two cells is stored exactly once.
+ *
+ * @note A set bit is a wall. The outer border is always walled.
+ */
+typedef struct maze_compact
+{
+    uint8_t *p_horizontal_walls; ///< (rows + 1) * columns bits. Bit
+                                 ///< row * columns + col is the wall to the
+                                 ///< north of the cell at (col, row).
+    uint8_t *p_vertical_walls;   ///< rows * (columns + 1) bits. Bit
+                                 ///< row * (columns + 1) + col is the wall to
+                                 ///< the west of the cell at (col, row).
+    uint8_t *p_visited; ///< rows * columns bits. Set if the cell has been
+                        ///< visited while mapping.
+    uint16_t rows;      ///< Number of rows in the maze.
+    uint16_t columns;   ///< Number of columns in the maze.
+} maze_compact_t;
+
+/**
+ * @brief This struct contains the state of a navigator in a compact maze.
+ * Cells are referred to by their index instead of pointers.
+ */
+typedef struct maze_compact_navigator
+{
+    maze_idx_t current_idx; ///< Index of the current location of the
+                            ///< navigator.
+    maze_idx_t start_idx;   ///< Index of the start cell of the maze.
+    maze_idx_t end_idx;     ///< Index of the end cell of the maze.
+    maze_cardinal_direction_t orientation; ///< Orientation of the navigator.
+} maze_compact_navigator_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+maze_compact_t maze_compact_create(uint16_t rows, uint16_t columns);
+
+void maze_compact_destroy(maze_compact_t *p_maze);
+
+void maze_compact_init_nowall(maze_compact_t *p_maze);
+
+size_t maze_compact_get_size(const maze_compact_t *p_maze);
+
+maze_idx_t maze_compact_get_idx(const maze_compact_t *p_maze,
+                                const maze_point_t   *p_coordinates);
+
+maze_point_t maze_compact_get_point(const maze_compact_t *p_maze,
+                                    maze_idx_t            cell_idx);
+
+maze_idx_t maze_compact_get_idx_in_dir(const maze_compact_t     *p_maze,
+                                       maze_idx_t                cell_idx,
+                                       maze_cardinal_direction_t direction);
+
+bool maze_compact_is_wall(const maze_compact_t     *p_maze,
+                          maze_idx_t                cell_idx,
+                          maze_cardinal_direction_t direction);
+
+maze_idx_t maze_compact_get_next_idx(const maze_compact_t     *p_maze,
+                                     maze_idx_t                cell_idx,
+                                     maze_cardinal_direction_t direction);
+
+void maze_compact_set_wall(maze_compact_t           *p_maze,
+                           maze_idx_t                cell_idx,
+                           maze_cardinal_direction_t direction);
+
+void maze_compact_unset_wall(maze_compact_t           *p_maze,
+                             maze_idx_t                cell_idx,
+                             maze_cardinal_direction_t direction);
+
+void maze_compact_modify_walls(maze_compact_t *p_maze,
+                               maze_idx_t      cell_idx,
+                               uint8_t         aligned_wall_bitmask,
+                               bool            is_set,
+                               bool            is_unset);
+
+uint8_t maze_compact_get_gap_bitmask(const maze_compact_t *p_maze,
+                                     maze_idx_t            cell_idx);
+
+bool maze_compact_is_visited(const maze_compact_t *p_maze,
+                             maze_idx_t            cell_idx);
+
+void maze_compact_set_visited(maze_compact_t *p_maze,
+                              maze_idx_t      cell_idx,
+                              bool            is_visited);
+
+int16_t maze_compact_deserialise(maze_compact_t           *p_maze,
+                                 const maze_gap_bitmask_t *p_no_walls_array);
+
+maze_gap_bitmask_t maze_compact_serialise(const maze_compact_t *p_maze);
+
+#endif // MAZE_COMPACT_H
+
+// End of pathfinding/maze_compact.h
@@ -0,0 +1,815 @@
+/**
+ * @file maze_dist_cache.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the cache of goal distance fields. When walls change,
+ * each field first raises the cells whose distance no longer leads to the
+ * goal, then lowers the raised cells and the cells around the change from
+ * their neighbours, so only the cells whose distance changed are visited.
+ * A move costs as much as the cell it enters, so a cell is as far from the
+ * goal as the cost of its best neighbour plus that neighbour's distance.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/maze_dist_cache.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Sum of a distance and a cell cost, wide enough that a sum through an
+ * unreachable cell stays above every distance instead of wrapping around.
+ */
+#if 32 == MAZE_IDX_WIDTH
+typedef uint64_t dist_sum_t;
+#else
+typedef uint32_t dist_sum_t;
+#endif
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void flood_field(maze_dist_cache_t *p_cache,
+                        maze_dist_field_t *p_field,
+                        maze_idx_t         goal_idx);
+
+static void repair_field(maze_dist_cache_t *p_cache,
+                         maze_dist_field_t *p_field,
+                         maze_idx_t         node_idx);
+
+static void lower_queued(maze_dist_cache_t *p_cache,
+                         maze_dist_field_t *p_field,
+                         size_t             num_queue);
+
+static void raise_if_unsupported(maze_dist_cache_t *p_cache,
+                                 maze_dist_field_t *p_field,
+                                 maze_idx_t         cell_idx,
+                                 size_t            *p_num_raised);
+
+static maze_dist_t get_lookahead(const maze_dist_cache_t *p_cache,
+                                 maze_dist_field_t       *p_field,
+                                 maze_idx_t               cell_idx);
+
+static bool has_unreached_neighbour(const maze_grid_t *p_grid,
+                                    const maze_dist_t *p_dists,
+                                    maze_idx_t         cell_idx);
+
+static uint8_t get_adjacent_cells(const maze_grid_t *p_grid,
+                                  maze_idx_t         cell_idx,
+                                  maze_idx_t        *p_adjacent);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a cache of distance fields for a grid maze. No field is
+ * flooded until its goal is got.
+ *
+ * @param[in] p_grid Pointer to the grid maze. It must outlive the cache.
+ * @param[in] num_fields Number of goals that the cache holds at once.
+ * @return maze_dist_cache_t Cache of distance fields. It has no fields if
+ * they could not be allocated, in which case every get returns NULL.
+ *
+ * @warning The cache must be destroyed by @ref maze_dist_cache_destroy.
+ */
+maze_dist_cache_t
+maze_dist_cache_create (const maze_grid_t *p_grid, uint8_t num_fields)
+{
+    size_t            num_cells = MAZE_GRID_CELLS(p_grid);
+    maze_dist_cache_t cache     = {
+        .p_grid      = p_grid,
+        .p_fields    = NULL,
+        .p_queue     = NULL,
+        .p_is_queued = NULL,
+        .version     = 0,
+        .tick        = 0,
+        .num_floods  = 0,
+        .num_fields  = num_fields,
+    };
+
+    if (0 == num_fields)
+    {
+        return cache;
+    }
+
+    cache.p_fields    = maze_malloc(sizeof(maze_dist_field_t) * num_fields);
+    cache.p_queue     = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    cache.p_is_queued = maze_calloc(num_cells, sizeof(uint8_t));
+
+    bool is_failed = NULL == cache.p_fields || NULL == cache.p_queue
+                     || NULL == cache.p_is_queued;
+
+    for (uint8_t field = 0; !is_failed && num_fields > field; field++)
+    {
+        maze_dist_field_t *p_field = &cache.p_fields[field];
+
+        p_field->p_dists      = maze_malloc(sizeof(maze_dist_t) * num_cells);
+        p_field->goal_idx     = 0;
+        p_field->version      = 0;
+        p_field->last_used    = 0;
+        p_field->is_used      = false;
+        p_field->is_saturated = false;
+        is_failed             = NULL == p_field->p_dists;
+
+        if (is_failed)
+        {
+            // Only the fields before this one are freed on destruction.
+            //
+            cache.num_fields = field;
+        }
+    }
+
+    if (is_failed)
+    {
+        maze_dist_cache_destroy(&cache);
+    }
+
+    return cache;
+}
+
+/**
+ * @brief Destroys a cache of distance fields.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ */
+void
+maze_dist_cache_destroy (maze_dist_cache_t *p_cache)
+{
+    if (NULL != p_cache->p_fields)
+    {
+        for (uint8_t field = 0; p_cache->num_fields > field; field++)
+        {
+            maze_free(p_cache->p_fields[field].p_dists);
+        }
+    }
+
+    maze_free(p_cache->p_fields);
+    maze_free(p_cache->p_queue);
+    maze_free(p_cache->p_is_queued);
+    p_cache->p_fields    = NULL;
+    p_cache->p_queue     = NULL;
+    p_cache->p_is_queued = NULL;
+    p_cache->num_fields  = 0;
+}
+
+/**
+ * @brief Gets the distance field of a goal cell. A field that matches the
+ * current walls is returned as is. Otherwise the goal is flooded, into its old
+ * field if it has one, or else into the least recently used field.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ * @param[in] p_goal Pointer to the goal cell.
+ * @return const maze_dist_field_t* Pointer to the field, NULL if the cache
+ * has no fields. It is valid until the next get, which may evict it.
+ */
+const maze_dist_field_t *
+maze_dist_cache_get (maze_dist_cache_t      *p_cache,
+                     const maze_grid_cell_t *p_goal)
+{
+    if (0 == p_cache->num_fields)
+    {
+        return NULL;
+    }
+
+    maze_idx_t         goal_idx = maze_get_cell_idx(p_cache->p_grid, p_goal);
+    maze_dist_field_t *p_victim = NULL;
+
+    p_cache->tick++;
+
+    // Step 1: Look for the field of the goal, and failing that, pick an unused
+    // field or the least recently used one.
+    //
+    for (uint8_t field = 0; p_cache->num_fields > field; field++)
+    {
+        maze_dist_field_t *p_field = &p_cache->p_fields[field];
+
+        if (p_field->is_used && goal_idx == p_field->goal_idx)
+        {
+            p_victim = p_field;
+            break;
+        }
+
+        if (NULL == p_victim
+            || (p_victim->is_used
+                && (!p_field->is_used
+                    || p_field->last_used < p_victim->last_used)))
+        {
+            p_victim = p_field;
+        }
+    }
+
+    // Step 2: Flood the field unless it already matches the walls.
+    //
+    if (!p_victim->is_used || goal_idx != p_victim->goal_idx
+        || p_cache->version != p_victim->version)
+    {
+        flood_field(p_cache, p_victim, goal_idx);
+    }
+
+    p_victim->last_used = p_cache->tick;
+
+    return p_victim;
+}
+
+/**
+ * @brief Repairs every field after the walls of a node have changed, e.g. by
+ * @ref maze_nav_modify_walls, or its cost has, e.g. by @ref
+ * maze_set_cell_cost. Only the cells whose distance changed are visited, so
+ * this is much cheaper than flooding the fields again.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ * @param[in] p_node Pointer to the node whose walls or cost have changed.
+ *
+ * @note Call this once for every node whose walls or cost change. Changes made
+ * without it must be followed by @ref maze_dist_cache_invalidate.
+ */
+void
+maze_dist_cache_update_walls (maze_dist_cache_t      *p_cache,
+                              const maze_grid_cell_t *p_node)
+{
+    maze_idx_t node_idx    = maze_get_cell_idx(p_cache->p_grid, p_node);
+    uint32_t   old_version = p_cache->version;
+
+    p_cache->version++;
+
+    for (uint8_t field = 0; p_cache->num_fields > field; field++)
+    {
+        maze_dist_field_t *p_field = &p_cache->p_fields[field];
+
+        // A field that was already stale is flooded when it is next got.
+        //
+        if (p_field->is_used && old_version == p_field->version)
+        {
+            repair_field(p_cache, p_field, node_idx);
+            p_field->version = p_cache->version;
+        }
+    }
+}
+
+/**
+ * @brief Marks every field as not matching the walls of the maze, so that
+ * each is flooded again when it is next got.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ *
+ * @note Call this after changing many walls at once, e.g. with @ref
+ * maze_deserialise.
+ */
+void
+maze_dist_cache_invalidate (maze_dist_cache_t *p_cache)
+{
+    p_cache->version++;
+}
+
+/**
+ * @brief Gets the best move from a node towards the goal of a field.
+ *
+ * @param[in] p_cache Pointer to the cache.
+ * @param[in] p_field Pointer to the field.
+ * @param[in] p_node Pointer to the node.
+ * @return maze_cardinal_direction_t Direction of the first neighbour on a
+ * shortest path to the goal, MAZE_NONE if the node is the goal or cannot reach
+ * it.
+ */
+maze_cardinal_direction_t
+maze_dist_cache_get_next_dir (const maze_dist_cache_t *p_cache,
+                              const maze_dist_field_t *p_field,
+                              const maze_grid_cell_t  *p_node)
+{
+    const maze_grid_t *p_grid = p_cache->p_grid;
+    maze_dist_t dist = p_field->p_dists[maze_get_cell_idx(p_grid, p_node)];
+
+    if (0 == dist || MAZE_DIST_CACHE_UNREACHABLE == dist)
+    {
+        return MAZE_NONE;
+    }
+
+    // The best neighbour is one whose distance is the node's distance less
+    // the cost of entering it.
+    //
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        const maze_grid_cell_t *p_next = p_node->p_next[direction];
+
+        if (NULL == p_next)
+        {
+            continue;
+        }
+
+        maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+        if ((dist_sum_t)dist
+            == (dist_sum_t)p_field->p_dists[next_idx]
+                   + MAZE_CELL_COST(p_grid, next_idx))
+        {
+            return (maze_cardinal_direction_t)direction;
+        }
+    }
+
+    return MAZE_NONE;
+}
+
+/**
+ * @brief Gets the shortest path from a node to the goal of a field
+ * (inclusive) by following the best move from each node.
+ *
+ * @param[in] p_cache Pointer to the cache.
+ * @param[in] p_field Pointer to the field.
+ * @param[in] p_start Pointer to the start node.
+ * @return a_star_path_t* Pointer to the path, NULL if the goal cannot be
+ * reached. The `p_came_from` field of each path cell points to the previous
+ * cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ */
+a_star_path_t *
+maze_dist_cache_get_path (const maze_dist_cache_t *p_cache,
+                          const maze_dist_field_t *p_field,
+                          const maze_grid_cell_t  *p_start)
+{
+    const maze_grid_t *p_grid = p_cache->p_grid;
+    maze_dist_t dist = p_field->p_dists[maze_get_cell_idx(p_grid, p_start)];
+
+    if (MAZE_DIST_CACHE_UNREACHABLE == dist)
+    {
+        return NULL;
+    }
+
+    // Cell costs make the distance differ from the number of moves, so the
+    // path is counted first.
+    //
+    uint32_t                path_length = 1u;
+    const maze_grid_cell_t *p_node      = p_start;
+
+    while (0 < p_field->p_dists[maze_get_cell_idx(p_grid, p_node)])
+    {
+        p_node = p_node->p_next[maze_dist_cache_get_next_dir(
+            p_cache, p_field, p_node)];
+        path_length++;
+    }
+
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_path;
+
+    p_node = p_start;
+
+    for (uint32_t index = 0; path_length > index; index++)
+    {
+        maze_grid_cell_t *p_cell = &p_path[index];
+        *p_cell                  = *p_node;
+        p_cell->f                = dist;
+        p_cell->h = p_field->p_dists[maze_get_cell_idx(p_grid, p_node)];
+        p_cell->g = dist - p_cell->h;
+        p_cell->p_came_from = (0 < index) ? &p_path[index - 1] : NULL;
+
+        if (path_length - 1u > index)
+        {
+            p_node = p_node->p_next[maze_dist_cache_get_next_dir(
+                p_cache, p_field, p_node)];
+        }
+    }
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Checks whether every distance of a grid maze fits in a field. Paths
+ * that cost as much as @ref MAZE_DIST_CACHE_UNREACHABLE or more read as
+ * unreachable, which can only happen if the most expensive simple path does.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @return true If no path to a goal is too long to store.
+ * @return false If the cells, weighted by the highest cell cost, are too many.
+ */
+bool
+maze_dist_cache_is_exact (const maze_grid_t *p_grid)
+{
+    uint64_t num_cells = MAZE_GRID_CELLS(p_grid);
+    uint64_t num_moves = (0 < num_cells) ? num_cells - 1u : 0;
+
+    return num_moves * p_grid->max_cost < MAZE_DIST_CACHE_UNREACHABLE;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Floods a field from its goal with a breadth-first search, or on a
+ * maze with cell costs, by lowering distances from the goal until they settle.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ * @param[in,out] p_field Pointer to the field.
+ * @param[in] goal_idx Index of the goal cell.
+ */
+static void
+flood_field (maze_dist_cache_t *p_cache,
+             maze_dist_field_t *p_field,
+             maze_idx_t         goal_idx)
+{
+    const maze_grid_t *p_grid    = p_cache->p_grid;
+    size_t             num_cells = MAZE_GRID_CELLS(p_grid);
+    maze_dist_t       *p_dists   = p_field->p_dists;
+    maze_idx_t        *p_queue   = p_cache->p_queue;
+    size_t             head      = 0;
+    size_t             tail      = 0;
+
+    for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_dists[cell_idx] = MAZE_DIST_CACHE_UNREACHABLE;
+    }
+
+    p_dists[goal_idx]     = 0;
+    p_field->is_saturated = false;
+
+    if (NULL != p_grid->p_costs)
+    {
+        // Cell costs break the breadth-first order, so the distances are
+        // lowered from the goal until they settle instead.
+        //
+        p_queue[0]                     = goal_idx;
+        p_cache->p_is_queued[goal_idx] = true;
+        lower_queued(p_cache, p_field, 1u);
+    }
+    else
+    {
+        p_queue[tail++] = goal_idx;
+    }
+
+    while (head < tail)
+    {
+        maze_idx_t              cell_idx = p_queue[head++];
+        const maze_grid_cell_t *p_cell   = &p_grid->p_grid_array[cell_idx];
+        maze_dist_t next_dist = (maze_dist_t)(p_dists[cell_idx] + 1u);
+
+        // Cells too far to store read as unreachable.
+        //
+        if (MAZE_DIST_CACHE_UNREACHABLE == next_dist)
+        {
+            p_field->is_saturated
+                |= has_unreached_neighbour(p_grid, p_dists, cell_idx);
+            continue;
+        }
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL == p_next)
+            {
+                continue;
+            }
+
+            maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+            if (MAZE_DIST_CACHE_UNREACHABLE == p_dists[next_idx])
+            {
+                p_dists[next_idx] = next_dist;
+                p_queue[tail++]   = next_idx;
+            }
+        }
+    }
+
+    p_field->goal_idx = goal_idx;
+    p_field->version  = p_cache->version;
+    p_field->is_used  = true;
+    p_cache->num_floods++;
+}
+
+/**
+ * @brief Repairs a field after the walls of a node have changed. Only the
+ * edges between the node and its adjacent cells can have changed, so only
+ * those cells can be out of step with their neighbours to begin with.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ * @param[in,out] p_field Pointer to the field.
+ * @param[in] node_idx Index of the node whose walls have changed.
+ */
+static void
+repair_field (maze_dist_cache_t *p_cache,
+              maze_dist_field_t *p_field,
+              maze_idx_t         node_idx)
+{
+    const maze_grid_t *p_grid      = p_cache->p_grid;
+    maze_dist_t       *p_dists     = p_field->p_dists;
+    maze_idx_t        *p_queue     = p_cache->p_queue;
+    uint8_t           *p_is_queued = p_cache->p_is_queued;
+    size_t             num_raised  = 0;
+    maze_idx_t         seeds[5];
+
+    seeds[0]          = node_idx;
+    uint8_t num_seeds = 1u + get_adjacent_cells(p_grid, node_idx, &seeds[1]);
+
+    // Step 1: Raise every cell that no longer has a neighbour on a shortest
+    // path to the goal. Raising a cell can take the support of its
+    // neighbours, so they are checked in turn. The raised cells are kept at
+    // the front of the queue.
+    //
+    for (uint8_t seed = 0; num_seeds > seed; seed++)
+    {
+        raise_if_unsupported(p_cache, p_field, seeds[seed], &num_raised);
+    }
+
+    for (size_t raised = 0; num_raised > raised; raised++)
+    {
+        const maze_grid_cell_t *p_cell
+            = &p_grid->p_grid_array[p_queue[raised]];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            if (NULL != p_cell->p_next[direction])
+            {
+                raise_if_unsupported(
+                    p_cache,
+                    p_field,
+                    maze_get_cell_idx(p_grid, p_cell->p_next[direction]),
+                    &num_raised);
+            }
+        }
+    }
+
+    // Step 2: Give each raised cell the distance through its closest
+    // neighbour, and queue the seeds behind the raised cells.
+    //
+    for (size_t raised = 0; num_raised > raised; raised++)
+    {
+        p_dists[p_queue[raised]]
+            = get_lookahead(p_cache, p_field, p_queue[raised]);
+    }
+
+    size_t num_queue = num_raised;
+
+    for (uint8_t seed = 0; num_seeds > seed; seed++)
+    {
+        if (!p_is_queued[seeds[seed]])
+        {
+            p_is_queued[seeds[seed]] = true;
+            p_queue[num_queue++]     = seeds[seed];
+        }
+    }
+
+    // Step 3: Lower the neighbours of the queued cells.
+    //
+    lower_queued(p_cache, p_field, num_queue);
+}
+
+/**
+ * @brief Lowers the neighbours of queued cells until no cell can be lowered
+ * through a neighbour. A cell is queued at most once at a time, so the ring
+ * queue cannot overflow.
+ *
+ * @param[in,out] p_cache Pointer to the cache, with the queued cells at the
+ * front of its queue.
+ * @param[in,out] p_field Pointer to the field.
+ * @param[in] num_queue Number of queued cells.
+ */
+static void
+lower_queued (maze_dist_cache_t *p_cache,
+              maze_dist_field_t *p_field,
+              size_t             num_queue)
+{
+    const maze_grid_t *p_grid      = p_cache->p_grid;
+    size_t             num_cells   = MAZE_GRID_CELLS(p_grid);
+    maze_dist_t       *p_dists     = p_field->p_dists;
+    maze_idx_t        *p_queue     = p_cache->p_queue;
+    uint8_t           *p_is_queued = p_cache->p_is_queued;
+    size_t             head        = 0;
+
+    while (0 < num_queue)
+    {
+        maze_idx_t cell_idx = p_queue[head];
+        head                = (head + 1u) % num_cells;
+        num_queue--;
+        p_is_queued[cell_idx] = false;
+
+        // Cells too far to store read as unreachable.
+        //
+        dist_sum_t next_dist = (dist_sum_t)p_dists[cell_idx]
+                               + MAZE_CELL_COST(p_grid, cell_idx);
+
+        if (MAZE_DIST_CACHE_UNREACHABLE <= next_dist)
+        {
+            p_field->is_saturated
+                |= MAZE_DIST_CACHE_UNREACHABLE != p_dists[cell_idx]
+                   && has_unreached_neighbour(p_grid, p_dists, cell_idx);
+            continue;
+        }
+
+        const maze_grid_cell_t *p_cell = &p_grid->p_grid_array[cell_idx];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL == p_next)
+            {
+                continue;
+            }
+
+            maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+            if (next_dist < p_dists[next_idx])
+            {
+                p_dists[next_idx] = (maze_dist_t)next_dist;
+
+                if (!p_is_queued[next_idx])
+                {
+                    p_is_queued[next_idx] = true;
+                    p_queue[(head + num_queue) % num_cells] = next_idx;
+                    num_queue++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Raises a cell to unreachable if none of its neighbours is on a
+ * shortest path to the goal, and appends it to the raised cells at the front
+ * of the queue.
+ *
+ * @param[in,out] p_cache Pointer to the cache.
+ * @param[in,out] p_field Pointer to the field.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in,out] p_num_raised Pointer to the number of raised cells.
+ */
+static void
+raise_if_unsupported (maze_dist_cache_t *p_cache,
+                      maze_dist_field_t *p_field,
+                      maze_idx_t         cell_idx,
+                      size_t            *p_num_raised)
+{
+    const maze_grid_t      *p_grid  = p_cache->p_grid;
+    maze_dist_t            *p_dists = p_field->p_dists;
+    const maze_grid_cell_t *p_cell  = &p_grid->p_grid_array[cell_idx];
+
+    if (p_field->goal_idx == cell_idx
+        || MAZE_DIST_CACHE_UNREACHABLE == p_dists[cell_idx])
+    {
+        return;
+    }
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+        if (NULL == p_next)
+        {
+            continue;
+        }
+
+        maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+        if ((dist_sum_t)p_dists[cell_idx]
+            == (dist_sum_t)p_dists[next_idx] + MAZE_CELL_COST(p_grid, next_idx))
+        {
+            return;
+        }
+    }
+
+    p_dists[cell_idx]                   = MAZE_DIST_CACHE_UNREACHABLE;
+    p_cache->p_is_queued[cell_idx]      = true;
+    p_cache->p_queue[(*p_num_raised)++] = cell_idx;
+}
+
+/**
+ * @brief Gets the distance of a cell through its closest neighbour.
+ *
+ * @param[in] p_cache Pointer to the cache.
+ * @param[in] p_field Pointer to the field.
+ * @param[in] cell_idx Index of the cell.
+ * @return maze_dist_t Distance, unreachable if no neighbour reaches the goal
+ * or the distance does not fit, in which case the field is saturated.
+ */
+static maze_dist_t
+get_lookahead (const maze_dist_cache_t *p_cache,
+               maze_dist_field_t       *p_field,
+               maze_idx_t               cell_idx)
+{
+    const maze_grid_t      *p_grid     = p_cache->p_grid;
+    const maze_grid_cell_t *p_cell     = &p_grid->p_grid_array[cell_idx];
+    dist_sum_t              min_dist   = MAZE_DIST_CACHE_UNREACHABLE;
+    bool                    is_cut_off = false;
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+        if (NULL == p_next)
+        {
+            continue;
+        }
+
+        maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+        dist_sum_t dist     = (dist_sum_t)p_field->p_dists[next_idx]
+                              + MAZE_CELL_COST(p_grid, next_idx);
+
+        if (dist < min_dist)
+        {
+            min_dist = dist;
+        }
+
+        is_cut_off
+            |= MAZE_DIST_CACHE_UNREACHABLE != p_field->p_dists[next_idx]
+               && MAZE_DIST_CACHE_UNREACHABLE <= dist;
+    }
+
+    if (MAZE_DIST_CACHE_UNREACHABLE == min_dist && is_cut_off)
+    {
+        p_field->is_saturated = true;
+    }
+
+    return (maze_dist_t)min_dist;
+}
+
+/**
+ * @brief Checks whether a cell has an open neighbour that reads as
+ * unreachable, i.e. one that a distance too large to store would have reached.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[in] p_dists Distances of the field.
+ * @param[in] cell_idx Index of the cell.
+ * @return true If an open neighbour reads as unreachable.
+ * @return false Otherwise.
+ */
+static bool
+has_unreached_neighbour (const maze_grid_t *p_grid,
+                         const maze_dist_t *p_dists,
+                         maze_idx_t         cell_idx)
+{
+    const maze_grid_cell_t *p_cell = &p_grid->p_grid_array[cell_idx];
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+        if (NULL != p_next
+            && MAZE_DIST_CACHE_UNREACHABLE
+                   == p_dists[maze_get_cell_idx(p_grid, p_next)])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Gets the cells adjacent to a cell, whether or not there is a wall
+ * between them.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[out] p_adjacent Array of at least 4 indices.
+ * @return uint8_t Number of adjacent cells.
+ */
+static uint8_t
+get_adjacent_cells (const maze_grid_t *p_grid,
+                    maze_idx_t         cell_idx,
+                    maze_idx_t        *p_adjacent)
+{
+    uint16_t columns      = MAZE_GRID_COLS(p_grid);
+    uint16_t row          = (uint16_t)(cell_idx / columns);
+    uint16_t col          = (uint16_t)(cell_idx % columns);
+    uint8_t  num_adjacent = 0;
+
+    if (0 < row)
+    {
+        p_adjacent[num_adjacent++] = cell_idx - columns;
+    }
+
+    if (columns - 1u > col)
+    {
+        p_adjacent[num_adjacent++] = cell_idx + 1u;
+    }
+
+    if (MAZE_GRID_ROWS(p_grid) - 1u > row)
+    {
+        p_adjacent[num_adjacent++] = cell_idx + columns;
+    }
+
+    if (0 < col)
+    {
+        p_adjacent[num_adjacent++] = cell_idx - 1u;
+    }
+
+    return num_adjacent;
+}
+
+// End of pathfinding/maze_dist_cache.c
@@ -0,0 +1,122 @@
+/**
+ * @file maze_dist_cache.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the cache of goal distance fields. A field holds the
+ * distance from every cell to one goal cell, so the next move towards the goal
+ * from any cell is read from its four neighbours instead of flooding the maze
+ * again. Fields are repaired in place when walls change, and the least
+ * recently used field is evicted when a new goal needs a slot.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_DIST_CACHE_H // Include guard.
+#define MAZE_DIST_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/a_star.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_DIST_CACHE_UNREACHABLE
+ * @brief Distance of cells that cannot reach the goal. Cells whose paths to
+ * the goal cost this much or more read as unreachable too, which only happens
+ * on weighted grids in the 16-bit build, and marks the field as saturated,
+ * @see maze_dist_cache_is_exact.
+ */
+#if 32 == MAZE_IDX_WIDTH
+#define MAZE_DIST_CACHE_UNREACHABLE UINT32_MAX
+#else
+#define MAZE_DIST_CACHE_UNREACHABLE UINT16_MAX
+#endif
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Distance in a field. It is as wide as the cell indices, so that every
+ * distance of an unweighted grid fits: 16 bits on the Pico, and 32 bits on
+ * large maps, where one corridor can be longer than 65534 cells.
+ */
+#if 32 == MAZE_IDX_WIDTH
+typedef uint32_t maze_dist_t;
+#else
+typedef uint16_t maze_dist_t;
+#endif
+
+/**
+ * @brief This struct contains the distance field of one goal cell.
+ */
+typedef struct maze_dist_field
+{
+    maze_dist_t *p_dists;      ///< Distance from each cell to the goal.
+    maze_idx_t   goal_idx;     ///< Index of the goal cell.
+    uint32_t     version;      ///< Version of the map that the distances match.
+    uint32_t     last_used;    ///< Tick of the cache when the field was last
+                               ///< got.
+    bool         is_used;      ///< Whether the field holds a goal.
+    bool         is_saturated; ///< Whether some cell may read as unreachable
+                               ///< only because its distance does not fit.
+} maze_dist_field_t;
+
+/**
+ * @brief This struct contains the distance fields of a grid maze and the
+ * scratch space shared by their floods. @see maze_dist_cache
+ *
+ * @note The memory is bounded by the number of fields given on creation: one
+ * distance per cell per field, and one index and one byte per cell of scratch.
+ */
+typedef struct maze_dist_cache
+{
+    const maze_grid_t *p_grid;      ///< Grid maze of the fields.
+    maze_dist_field_t *p_fields;    ///< Fields of the cache.
+    maze_idx_t        *p_queue;     ///< Ring queue of the floods and repairs.
+    uint8_t           *p_is_queued; ///< Whether each cell is in the queue.
+    uint32_t           version;     ///< Version of the map, raised whenever
+                                    ///< the walls change.
+    uint32_t           tick;        ///< Clock of the least recently used
+                                    ///< eviction.
+    uint32_t           num_floods;  ///< Number of fields flooded from scratch.
+    uint8_t            num_fields;  ///< Number of fields.
+} maze_dist_cache_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+maze_dist_cache_t maze_dist_cache_create(const maze_grid_t *p_grid,
+                                         uint8_t            num_fields);
+
+void maze_dist_cache_destroy(maze_dist_cache_t *p_cache);
+
+const maze_dist_field_t *maze_dist_cache_get(maze_dist_cache_t      *p_cache,
+                                             const maze_grid_cell_t *p_goal);
+
+void maze_dist_cache_update_walls(maze_dist_cache_t      *p_cache,
+                                  const maze_grid_cell_t *p_node);
+
+void maze_dist_cache_invalidate(maze_dist_cache_t *p_cache);
+
+maze_cardinal_direction_t maze_dist_cache_get_next_dir(
+    const maze_dist_cache_t *p_cache,
+    const maze_dist_field_t *p_field,
+    const maze_grid_cell_t  *p_node);
+
+a_star_path_t *maze_dist_cache_get_path(const maze_dist_cache_t *p_cache,
+                                        const maze_dist_field_t *p_field,
+                                        const maze_grid_cell_t  *p_start);
+
+bool maze_dist_cache_is_exact(const maze_grid_t *p_grid);
+
+#endif // MAZE_DIST_CACHE_H
+
+// End of pathfinding/maze_dist_cache.h
@@ -0,0 +1,940 @@
+/**
+ * @file maze_graph.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the junction graph of a grid maze. Each corridor cell
+ * stores its edge and how far along the edge it is, so an edge can be removed
+ * and traced again without walking the whole maze.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/maze_graph.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_GRAPH_NUM_AFFECTED
+ * @brief Number of cells whose gaps can change when the walls of one cell
+ * change: the cell and its 4 adjacent cells.
+ */
+#define MAZE_GRAPH_NUM_AFFECTED 5u
+
+/**
+ * @def MAZE_GRAPH_PENDING_SLACK
+ * @brief Number of cells to repair on top of the corridor cells of the removed
+ * edges: the affected cells, and both nodes of up to 4 edges of each.
+ */
+#define MAZE_GRAPH_PENDING_SLACK (MAZE_GRAPH_NUM_AFFECTED * 9u)
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_idx_t get_adjacent_idx(const maze_grid_t        *p_grid,
+                                   maze_idx_t                cell_idx,
+                                   maze_cardinal_direction_t direction);
+
+static uint8_t get_num_gaps(const maze_grid_cell_t *p_cell);
+
+static maze_cardinal_direction_t get_corridor_dir(
+    const maze_grid_cell_t   *p_cell,
+    maze_cardinal_direction_t direction);
+
+static void trace_edge(maze_graph_t             *p_graph,
+                       maze_idx_t                node_idx,
+                       maze_cardinal_direction_t direction);
+
+static void remove_edge(maze_graph_t *p_graph,
+                        maze_idx_t    edge_idx,
+                        maze_idx_t   *p_num_pending);
+
+static void repair_cell(maze_graph_t *p_graph, maze_idx_t cell_idx);
+
+static void walk_edge(const maze_graph_t *p_graph,
+                      maze_idx_t          edge_idx,
+                      bool                is_from_start,
+                      uint32_t            first_step,
+                      uint32_t            last_step,
+                      maze_idx_t         *p_cells,
+                      int8_t              stride);
+
+static maze_priority_t get_priority(uint32_t g_score,
+                                    uint32_t h_score,
+                                    uint64_t h_scale);
+
+static a_star_path_t *get_path(const maze_grid_t *p_grid,
+                               const maze_idx_t  *p_cells,
+                               uint32_t           path_length);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Builds the junction graph of a grid maze.
+ *
+ * @param[in] p_grid Pointer to the grid maze. It must outlive the graph.
+ * @return maze_graph_t Junction graph. Its arrays are NULL if they could not
+ * be allocated.
+ *
+ * @warning The graph must be destroyed by @ref maze_graph_destroy.
+ */
+maze_graph_t
+maze_graph_create (const maze_grid_t *p_grid)
+{
+    // Step 1: Allocate the graph. Every edge has at least one gap, and there
+    // are fewer than 2 gaps per cell, so there are fewer than 2 edges per
+    // cell.
+    //
+    maze_idx_t   num_cells     = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    size_t       edge_capacity = (size_t)num_cells * 2u;
+    maze_graph_t graph         = {
+                .p_grid         = p_grid,
+                .p_edges        = NULL,
+                .p_free_edges   = NULL,
+                .p_node_edges   = NULL,
+                .p_cell_edges   = NULL,
+                .p_offsets      = NULL,
+                .p_is_node      = NULL,
+                .p_pending      = NULL,
+                .num_free_edges = 0,
+                .num_nodes      = 0,
+                .num_edges      = 0,
+    };
+
+    if (MAZE_GRAPH_NO_EDGE <= edge_capacity)
+    {
+        return graph;
+    }
+
+    graph.p_edges      = maze_malloc(sizeof(maze_graph_edge_t) * edge_capacity);
+    graph.p_free_edges = maze_malloc(sizeof(maze_idx_t) * edge_capacity);
+    graph.p_node_edges = maze_malloc(sizeof(maze_idx_t) * num_cells * 4u);
+    graph.p_cell_edges = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    graph.p_offsets    = maze_malloc(sizeof(uint32_t) * num_cells);
+    graph.p_is_node    = maze_malloc(sizeof(uint8_t) * num_cells);
+    graph.p_pending    = maze_malloc(
+        sizeof(maze_idx_t) * (num_cells + MAZE_GRAPH_PENDING_SLACK));
+
+    if (NULL == graph.p_edges || NULL == graph.p_free_edges
+        || NULL == graph.p_node_edges || NULL == graph.p_cell_edges
+        || NULL == graph.p_offsets || NULL == graph.p_is_node
+        || NULL == graph.p_pending)
+    {
+        maze_graph_destroy(&graph);
+        return graph;
+    }
+
+    // Step 2: Free every edge, so that the lowest index is used first.
+    //
+    for (size_t edge_idx = edge_capacity; 0 < edge_idx; edge_idx--)
+    {
+        graph.p_free_edges[graph.num_free_edges] = (maze_idx_t)(edge_idx - 1);
+        graph.num_free_edges++;
+    }
+
+    // Step 3: Find the nodes, then trace the edges from every cell.
+    //
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        graph.p_is_node[cell_idx]
+            = 2 != get_num_gaps(&p_grid->p_grid_array[cell_idx]);
+        graph.num_nodes += graph.p_is_node[cell_idx];
+        graph.p_cell_edges[cell_idx] = MAZE_GRAPH_NO_EDGE;
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            graph.p_node_edges[cell_idx * 4u + direction] = MAZE_GRAPH_NO_EDGE;
+        }
+    }
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        repair_cell(&graph, cell_idx);
+    }
+
+    return graph;
+}
+
+/**
+ * @brief Destroys a junction graph.
+ *
+ * @param[in,out] p_graph Pointer to the graph.
+ */
+void
+maze_graph_destroy (maze_graph_t *p_graph)
+{
+    maze_free(p_graph->p_edges);
+    maze_free(p_graph->p_free_edges);
+    maze_free(p_graph->p_node_edges);
+    maze_free(p_graph->p_cell_edges);
+    maze_free(p_graph->p_offsets);
+    maze_free(p_graph->p_is_node);
+    maze_free(p_graph->p_pending);
+
+    p_graph->p_edges      = NULL;
+    p_graph->p_free_edges = NULL;
+    p_graph->p_node_edges = NULL;
+    p_graph->p_cell_edges = NULL;
+    p_graph->p_offsets    = NULL;
+    p_graph->p_is_node    = NULL;
+    p_graph->p_pending    = NULL;
+}
+
+/**
+ * @brief Repairs the graph after the walls of a node were changed, e.g. by
+ * @ref maze_nav_modify_walls. The edges through the node and its adjacent
+ * cells are removed and traced again, and the rest of the graph is kept.
+ *
+ * @param[in,out] p_graph Pointer to the graph.
+ * @param[in] p_node Pointer to the node whose walls changed.
+ */
+void
+maze_graph_update_walls (maze_graph_t *p_graph, const maze_grid_cell_t *p_node)
+{
+    const maze_grid_t *p_grid      = p_graph->p_grid;
+    maze_idx_t         num_pending = 0;
+    maze_idx_t         affected[MAZE_GRAPH_NUM_AFFECTED];
+    uint8_t            num_affected = 0;
+
+    affected[num_affected++] = maze_get_cell_idx(p_grid, p_node);
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        maze_idx_t adjacent_idx
+            = get_adjacent_idx(p_grid, affected[0], direction);
+
+        if (MAZE_IDX_MAX != adjacent_idx)
+        {
+            affected[num_affected++] = adjacent_idx;
+        }
+    }
+
+    // Step 1: Remove every edge that passes through or leaves an affected
+    // cell. The cells of those edges are listed to be repaired.
+    //
+    for (uint8_t idx = 0; num_affected > idx; idx++)
+    {
+        maze_idx_t cell_idx = affected[idx];
+
+        if (p_graph->p_is_node[cell_idx])
+        {
+            for (uint8_t direction = 0; 4 > direction; direction++)
+            {
+                maze_idx_t edge_idx
+                    = p_graph->p_node_edges[cell_idx * 4u + direction];
+
+                if (MAZE_GRAPH_NO_EDGE != edge_idx)
+                {
+                    remove_edge(p_graph, edge_idx, &num_pending);
+                }
+            }
+        }
+        else if (MAZE_GRAPH_NO_EDGE != p_graph->p_cell_edges[cell_idx])
+        {
+            remove_edge(
+                p_graph, p_graph->p_cell_edges[cell_idx], &num_pending);
+        }
+
+        p_graph->p_pending[num_pending++] = cell_idx;
+    }
+
+    // Step 2: The affected cells may have become nodes or corridor cells.
+    //
+    for (uint8_t idx = 0; num_affected > idx; idx++)
+    {
+        maze_idx_t cell_idx = affected[idx];
+        bool       is_node
+            = 2 != get_num_gaps(&p_grid->p_grid_array[cell_idx]);
+
+        p_graph->num_nodes += (maze_idx_t)is_node;
+        p_graph->num_nodes -= p_graph->p_is_node[cell_idx];
+        p_graph->p_is_node[cell_idx] = is_node;
+    }
+
+    // Step 3: Trace the edges of the listed cells again.
+    //
+    for (maze_idx_t idx = 0; num_pending > idx; idx++)
+    {
+        repair_cell(p_graph, p_graph->p_pending[idx]);
+    }
+}
+
+/**
+ * @brief Runs A* over the junction graph, and expands the path found into
+ * every cell in between. The start and end nodes can be corridor cells, in
+ * which case the search leaves or enters them along their edges. Dead ends
+ * are never expanded unless the end node is in them.
+ *
+ * @param[in] p_graph Pointer to the graph.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[out] p_num_expanded Number of graph nodes taken from the open set,
+ * or NULL.
+ * @return a_star_path_t* Path from the start node to the end node (inclusive),
+ * NULL if no path exists. The `p_came_from` field of each path cell points to
+ * the previous cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ * @note The open set is always the binary heap, since the edges are not unit
+ * costs.
+ * @note The edges only count moves, so mazes with cell costs are searched
+ * cell by cell with @ref a_star_jps instead, and the nodes expanded are
+ * cells. The graph holds no costs, so it need not be repaired when they
+ * change.
+ */
+a_star_path_t *
+maze_graph_find_path (const maze_graph_t     *p_graph,
+                      const maze_grid_cell_t *p_start_node,
+                      const maze_grid_cell_t *p_end_node,
+                      uint32_t               *p_num_expanded)
+{
+    const maze_grid_t *p_grid    = p_graph->p_grid;
+    maze_idx_t         num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    maze_idx_t         start_idx = maze_get_cell_idx(p_grid, p_start_node);
+    maze_idx_t         end_idx   = maze_get_cell_idx(p_grid, p_end_node);
+
+    if (NULL != p_grid->p_costs)
+    {
+        return a_star_jps(p_grid, p_start_node, p_end_node, p_num_expanded);
+    }
+
+    // Step 1: Initialise the open set heap and the search arrays. Each node
+    // keeps the edge that it was reached along.
+    //
+    binary_heap_t  open_set     = binary_heap_create(num_cells);
+    uint32_t      *p_g          = maze_malloc(sizeof(uint32_t) * num_cells);
+    maze_idx_t    *p_came_from  = maze_malloc(sizeof(maze_idx_t) * num_cells);
+    maze_idx_t    *p_cells      = NULL;
+    a_star_path_t *p_path       = NULL;
+    uint32_t       num_expanded = 0;
+
+    if (NULL == open_set.p_array || NULL == open_set.p_positions
+        || NULL == p_g || NULL == p_came_from)
+    {
+        goto end;
+    }
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_g[cell_idx] = UINT32_MAX;
+    }
+
+    // Step 2: Find the nodes that the path can leave the start node from, and
+    // the nodes that it can enter the end node from, with their distances.
+    //
+    maze_idx_t seeds[2]       = { start_idx, start_idx };
+    uint32_t   seed_dists[2]  = { 0, 0 };
+    maze_idx_t goals[2]       = { end_idx, end_idx };
+    uint32_t   goal_dists[2]  = { 0, 0 };
+    maze_idx_t start_edge_idx = p_graph->p_cell_edges[start_idx];
+    maze_idx_t end_edge_idx   = p_graph->p_cell_edges[end_idx];
+
+    if (!p_graph->p_is_node[start_idx])
+    {
+        const maze_graph_edge_t *p_edge = &p_graph->p_edges[start_edge_idx];
+        seeds[0]      = p_edge->from_idx;
+        seeds[1]      = p_edge->to_idx;
+        seed_dists[0] = p_graph->p_offsets[start_idx];
+        seed_dists[1] = p_edge->length - seed_dists[0];
+    }
+
+    if (!p_graph->p_is_node[end_idx])
+    {
+        const maze_graph_edge_t *p_edge = &p_graph->p_edges[end_edge_idx];
+        goals[0]      = p_edge->from_idx;
+        goals[1]      = p_edge->to_idx;
+        goal_dists[0] = p_graph->p_offsets[end_idx];
+        goal_dists[1] = p_edge->length - goal_dists[0];
+    }
+
+    // A path along the corridor that both nodes are on is a candidate too.
+    //
+    uint32_t   best_cost = UINT32_MAX;
+    maze_idx_t best_goal = MAZE_IDX_MAX;
+
+    if (!p_graph->p_is_node[start_idx] && !p_graph->p_is_node[end_idx]
+        && start_edge_idx == end_edge_idx)
+    {
+        best_cost = (seed_dists[0] > goal_dists[0])
+                        ? seed_dists[0] - goal_dists[0]
+                        : goal_dists[0] - seed_dists[0];
+    }
+
+    // Ties between equal F-values go to the node nearest the end node, as in
+    // @ref a_star_jps, if the scaled priorities fit.
+    //
+    const maze_point_t *p_end_point = &p_end_node->coordinates;
+    uint64_t            h_scale
+        = (uint64_t)MAZE_GRID_ROWS(p_grid) + MAZE_GRID_COLS(p_grid);
+
+    if ((num_cells + h_scale) * h_scale > MAZE_PRIORITY_MAX)
+    {
+        h_scale = 1;
+    }
+
+    for (uint8_t seed = 0; 2 > seed; seed++)
+    {
+        maze_idx_t seed_idx = seeds[seed];
+
+        if (seed_dists[seed] >= p_g[seed_idx])
+        {
+            continue;
+        }
+
+        uint32_t h_score = maze_manhattan_dist(
+            &p_grid->p_grid_array[seed_idx].coordinates, p_end_point);
+
+        p_g[seed_idx]         = seed_dists[seed];
+        p_came_from[seed_idx] = MAZE_GRAPH_NO_EDGE;
+        binary_heap_decrease_key_idx(
+            &open_set,
+            seed_idx,
+            get_priority(seed_dists[seed], h_score, h_scale));
+    }
+
+    while (0 < open_set.size)
+    {
+        // Step 3: Get the node with the lowest F-value. Stop once it cannot
+        // lead to a cheaper path than the best one found.
+        //
+        binary_heap_node_t current = binary_heap_peek(&open_set);
+        maze_idx_t         current_idx = current.cell_idx;
+        binary_heap_delete_min(&open_set);
+
+        if (current.priority / h_scale >= best_cost)
+        {
+            break;
+        }
+
+        num_expanded++;
+
+        for (uint8_t goal = 0; 2 > goal; goal++)
+        {
+            if (goals[goal] == current_idx
+                && p_g[current_idx] + goal_dists[goal] < best_cost)
+            {
+                best_cost = p_g[current_idx] + goal_dists[goal];
+                best_goal = current_idx;
+            }
+        }
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            // Step 4: Follow each edge to the node at its other end. Dead
+            // ends cannot lead anywhere else.
+            //
+            maze_idx_t edge_idx
+                = p_graph->p_node_edges[current_idx * 4u + direction];
+
+            if (MAZE_GRAPH_NO_EDGE == edge_idx)
+            {
+                continue;
+            }
+
+            const maze_graph_edge_t *p_edge = &p_graph->p_edges[edge_idx];
+            maze_idx_t               neighbour_idx
+                = (p_edge->from_idx == current_idx
+                   && p_edge->from_dir == direction)
+                      ? p_edge->to_idx
+                      : p_edge->from_idx;
+            const maze_grid_cell_t *p_neighbour_node
+                = &p_grid->p_grid_array[neighbour_idx];
+
+            if (neighbour_idx == current_idx
+                || (1 == get_num_gaps(p_neighbour_node)
+                    && goals[0] != neighbour_idx && goals[1] != neighbour_idx))
+            {
+                continue;
+            }
+
+            uint32_t tentative_g_score = p_g[current_idx] + p_edge->length;
+
+            if (tentative_g_score >= p_g[neighbour_idx])
+            {
+                continue;
+            }
+
+            // Step 5: Add the neighbour to the open set, or update its
+            // priority.
+            //
+            uint32_t h_score = maze_manhattan_dist(
+                &p_neighbour_node->coordinates, p_end_point);
+
+            p_g[neighbour_idx]         = tentative_g_score;
+            p_came_from[neighbour_idx] = edge_idx;
+            binary_heap_decrease_key_idx(
+                &open_set,
+                neighbour_idx,
+                get_priority(tentative_g_score, h_score, h_scale));
+        }
+    }
+
+    if (UINT32_MAX == best_cost)
+    {
+        goto end;
+    }
+
+    p_cells = maze_malloc(sizeof(maze_idx_t) * (best_cost + 1u));
+
+    if (NULL == p_cells)
+    {
+        goto end;
+    }
+
+    // Step 6: Expand the path into its cells. If it only runs along the
+    // corridor of both nodes, walk it from the start of the edge.
+    //
+    if (MAZE_IDX_MAX == best_goal)
+    {
+        uint32_t first_step = seed_dists[0];
+        uint32_t last_step  = goal_dists[0];
+        bool     is_forward = first_step <= last_step;
+
+        walk_edge(p_graph,
+                  start_edge_idx,
+                  true,
+                  is_forward ? first_step : last_step,
+                  is_forward ? last_step : first_step,
+                  is_forward ? p_cells : &p_cells[best_cost],
+                  is_forward ? 1 : -1);
+    }
+    else
+    {
+        // Step 6a: From the last node to the end node. The last node is
+        // written first in case no edge is walked.
+        //
+        maze_idx_t node_idx = best_goal;
+        p_cells[p_g[node_idx]] = node_idx;
+
+        if (!p_graph->p_is_node[end_idx])
+        {
+            bool is_from_start = goals[0] == node_idx
+                                 && p_g[node_idx] + goal_dists[0] == best_cost;
+            walk_edge(p_graph,
+                      end_edge_idx,
+                      is_from_start,
+                      0,
+                      goal_dists[is_from_start ? 0 : 1],
+                      &p_cells[p_g[node_idx]],
+                      1);
+        }
+
+        // Step 6b: Along the edges back to the first node.
+        //
+        while (MAZE_GRAPH_NO_EDGE != p_came_from[node_idx])
+        {
+            maze_idx_t               edge_idx = p_came_from[node_idx];
+            const maze_graph_edge_t *p_edge   = &p_graph->p_edges[edge_idx];
+            bool is_from_start = p_edge->to_idx == node_idx;
+
+            node_idx = is_from_start ? p_edge->from_idx : p_edge->to_idx;
+            walk_edge(p_graph,
+                      edge_idx,
+                      is_from_start,
+                      0,
+                      p_edge->length,
+                      &p_cells[p_g[node_idx]],
+                      1);
+        }
+
+        // Step 6c: From the start node to the first node.
+        //
+        if (!p_graph->p_is_node[start_idx])
+        {
+            bool is_from_start = seeds[0] == node_idx
+                                 && seed_dists[0] == p_g[node_idx];
+            walk_edge(p_graph,
+                      start_edge_idx,
+                      is_from_start,
+                      0,
+                      p_g[node_idx],
+                      &p_cells[p_g[node_idx]],
+                      -1);
+        }
+    }
+
+    p_path = get_path(p_grid, p_cells, best_cost + 1u);
+
+end:
+    if (NULL != p_num_expanded)
+    {
+        *p_num_expanded = num_expanded;
+    }
+
+    binary_heap_destroy(&open_set);
+    maze_free(p_g);
+    maze_free(p_came_from);
+    maze_free(p_cells);
+
+    return p_path;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Gets the index of the cell next to a cell, regardless of walls.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] direction Direction of the adjacent cell.
+ * @return maze_idx_t Index of the adjacent cell, MAZE_IDX_MAX if it is outside
+ * the maze.
+ */
+static maze_idx_t
+get_adjacent_idx (const maze_grid_t        *p_grid,
+                  maze_idx_t                cell_idx,
+                  maze_cardinal_direction_t direction)
+{
+    static const int8_t row_offsets[4] = { -1, 0, 1, 0 };
+    static const int8_t col_offsets[4] = { 0, 1, 0, -1 };
+
+    // Moving off the top or left edge wraps around to a large value, so one
+    // comparison per axis checks both edges.
+    //
+    uint16_t row = cell_idx / MAZE_GRID_COLS(p_grid) + row_offsets[direction];
+    uint16_t col = cell_idx % MAZE_GRID_COLS(p_grid) + col_offsets[direction];
+
+    if (MAZE_GRID_ROWS(p_grid) <= row || MAZE_GRID_COLS(p_grid) <= col)
+    {
+        return MAZE_IDX_MAX;
+    }
+
+    return (maze_idx_t)((size_t)row * MAZE_GRID_COLS(p_grid) + col);
+}
+
+/**
+ * @brief Counts the gaps of a cell.
+ *
+ * @param[in] p_cell Pointer to the cell.
+ * @return uint8_t Number of gaps.
+ */
+static uint8_t
+get_num_gaps (const maze_grid_cell_t *p_cell)
+{
+    uint8_t num_gaps = 0;
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        num_gaps += NULL != p_cell->p_next[direction];
+    }
+
+    return num_gaps;
+}
+
+/**
+ * @brief Gets the direction to leave a corridor cell in, given the direction
+ * it was entered in.
+ *
+ * @param[in] p_cell Pointer to the corridor cell.
+ * @param[in] direction Direction that the cell was entered in, or MAZE_NONE
+ * for either gap.
+ * @return maze_cardinal_direction_t Direction of its other gap.
+ */
+static maze_cardinal_direction_t
+get_corridor_dir (const maze_grid_cell_t   *p_cell,
+                  maze_cardinal_direction_t direction)
+{
+    maze_cardinal_direction_t back
+        = (MAZE_NONE == direction) ? MAZE_NONE : (direction + 2) % 4;
+
+    for (uint8_t next_dir = 0; 4 > next_dir; next_dir++)
+    {
+        if (next_dir != back && NULL != p_cell->p_next[next_dir])
+        {
+            return next_dir;
+        }
+    }
+
+    return MAZE_NONE;
+}
+
+/**
+ * @brief Follows the corridor that leaves a node in a direction to the node at
+ * its other end, and adds it as an edge.
+ *
+ * @param[in,out] p_graph Pointer to the graph.
+ * @param[in] node_idx Index of the node.
+ * @param[in] direction Direction of the gap that the corridor leaves through.
+ */
+static void
+trace_edge (maze_graph_t             *p_graph,
+            maze_idx_t                node_idx,
+            maze_cardinal_direction_t direction)
+{
+    const maze_grid_t *p_grid = p_graph->p_grid;
+    maze_idx_t         edge_idx
+        = p_graph->p_free_edges[--p_graph->num_free_edges];
+    maze_graph_edge_t *p_edge = &p_graph->p_edges[edge_idx];
+
+    const maze_grid_cell_t *p_cell
+        = p_grid->p_grid_array[node_idx].p_next[direction];
+    maze_idx_t                cell_idx = maze_get_cell_idx(p_grid, p_cell);
+    maze_cardinal_direction_t cell_dir = direction;
+
+    p_edge->from_idx  = node_idx;
+    p_edge->from_dir  = direction;
+    p_edge->length    = 1;
+    p_edge->num_turns = 0;
+
+    while (!p_graph->p_is_node[cell_idx])
+    {
+        maze_cardinal_direction_t next_dir
+            = get_corridor_dir(p_cell, cell_dir);
+
+        p_graph->p_cell_edges[cell_idx] = edge_idx;
+        p_graph->p_offsets[cell_idx]    = p_edge->length;
+        p_edge->num_turns += next_dir != cell_dir;
+        p_edge->length++;
+
+        cell_dir = next_dir;
+        p_cell   = p_cell->p_next[next_dir];
+        cell_idx = maze_get_cell_idx(p_grid, p_cell);
+    }
+
+    p_edge->to_idx = cell_idx;
+    p_edge->to_dir = (cell_dir + 2) % 4;
+
+    p_graph->p_node_edges[node_idx * 4u + direction]      = edge_idx;
+    p_graph->p_node_edges[cell_idx * 4u + p_edge->to_dir] = edge_idx;
+    p_graph->num_edges++;
+}
+
+/**
+ * @brief Removes an edge, and lists its nodes and corridor cells to be
+ * repaired. The corridor is found from the offsets of its cells, since the
+ * walls along it may have changed.
+ *
+ * @param[in,out] p_graph Pointer to the graph.
+ * @param[in] edge_idx Index of the edge.
+ * @param[in,out] p_num_pending Number of cells listed to be repaired.
+ */
+static void
+remove_edge (maze_graph_t *p_graph,
+             maze_idx_t    edge_idx,
+             maze_idx_t   *p_num_pending)
+{
+    const maze_graph_edge_t *p_edge = &p_graph->p_edges[edge_idx];
+
+    p_graph->p_node_edges[p_edge->from_idx * 4u + p_edge->from_dir]
+        = MAZE_GRAPH_NO_EDGE;
+    p_graph->p_node_edges[p_edge->to_idx * 4u + p_edge->to_dir]
+        = MAZE_GRAPH_NO_EDGE;
+    p_graph->p_pending[(*p_num_pending)++] = p_edge->from_idx;
+    p_graph->p_pending[(*p_num_pending)++] = p_edge->to_idx;
+
+    maze_idx_t cell_idx
+        = get_adjacent_idx(p_graph->p_grid, p_edge->from_idx, p_edge->from_dir);
+
+    for (uint32_t offset = 1; p_edge->length > offset; offset++)
+    {
+        p_graph->p_cell_edges[cell_idx]        = MAZE_GRAPH_NO_EDGE;
+        p_graph->p_pending[(*p_num_pending)++] = cell_idx;
+
+        // The next cell of the corridor is the adjacent cell one further
+        // along the same edge.
+        //
+        maze_idx_t current_idx = cell_idx;
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t adjacent_idx
+                = get_adjacent_idx(p_graph->p_grid, current_idx, direction);
+
+            if (MAZE_IDX_MAX != adjacent_idx
+                && edge_idx == p_graph->p_cell_edges[adjacent_idx]
+                && offset + 1u == p_graph->p_offsets[adjacent_idx])
+            {
+                cell_idx = adjacent_idx;
+                break;
+            }
+        }
+    }
+
+    p_graph->p_free_edges[p_graph->num_free_edges++] = edge_idx;
+    p_graph->num_edges--;
+}
+
+/**
+ * @brief Traces the missing edges of a node, or the edge of a corridor cell
+ * that is not on one. A corridor that loops without a node gets a node.
+ *
+ * @param[in,out] p_graph Pointer to the graph.
+ * @param[in] cell_idx Index of the cell.
+ */
+static void
+repair_cell (maze_graph_t *p_graph, maze_idx_t cell_idx)
+{
+    const maze_grid_cell_t *p_cell = &p_graph->p_grid->p_grid_array[cell_idx];
+
+    if (!p_graph->p_is_node[cell_idx])
+    {
+        if (MAZE_GRAPH_NO_EDGE != p_graph->p_cell_edges[cell_idx])
+        {
+            return;
+        }
+
+        // Step 1: Follow the corridor to a node, and trace the edge back from
+        // it. If the corridor comes back around, the cell becomes a node.
+        //
+        maze_cardinal_direction_t direction
+            = get_corridor_dir(p_cell, MAZE_NONE);
+        const maze_grid_cell_t *p_current = p_cell;
+
+        while (true)
+        {
+            const maze_grid_cell_t *p_next = p_current->p_next[direction];
+            maze_idx_t next_idx = maze_get_cell_idx(p_graph->p_grid, p_next);
+
+            if (p_graph->p_is_node[next_idx])
+            {
+                trace_edge(p_graph, next_idx, (direction + 2) % 4);
+                return;
+            }
+
+            if (next_idx == cell_idx)
+            {
+                p_graph->p_is_node[cell_idx] = true;
+                p_graph->num_nodes++;
+                break;
+            }
+
+            direction = get_corridor_dir(p_next, direction);
+            p_current = p_next;
+        }
+    }
+
+    // Step 2: Trace an edge through every gap of the node that has none.
+    //
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        if (NULL != p_cell->p_next[direction]
+            && MAZE_GRAPH_NO_EDGE
+                   == p_graph->p_node_edges[cell_idx * 4u + direction])
+        {
+            trace_edge(p_graph, cell_idx, direction);
+        }
+    }
+}
+
+/**
+ * @brief Walks along an edge from one of its nodes, and writes the index of
+ * each cell between two steps.
+ *
+ * @param[in] p_graph Pointer to the graph.
+ * @param[in] edge_idx Index of the edge.
+ * @param[in] is_from_start Whether to walk from the start node of the edge
+ * instead of its end node.
+ * @param[in] first_step Number of moves to the first cell to write.
+ * @param[in] last_step Number of moves to the last cell to write.
+ * @param[out] p_cells Where to write the first cell.
+ * @param[in] stride Step between the written cells, 1 or -1.
+ */
+static void
+walk_edge (const maze_graph_t *p_graph,
+           maze_idx_t          edge_idx,
+           bool                is_from_start,
+           uint32_t            first_step,
+           uint32_t            last_step,
+           maze_idx_t         *p_cells,
+           int8_t              stride)
+{
+    const maze_graph_edge_t  *p_edge   = &p_graph->p_edges[edge_idx];
+    maze_idx_t                cell_idx = is_from_start ? p_edge->from_idx
+                                                       : p_edge->to_idx;
+    const maze_grid_cell_t *p_cell
+        = &p_graph->p_grid->p_grid_array[cell_idx];
+    maze_cardinal_direction_t direction
+        = is_from_start ? p_edge->from_dir : p_edge->to_dir;
+
+    for (uint32_t step = 0; last_step >= step; step++)
+    {
+        if (first_step <= step)
+        {
+            *p_cells = maze_get_cell_idx(p_graph->p_grid, p_cell);
+            p_cells += stride;
+        }
+
+        if (0 < step)
+        {
+            direction = get_corridor_dir(p_cell, direction);
+        }
+
+        if (last_step > step)
+        {
+            p_cell = p_cell->p_next[direction];
+        }
+    }
+}
+
+/**
+ * @brief Gets the priority of a node in the open set from its scores.
+ *
+ * @param[in] g_score Distance from the start node.
+ * @param[in] h_score Manhattan distance to the end node.
+ * @param[in] h_scale Multiplier of the F-value, above any H-value, or 1 for no
+ * tie-breaking.
+ * @return maze_priority_t Priority, clamped to the largest priority.
+ */
+static maze_priority_t
+get_priority (uint32_t g_score, uint32_t h_score, uint64_t h_scale)
+{
+    uint64_t priority = ((uint64_t)g_score + h_score) * h_scale
+                        + ((1 < h_scale) ? h_score : 0);
+
+    return (maze_priority_t)((MAZE_PRIORITY_MAX < priority) ? MAZE_PRIORITY_MAX
+                                                            : priority);
+}
+
+/**
+ * @brief Copies the cells of a path into a new path.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[in] p_cells Indices of the cells from the start node to the end
+ * node.
+ * @param[in] path_length Number of cells.
+ * @return a_star_path_t* Pointer to the path.
+ */
+static a_star_path_t *
+get_path (const maze_grid_t *p_grid,
+          const maze_idx_t  *p_cells,
+          uint32_t           path_length)
+{
+    maze_grid_cell_t *p_path
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_path;
+
+    const maze_point_t *p_end_point
+        = &p_grid->p_grid_array[p_cells[path_length - 1]].coordinates;
+
+    for (uint32_t index = 0; path_length > index; index++)
+    {
+        maze_grid_cell_t *p_cell = &p_path[index];
+        *p_cell                  = p_grid->p_grid_array[p_cells[index]];
+        p_cell->g                = index;
+        p_cell->h = maze_manhattan_dist(&p_cell->coordinates, p_end_point);
+        p_cell->f = p_cell->g + p_cell->h;
+        p_cell->p_came_from = (0 < index) ? &p_path[index - 1] : NULL;
+    }
+
+    return p_path_struct;
+}
+
+// End of pathfinding/maze_graph.c
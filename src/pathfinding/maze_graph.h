@@ -0,0 +1,95 @@
+/**
+ * @file maze_graph.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the junction graph of a grid maze. Corridors of
+ * cells with exactly two gaps are collapsed into weighted edges between the
+ * junctions and dead ends, so that searches expand one node per junction
+ * instead of one per cell. The graph is repaired around a cell when its walls
+ * change. Edges count moves only, so mazes with cell costs are searched cell
+ * by cell instead.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_GRAPH_H // Include guard.
+#define MAZE_GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/a_star.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_GRAPH_NO_EDGE
+ * @brief Edge index of directions and cells that have no edge.
+ */
+#define MAZE_GRAPH_NO_EDGE MAZE_IDX_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains an edge of the junction graph, which is a
+ * corridor between two nodes. @see maze_graph_edge
+ */
+typedef struct maze_graph_edge
+{
+    maze_idx_t from_idx;  ///< Node at the start of the edge.
+    maze_idx_t to_idx;    ///< Node at the end of the edge.
+    uint32_t   length;    ///< Number of moves from one node to the other.
+    uint16_t   num_turns; ///< Number of turns along the corridor.
+    uint8_t    from_dir;  ///< Direction that the edge leaves its start node.
+    uint8_t    to_dir;    ///< Direction that the edge leaves its end node.
+} maze_graph_edge_t;
+
+/**
+ * @brief This struct contains the junction graph of a grid maze. The nodes
+ * are the cells that do not have exactly two gaps, and one cell of each
+ * corridor that loops without a junction. Every other cell lies on one edge.
+ * @see maze_graph
+ */
+typedef struct maze_graph
+{
+    const maze_grid_t *p_grid;         ///< Grid maze of the graph.
+    maze_graph_edge_t *p_edges;        ///< Edges, some of which are free.
+    maze_idx_t        *p_free_edges;   ///< Stack of free edge indices.
+    maze_idx_t        *p_node_edges;   ///< Edge leaving each node in each
+                                       ///< direction, 4 per cell.
+    maze_idx_t        *p_cell_edges;   ///< Edge that each corridor cell lies
+                                       ///< on, MAZE_GRAPH_NO_EDGE for nodes.
+    uint32_t          *p_offsets;      ///< Moves from the start node of its
+                                       ///< edge to each corridor cell.
+    uint8_t           *p_is_node;      ///< Whether each cell is a node.
+    maze_idx_t        *p_pending;      ///< Cells to repair after a change.
+    maze_idx_t         num_free_edges; ///< Number of free edge indices.
+    maze_idx_t         num_nodes;      ///< Number of nodes.
+    maze_idx_t         num_edges;      ///< Number of edges.
+} maze_graph_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+maze_graph_t maze_graph_create(const maze_grid_t *p_grid);
+
+void maze_graph_destroy(maze_graph_t *p_graph);
+
+void maze_graph_update_walls(maze_graph_t           *p_graph,
+                             const maze_grid_cell_t *p_node);
+
+a_star_path_t *maze_graph_find_path(const maze_graph_t     *p_graph,
+                                    const maze_grid_cell_t *p_start_node,
+                                    const maze_grid_cell_t *p_end_node,
+                                    uint32_t               *p_num_expanded);
+
+#endif // MAZE_GRAPH_H
+
+// End of pathfinding/maze_graph.h
@@ -0,0 +1,309 @@
+/**
+ * @file maze_landmarks.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the landmark tables of the ALT heuristic. Landmarks
+ * are chosen one at a time as the cell furthest from the landmarks so far, so
+ * they spread to the corners and dead ends of the maze, and the breadth-first
+ * search that measures each landmark also picks the next one.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_landmarks.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void       fill_dists(maze_landmarks_t *p_landmarks, uint8_t landmark);
+static maze_idx_t get_furthest_cell(const maze_landmarks_t *p_landmarks,
+                                    uint8_t                 num_placed);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates the landmark tables of a grid maze. The landmarks are not
+ * placed until @ref maze_landmarks_update is called.
+ *
+ * @param[in] p_grid Pointer to the grid maze. It must outlive the tables.
+ * @param[in] num_landmarks Number of landmarks, at most @ref
+ * MAZE_LANDMARKS_MAX and the number of cells.
+ * @return maze_landmarks_t Landmark tables. Its distances are NULL if they
+ * could not be allocated, in which case it gives no bound.
+ *
+ * @warning The tables must be destroyed by @ref maze_landmarks_destroy.
+ */
+maze_landmarks_t
+maze_landmarks_create (const maze_grid_t *p_grid, uint8_t num_landmarks)
+{
+    size_t           num_cells = MAZE_GRID_CELLS(p_grid);
+    maze_landmarks_t landmarks = {
+        .p_grid        = p_grid,
+        .p_dists       = NULL,
+        .p_queue       = NULL,
+        .num_landmarks = num_landmarks,
+        .is_valid      = false,
+    };
+
+    if (MAZE_LANDMARKS_MAX < landmarks.num_landmarks)
+    {
+        landmarks.num_landmarks = MAZE_LANDMARKS_MAX;
+    }
+
+    if (num_cells < landmarks.num_landmarks)
+    {
+        landmarks.num_landmarks = (uint8_t)num_cells;
+    }
+
+    if (0 == landmarks.num_landmarks)
+    {
+        return landmarks;
+    }
+
+    landmarks.p_dists
+        = maze_malloc(sizeof(uint16_t) * num_cells * landmarks.num_landmarks);
+    landmarks.p_queue = maze_malloc(sizeof(maze_idx_t) * num_cells);
+
+    if (NULL == landmarks.p_dists || NULL == landmarks.p_queue)
+    {
+        maze_landmarks_destroy(&landmarks);
+    }
+
+    return landmarks;
+}
+
+/**
+ * @brief Destroys landmark tables.
+ *
+ * @param[in,out] p_landmarks Pointer to the tables.
+ */
+void
+maze_landmarks_destroy (maze_landmarks_t *p_landmarks)
+{
+    maze_free(p_landmarks->p_dists);
+    maze_free(p_landmarks->p_queue);
+    p_landmarks->p_dists  = NULL;
+    p_landmarks->p_queue  = NULL;
+    p_landmarks->is_valid = false;
+}
+
+/**
+ * @brief Places the landmarks and measures their distances to every cell, if
+ * the tables were invalidated since they were last measured.
+ *
+ * @param[in,out] p_landmarks Pointer to the tables.
+ *
+ * @note This runs one breadth-first search per landmark, so call it between
+ * searches rather than after every wall that is found.
+ */
+void
+maze_landmarks_update (maze_landmarks_t *p_landmarks)
+{
+    if (p_landmarks->is_valid || NULL == p_landmarks->p_dists)
+    {
+        return;
+    }
+
+    // The first landmark is the top left corner. Every other landmark is the
+    // cell furthest from the landmarks before it, so a part of the maze that
+    // no landmark reaches gets one of its own.
+    //
+    p_landmarks->cells[0] = 0;
+
+    for (uint8_t landmark = 0; p_landmarks->num_landmarks > landmark;
+         landmark++)
+    {
+        if (0 < landmark)
+        {
+            p_landmarks->cells[landmark]
+                = get_furthest_cell(p_landmarks, landmark);
+        }
+
+        fill_dists(p_landmarks, landmark);
+    }
+
+    p_landmarks->is_valid = true;
+}
+
+/**
+ * @brief Marks the tables as not matching the walls of the maze, so that they
+ * give no bound until they are updated.
+ *
+ * @param[in,out] p_landmarks Pointer to the tables.
+ *
+ * @note Call this whenever a wall is added or removed. Removing a wall can
+ * shorten distances below the stored bound, which would make A* miss the
+ * shortest path.
+ */
+void
+maze_landmarks_invalidate (maze_landmarks_t *p_landmarks)
+{
+    p_landmarks->is_valid = false;
+}
+
+/**
+ * @brief Gets the lower bound on the distance between two cells from the
+ * landmarks: the largest difference of their distances to one landmark.
+ *
+ * @param[in] p_landmarks Pointer to the tables.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] end_idx Index of the end cell.
+ * @return uint32_t Lower bound on the distance, 0 if the tables are invalid.
+ */
+uint32_t
+maze_landmarks_get_bound (const maze_landmarks_t *p_landmarks,
+                          maze_idx_t              cell_idx,
+                          maze_idx_t              end_idx)
+{
+    if (!p_landmarks->is_valid)
+    {
+        return 0;
+    }
+
+    const uint16_t *p_cell_dists
+        = &p_landmarks->p_dists[(size_t)cell_idx * p_landmarks->num_landmarks];
+    const uint16_t *p_end_dists
+        = &p_landmarks->p_dists[(size_t)end_idx * p_landmarks->num_landmarks];
+    uint32_t bound = 0;
+
+    for (uint8_t landmark = 0; p_landmarks->num_landmarks > landmark;
+         landmark++)
+    {
+        uint16_t cell_dist = p_cell_dists[landmark];
+        uint16_t end_dist  = p_end_dists[landmark];
+
+        // A landmark that cannot reach both cells says nothing about them.
+        //
+        if (MAZE_LANDMARKS_UNREACHABLE == cell_dist
+            || MAZE_LANDMARKS_UNREACHABLE == end_dist)
+        {
+            continue;
+        }
+
+        uint32_t diff = (cell_dist > end_dist) ? cell_dist - end_dist
+                                               : end_dist - cell_dist;
+
+        if (diff > bound)
+        {
+            bound = diff;
+        }
+    }
+
+    return bound;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Measures the distance from a landmark to every cell with a
+ * breadth-first search.
+ *
+ * @param[in,out] p_landmarks Pointer to the tables.
+ * @param[in] landmark Index of the landmark, whose cell is already placed.
+ */
+static void
+fill_dists (maze_landmarks_t *p_landmarks, uint8_t landmark)
+{
+    const maze_grid_t *p_grid        = p_landmarks->p_grid;
+    size_t             num_cells     = MAZE_GRID_CELLS(p_grid);
+    uint8_t            num_landmarks = p_landmarks->num_landmarks;
+    uint16_t          *p_dists       = &p_landmarks->p_dists[landmark];
+    maze_idx_t        *p_queue       = p_landmarks->p_queue;
+    size_t             head          = 0;
+    size_t             tail          = 0;
+
+    for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_dists[cell_idx * num_landmarks] = MAZE_LANDMARKS_UNREACHABLE;
+    }
+
+    maze_idx_t start_idx = p_landmarks->cells[landmark];
+    p_dists[(size_t)start_idx * num_landmarks] = 0;
+    p_queue[tail++]                            = start_idx;
+
+    while (head < tail)
+    {
+        maze_idx_t              cell_idx = p_queue[head++];
+        const maze_grid_cell_t *p_cell   = &p_grid->p_grid_array[cell_idx];
+        uint16_t next_dist = p_dists[(size_t)cell_idx * num_landmarks];
+
+        // Saturate rather than wrap, so that a long distance still bounds.
+        //
+        if (MAZE_LANDMARKS_UNREACHABLE - 1u > next_dist)
+        {
+            next_dist++;
+        }
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL == p_next)
+            {
+                continue;
+            }
+
+            maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+            if (MAZE_LANDMARKS_UNREACHABLE
+                == p_dists[(size_t)next_idx * num_landmarks])
+            {
+                p_dists[(size_t)next_idx * num_landmarks] = next_dist;
+                p_queue[tail++]                           = next_idx;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gets the cell furthest from the nearest of the placed landmarks.
+ * Cells that no placed landmark reaches are the furthest of all.
+ *
+ * @param[in] p_landmarks Pointer to the tables.
+ * @param[in] num_placed Number of landmarks placed and measured.
+ * @return maze_idx_t Index of the cell, the lowest index of any tie.
+ */
+static maze_idx_t
+get_furthest_cell (const maze_landmarks_t *p_landmarks, uint8_t num_placed)
+{
+    size_t     num_cells     = MAZE_GRID_CELLS(p_landmarks->p_grid);
+    maze_idx_t furthest_idx  = 0;
+    uint32_t   furthest_dist = 0;
+
+    for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        const uint16_t *p_cell_dists
+            = &p_landmarks->p_dists[cell_idx * p_landmarks->num_landmarks];
+        uint32_t nearest_dist = MAZE_LANDMARKS_UNREACHABLE;
+
+        for (uint8_t landmark = 0; num_placed > landmark; landmark++)
+        {
+            if (p_cell_dists[landmark] < nearest_dist)
+            {
+                nearest_dist = p_cell_dists[landmark];
+            }
+        }
+
+        if (nearest_dist > furthest_dist)
+        {
+            furthest_idx  = (maze_idx_t)cell_idx;
+            furthest_dist = nearest_dist;
+        }
+    }
+
+    return furthest_idx;
+}
+
+// End of pathfinding/maze_landmarks.c
@@ -0,0 +1,83 @@
+/**
+ * @file maze_landmarks.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the landmark tables of the ALT heuristic (A*,
+ * landmarks and the triangle inequality). The distance from a few landmark
+ * cells to every cell is stored, and the distance between any two cells is at
+ * least the difference of their distances to a landmark, which bounds detours
+ * around walls that the Manhattan distance cannot see.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_LANDMARKS_H // Include guard.
+#define MAZE_LANDMARKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_LANDMARKS_MAX
+ * @brief Largest number of landmarks of a table.
+ */
+#ifndef MAZE_LANDMARKS_MAX
+#define MAZE_LANDMARKS_MAX 8u
+#endif
+
+/**
+ * @def MAZE_LANDMARKS_UNREACHABLE
+ * @brief Distance of cells that a landmark cannot reach. Longer distances are
+ * saturated one below it, which keeps the bound a lower bound.
+ */
+#define MAZE_LANDMARKS_UNREACHABLE UINT16_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the distance tables of the landmarks of a grid
+ * maze. @see maze_landmarks
+ *
+ * @note The distances of a cell to every landmark sit next to each other, so
+ * that the heuristic of a cell reads one run of memory.
+ */
+typedef struct maze_landmarks
+{
+    const maze_grid_t *p_grid;  ///< Grid maze of the landmarks.
+    uint16_t          *p_dists; ///< Distance from each landmark to each cell,
+                                ///< num_landmarks per cell.
+    maze_idx_t        *p_queue; ///< Queue of the breadth-first searches.
+    maze_idx_t cells[MAZE_LANDMARKS_MAX]; ///< Cells of the landmarks.
+    uint8_t    num_landmarks;             ///< Number of landmarks.
+    bool       is_valid; ///< Whether the tables match the walls of the maze.
+} maze_landmarks_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+maze_landmarks_t maze_landmarks_create(const maze_grid_t *p_grid,
+                                       uint8_t            num_landmarks);
+
+void maze_landmarks_destroy(maze_landmarks_t *p_landmarks);
+
+void maze_landmarks_update(maze_landmarks_t *p_landmarks);
+
+void maze_landmarks_invalidate(maze_landmarks_t *p_landmarks);
+
+uint32_t maze_landmarks_get_bound(const maze_landmarks_t *p_landmarks,
+                                  maze_idx_t              cell_idx,
+                                  maze_idx_t              end_idx);
+
+#endif // MAZE_LANDMARKS_H
+
+// End of pathfinding/maze_landmarks.h
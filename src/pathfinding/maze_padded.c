@@ -0,0 +1,364 @@
+/**
+ * @file maze_padded.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Contains the implementation of the sentinel-padded maze backend.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ * @par Moving to a neighbour is cell_idx + offsets[direction]. As the border
+ * cells are sentinels with every wall set, no row or column bounds checks are
+ * needed when walking the maze.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_padded.h"
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a padded maze with the specified number of rows and columns.
+ * Every wall is set, like @ref maze_create.
+ *
+ * @param[in] rows Number of rows in the maze.
+ * @param[in] columns Number of columns in the maze.
+ * @return maze_padded_t Fully walled maze.
+ *
+ * @warning The maze must be destroyed by @ref maze_padded_destroy.
+ * @note (rows + 2) * (columns + 2) must fit in @ref maze_idx_t.
+ */
+maze_padded_t
+maze_padded_create (uint16_t rows, uint16_t columns)
+{
+    maze_idx_t stride    = (maze_idx_t)(columns + 2u);
+    size_t     num_cells = (size_t)(rows + 2u) * stride;
+
+    maze_padded_t maze = {
+        .p_cells = maze_malloc(num_cells),
+        .rows    = rows,
+        .columns = columns,
+        .stride  = stride,
+        .offsets = { -(int32_t)stride, 1, (int32_t)stride, -1 },
+    };
+
+    memset(maze.p_cells, MAZE_PADDED_ALL_WALLS, num_cells);
+
+    // Step 1: Mark the top and bottom padding rows.
+    //
+    for (maze_idx_t col = 0; stride > col; col++)
+    {
+        maze.p_cells[col] |= MAZE_PADDED_SENTINEL;
+        maze.p_cells[(size_t)(rows + 1u) * stride + col]
+            |= MAZE_PADDED_SENTINEL;
+    }
+
+    // Step 2: Mark the left and right padding columns.
+    //
+    for (uint16_t row = 1; rows >= row; row++)
+    {
+        maze.p_cells[(size_t)row * stride] |= MAZE_PADDED_SENTINEL;
+        maze.p_cells[(size_t)row * stride + stride - 1u]
+            |= MAZE_PADDED_SENTINEL;
+    }
+
+    return maze;
+}
+
+/**
+ * @brief Destroys the maze by freeing the memory allocated to the cells.
+ *
+ * @param[in,out] p_maze Pointer to the padded maze.
+ */
+void
+maze_padded_destroy (maze_padded_t *p_maze)
+{
+    maze_free(p_maze->p_cells);
+
+    p_maze->p_cells = NULL;
+    p_maze->rows    = 0;
+    p_maze->columns = 0;
+    p_maze->stride  = 0;
+}
+
+/**
+ * @brief Removes every interior wall. The outer border stays walled. This is
+ * the padded equivalent of @ref floodfill_init_maze_nowall.
+ *
+ * @param[in,out] p_maze Pointer to the padded maze.
+ */
+void
+maze_padded_init_nowall (maze_padded_t *p_maze)
+{
+    for (uint16_t row = 0; p_maze->rows > row; row++)
+    {
+        maze_idx_t cell_idx = (maze_idx_t)(row + 1u) * p_maze->stride + 1u;
+
+        for (uint16_t col = 0; p_maze->columns > col; col++, cell_idx++)
+        {
+            maze_padded_unset_wall(p_maze, cell_idx, MAZE_NORTH);
+            maze_padded_unset_wall(p_maze, cell_idx, MAZE_WEST);
+        }
+    }
+}
+
+/**
+ * @brief Gets the number of cells in the padded array. Per-cell arrays used
+ * with padded cell indices must have this many elements.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @return maze_idx_t Number of cells, including the sentinels.
+ */
+maze_idx_t
+maze_padded_get_num_cells (const maze_padded_t *p_maze)
+{
+    return (maze_idx_t)(p_maze->rows + 2u) * p_maze->stride;
+}
+
+/**
+ * @brief Gets the index of the cell at the specified coordinates.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] p_coordinates Pointer to the coordinates of the cell.
+ * @return maze_idx_t Padded index of the cell. MAZE_PADDED_NO_CELL if the
+ * coordinates are out of bounds.
+ */
+maze_idx_t
+maze_padded_get_idx (const maze_padded_t *p_maze,
+                     const maze_point_t  *p_coordinates)
+{
+    if (p_maze->rows <= p_coordinates->y || p_maze->columns <= p_coordinates->x)
+    {
+        return MAZE_PADDED_NO_CELL;
+    }
+
+    return (maze_idx_t)(p_coordinates->y + 1u) * p_maze->stride
+           + p_coordinates->x + 1u;
+}
+
+/**
+ * @brief Gets the coordinates of a cell from its index.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of a cell that is not a sentinel.
+ * @return maze_point_t Coordinates of the cell.
+ */
+maze_point_t
+maze_padded_get_point (const maze_padded_t *p_maze, maze_idx_t cell_idx)
+{
+    maze_point_t point = { cell_idx % p_maze->stride - 1u,
+                           cell_idx / p_maze->stride - 1u };
+    return point;
+}
+
+/**
+ * @brief Gets the index of the adjacent cell in the specified direction,
+ * regardless of walls. This is a single add.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of a cell that is not a sentinel.
+ * @param[in] direction Cardinal direction of the adjacent cell.
+ * @return maze_idx_t Padded index of the adjacent cell. This is a sentinel if
+ * the cell is on the border in that direction.
+ */
+maze_idx_t
+maze_padded_get_idx_in_dir (const maze_padded_t      *p_maze,
+                            maze_idx_t                cell_idx,
+                            maze_cardinal_direction_t direction)
+{
+    return (maze_idx_t)(cell_idx + p_maze->offsets[direction]);
+}
+
+/**
+ * @brief Checks if a cell is one of the sentinels padding the maze.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of the cell.
+ * @return true The cell is a sentinel.
+ * @return false The cell is in the maze.
+ */
+bool
+maze_padded_is_sentinel (const maze_padded_t *p_maze, maze_idx_t cell_idx)
+{
+    return 0 != (p_maze->p_cells[cell_idx] & MAZE_PADDED_SENTINEL);
+}
+
+/**
+ * @brief Checks if there is a wall on a side of a cell.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of the cell.
+ * @param[in] direction Cardinal direction of the wall.
+ * @return true There is a wall.
+ * @return false There is a gap.
+ */
+bool
+maze_padded_is_wall (const maze_padded_t      *p_maze,
+                     maze_idx_t                cell_idx,
+                     maze_cardinal_direction_t direction)
+{
+    return 0 != ((p_maze->p_cells[cell_idx] >> direction) & 1u);
+}
+
+/**
+ * @brief Gets the index of the cell that can be moved to in the specified
+ * direction.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of the cell.
+ * @param[in] direction Cardinal direction to move in.
+ * @return maze_idx_t Padded index of the next cell. MAZE_PADDED_NO_CELL if
+ * there is a wall in the way.
+ */
+maze_idx_t
+maze_padded_get_next_idx (const maze_padded_t      *p_maze,
+                          maze_idx_t                cell_idx,
+                          maze_cardinal_direction_t direction)
+{
+    maze_idx_t next_idx = (maze_idx_t)(cell_idx + p_maze->offsets[direction]);
+
+    return maze_padded_is_wall(p_maze, cell_idx, direction)
+               ? MAZE_PADDED_NO_CELL
+               : next_idx;
+}
+
+/**
+ * @brief Sets a wall on a side of a cell, and the matching wall of the
+ * adjacent cell.
+ *
+ * @param[in,out] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of a cell that is not a sentinel.
+ * @param[in] direction Cardinal direction of the wall.
+ */
+void
+maze_padded_set_wall (maze_padded_t            *p_maze,
+                      maze_idx_t                cell_idx,
+                      maze_cardinal_direction_t direction)
+{
+    maze_idx_t next_idx = (maze_idx_t)(cell_idx + p_maze->offsets[direction]);
+
+    p_maze->p_cells[cell_idx] |= (uint8_t)(1u << direction);
+    p_maze->p_cells[next_idx] |= (uint8_t)(1u << ((direction + 2) % 4));
+}
+
+/**
+ * @brief Unsets a wall on a side of a cell, and the matching wall of the
+ * adjacent cell. Walls next to a sentinel cannot be unset.
+ *
+ * @param[in,out] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of a cell that is not a sentinel.
+ * @param[in] direction Cardinal direction of the wall.
+ */
+void
+maze_padded_unset_wall (maze_padded_t            *p_maze,
+                        maze_idx_t                cell_idx,
+                        maze_cardinal_direction_t direction)
+{
+    maze_idx_t next_idx = (maze_idx_t)(cell_idx + p_maze->offsets[direction]);
+
+    if (maze_padded_is_sentinel(p_maze, next_idx))
+    {
+        return;
+    }
+
+    p_maze->p_cells[cell_idx] &= (uint8_t)~(1u << direction);
+    p_maze->p_cells[next_idx] &= (uint8_t)~(1u << ((direction + 2) % 4));
+}
+
+/**
+ * @brief Gets the gaps of a cell as a bitmask in the same format as @ref
+ * maze_serialise.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[in] cell_idx Padded index of the cell.
+ * @return uint8_t Bitmask of the gaps, aligned to MAZE_NORTH.
+ */
+uint8_t
+maze_padded_get_gap_bitmask (const maze_padded_t *p_maze, maze_idx_t cell_idx)
+{
+    uint8_t wall_bitmask = p_maze->p_cells[cell_idx] & MAZE_PADDED_ALL_WALLS;
+
+    return MAZE_INVERT_BITMASK(wall_bitmask);
+}
+
+/**
+ * @brief Deserialises the maze from a bitmask array. @ref maze_deserialise.
+ *
+ * @param[in,out] p_maze Pointer to the padded maze.
+ * @param[in] p_no_walls_array Pointer to the bitmask array of maze gaps.
+ * @return int16_t 0 if successful, -1 otherwise.
+ */
+int16_t
+maze_padded_deserialise (maze_padded_t            *p_maze,
+                         const maze_gap_bitmask_t *p_no_walls_array)
+{
+    if (NULL == p_no_walls_array || p_maze->rows != p_no_walls_array->rows
+        || p_maze->columns != p_no_walls_array->columns)
+    {
+        return -1;
+    }
+
+    const uint16_t *p_bitmask = p_no_walls_array->p_bitmask;
+
+    for (uint16_t row = 0; p_maze->rows > row; row++)
+    {
+        maze_idx_t cell_idx = (maze_idx_t)(row + 1u) * p_maze->stride + 1u;
+
+        for (uint16_t col = 0; p_maze->columns > col; col++, cell_idx++)
+        {
+            for (uint8_t direction = 0; 4 > direction; direction++)
+            {
+                (*p_bitmask & (1u << direction))
+                    ? maze_padded_unset_wall(p_maze, cell_idx, direction)
+                    : maze_padded_set_wall(p_maze, cell_idx, direction);
+            }
+
+            p_bitmask++;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Serialises the maze into a bitmask array. @ref maze_serialise.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @return maze_gap_bitmask_t Bitmask array of maze gaps.
+ *
+ * @warning The bitmask array must be freed with @ref maze_free.
+ */
+maze_gap_bitmask_t
+maze_padded_serialise (const maze_padded_t *p_maze)
+{
+    maze_gap_bitmask_t no_walls_array = {
+        .p_bitmask = maze_malloc(sizeof(uint16_t) * p_maze->rows
+                                 * p_maze->columns),
+        .rows      = p_maze->rows,
+        .columns   = p_maze->columns,
+    };
+
+    uint16_t *p_bitmask = no_walls_array.p_bitmask;
+
+    for (uint16_t row = 0; p_maze->rows > row; row++)
+    {
+        maze_idx_t cell_idx = (maze_idx_t)(row + 1u) * p_maze->stride + 1u;
+
+        for (uint16_t col = 0; p_maze->columns > col; col++, cell_idx++)
+        {
+            *p_bitmask++ = maze_padded_get_gap_bitmask(p_maze, cell_idx);
+        }
+    }
+
+    return no_walls_array;
+}
+
+// End of pathfinding/maze_padded.c
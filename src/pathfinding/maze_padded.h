@@ -0,0 +1,119 @@
+/**
+ * @file maze_padded.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the sentinel-padded maze backend. The maze is
+ * surrounded by a one-cell border of permanently walled sentinel cells, so the
+ * neighbour of any real cell is always inside the array and is found with a
+ * single add from a per-direction offset table.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_PADDED_H // Include guard.
+#define MAZE_PADDED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_PADDED_NO_CELL
+ * @brief Index returned when a cell does not exist or cannot be reached.
+ */
+#define MAZE_PADDED_NO_CELL MAZE_IDX_MAX
+
+/**
+ * @def MAZE_PADDED_ALL_WALLS
+ * @brief Cell bits of a cell with a wall in every direction. Bit d is set if
+ * there is a wall in the cardinal direction d.
+ */
+#define MAZE_PADDED_ALL_WALLS 0xFu
+
+/**
+ * @def MAZE_PADDED_SENTINEL
+ * @brief Cell bit set on the border cells that pad the maze.
+ */
+#define MAZE_PADDED_SENTINEL 0x10u
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains a maze stored as one byte per cell with a border
+ * of sentinel cells around it. Cell indices refer to the padded array, so the
+ * cell at (col, row) has the index (row + 1) * stride + (col + 1).
+ *
+ * @note Walls are kept symmetric, i.e. the east wall of a cell is also set as
+ * the west wall of its neighbour. The outer border is always walled.
+ */
+typedef struct maze_padded
+{
+    uint8_t *p_cells; ///< (rows + 2) * stride cells. The low nibble is the
+                      ///< wall bitmask, @see MAZE_PADDED_SENTINEL.
+    uint16_t   rows;       ///< Number of rows in the maze, without padding.
+    uint16_t   columns;    ///< Number of columns in the maze, without padding.
+    maze_idx_t stride;     ///< Number of cells in a padded row, columns + 2.
+    int32_t    offsets[4]; ///< Index offset to the adjacent cell, indexed by
+                           ///< the direction enum: {-stride, 1, stride, -1}.
+} maze_padded_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+maze_padded_t maze_padded_create(uint16_t rows, uint16_t columns);
+
+void maze_padded_destroy(maze_padded_t *p_maze);
+
+void maze_padded_init_nowall(maze_padded_t *p_maze);
+
+maze_idx_t maze_padded_get_num_cells(const maze_padded_t *p_maze);
+
+maze_idx_t maze_padded_get_idx(const maze_padded_t *p_maze,
+                               const maze_point_t  *p_coordinates);
+
+maze_point_t maze_padded_get_point(const maze_padded_t *p_maze,
+                                   maze_idx_t           cell_idx);
+
+maze_idx_t maze_padded_get_idx_in_dir(const maze_padded_t      *p_maze,
+                                      maze_idx_t                cell_idx,
+                                      maze_cardinal_direction_t direction);
+
+bool maze_padded_is_sentinel(const maze_padded_t *p_maze, maze_idx_t cell_idx);
+
+bool maze_padded_is_wall(const maze_padded_t      *p_maze,
+                         maze_idx_t                cell_idx,
+                         maze_cardinal_direction_t direction);
+
+maze_idx_t maze_padded_get_next_idx(const maze_padded_t      *p_maze,
+                                    maze_idx_t                cell_idx,
+                                    maze_cardinal_direction_t direction);
+
+void maze_padded_set_wall(maze_padded_t            *p_maze,
+                          maze_idx_t                cell_idx,
+                          maze_cardinal_direction_t direction);
+
+void maze_padded_unset_wall(maze_padded_t            *p_maze,
+                            maze_idx_t                cell_idx,
+                            maze_cardinal_direction_t direction);
+
+uint8_t maze_padded_get_gap_bitmask(const maze_padded_t *p_maze,
+                                    maze_idx_t           cell_idx);
+
+int16_t maze_padded_deserialise(maze_padded_t            *p_maze,
+                                const maze_gap_bitmask_t *p_no_walls_array);
+
+maze_gap_bitmask_t maze_padded_serialise(const maze_padded_t *p_maze);
+
+#endif // MAZE_PADDED_H
+
+// End of pathfinding/maze_padded.h
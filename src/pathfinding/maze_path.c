@@ -0,0 +1,358 @@
+/**
+ * @file maze_path.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the compact path. The steps are written straight from
+ * the came-from indices of a search, from the last step to the first, so no
+ * cells are copied.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_render.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/maze_path.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void move_point(maze_point_t *p_point, maze_cardinal_direction_t dir);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a compact path with room for a number of steps. Every step is
+ * north until it is set.
+ *
+ * @param[in] p_start Pointer to the point of the first cell.
+ * @param[in] num_steps Number of steps.
+ * @return maze_path_t Compact path. Its steps are NULL if there are no steps
+ * or they could not be allocated.
+ *
+ * @warning The path must be destroyed by @ref maze_path_destroy.
+ */
+maze_path_t
+maze_path_create (const maze_point_t *p_start, uint32_t num_steps)
+{
+    maze_path_t path = {
+        .start     = *p_start,
+        .num_steps = num_steps,
+        .p_steps   = NULL,
+    };
+
+    if (0 < num_steps)
+    {
+        path.p_steps
+            = maze_calloc(MAZE_PATH_GET_NUM_BYTES(num_steps), sizeof(uint8_t));
+    }
+
+    return path;
+}
+
+/**
+ * @brief Destroys a compact path.
+ *
+ * @param[in,out] p_path Pointer to the path.
+ */
+void
+maze_path_destroy (maze_path_t *p_path)
+{
+    maze_free(p_path->p_steps);
+    p_path->p_steps   = NULL;
+    p_path->num_steps = 0;
+}
+
+/**
+ * @brief Gets the direction of a step.
+ *
+ * @param[in] p_path Pointer to the path.
+ * @param[in] step Index of the step, less than the number of steps.
+ * @return maze_cardinal_direction_t Direction of the step.
+ */
+maze_cardinal_direction_t
+maze_path_get_step (const maze_path_t *p_path, uint32_t step)
+{
+    uint8_t shift = (uint8_t)((step % MAZE_PATH_STEPS_PER_BYTE) * 2u);
+
+    return (maze_cardinal_direction_t)((
+        p_path->p_steps[step / MAZE_PATH_STEPS_PER_BYTE] >> shift) & 0x3u);
+}
+
+/**
+ * @brief Sets the direction of a step.
+ *
+ * @param[in,out] p_path Pointer to the path.
+ * @param[in] step Index of the step, less than the number of steps.
+ * @param[in] direction Direction of the step.
+ */
+void
+maze_path_set_step (maze_path_t              *p_path,
+                    uint32_t                  step,
+                    maze_cardinal_direction_t direction)
+{
+    uint8_t  shift  = (uint8_t)((step % MAZE_PATH_STEPS_PER_BYTE) * 2u);
+    uint8_t *p_byte = &p_path->p_steps[step / MAZE_PATH_STEPS_PER_BYTE];
+
+    *p_byte = (uint8_t)((*p_byte & ~(0x3u << shift))
+                        | ((direction & 0x3u) << shift));
+}
+
+/**
+ * @brief Gets the point of the last cell of the path.
+ *
+ * @param[in] p_path Pointer to the path.
+ * @return maze_point_t Point of the last cell.
+ */
+maze_point_t
+maze_path_get_end (const maze_path_t *p_path)
+{
+    maze_path_iter_t iter = maze_path_iter_begin(p_path);
+
+    while (maze_path_iter_next(&iter))
+    {
+    }
+
+    return iter.point;
+}
+
+/**
+ * @brief Gets an iterator at the first cell of the path.
+ *
+ * @param[in] p_path Pointer to the path. It must outlive the iterator.
+ * @return maze_path_iter_t Iterator at the first cell.
+ */
+maze_path_iter_t
+maze_path_iter_begin (const maze_path_t *p_path)
+{
+    maze_path_iter_t iter = {
+        .p_path = p_path,
+        .point  = p_path->start,
+        .step   = 0,
+    };
+
+    return iter;
+}
+
+/**
+ * @brief Moves an iterator to the next cell of the path.
+ *
+ * @param[in,out] p_iter Pointer to the iterator.
+ * @return true If the iterator moved to the next cell.
+ * @return false If it was at the last cell, in which case it does not move.
+ */
+bool
+maze_path_iter_next (maze_path_iter_t *p_iter)
+{
+    if (p_iter->p_path->num_steps <= p_iter->step)
+    {
+        return false;
+    }
+
+    move_point(&p_iter->point,
+               maze_path_get_step(p_iter->p_path, p_iter->step));
+    p_iter->step++;
+
+    return true;
+}
+
+/**
+ * @brief Gets the path found by @ref a_star_ctx from the start node to the end
+ * node as a compact path. The steps are counted, then written backwards while
+ * following the came-from indices.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_context Pointer to the search context used by the search.
+ * @param[in] p_end_node Pointer to the end node.
+ * @param[out] p_path Pointer to the compact path to create.
+ * @return true If the path was created.
+ * @return false If the end node was not reached or the steps could not be
+ * allocated.
+ *
+ * @warning The path must be destroyed by @ref maze_path_destroy.
+ */
+bool
+maze_path_from_context (const maze_grid_t      *p_grid,
+                        const search_context_t *p_context,
+                        const maze_grid_cell_t *p_end_node,
+                        maze_path_t            *p_path)
+{
+    maze_idx_t cell_idx = maze_get_cell_idx(p_grid, p_end_node);
+
+    if (!search_context_is_reached(p_context, cell_idx))
+    {
+        return false;
+    }
+
+    // Cell costs make G differ from the number of steps, so the steps are
+    // counted first.
+    //
+    uint32_t num_steps = 0;
+
+    for (maze_idx_t idx = p_context->p_came_from[cell_idx];
+         SEARCH_CONTEXT_NO_CELL != idx;
+         idx = p_context->p_came_from[idx])
+    {
+        num_steps++;
+    }
+
+    *p_path = maze_path_create(&p_end_node->coordinates, num_steps);
+
+    if (0 < num_steps && NULL == p_path->p_steps)
+    {
+        return false;
+    }
+
+    // The start point is only known once the walk reaches it.
+    //
+    for (uint32_t step = num_steps; 0 < step; step--)
+    {
+        maze_idx_t prev_idx = p_context->p_came_from[cell_idx];
+
+        maze_path_set_step(
+            p_path,
+            step - 1u,
+            maze_get_dir_from_to(&p_grid->p_grid_array[prev_idx].coordinates,
+                                 &p_grid->p_grid_array[cell_idx].coordinates));
+        cell_idx = prev_idx;
+    }
+
+    p_path->start = p_grid->p_grid_array[cell_idx].coordinates;
+
+    return true;
+}
+
+/**
+ * @brief Converts a path of cells into a compact path.
+ *
+ * @param[in] p_path Pointer to the path of cells, with at least one cell.
+ * @return maze_path_t Compact path. Its steps are NULL if they could not be
+ * allocated.
+ *
+ * @warning The path must be destroyed by @ref maze_path_destroy.
+ */
+maze_path_t
+maze_path_from_a_star_path (const a_star_path_t *p_path)
+{
+    maze_path_t path = maze_path_create(&p_path->p_path[0].coordinates,
+                                        p_path->length - 1u);
+
+    for (uint32_t step = 0; NULL != path.p_steps && path.num_steps > step;
+         step++)
+    {
+        maze_path_set_step(
+            &path,
+            step,
+            maze_get_dir_from_to(&p_path->p_path[step].coordinates,
+                                 &p_path->p_path[step + 1u].coordinates));
+    }
+
+    return path;
+}
+
+/**
+ * @brief Converts a compact path into a path of cells, for code that needs
+ * the cells.
+ *
+ * @param[in] p_grid The grid maze that the path is in.
+ * @param[in] p_path Pointer to the compact path.
+ * @return a_star_path_t* Pointer to the path of cells. The `p_came_from`
+ * field of each path cell points to the previous cell in the path.
+ *
+ * @warning The path and its array of cells must be freed with @ref
+ * maze_free.
+ */
+a_star_path_t *
+maze_path_to_a_star_path (const maze_grid_t *p_grid, const maze_path_t *p_path)
+{
+    uint32_t          path_length = p_path->num_steps + 1u;
+    maze_grid_cell_t *p_cells
+        = maze_malloc(sizeof(maze_grid_cell_t) * path_length);
+    a_star_path_t    *p_path_struct = maze_malloc(sizeof(a_star_path_t));
+    p_path_struct->length           = path_length;
+    p_path_struct->p_path           = p_cells;
+
+    maze_point_t     end_point = maze_path_get_end(p_path);
+    maze_path_iter_t iter      = maze_path_iter_begin(p_path);
+
+    do
+    {
+        size_t cell_idx
+            = (size_t)iter.point.y * MAZE_GRID_COLS(p_grid) + iter.point.x;
+        maze_grid_cell_t *p_cell = &p_cells[iter.step];
+
+        *p_cell             = p_grid->p_grid_array[cell_idx];
+        p_cell->g           = iter.step;
+        p_cell->h           = maze_manhattan_dist(&iter.point, &end_point);
+        p_cell->f           = p_cell->g + p_cell->h;
+        p_cell->p_came_from = (0 < iter.step) ? &p_cells[iter.step - 1] : NULL;
+    } while (maze_path_iter_next(&iter));
+
+    return p_path_struct;
+}
+
+/**
+ * @brief Gets the string representation of a compact path over its maze.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[in] p_path Pointer to the compact path.
+ * @return char* The string representation of the path.
+ *
+ * @warning The string must be freed after use with @ref maze_free.
+ */
+char *
+maze_path_get_str (const maze_grid_t *p_grid, const maze_path_t *p_path)
+{
+    maze_render_overlay_t overlay = {
+        .p_navigator = NULL,
+        .p_path      = NULL,
+        .path_length = 0,
+        .p_steps     = p_path,
+    };
+
+    return maze_render_to_string(p_grid, &overlay);
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Moves a point to the adjacent cell in a direction.
+ *
+ * @param[in,out] p_point Pointer to the point.
+ * @param[in] dir Direction to move in.
+ */
+static void
+move_point (maze_point_t *p_point, maze_cardinal_direction_t dir)
+{
+    switch (dir)
+    {
+        case MAZE_NORTH:
+            p_point->y--;
+            break;
+        case MAZE_EAST:
+            p_point->x++;
+            break;
+        case MAZE_SOUTH:
+            p_point->y++;
+            break;
+        case MAZE_WEST:
+            p_point->x--;
+            break;
+        default:
+            break;
+    }
+}
+
+// End of pathfinding/maze_path.c
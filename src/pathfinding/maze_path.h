@@ -0,0 +1,103 @@
+/**
+ * @file maze_path.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the compact path. A path is stored as its start point
+ * and a 2-bit direction for each step, so a path of n steps takes n / 4 bytes
+ * instead of a copy of every cell along it.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_PATH_H // Include guard.
+#define MAZE_PATH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_PATH_STEPS_PER_BYTE
+ * @brief Number of 2-bit steps packed into each byte.
+ */
+#define MAZE_PATH_STEPS_PER_BYTE 4u
+
+/**
+ * @def MAZE_PATH_GET_NUM_BYTES
+ * @brief Gets the number of bytes that hold a number of steps.
+ */
+#define MAZE_PATH_GET_NUM_BYTES(num_steps) \
+    (((num_steps) + MAZE_PATH_STEPS_PER_BYTE - 1u) / MAZE_PATH_STEPS_PER_BYTE)
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains a path as the point it starts at and the
+ * direction of each step from there. @see maze_path
+ */
+typedef struct maze_path
+{
+    maze_point_t start;     ///< Point of the first cell of the path.
+    uint32_t     num_steps; ///< Number of moves, one less than the cells.
+    uint8_t     *p_steps;   ///< Directions of the moves, 4 to a byte with the
+                            ///< first move in the lowest 2 bits. NULL if
+                            ///< there are no steps.
+} maze_path_t;
+
+/**
+ * @brief This struct contains the position of an iterator along a compact
+ * path. @see maze_path_iter
+ */
+typedef struct maze_path_iter
+{
+    const maze_path_t *p_path; ///< Path being iterated over.
+    maze_point_t       point;  ///< Point of the current cell.
+    uint32_t           step;   ///< Index of the current cell.
+} maze_path_iter_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+maze_path_t maze_path_create(const maze_point_t *p_start, uint32_t num_steps);
+
+void maze_path_destroy(maze_path_t *p_path);
+
+maze_cardinal_direction_t maze_path_get_step(const maze_path_t *p_path,
+                                             uint32_t           step);
+
+void maze_path_set_step(maze_path_t              *p_path,
+                        uint32_t                  step,
+                        maze_cardinal_direction_t direction);
+
+maze_point_t maze_path_get_end(const maze_path_t *p_path);
+
+maze_path_iter_t maze_path_iter_begin(const maze_path_t *p_path);
+
+bool maze_path_iter_next(maze_path_iter_t *p_iter);
+
+bool maze_path_from_context(const maze_grid_t      *p_grid,
+                            const search_context_t *p_context,
+                            const maze_grid_cell_t *p_end_node,
+                            maze_path_t            *p_path);
+
+maze_path_t maze_path_from_a_star_path(const a_star_path_t *p_path);
+
+a_star_path_t *maze_path_to_a_star_path(const maze_grid_t *p_grid,
+                                        const maze_path_t *p_path);
+
+char *maze_path_get_str(const maze_grid_t *p_grid, const maze_path_t *p_path);
+
+#endif // MAZE_PATH_H
+
+// End of pathfinding/maze_path.h
@@ -0,0 +1,534 @@
+/**
+ * @file maze_render.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the maze renderer. Every character is written at an
+ * offset computed from its cell, so rendering is linear in the size of the
+ * map.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_render.h"
+#include "pathfinding/maze_path.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def CELL_WIDTH
+ * @brief Number of characters drawn for each cell in a line.
+ */
+#define CELL_WIDTH 4u
+
+/**
+ * @def MARK_START
+ * @brief Path mark bit set on the start cell. The low nibble of a mark is the
+ * bitmask of directions the path leaves the cell in.
+ */
+#define MARK_START 0x10u
+
+/**
+ * @def MARK_END
+ * @brief Path mark bit set on the end cell.
+ */
+#define MARK_END 0x20u
+
+/**
+ * @brief This struct contains the state of the sink that builds a string.
+ */
+typedef struct string_sink
+{
+    char  *p_string; ///< String being built.
+    size_t offset;   ///< Offset of the next character.
+} string_sink_t;
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint8_t *mark_path(const maze_grid_t           *p_grid,
+                          const maze_render_overlay_t *p_overlay);
+static void     mark_steps(const maze_grid_t *p_grid,
+                           const maze_path_t *p_path,
+                           uint8_t           *p_marks);
+static void     render_line(const maze_grid_t           *p_grid,
+                            const maze_render_overlay_t *p_overlay,
+                            const uint8_t               *p_marks,
+                            uint32_t                     line,
+                            char                        *p_line);
+static char     get_path_char(uint8_t mark);
+static char     get_nav_char(maze_cardinal_direction_t orientation);
+static void     write_to_file(void       *p_context,
+                              const char *p_line,
+                              size_t      length);
+static void     write_to_string(void       *p_context,
+                                const char *p_line,
+                                size_t      length);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Gets the number of characters in each rendered line, excluding the
+ * newline.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @return size_t Number of characters in a line.
+ */
+size_t
+maze_render_get_line_length (const maze_grid_t *p_grid)
+{
+    return (size_t)MAZE_GRID_COLS(p_grid) * CELL_WIDTH + 1u;
+}
+
+/**
+ * @brief Renders the maze line by line. Each cell takes two lines, its north
+ * wall and its centre, and the south wall of the maze is the last line.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_overlay Pointer to the path and navigator to draw, or NULL.
+ * @param[in] p_sink Function that receives each line.
+ * @param[in,out] p_context Context passed to the sink.
+ * @return int16_t 0 if successful, -1 if memory could not be allocated.
+ *
+ * @note Only one line is held in memory. If there is a path, one byte per cell
+ * is also allocated to mark it.
+ */
+int16_t
+maze_render (const maze_grid_t           *p_grid,
+             const maze_render_overlay_t *p_overlay,
+             maze_render_sink_t           p_sink,
+             void                        *p_context)
+{
+    int16_t  ret_val   = 0;
+    uint8_t *p_marks   = NULL;
+    char    *p_line    = maze_malloc(maze_render_get_line_length(p_grid));
+    uint32_t num_lines = (uint32_t)MAZE_GRID_ROWS(p_grid) * 2u + 1u;
+
+    if (NULL == p_line)
+    {
+        return -1;
+    }
+
+    if (NULL != p_overlay
+        && ((NULL != p_overlay->p_path && 0 < p_overlay->path_length)
+            || NULL != p_overlay->p_steps))
+    {
+        p_marks = mark_path(p_grid, p_overlay);
+
+        if (NULL == p_marks)
+        {
+            ret_val = -1;
+            goto end;
+        }
+    }
+
+    for (uint32_t line = 0; num_lines > line; line++)
+    {
+        render_line(p_grid, p_overlay, p_marks, line, p_line);
+        p_sink(p_context, p_line, maze_render_get_line_length(p_grid));
+    }
+
+end:
+    maze_free(p_marks);
+    maze_free(p_line);
+    return ret_val;
+}
+
+/**
+ * @brief Renders the maze to a file, ending every line with a newline.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_overlay Pointer to the path and navigator to draw, or NULL.
+ * @param[in,out] p_file File to write to.
+ * @return int16_t 0 if successful, -1 otherwise.
+ */
+int16_t
+maze_render_to_file (const maze_grid_t           *p_grid,
+                     const maze_render_overlay_t *p_overlay,
+                     FILE                        *p_file)
+{
+    if (0 != maze_render(p_grid, p_overlay, &write_to_file, p_file)
+        || 0 != ferror(p_file))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Renders the maze to a string. Lines are separated by newlines, and
+ * the last line does not end with one.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_overlay Pointer to the path and navigator to draw, or NULL.
+ * @return char* The rendered maze, or NULL if memory could not be allocated.
+ *
+ * @warning The string must be freed with @ref maze_free.
+ */
+char *
+maze_render_to_string (const maze_grid_t           *p_grid,
+                       const maze_render_overlay_t *p_overlay)
+{
+    size_t        line_length = maze_render_get_line_length(p_grid) + 1u;
+    size_t        num_lines   = (size_t)MAZE_GRID_ROWS(p_grid) * 2u + 1u;
+    string_sink_t sink        = {
+        .p_string = maze_malloc(line_length * num_lines),
+        .offset   = 0,
+    };
+
+    if (NULL == sink.p_string)
+    {
+        return NULL;
+    }
+
+    if (0 != maze_render(p_grid, p_overlay, &write_to_string, &sink))
+    {
+        maze_free(sink.p_string);
+        return NULL;
+    }
+
+    sink.p_string[sink.offset] = '\0';
+    return sink.p_string;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Marks every cell of the path with the directions the path leaves it
+ * in.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_overlay Pointer to the overlay with the path.
+ * @return uint8_t* Marks indexed by cell, or NULL if they could not be
+ * allocated.
+ */
+static uint8_t *
+mark_path (const maze_grid_t *p_grid, const maze_render_overlay_t *p_overlay)
+{
+    const maze_grid_cell_t *p_path = p_overlay->p_path;
+    uint32_t                last   = p_overlay->path_length - 1u;
+    uint8_t                *p_marks
+        = maze_calloc(MAZE_GRID_CELLS(p_grid), sizeof(uint8_t));
+
+    if (NULL == p_marks)
+    {
+        return NULL;
+    }
+
+    if (NULL != p_overlay->p_steps)
+    {
+        mark_steps(p_grid, p_overlay->p_steps, p_marks);
+        return p_marks;
+    }
+
+    for (uint32_t idx = 0; last >= idx; idx++)
+    {
+        const maze_point_t *p_point = &p_path[idx].coordinates;
+
+        if (MAZE_GRID_ROWS(p_grid) <= p_point->y
+            || MAZE_GRID_COLS(p_grid) <= p_point->x)
+        {
+            continue;
+        }
+
+        uint8_t *p_mark = &p_marks[(size_t)p_point->y * MAZE_GRID_COLS(p_grid)
+                                   + p_point->x];
+
+        if (0 == idx)
+        {
+            *p_mark |= MARK_START;
+        }
+        if (last == idx)
+        {
+            *p_mark |= MARK_END;
+        }
+        if (0 < idx)
+        {
+            maze_cardinal_direction_t direction
+                = maze_get_dir_from_to(p_point, &p_path[idx - 1].coordinates);
+
+            if (MAZE_NONE != direction)
+            {
+                *p_mark |= 1u << direction;
+            }
+        }
+        if (last > idx)
+        {
+            maze_cardinal_direction_t direction
+                = maze_get_dir_from_to(p_point, &p_path[idx + 1].coordinates);
+
+            if (MAZE_NONE != direction)
+            {
+                *p_mark |= 1u << direction;
+            }
+        }
+    }
+
+    return p_marks;
+}
+
+/**
+ * @brief Marks every cell of a compact path with the directions the path
+ * leaves it in. Each step marks the cell it leaves and the cell it enters.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_path Pointer to the compact path.
+ * @param[in,out] p_marks Marks indexed by cell.
+ */
+static void
+mark_steps (const maze_grid_t *p_grid,
+            const maze_path_t *p_path,
+            uint8_t           *p_marks)
+{
+    maze_path_iter_t iter  = maze_path_iter_begin(p_path);
+    uint8_t          flags = MARK_START;
+    uint8_t          entry = 0;
+
+    while (true)
+    {
+        uint8_t exit = 0;
+
+        if (p_path->num_steps > iter.step)
+        {
+            exit = 1u << maze_path_get_step(p_path, iter.step);
+        }
+        else
+        {
+            flags |= MARK_END;
+        }
+
+        if (MAZE_GRID_ROWS(p_grid) > iter.point.y
+            && MAZE_GRID_COLS(p_grid) > iter.point.x)
+        {
+            p_marks[(size_t)iter.point.y * MAZE_GRID_COLS(p_grid)
+                    + iter.point.x]
+                |= flags | entry | exit;
+        }
+
+        if (!maze_path_iter_next(&iter))
+        {
+            break;
+        }
+
+        // The cell entered is marked towards the cell it was entered from.
+        //
+        entry = 1u << ((maze_path_get_step(p_path, iter.step - 1u) + 2u) % 4u);
+        flags = 0;
+    }
+}
+
+/**
+ * @brief Renders one line of the maze.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_overlay Pointer to the overlay, or NULL.
+ * @param[in] p_marks Path marks indexed by cell, or NULL.
+ * @param[in] line Index of the line. Even lines are walls, odd lines are cell
+ * centres.
+ * @param[out] p_line Buffer of @ref maze_render_get_line_length characters.
+ */
+static void
+render_line (const maze_grid_t           *p_grid,
+             const maze_render_overlay_t *p_overlay,
+             const uint8_t               *p_marks,
+             uint32_t                     line,
+             char                        *p_line)
+{
+    uint16_t row       = (uint16_t)(line / 2u);
+    bool     is_centre = 1u == (line & 1u);
+
+    // Step 1: Draw the walls. The south wall of the maze is always closed.
+    //
+    for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
+    {
+        char *p_cell_str = &p_line[(size_t)col * CELL_WIDTH];
+
+        if (MAZE_GRID_ROWS(p_grid) == row)
+        {
+            memcpy(p_cell_str, "+---", CELL_WIDTH);
+            continue;
+        }
+
+        const maze_grid_cell_t *p_cell
+            = &p_grid->p_grid_array[(size_t)row * MAZE_GRID_COLS(p_grid) + col];
+
+        if (is_centre)
+        {
+            memcpy(p_cell_str,
+                   NULL == p_cell->p_next[MAZE_WEST] ? "|   " : "    ",
+                   CELL_WIDTH);
+        }
+        else
+        {
+            memcpy(p_cell_str,
+                   NULL == p_cell->p_next[MAZE_NORTH] ? "+---" : "+   ",
+                   CELL_WIDTH);
+        }
+    }
+
+    p_line[(size_t)MAZE_GRID_COLS(p_grid) * CELL_WIDTH] = is_centre ? '|' : '+';
+
+    if (MAZE_GRID_ROWS(p_grid) == row)
+    {
+        return;
+    }
+
+    // Step 2: Draw the path over the walls.
+    //
+    for (uint16_t col = 0; NULL != p_marks && MAZE_GRID_COLS(p_grid) > col;
+         col++)
+    {
+        uint8_t mark   = p_marks[(size_t)row * MAZE_GRID_COLS(p_grid) + col];
+        size_t  centre = (size_t)col * CELL_WIDTH + 2u;
+
+        if (!is_centre)
+        {
+            if (0 != (mark & (1u << MAZE_NORTH)))
+            {
+                p_line[centre] = '|';
+            }
+            continue;
+        }
+
+        if (0 == mark)
+        {
+            continue;
+        }
+
+        p_line[centre] = get_path_char(mark);
+
+        if (0 != (mark & (1u << MAZE_EAST)))
+        {
+            memset(&p_line[centre + 1u], '-', 3);
+        }
+        if (0 != (mark & (1u << MAZE_WEST)))
+        {
+            memset(&p_line[centre - 3u], '-', 3);
+        }
+    }
+
+    // Step 3: Draw the navigator over the path.
+    //
+    if (is_centre && NULL != p_overlay && NULL != p_overlay->p_navigator)
+    {
+        const maze_grid_cell_t *p_current
+            = p_overlay->p_navigator->p_current_node;
+
+        if (row == p_current->coordinates.y)
+        {
+            p_line[(size_t)p_current->coordinates.x * CELL_WIDTH + 2u]
+                = get_nav_char(p_overlay->p_navigator->orientation);
+        }
+    }
+}
+
+/**
+ * @brief Gets the character drawn at the centre of a cell of the path.
+ *
+ * @param[in] mark Path mark of the cell.
+ * @return char 'X' for the end, '%' for the start, '|' or '-' if the path goes
+ * straight through, and 'O' if it turns.
+ */
+static char
+get_path_char (uint8_t mark)
+{
+    uint8_t directions = mark & 0xFu;
+
+    if (0 != (mark & MARK_END))
+    {
+        return 'X';
+    }
+    if (0 != (mark & MARK_START))
+    {
+        return '%';
+    }
+    if (((1u << MAZE_NORTH) | (1u << MAZE_SOUTH)) == directions)
+    {
+        return '|';
+    }
+    if (((1u << MAZE_EAST) | (1u << MAZE_WEST)) == directions)
+    {
+        return '-';
+    }
+
+    return 'O';
+}
+
+/**
+ * @brief Gets the character drawn for the navigator.
+ *
+ * @param[in] orientation Orientation of the navigator.
+ * @return char Arrow in the direction of the navigator, or 'X' if it has no
+ * orientation.
+ */
+static char
+get_nav_char (maze_cardinal_direction_t orientation)
+{
+    switch (orientation)
+    {
+        case MAZE_NORTH:
+            return '^';
+        case MAZE_EAST:
+            return '>';
+        case MAZE_SOUTH:
+            return 'v';
+        case MAZE_WEST:
+            return '<';
+        default:
+            return 'X';
+    }
+}
+
+/**
+ * @brief Sink that writes a line and a newline to a file.
+ *
+ * @param[in,out] p_context File to write to.
+ * @param[in] p_line Characters of the line.
+ * @param[in] length Number of characters in the line.
+ */
+static void
+write_to_file (void *p_context, const char *p_line, size_t length)
+{
+    fwrite(p_line, sizeof(char), length, (FILE *)p_context);
+    fputc('\n', (FILE *)p_context);
+}
+
+/**
+ * @brief Sink that appends a line to a string, separated from the previous
+ * line by a newline.
+ *
+ * @param[in,out] p_context Pointer to the string sink.
+ * @param[in] p_line Characters of the line.
+ * @param[in] length Number of characters in the line.
+ */
+static void
+write_to_string (void *p_context, const char *p_line, size_t length)
+{
+    string_sink_t *p_sink = p_context;
+
+    if (0 != p_sink->offset)
+    {
+        p_sink->p_string[p_sink->offset++] = '\n';
+    }
+
+    memcpy(&p_sink->p_string[p_sink->offset], p_line, length);
+    p_sink->offset += length;
+}
+
+// End of pathfinding/maze_render.c
@@ -0,0 +1,74 @@
+/**
+ * @file maze_render.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the maze renderer. The ASCII map is drawn one line at
+ * a time into a buffer of one line, with the path and navigator overlaid in
+ * the same pass, and each line is handed to a sink.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_RENDER_H // Include guard.
+#define MAZE_RENDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "pathfinding/maze.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+struct maze_path;
+
+/**
+ * @brief Function that receives each rendered line of the map.
+ *
+ * @param[in,out] p_context Context given to @ref maze_render.
+ * @param[in] p_line Characters of the line. It is not NUL-terminated and does
+ * not end with a newline.
+ * @param[in] length Number of characters in the line.
+ */
+typedef void (*maze_render_sink_t)(void       *p_context,
+                                   const char *p_line,
+                                   size_t      length);
+
+/**
+ * @brief This struct contains what is drawn over the walls of the map.
+ */
+typedef struct maze_render_overlay
+{
+    const maze_navigator_state_t *p_navigator; ///< Navigator to draw, or NULL.
+    const maze_grid_cell_t *p_path; ///< Cells of the path from the start to
+                                    ///< the end, or NULL. Only their
+                                    ///< coordinates are read.
+    uint32_t path_length;           ///< Number of cells in the path.
+    const struct maze_path *p_steps; ///< Compact path to draw instead of
+                                     ///< p_path, or NULL.
+} maze_render_overlay_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+size_t maze_render_get_line_length(const maze_grid_t *p_grid);
+
+int16_t maze_render(const maze_grid_t           *p_grid,
+                    const maze_render_overlay_t *p_overlay,
+                    maze_render_sink_t           p_sink,
+                    void                        *p_context);
+
+int16_t maze_render_to_file(const maze_grid_t           *p_grid,
+                            const maze_render_overlay_t *p_overlay,
+                            FILE                        *p_file);
+
+char *maze_render_to_string(const maze_grid_t           *p_grid,
+                            const maze_render_overlay_t *p_overlay);
+
+#endif // MAZE_RENDER_H
+
+// End of pathfinding/maze_render.h
@@ -0,0 +1,496 @@
+/**
+ * @file maze_snapshot.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for versioned maps and their copy-on-write snapshots.
+ * Only the mapper writes to the rows of a versioned map, and only while it is
+ * the sole holder of the row, so readers of a snapshot never see a write.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_snapshot.h"
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_snapshot_row_t *create_row(uint16_t columns);
+static void                 release_row(maze_snapshot_row_t *p_row);
+static uint8_t              get_cell_gaps(const maze_grid_cell_t *p_cell);
+static int16_t              sync_point(maze_versioned_t *p_map,
+                                       uint16_t          row,
+                                       uint16_t          col,
+                                       bool             *p_is_changed);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Initialises a versioned map that mirrors the walls of a grid maze.
+ *
+ * @param[out] p_map Pointer to the versioned map.
+ * @param[in] p_grid Pointer to the live grid maze. It must outlive the map.
+ * @return int16_t 0 if successful, -1 if memory could not be allocated.
+ *
+ * @warning The map must be destroyed by @ref maze_versioned_destroy.
+ */
+int16_t
+maze_versioned_init (maze_versioned_t *p_map, maze_grid_t *p_grid)
+{
+    p_map->p_grid     = p_grid;
+    p_map->version    = 0;
+    p_map->num_copies = 0;
+    p_map->p_rows
+        = maze_malloc(sizeof(maze_snapshot_row_t *) * MAZE_GRID_ROWS(p_grid));
+
+    if (NULL == p_map->p_rows)
+    {
+        return -1;
+    }
+
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
+    {
+        p_map->p_rows[row] = create_row(MAZE_GRID_COLS(p_grid));
+
+        if (NULL == p_map->p_rows[row])
+        {
+            while (0 < row)
+            {
+                release_row(p_map->p_rows[--row]);
+            }
+
+            maze_free(p_map->p_rows);
+            p_map->p_rows = NULL;
+            return -1;
+        }
+
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
+        {
+            p_map->p_rows[row]->gaps[col] = get_cell_gaps(
+                &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col]);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Destroys a versioned map. Rows still held by snapshots are freed when
+ * the last snapshot is released. The grid maze is not destroyed.
+ *
+ * @param[in,out] p_map Pointer to the versioned map.
+ */
+void
+maze_versioned_destroy (maze_versioned_t *p_map)
+{
+    if (NULL == p_map->p_rows)
+    {
+        return;
+    }
+
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_map->p_grid) > row; row++)
+    {
+        release_row(p_map->p_rows[row]);
+    }
+
+    maze_free(p_map->p_rows);
+    p_map->p_rows = NULL;
+}
+
+/**
+ * @brief Copies the walls of a cell and its neighbours from the grid maze to
+ * the versioned map. A row held by a snapshot is copied before it is written.
+ *
+ * @param[in,out] p_map Pointer to the versioned map.
+ * @param[in] p_cell Pointer to the cell of the grid maze whose walls changed.
+ * @return int16_t 0 if successful, -1 if a row could not be copied.
+ */
+int16_t
+maze_versioned_sync_cell (maze_versioned_t       *p_map,
+                          const maze_grid_cell_t *p_cell)
+{
+    static const int8_t row_offsets[5] = { 0, -1, 0, 1, 0 };
+    static const int8_t col_offsets[5] = { 0, 0, 1, 0, -1 };
+
+    int16_t  ret_val    = 0;
+    bool     is_changed = false;
+    uint16_t rows       = MAZE_GRID_ROWS(p_map->p_grid);
+    uint16_t columns    = MAZE_GRID_COLS(p_map->p_grid);
+
+    // Step 1: Walls are symmetric, so the cell and its four neighbours can
+    // change.
+    //
+    for (uint8_t idx = 0; 5 > idx; idx++)
+    {
+        uint16_t row = (uint16_t)(p_cell->coordinates.y + row_offsets[idx]);
+        uint16_t col = (uint16_t)(p_cell->coordinates.x + col_offsets[idx]);
+
+        if (rows <= row || columns <= col)
+        {
+            continue;
+        }
+
+        if (0 != sync_point(p_map, row, col, &is_changed))
+        {
+            ret_val = -1;
+        }
+    }
+
+    // Step 2: Bump the version so that planners can tell their snapshot is
+    // stale.
+    //
+    if (is_changed)
+    {
+        MAZE_SNAPSHOT_LOCK();
+        p_map->version++;
+        MAZE_SNAPSHOT_UNLOCK();
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Modifies the walls of the current cell of the navigator like
+ * @ref maze_nav_modify_walls, and records them in the versioned map.
+ *
+ * @param[in,out] p_map Pointer to the versioned map.
+ * @param[in] p_navigator Pointer to the navigator in the grid maze.
+ * @param[in] wall_bitmask Bitmask of the walls, indexed by direction.
+ * @param[in] is_set Whether to set the walls.
+ * @param[in] is_unset Whether to unset the walls.
+ * @return int16_t 0 if successful, -1 if a row could not be copied.
+ */
+int16_t
+maze_versioned_modify_walls (maze_versioned_t       *p_map,
+                             maze_navigator_state_t *p_navigator,
+                             uint8_t                 wall_bitmask,
+                             bool                    is_set,
+                             bool                    is_unset)
+{
+    maze_nav_modify_walls(
+        p_map->p_grid, p_navigator, wall_bitmask, is_set, is_unset);
+    return maze_versioned_sync_cell(p_map, p_navigator->p_current_node);
+}
+
+/**
+ * @brief Takes a snapshot of a versioned map. Every row is shared with the
+ * map, so this costs one allocation and O(rows) time.
+ *
+ * @param[in,out] p_map Pointer to the versioned map.
+ * @return maze_snapshot_t* Pointer to the snapshot with a reference count of
+ * 1, or NULL if it could not be allocated.
+ *
+ * @warning The snapshot must be released by @ref maze_snapshot_release.
+ */
+maze_snapshot_t *
+maze_versioned_snapshot (maze_versioned_t *p_map)
+{
+    uint16_t         rows       = MAZE_GRID_ROWS(p_map->p_grid);
+    maze_snapshot_t *p_snapshot = maze_malloc(
+        sizeof(maze_snapshot_t) + sizeof(maze_snapshot_row_t *) * rows);
+
+    if (NULL == p_snapshot)
+    {
+        return NULL;
+    }
+
+    p_snapshot->p_rows   = (maze_snapshot_row_t **)(p_snapshot + 1);
+    p_snapshot->rows     = rows;
+    p_snapshot->columns  = MAZE_GRID_COLS(p_map->p_grid);
+    p_snapshot->refcount = 1;
+
+    MAZE_SNAPSHOT_LOCK();
+
+    for (uint16_t row = 0; rows > row; row++)
+    {
+        p_snapshot->p_rows[row] = p_map->p_rows[row];
+        p_snapshot->p_rows[row]->refcount++;
+    }
+
+    p_snapshot->version = p_map->version;
+    MAZE_SNAPSHOT_UNLOCK();
+
+    return p_snapshot;
+}
+
+/**
+ * @brief Adds a holder to a snapshot, e.g. before handing it to another task.
+ *
+ * @param[in,out] p_snapshot Pointer to the snapshot.
+ * @return maze_snapshot_t* The same snapshot.
+ */
+maze_snapshot_t *
+maze_snapshot_retain (maze_snapshot_t *p_snapshot)
+{
+    MAZE_SNAPSHOT_LOCK();
+    p_snapshot->refcount++;
+    MAZE_SNAPSHOT_UNLOCK();
+
+    return p_snapshot;
+}
+
+/**
+ * @brief Removes a holder from a snapshot. The snapshot and the rows it alone
+ * holds are freed when the last holder releases it.
+ *
+ * @param[in,out] p_snapshot Pointer to the snapshot. Nothing is done if it is
+ * NULL.
+ */
+void
+maze_snapshot_release (maze_snapshot_t *p_snapshot)
+{
+    if (NULL == p_snapshot)
+    {
+        return;
+    }
+
+    MAZE_SNAPSHOT_LOCK();
+    uint32_t remaining = --p_snapshot->refcount;
+    MAZE_SNAPSHOT_UNLOCK();
+
+    if (0 != remaining)
+    {
+        return;
+    }
+
+    for (uint16_t row = 0; p_snapshot->rows > row; row++)
+    {
+        release_row(p_snapshot->p_rows[row]);
+    }
+
+    maze_free(p_snapshot);
+}
+
+/**
+ * @brief Gets the gap bitmask of a cell in a snapshot.
+ *
+ * @param[in] p_snapshot Pointer to the snapshot.
+ * @param[in] p_point Pointer to the coordinates of the cell.
+ * @return uint8_t Gap bitmask of the cell. Bit d is set if there is no wall in
+ * the direction d. 0 if the cell is out of bounds.
+ */
+uint8_t
+maze_snapshot_get_gaps (const maze_snapshot_t *p_snapshot,
+                        const maze_point_t    *p_point)
+{
+    if (p_snapshot->rows <= p_point->y || p_snapshot->columns <= p_point->x)
+    {
+        return 0;
+    }
+
+    return p_snapshot->p_rows[p_point->y]->gaps[p_point->x];
+}
+
+/**
+ * @brief Serialises a snapshot into the format of @ref maze_serialise, e.g.
+ * to send it over WiFi.
+ *
+ * @param[in] p_snapshot Pointer to the snapshot.
+ * @return maze_gap_bitmask_t Gap bitmask of the snapshot.
+ *
+ * @warning The bitmask array must be freed with @ref maze_free.
+ */
+maze_gap_bitmask_t
+maze_snapshot_serialise (const maze_snapshot_t *p_snapshot)
+{
+    maze_gap_bitmask_t no_walls_array = {
+        .p_bitmask = maze_malloc(sizeof(uint16_t) * p_snapshot->rows
+                                 * p_snapshot->columns),
+        .rows      = p_snapshot->rows,
+        .columns   = p_snapshot->columns,
+    };
+
+    if (NULL == no_walls_array.p_bitmask)
+    {
+        return no_walls_array;
+    }
+
+    for (uint16_t row = 0; p_snapshot->rows > row; row++)
+    {
+        for (uint16_t col = 0; p_snapshot->columns > col; col++)
+        {
+            no_walls_array.p_bitmask[row * p_snapshot->columns + col]
+                = p_snapshot->p_rows[row]->gaps[col];
+        }
+    }
+
+    return no_walls_array;
+}
+
+/**
+ * @brief Restores the walls of a snapshot into a grid maze owned by the
+ * planner, so that A* can be run against a consistent map.
+ *
+ * @param[in] p_snapshot Pointer to the snapshot.
+ * @param[in,out] p_grid Pointer to the grid maze of the same dimensions.
+ * @return int16_t 0 if successful, -1 if the dimensions differ.
+ */
+int16_t
+maze_snapshot_restore (const maze_snapshot_t *p_snapshot, maze_grid_t *p_grid)
+{
+    if (MAZE_GRID_ROWS(p_grid) != p_snapshot->rows
+        || MAZE_GRID_COLS(p_grid) != p_snapshot->columns)
+    {
+        return -1;
+    }
+
+    maze_navigator_state_t navigator = { NULL, NULL, NULL, MAZE_NORTH };
+
+    for (uint16_t row = 0; MAZE_GRID_ROWS(p_grid) > row; row++)
+    {
+        for (uint16_t col = 0; MAZE_GRID_COLS(p_grid) > col; col++)
+        {
+            // Unsets the walls where the gap bit is set and sets the rest.
+            //
+            navigator.p_current_node
+                = &p_grid->p_grid_array[row * MAZE_GRID_COLS(p_grid) + col];
+            maze_nav_modify_walls(p_grid,
+                                  &navigator,
+                                  p_snapshot->p_rows[row]->gaps[col],
+                                  true,
+                                  true);
+        }
+    }
+
+    return 0;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Allocates a row held by one holder.
+ *
+ * @param[in] columns Number of cells in the row.
+ * @return maze_snapshot_row_t* Pointer to the row, or NULL if it could not be
+ * allocated.
+ */
+static maze_snapshot_row_t *
+create_row (uint16_t columns)
+{
+    maze_snapshot_row_t *p_row
+        = maze_malloc(sizeof(maze_snapshot_row_t) + columns);
+
+    if (NULL != p_row)
+    {
+        p_row->refcount = 1;
+    }
+
+    return p_row;
+}
+
+/**
+ * @brief Removes a holder from a row and frees it if it was the last one.
+ *
+ * @param[in,out] p_row Pointer to the row.
+ */
+static void
+release_row (maze_snapshot_row_t *p_row)
+{
+    MAZE_SNAPSHOT_LOCK();
+    uint32_t remaining = --p_row->refcount;
+    MAZE_SNAPSHOT_UNLOCK();
+
+    if (0 == remaining)
+    {
+        maze_free(p_row);
+    }
+}
+
+/**
+ * @brief Gets the gap bitmask of a cell of a grid maze.
+ *
+ * @param[in] p_cell Pointer to the cell.
+ * @return uint8_t Gap bitmask of the cell.
+ */
+static uint8_t
+get_cell_gaps (const maze_grid_cell_t *p_cell)
+{
+    uint8_t gaps = 0;
+
+    for (uint8_t direction = 0; 4 > direction; direction++)
+    {
+        if (NULL != p_cell->p_next[direction])
+        {
+            gaps |= (1 << direction);
+        }
+    }
+
+    return gaps;
+}
+
+/**
+ * @brief Copies the walls of one cell from the grid maze to the versioned map.
+ *
+ * @param[in,out] p_map Pointer to the versioned map.
+ * @param[in] row Row of the cell.
+ * @param[in] col Column of the cell.
+ * @param[out] p_is_changed Set to true if the walls of the cell changed.
+ * @return int16_t 0 if successful, -1 if the row could not be copied.
+ */
+static int16_t
+sync_point (maze_versioned_t *p_map,
+            uint16_t          row,
+            uint16_t          col,
+            bool             *p_is_changed)
+{
+    uint16_t columns = MAZE_GRID_COLS(p_map->p_grid);
+    uint8_t  gaps
+        = get_cell_gaps(&p_map->p_grid->p_grid_array[row * columns + col]);
+    maze_snapshot_row_t *p_row = p_map->p_rows[row];
+
+    // Step 1: Write in place if the map is the only holder of the row.
+    //
+    MAZE_SNAPSHOT_LOCK();
+
+    if (gaps == p_row->gaps[col])
+    {
+        MAZE_SNAPSHOT_UNLOCK();
+        return 0;
+    }
+
+    if (1 == p_row->refcount)
+    {
+        p_row->gaps[col] = gaps;
+        MAZE_SNAPSHOT_UNLOCK();
+        *p_is_changed = true;
+        return 0;
+    }
+
+    MAZE_SNAPSHOT_UNLOCK();
+
+    // Step 2: Otherwise, copy the row outside of the critical section. The
+    // shared row is never written to, so it is safe to read.
+    //
+    maze_snapshot_row_t *p_copy = create_row(columns);
+
+    if (NULL == p_copy)
+    {
+        return -1;
+    }
+
+    memcpy(p_copy->gaps, p_row->gaps, columns);
+    p_copy->gaps[col] = gaps;
+
+    MAZE_SNAPSHOT_LOCK();
+    p_map->p_rows[row] = p_copy;
+    MAZE_SNAPSHOT_UNLOCK();
+
+    release_row(p_row);
+    p_map->num_copies++;
+    *p_is_changed = true;
+    return 0;
+}
+
+// End of pathfinding/maze_snapshot.c
@@ -0,0 +1,123 @@
+/**
+ * @file maze_snapshot.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for versioned maps and their copy-on-write snapshots. A
+ * versioned map mirrors the walls of a live grid maze in reference-counted
+ * rows. Taking a snapshot shares every row, and a row is only copied when the
+ * mapper writes to it while a snapshot still holds it.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_SNAPSHOT_H // Include guard.
+#define MAZE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_SNAPSHOT_LOCK()
+ * @brief Enters the critical section that guards reference counts and row
+ * pointers. Define it, e.g. as taskENTER_CRITICAL(), when snapshots are taken
+ * or released from more than one task.
+ */
+#ifndef MAZE_SNAPSHOT_LOCK
+#define MAZE_SNAPSHOT_LOCK()
+#endif
+
+/**
+ * @def MAZE_SNAPSHOT_UNLOCK()
+ * @brief Leaves the critical section entered by @ref MAZE_SNAPSHOT_LOCK.
+ */
+#ifndef MAZE_SNAPSHOT_UNLOCK
+#define MAZE_SNAPSHOT_UNLOCK()
+#endif
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains one row of gap bitmasks shared between a
+ * versioned map and its snapshots.
+ */
+typedef struct maze_snapshot_row
+{
+    uint32_t refcount; ///< Number of maps and snapshots holding the row.
+    uint8_t  gaps[];   ///< Gap bitmask of each cell. Bit d is set if there is
+                       ///< no wall in the direction d.
+} maze_snapshot_row_t;
+
+/**
+ * @brief This struct contains a frozen view of the walls of a versioned map.
+ *
+ * @note A snapshot is never written to, so it can be read by another task
+ * without locking.
+ */
+typedef struct maze_snapshot
+{
+    maze_snapshot_row_t **p_rows;   ///< Rows of the snapshot.
+    uint16_t              rows;     ///< Number of rows.
+    uint16_t              columns;  ///< Number of columns.
+    uint32_t              version;  ///< Version of the map when it was taken.
+    uint32_t              refcount; ///< Number of holders of the snapshot.
+} maze_snapshot_t;
+
+/**
+ * @brief This struct contains the rows mirroring the walls of a live grid
+ * maze.
+ *
+ * @warning Walls must be changed through @ref maze_versioned_modify_walls, or
+ * followed by @ref maze_versioned_sync_cell, for snapshots to see them.
+ */
+typedef struct maze_versioned
+{
+    maze_grid_t          *p_grid;     ///< Live grid maze written by the mapper.
+    maze_snapshot_row_t **p_rows;     ///< Current rows of the map.
+    uint32_t              version;    ///< Incremented whenever a wall changes.
+    uint32_t              num_copies; ///< Number of rows copied on write.
+} maze_versioned_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+int16_t maze_versioned_init(maze_versioned_t *p_map, maze_grid_t *p_grid);
+
+void maze_versioned_destroy(maze_versioned_t *p_map);
+
+int16_t maze_versioned_sync_cell(maze_versioned_t       *p_map,
+                                 const maze_grid_cell_t *p_cell);
+
+int16_t maze_versioned_modify_walls(maze_versioned_t       *p_map,
+                                    maze_navigator_state_t *p_navigator,
+                                    uint8_t                 wall_bitmask,
+                                    bool                    is_set,
+                                    bool                    is_unset);
+
+maze_snapshot_t *maze_versioned_snapshot(maze_versioned_t *p_map);
+
+maze_snapshot_t *maze_snapshot_retain(maze_snapshot_t *p_snapshot);
+
+void maze_snapshot_release(maze_snapshot_t *p_snapshot);
+
+uint8_t maze_snapshot_get_gaps(const maze_snapshot_t *p_snapshot,
+                               const maze_point_t    *p_point);
+
+maze_gap_bitmask_t maze_snapshot_serialise(const maze_snapshot_t *p_snapshot);
+
+int16_t maze_snapshot_restore(const maze_snapshot_t *p_snapshot,
+                              maze_grid_t           *p_grid);
+
+#endif // MAZE_SNAPSHOT_H
+
+// End of pathfinding/maze_snapshot.h
@@ -0,0 +1,532 @@
+/**
+ * @file maze_tour.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the tour planner. The stops are numbered with the
+ * waypoints first, then the start, then the exit, and every leg of the tour
+ * is walked along the distance field of the stop it leads to.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_dist_cache.h"
+#include "pathfinding/maze_path.h"
+#include "pathfinding/maze_tour.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def GET_DIST
+ * @brief Gets the distance between two stops from the table of distances.
+ */
+#define GET_DIST(p_dists, num_stops, from, to) \
+    ((p_dists)[(size_t)(from) * (num_stops) + (to)])
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static bool solve_exact(const uint32_t *p_dists,
+                        uint8_t         num_waypoints,
+                        uint8_t        *p_order);
+
+static void solve_two_opt(const uint32_t *p_dists,
+                          uint8_t         num_waypoints,
+                          uint8_t        *p_order);
+
+static maze_tour_result_t build_path(
+    maze_dist_cache_t             *p_cache,
+    const maze_grid_cell_t        *p_start,
+    const maze_grid_cell_t *const *pp_stops,
+    const uint8_t                 *p_order,
+    uint8_t                        num_waypoints,
+    maze_path_t                   *p_path);
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Plans the shortest tour from the start through every waypoint to the
+ * exit. The order is exact for up to @ref MAZE_TOUR_MAX_EXACT waypoints.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_start Pointer to the start node.
+ * @param[in] pp_waypoints Array of pointers to the waypoints, in any order.
+ * @param[in] num_waypoints Number of waypoints, at most @ref
+ * MAZE_TOUR_MAX_WAYPOINTS.
+ * @param[in] p_exit Pointer to the exit node.
+ * @param[out] p_order Array of the index of each waypoint in the order they
+ * are visited, or NULL.
+ * @param[out] p_path Pointer to the compact path of the tour to create.
+ * @return maze_tour_result_t MAZE_TOUR_PLANNED if the tour was planned. A stop
+ * that is too far for its distance field to measure is reported as
+ * MAZE_TOUR_TOO_FAR rather than unreachable, @see maze_tour_result_t.
+ *
+ * @warning The path must be destroyed by @ref maze_path_destroy, and is only
+ * created if the tour was planned.
+ * @note Memory grows with the stops: a distance field of one @ref maze_dist_t
+ * per cell for each waypoint and the exit.
+ */
+maze_tour_result_t
+maze_tour_plan (const maze_grid_t             *p_grid,
+                const maze_grid_cell_t        *p_start,
+                const maze_grid_cell_t *const *pp_waypoints,
+                uint8_t                        num_waypoints,
+                const maze_grid_cell_t        *p_exit,
+                uint8_t                       *p_order,
+                maze_path_t                   *p_path)
+{
+    if (MAZE_TOUR_MAX_WAYPOINTS < num_waypoints)
+    {
+        return MAZE_TOUR_TOO_MANY;
+    }
+
+    // Stops are the waypoints, then the start, then the exit. Only the
+    // waypoints and the exit are flooded, as the start is never a
+    // destination.
+    //
+    uint8_t num_stops = num_waypoints + 2u;
+    uint8_t start     = num_waypoints;
+    uint8_t exit      = num_waypoints + 1u;
+
+    const maze_grid_cell_t **pp_stops
+        = maze_malloc(sizeof(maze_grid_cell_t *) * num_stops);
+    uint32_t *p_dists
+        = maze_malloc(sizeof(uint32_t) * (size_t)num_stops * num_stops);
+    uint8_t *p_visits = maze_malloc(sizeof(uint8_t) * (num_waypoints + 1u));
+    maze_dist_cache_t cache = maze_dist_cache_create(p_grid, num_stops - 1u);
+
+    maze_tour_result_t result
+        = (NULL != pp_stops && NULL != p_dists && NULL != p_visits
+           && 0 < cache.num_fields)
+              ? MAZE_TOUR_PLANNED
+              : MAZE_TOUR_NO_MEMORY;
+
+    // Step 1: Flood each destination, and read the distance to it from every
+    // stop. A move costs as much as the cell it enters, so the distance from
+    // one stop to another differs from the distance back by the difference of
+    // their costs. Adding the cost of the stop left makes the table the same
+    // both ways, as 2-opt needs, and adds the same to every tour. Every leg
+    // must cost less than its share of UINT32_MAX so that tours add up.
+    //
+    uint32_t max_leg     = UINT32_MAX / (num_waypoints + 1u);
+    bool     is_too_far  = false;
+    bool     is_isolated = false;
+
+    for (uint8_t stop = 0; MAZE_TOUR_PLANNED == result && num_waypoints > stop;
+         stop++)
+    {
+        pp_stops[stop] = pp_waypoints[stop];
+    }
+
+    if (MAZE_TOUR_PLANNED == result)
+    {
+        pp_stops[start] = p_start;
+        pp_stops[exit]  = p_exit;
+    }
+
+    for (uint8_t to = 0; MAZE_TOUR_PLANNED == result && num_stops > to; to++)
+    {
+        if (start == to)
+        {
+            continue;
+        }
+
+        const maze_dist_field_t *p_field
+            = maze_dist_cache_get(&cache, pp_stops[to]);
+
+        if (NULL == p_field)
+        {
+            result = MAZE_TOUR_NO_MEMORY;
+            break;
+        }
+
+        for (uint8_t from = 0; num_stops > from; from++)
+        {
+            maze_dist_t dist = p_field->p_dists[maze_get_cell_idx(
+                p_grid, pp_stops[from])];
+            uint64_t leg
+                = (uint64_t)dist + maze_get_cell_cost(p_grid, pp_stops[from]);
+
+            // A saturated field cannot tell a stop that is too far from one
+            // that cannot be reached, so the stop is taken to be too far.
+            //
+            if (MAZE_DIST_CACHE_UNREACHABLE == dist && !p_field->is_saturated)
+            {
+                is_isolated = true;
+            }
+            else if (MAZE_DIST_CACHE_UNREACHABLE == dist || max_leg <= leg)
+            {
+                is_too_far = true;
+            }
+
+            GET_DIST(p_dists, num_stops, from, to)
+                = (max_leg <= leg) ? UINT32_MAX : (uint32_t)leg;
+        }
+    }
+
+    if (MAZE_TOUR_PLANNED == result && is_isolated)
+    {
+        result = MAZE_TOUR_UNREACHABLE;
+    }
+    else if (MAZE_TOUR_PLANNED == result && is_too_far)
+    {
+        result = MAZE_TOUR_TOO_FAR;
+    }
+
+    // Step 2: Order the waypoints.
+    //
+    if (MAZE_TOUR_PLANNED == result && MAZE_TOUR_MAX_EXACT >= num_waypoints)
+    {
+        if (!solve_exact(p_dists, num_waypoints, p_visits))
+        {
+            result = MAZE_TOUR_NO_MEMORY;
+        }
+    }
+    else if (MAZE_TOUR_PLANNED == result)
+    {
+        solve_two_opt(p_dists, num_waypoints, p_visits);
+    }
+
+    // Step 3: Walk every leg into one path.
+    //
+    if (MAZE_TOUR_PLANNED == result)
+    {
+        p_visits[num_waypoints] = exit;
+        result                  = build_path(
+            &cache, p_start, pp_stops, p_visits, num_waypoints, p_path);
+    }
+
+    if (MAZE_TOUR_PLANNED == result && NULL != p_order)
+    {
+        for (uint8_t visit = 0; num_waypoints > visit; visit++)
+        {
+            p_order[visit] = p_visits[visit];
+        }
+    }
+
+    maze_dist_cache_destroy(&cache);
+    maze_free(p_visits);
+    maze_free(p_dists);
+    maze_free(pp_stops);
+
+    return result;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Orders the waypoints exactly with the Held-Karp algorithm: the
+ * shortest walk from the start through each subset of waypoints that ends at
+ * each of them, built up from the smaller subsets.
+ *
+ * @param[in] p_dists Table of distances between the stops.
+ * @param[in] num_waypoints Number of waypoints, at most @ref
+ * MAZE_TOUR_MAX_EXACT.
+ * @param[out] p_order Array of the waypoints in the order they are visited.
+ * @return true If the waypoints were ordered.
+ * @return false If the tables could not be allocated.
+ */
+static bool
+solve_exact (const uint32_t *p_dists, uint8_t num_waypoints, uint8_t *p_order)
+{
+    if (0 == num_waypoints)
+    {
+        return true;
+    }
+
+    uint8_t   num_stops  = num_waypoints + 2u;
+    uint8_t   start      = num_waypoints;
+    uint8_t   exit       = num_waypoints + 1u;
+    uint32_t  num_sets   = 1u << num_waypoints;
+    uint32_t *p_lengths  = maze_malloc(sizeof(uint32_t) * num_sets
+                                      * num_waypoints);
+    uint8_t  *p_previous = maze_malloc(sizeof(uint8_t) * num_sets
+                                      * num_waypoints);
+
+    if (NULL == p_lengths || NULL == p_previous)
+    {
+        maze_free(p_lengths);
+        maze_free(p_previous);
+        return false;
+    }
+
+    for (size_t entry = 0; (size_t)num_sets * num_waypoints > entry; entry++)
+    {
+        p_lengths[entry] = UINT32_MAX;
+    }
+
+    for (uint8_t last = 0; num_waypoints > last; last++)
+    {
+        p_lengths[(size_t)(1u << last) * num_waypoints + last]
+            = GET_DIST(p_dists, num_stops, start, last);
+        p_previous[(size_t)(1u << last) * num_waypoints + last] = start;
+    }
+
+    // Every subset is built from smaller ones, which come before it in
+    // numeric order.
+    //
+    for (uint32_t set = 1; num_sets > set; set++)
+    {
+        for (uint8_t last = 0; num_waypoints > last; last++)
+        {
+            uint32_t length = p_lengths[(size_t)set * num_waypoints + last];
+
+            if (UINT32_MAX == length)
+            {
+                continue;
+            }
+
+            for (uint8_t next = 0; num_waypoints > next; next++)
+            {
+                if (0 != (set & (1u << next)))
+                {
+                    continue;
+                }
+
+                size_t entry
+                    = (size_t)(set | (1u << next)) * num_waypoints + next;
+                uint32_t next_length
+                    = length + GET_DIST(p_dists, num_stops, last, next);
+
+                if (next_length < p_lengths[entry])
+                {
+                    p_lengths[entry]  = next_length;
+                    p_previous[entry] = last;
+                }
+            }
+        }
+    }
+
+    // Close the walks at the exit, and follow the best one back.
+    //
+    uint32_t full_set    = num_sets - 1u;
+    uint32_t best_length = UINT32_MAX;
+    uint8_t  last        = 0;
+
+    for (uint8_t candidate = 0; num_waypoints > candidate; candidate++)
+    {
+        uint32_t length
+            = p_lengths[(size_t)full_set * num_waypoints + candidate]
+              + GET_DIST(p_dists, num_stops, candidate, exit);
+
+        if (length < best_length)
+        {
+            best_length = length;
+            last        = candidate;
+        }
+    }
+
+    uint32_t set = full_set;
+
+    for (uint8_t visit = num_waypoints; 0 < visit; visit--)
+    {
+        uint8_t previous = p_previous[(size_t)set * num_waypoints + last];
+        p_order[visit - 1u] = last;
+        set &= ~(1u << last);
+        last = previous;
+    }
+
+    maze_free(p_lengths);
+    maze_free(p_previous);
+
+    return true;
+}
+
+/**
+ * @brief Orders the waypoints by always visiting the closest one left, then
+ * reverses stretches of the order while that shortens the tour (2-opt). The
+ * start and the exit stay at the ends.
+ *
+ * @param[in] p_dists Table of distances between the stops.
+ * @param[in] num_waypoints Number of waypoints.
+ * @param[out] p_order Array of the waypoints in the order they are visited,
+ * with room for the exit after them.
+ */
+static void
+solve_two_opt (const uint32_t *p_dists, uint8_t num_waypoints, uint8_t *p_order)
+{
+    uint8_t num_stops = num_waypoints + 2u;
+    uint8_t start     = num_waypoints;
+    uint8_t exit      = num_waypoints + 1u;
+    uint8_t from      = start;
+
+    // Step 1: Build the tour greedily. The order doubles as the set of
+    // waypoints left, kept after the ones visited.
+    //
+    for (uint8_t visit = 0; num_waypoints > visit; visit++)
+    {
+        p_order[visit] = visit;
+    }
+
+    for (uint8_t visit = 0; num_waypoints > visit; visit++)
+    {
+        uint8_t closest = visit;
+
+        for (uint8_t left = visit + 1u; num_waypoints > left; left++)
+        {
+            if (GET_DIST(p_dists, num_stops, from, p_order[left])
+                < GET_DIST(p_dists, num_stops, from, p_order[closest]))
+            {
+                closest = left;
+            }
+        }
+
+        uint8_t waypoint = p_order[closest];
+        p_order[closest] = p_order[visit];
+        p_order[visit]   = waypoint;
+        from             = waypoint;
+    }
+
+    // Step 2: Reverse the visits from first to last whenever joining the ends
+    // of that stretch the other way round is shorter. The tour is open at the
+    // start and the exit, which are the stops either side of the order.
+    //
+    bool is_improved = true;
+
+    while (is_improved)
+    {
+        is_improved = false;
+
+        for (uint8_t first = 0; num_waypoints > first; first++)
+        {
+            uint8_t before = (0 == first) ? start : p_order[first - 1u];
+
+            for (uint8_t last = first + 1u; num_waypoints > last; last++)
+            {
+                uint8_t after
+                    = (num_waypoints - 1u == last) ? exit : p_order[last + 1u];
+                uint64_t old_length
+                    = (uint64_t)GET_DIST(
+                          p_dists, num_stops, before, p_order[first])
+                      + GET_DIST(p_dists, num_stops, p_order[last], after);
+                uint64_t new_length
+                    = (uint64_t)GET_DIST(
+                          p_dists, num_stops, before, p_order[last])
+                      + GET_DIST(p_dists, num_stops, p_order[first], after);
+
+                if (new_length >= old_length)
+                {
+                    continue;
+                }
+
+                for (uint8_t low = first, high = last; low < high;
+                     low++, high--)
+                {
+                    uint8_t waypoint = p_order[low];
+                    p_order[low]     = p_order[high];
+                    p_order[high]    = waypoint;
+                }
+
+                is_improved = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Walks each leg of a tour along the distance field of the stop it
+ * leads to, and writes the steps into one compact path. The legs are walked
+ * twice, first to count the steps, since cell costs make the distances differ
+ * from the number of steps.
+ *
+ * @param[in,out] p_cache Pointer to the cache that holds the field of every
+ * destination.
+ * @param[in] p_start Pointer to the start node.
+ * @param[in] pp_stops Array of pointers to the stops.
+ * @param[in] p_order Array of the waypoints in the order they are visited,
+ * followed by the exit.
+ * @param[in] num_waypoints Number of waypoints.
+ * @param[out] p_path Pointer to the compact path to create.
+ * @return maze_tour_result_t MAZE_TOUR_PLANNED if the path was created,
+ * MAZE_TOUR_NO_MEMORY if a field or the steps could not be allocated, and
+ * MAZE_TOUR_TOO_FAR if a field has no step to take.
+ */
+static maze_tour_result_t
+build_path (maze_dist_cache_t             *p_cache,
+            const maze_grid_cell_t        *p_start,
+            const maze_grid_cell_t *const *pp_stops,
+            const uint8_t                 *p_order,
+            uint8_t                        num_waypoints,
+            maze_path_t                   *p_path)
+{
+    uint32_t num_steps = 0;
+
+    for (uint8_t pass = 0; 2u > pass; pass++)
+    {
+        const maze_grid_cell_t *p_node = p_start;
+        uint32_t                step   = 0;
+
+        if (1u == pass)
+        {
+            *p_path = maze_path_create(&p_start->coordinates, num_steps);
+
+            if (0 < num_steps && NULL == p_path->p_steps)
+            {
+                return MAZE_TOUR_NO_MEMORY;
+            }
+        }
+
+        for (uint8_t visit = 0; num_waypoints >= visit; visit++)
+        {
+            const maze_grid_cell_t  *p_goal = pp_stops[p_order[visit]];
+            const maze_dist_field_t *p_field
+                = maze_dist_cache_get(p_cache, p_goal);
+
+            if (NULL == p_field)
+            {
+                if (1u == pass)
+                {
+                    maze_path_destroy(p_path);
+                }
+
+                return MAZE_TOUR_NO_MEMORY;
+            }
+
+            while (p_goal != p_node)
+            {
+                maze_cardinal_direction_t direction
+                    = maze_dist_cache_get_next_dir(p_cache, p_field, p_node);
+
+                // Only a saturated field can lack a step, and such tours are
+                // turned down before their path is built.
+                //
+                if (MAZE_NONE == direction)
+                {
+                    if (1u == pass)
+                    {
+                        maze_path_destroy(p_path);
+                    }
+
+                    return MAZE_TOUR_TOO_FAR;
+                }
+
+                if (1u == pass)
+                {
+                    maze_path_set_step(p_path, step, direction);
+                }
+
+                step++;
+                p_node = p_node->p_next[direction];
+            }
+        }
+
+        num_steps = step;
+    }
+
+    return MAZE_TOUR_PLANNED;
+}
+
+// End of pathfinding/maze_tour.c
@@ -0,0 +1,80 @@
+/**
+ * @file maze_tour.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the tour planner, which finds the shortest order in
+ * which to visit a set of waypoints, e.g. barcode cells, between the start and
+ * the exit. The distances between the stops come from one flood of each, and
+ * the whole tour is returned as one compact path.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef MAZE_TOUR_H // Include guard.
+#define MAZE_TOUR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_path.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_TOUR_MAX_EXACT
+ * @brief Largest number of waypoints whose order is solved exactly by the
+ * Held-Karp algorithm. Its tables take 5 * 2^n * n bytes, so lower this on the
+ * Pico. Tours with more waypoints are built greedily and improved by 2-opt.
+ */
+#ifndef MAZE_TOUR_MAX_EXACT
+#define MAZE_TOUR_MAX_EXACT 12u
+#endif
+
+/**
+ * @def MAZE_TOUR_MAX_WAYPOINTS
+ * @brief Largest number of waypoints of a tour, so that the waypoints, the
+ * start and the exit can be numbered in a byte.
+ */
+#define MAZE_TOUR_MAX_WAYPOINTS (UINT8_MAX - 2u)
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains the results of planning a tour.
+ *
+ * @note Distances are read from fields of @ref maze_dist_t, so in the 16-bit
+ * build a leg that costs 65535 or more cannot be measured, which can only
+ * happen on weighted grids. A leg must also cost less than UINT32_MAX divided
+ * by the number of legs, so that the whole tour can be added up.
+ */
+typedef enum
+{
+    MAZE_TOUR_PLANNED = 0, ///< The tour was planned.
+    MAZE_TOUR_TOO_MANY,    ///< There are more than @ref
+                           ///< MAZE_TOUR_MAX_WAYPOINTS waypoints.
+    MAZE_TOUR_UNREACHABLE, ///< A waypoint or the exit cannot be reached.
+    MAZE_TOUR_TOO_FAR,     ///< A leg costs too much to be measured.
+    MAZE_TOUR_NO_MEMORY    ///< The tables or the path could not be allocated.
+} maze_tour_result_t;
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+maze_tour_result_t maze_tour_plan(const maze_grid_t             *p_grid,
+                                  const maze_grid_cell_t        *p_start,
+                                  const maze_grid_cell_t *const *pp_waypoints,
+                                  uint8_t                        num_waypoints,
+                                  const maze_grid_cell_t        *p_exit,
+                                  uint8_t                       *p_order,
+                                  maze_path_t                   *p_path);
+
+#endif // MAZE_TOUR_H
+
+// End of pathfinding/maze_tour.h
@@ -0,0 +1,157 @@
+/**
+ * @file open_set.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for the open set of the searches over cell indices.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/bucket_queue.h"
+#include "pathfinding/open_set.h"
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates an empty open set.
+ *
+ * @param[in] num_cells Number of cells of the maze.
+ * @return open_set_t Empty open set.
+ *
+ * @warning The open set must be destroyed by @ref open_set_destroy.
+ */
+open_set_t
+open_set_create (maze_idx_t num_cells)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    return bucket_queue_create(num_cells);
+#else
+    return binary_heap_create(num_cells);
+#endif
+}
+
+/**
+ * @brief Destroys an open set.
+ *
+ * @param[in,out] p_open_set Pointer to the open set.
+ */
+void
+open_set_destroy (open_set_t *p_open_set)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    bucket_queue_destroy(p_open_set);
+#else
+    binary_heap_destroy(p_open_set);
+#endif
+}
+
+/**
+ * @brief Removes every cell from an open set.
+ *
+ * @param[in,out] p_open_set Pointer to the open set.
+ */
+void
+open_set_clear (open_set_t *p_open_set)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    bucket_queue_clear(p_open_set);
+#else
+    p_open_set->size = 0;
+#endif
+}
+
+/**
+ * @brief Checks if an open set is empty.
+ *
+ * @param[in] p_open_set Pointer to the open set.
+ * @return true If there are no cells in the open set.
+ * @return false Otherwise.
+ */
+bool
+open_set_is_empty (const open_set_t *p_open_set)
+{
+    return 0 == p_open_set->size;
+}
+
+/**
+ * @brief Checks if every array of an open set was allocated.
+ *
+ * @param[in] p_open_set Pointer to the open set.
+ * @return true If the open set can be used.
+ * @return false If an allocation failed.
+ */
+bool
+open_set_is_valid (const open_set_t *p_open_set)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    return NULL != p_open_set->p_heads && NULL != p_open_set->p_next
+           && NULL != p_open_set->p_prev && NULL != p_open_set->p_priorities;
+#else
+    return NULL != p_open_set->p_array && NULL != p_open_set->p_positions;
+#endif
+}
+
+/**
+ * @brief Adds a cell to the open set, or lowers its priority if it is already
+ * in the open set.
+ *
+ * @param[in,out] p_open_set Pointer to the open set.
+ * @param[in] cell_idx Index of the cell.
+ * @param[in] priority Priority of the cell.
+ */
+void
+open_set_push (open_set_t     *p_open_set,
+               maze_idx_t      cell_idx,
+               maze_priority_t priority)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    bucket_queue_push(p_open_set, cell_idx, priority);
+#else
+    binary_heap_decrease_key_idx(p_open_set, cell_idx, priority);
+#endif
+}
+
+/**
+ * @brief Gets the cell with the lowest priority without removing it.
+ *
+ * @param[in,out] p_open_set Pointer to the open set. It must not be empty.
+ * @return maze_idx_t Index of the cell.
+ */
+maze_idx_t
+open_set_peek (open_set_t *p_open_set)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    return bucket_queue_peek(p_open_set);
+#else
+    return binary_heap_peek(p_open_set).cell_idx;
+#endif
+}
+
+/**
+ * @brief Removes the cell with the lowest priority.
+ *
+ * @param[in,out] p_open_set Pointer to the open set. It must not be empty.
+ * @return maze_idx_t Index of the cell.
+ */
+maze_idx_t
+open_set_pop (open_set_t *p_open_set)
+{
+#ifdef MAZE_BUCKET_QUEUE
+    return bucket_queue_pop(p_open_set);
+#else
+    maze_idx_t cell_idx = binary_heap_peek(p_open_set).cell_idx;
+    binary_heap_delete_min(p_open_set);
+    return cell_idx;
+#endif
+}
+
+// End of pathfinding/open_set.c
@@ -0,0 +1,97 @@
+/**
+ * @file open_set.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the open set of the searches over cell indices. It is
+ * the indexed binary heap by default, or the bucket queue if MAZE_BUCKET_QUEUE
+ * is defined, so that the two can be compared on the same searches.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef OPEN_SET_H // Include guard.
+#define OPEN_SET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/bucket_queue.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def MAZE_BUCKET_QUEUE
+ * @brief Define to use the bucket queue as the open set. Every edge of the
+ * maze costs 1, so the priorities in the open set span a few values and the
+ * bucket queue does every operation in O(1) amortised time.
+ */
+#ifdef MAZE_BUCKET_QUEUE
+/**
+ * @def OPEN_SET_BYTES_PER_CELL
+ * @brief Bytes allocated by the open set for each cell.
+ */
+#define OPEN_SET_BYTES_PER_CELL \
+    (sizeof(maze_idx_t) * 2u + sizeof(maze_priority_t))
+
+/**
+ * @def OPEN_SET_FIXED_BYTES
+ * @brief Bytes allocated by the open set regardless of the number of cells.
+ */
+#define OPEN_SET_FIXED_BYTES (sizeof(maze_idx_t) * BUCKET_QUEUE_NUM_BUCKETS)
+#else
+#define OPEN_SET_BYTES_PER_CELL \
+    (sizeof(binary_heap_node_t) + sizeof(maze_idx_t))
+#define OPEN_SET_FIXED_BYTES 0u
+#endif
+
+/**
+ * @def OPEN_SET_PRIORITY(value)
+ * @brief Converts an F-value to a priority, saturating at @ref
+ * MAZE_PRIORITY_MAX. F-values only outgrow the priorities when cell costs make
+ * paths longer than the cells of the maze, and saturated nodes are then taken
+ * in no particular order, so large weighted mazes need MAZE_PRIORITY_WIDTH 32.
+ */
+#define OPEN_SET_PRIORITY(value)                                 \
+    ((MAZE_PRIORITY_MAX < (uint64_t)(value)) ? MAZE_PRIORITY_MAX \
+                                             : (maze_priority_t)(value))
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+#ifdef MAZE_BUCKET_QUEUE
+typedef bucket_queue_t open_set_t; ///< Open set of cell indices.
+#else
+typedef binary_heap_t open_set_t; ///< Open set of cell indices.
+#endif
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+open_set_t open_set_create(maze_idx_t num_cells);
+
+void open_set_destroy(open_set_t *p_open_set);
+
+void open_set_clear(open_set_t *p_open_set);
+
+bool open_set_is_empty(const open_set_t *p_open_set);
+
+bool open_set_is_valid(const open_set_t *p_open_set);
+
+void open_set_push(open_set_t     *p_open_set,
+                   maze_idx_t      cell_idx,
+                   maze_priority_t priority);
+
+maze_idx_t open_set_peek(open_set_t *p_open_set);
+
+maze_idx_t open_set_pop(open_set_t *p_open_set);
+
+#endif // OPEN_SET_H
+
+// End of pathfinding/open_set.h
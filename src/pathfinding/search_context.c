@@ -0,0 +1,157 @@
+/**
+ * @file search_context.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Source file for search contexts. The scratch arrays are allocated
+ * once per context and reset lazily with search epochs, so starting a search
+ * costs O(1).
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/open_set.h"
+#include "pathfinding/search_context.h"
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates a search context for a maze with the given number of cells.
+ *
+ * @param[in] num_cells Number of cells in the maze.
+ * @return search_context_t Search context with every cell unreached.
+ *
+ * @warning The context must be destroyed by @ref search_context_destroy.
+ */
+search_context_t
+search_context_create (maze_idx_t num_cells)
+{
+    search_context_t context = {
+        .p_f          = maze_malloc(sizeof(uint32_t) * num_cells),
+        .p_g          = maze_malloc(sizeof(uint32_t) * num_cells),
+        .p_h          = maze_malloc(sizeof(uint32_t) * num_cells),
+        .p_came_from  = maze_malloc(sizeof(maze_idx_t) * num_cells),
+        .p_stamps     = maze_calloc(num_cells, sizeof(uint32_t)),
+        .epoch        = 0,
+        .open_set     = open_set_create(num_cells),
+        .num_cells    = num_cells,
+        .num_expanded = 0,
+    };
+
+    return context;
+}
+
+/**
+ * @brief Destroys a search context by freeing its scratch arrays.
+ *
+ * @param[in,out] p_context Pointer to the search context.
+ */
+void
+search_context_destroy (search_context_t *p_context)
+{
+    maze_free(p_context->p_f);
+    maze_free(p_context->p_g);
+    maze_free(p_context->p_h);
+    maze_free(p_context->p_came_from);
+    maze_free(p_context->p_stamps);
+    open_set_destroy(&p_context->open_set);
+
+    p_context->p_f         = NULL;
+    p_context->p_g         = NULL;
+    p_context->p_h         = NULL;
+    p_context->p_came_from = NULL;
+    p_context->p_stamps    = NULL;
+    p_context->num_cells   = 0;
+}
+
+/**
+ * @brief Begins a new search. Every cell becomes unreached and the open set is
+ * emptied.
+ *
+ * @param[in,out] p_context Pointer to the search context.
+ *
+ * @note The stamps are only swept when the epoch counter wraps around.
+ */
+void
+search_context_begin (search_context_t *p_context)
+{
+    open_set_clear(&p_context->open_set);
+    p_context->num_expanded = 0;
+    p_context->epoch++;
+
+    if (0 != p_context->epoch)
+    {
+        return;
+    }
+
+    // The counter has wrapped, so old stamps could match again. Reset them.
+    //
+    memset(p_context->p_stamps, 0, sizeof(uint32_t) * p_context->num_cells);
+    p_context->epoch = 1;
+}
+
+/**
+ * @brief Stamps a cell with the current epoch. If the cell was last written in
+ * an older epoch, its values are reset to UINT32_MAX and it has no came-from
+ * cell. This must be called before reading or writing the values of a cell.
+ *
+ * @param[in,out] p_context Pointer to the search context.
+ * @param[in] cell_idx Index of the cell.
+ */
+void
+search_context_stamp (search_context_t *p_context, maze_idx_t cell_idx)
+{
+    if (p_context->epoch == p_context->p_stamps[cell_idx])
+    {
+        return;
+    }
+
+    p_context->p_f[cell_idx]         = UINT32_MAX;
+    p_context->p_g[cell_idx]         = UINT32_MAX;
+    p_context->p_h[cell_idx]         = UINT32_MAX;
+    p_context->p_came_from[cell_idx] = SEARCH_CONTEXT_NO_CELL;
+    p_context->p_stamps[cell_idx]    = p_context->epoch;
+}
+
+/**
+ * @brief Checks if every array of a search context was allocated.
+ *
+ * @param[in] p_context Pointer to the search context.
+ * @return true If the search context can be used.
+ * @return false If an allocation failed.
+ */
+bool
+search_context_is_valid (const search_context_t *p_context)
+{
+    return NULL != p_context->p_f && NULL != p_context->p_g
+           && NULL != p_context->p_h && NULL != p_context->p_came_from
+           && NULL != p_context->p_stamps
+           && open_set_is_valid(&p_context->open_set);
+}
+
+/**
+ * @brief Checks if a cell has been given a G-value in the current search.
+ *
+ * @param[in] p_context Pointer to the search context.
+ * @param[in] cell_idx Index of the cell.
+ * @return true The cell was reached.
+ * @return false The cell was not reached.
+ */
+bool
+search_context_is_reached (const search_context_t *p_context,
+                           maze_idx_t              cell_idx)
+{
+    return p_context->epoch == p_context->p_stamps[cell_idx]
+           && UINT32_MAX != p_context->p_g[cell_idx];
+}
+
+// End of pathfinding/search_context.c
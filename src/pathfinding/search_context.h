@@ -0,0 +1,77 @@
+/**
+ * @file search_context.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for search contexts. A search context owns the scratch
+ * values of a search so that the maze can stay read-only while planning, and
+ * several searches can run on the same maze at once.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SEARCH_CONTEXT_H // Include guard.
+#define SEARCH_CONTEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "pathfinding/open_set.h"
+
+// Definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @def SEARCH_CONTEXT_NO_CELL
+ * @brief Came-from index of cells that were not reached from another cell.
+ */
+#define SEARCH_CONTEXT_NO_CELL MAZE_IDX_MAX
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This struct contains the scratch values of a search, indexed by cell.
+ * Values are only valid for cells stamped with the current epoch, @see
+ * search_context_stamp.
+ *
+ * @note A context must only be used by one search at a time. Give each thread
+ * or core its own context.
+ */
+typedef struct search_context
+{
+    uint32_t   *p_f;          ///< F-values of the cells. F = G + H.
+    uint32_t   *p_g;          ///< G-values of the cells.
+    uint32_t   *p_h;          ///< H-values of the cells.
+    maze_idx_t *p_came_from;  ///< Index of the cell that each cell was reached
+                              ///< from, SEARCH_CONTEXT_NO_CELL if none.
+    uint32_t   *p_stamps;     ///< Epoch in which each cell was last written.
+    uint32_t    epoch;        ///< Current search epoch.
+    open_set_t  open_set;     ///< Open set, preallocated for every cell.
+    maze_idx_t  num_cells;    ///< Number of cells the context can hold.
+    uint32_t    num_expanded; ///< Cells expanded by the last A* search.
+} search_context_t;
+
+// Public functions.
+// ----------------------------------------------------------------------------
+//
+
+search_context_t search_context_create(maze_idx_t num_cells);
+
+void search_context_destroy(search_context_t *p_context);
+
+void search_context_begin(search_context_t *p_context);
+
+void search_context_stamp(search_context_t *p_context, maze_idx_t cell_idx);
+
+bool search_context_is_valid(const search_context_t *p_context);
+
+bool search_context_is_reached(const search_context_t *p_context,
+                               maze_idx_t              cell_idx);
+
+#endif // SEARCH_CONTEXT_H
+
+// End of pathfinding/search_context.h
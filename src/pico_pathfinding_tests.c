@@ -19,6 +19,7 @@
 #include "pico/platform.h"
 #include "pico/time.h"
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
 #include "pathfinding/dfs.h"
 #include "pathfinding/floodfill.h"
 #include "pathfinding/a_star.h"
@@ -310,7 +311,7 @@ explore_current_node (maze_grid_t              *p_grid,
     char *p_maze_str = maze_get_string(p_grid);
     maze_insert_nav_str(p_grid, p_navigator, p_maze_str);
     printf("%s\n\n", p_maze_str);
-    free(p_maze_str);
+    maze_free(p_maze_str);
 
     return bitmask;
 }
@@ -355,7 +356,8 @@ map_maze (maze_grid_t            *p_grid,
     maze_deserialise(&true_grid, &gap_bitmask);
     char *p_true_maze_str = maze_get_string(&true_grid);
     printf("%s\n\n", p_true_maze_str);
-    free(p_true_maze_str);
+    maze_free(p_true_maze_str);
+    maze_destroy(&true_grid);
 
     floodfill_init_maze_nowall(p_grid);
 
@@ -371,7 +373,7 @@ map_maze (maze_grid_t            *p_grid,
     char *p_maze_str = maze_get_string(p_grid);
     maze_insert_nav_str(p_grid, p_navigator, p_maze_str);
     printf("%s\n\n", p_maze_str);
-    free(p_maze_str);
+    maze_free(p_maze_str);
 }
 
 /**
@@ -460,6 +462,7 @@ test_mapping (const uint16_t *p_bitmask_array)
     bool is_test_passing = is_maze_correct(map_bitmask, true_map_bitmask);
 
     ret_val = is_test_passing ? 0 : -1;
+    maze_free(map_bitmask.p_bitmask);
     maze_destroy(&maze);
     return ret_val;
 }
@@ -485,6 +488,8 @@ test_navigation (const uint16_t *p_bitmask_array)
                                             .columns   = GRID_COLS };
     maze_deserialise(&maze, &true_map_bitmask);
 
+    char *p_maze_str = NULL;
+
     a_star(&maze, navigator.p_start_node, navigator.p_end_node);
     a_star_path_t *p_path = a_star_get_path(navigator.p_end_node);
 
@@ -495,11 +500,14 @@ test_navigation (const uint16_t *p_bitmask_array)
         goto end;
     }
 
-    char *maze_str = a_star_get_path_str(&maze, p_path);
-    printf("%s\n\n", maze_str);
+    p_maze_str = a_star_get_path_str(&maze, p_path);
+    printf("%s\n\n", p_maze_str);
+
+    maze_free(p_path->p_path);
+    maze_free(p_path);
 
 end:
-    free(maze_str);
+    maze_free(p_maze_str);
     navigator.p_current_node = NULL;
     navigator.p_start_node   = NULL;
     navigator.p_end_node     = NULL;
@@ -551,7 +559,7 @@ test_combined (const uint16_t *p_bitmask_array)
         char *p_maze_str = a_star_get_path_str(&maze, p_path);
         maze_insert_nav_str(&maze, &navigator, p_maze_str);
         printf("Path Step %u:\n%s\n\n", idx, p_maze_str);
-        free(p_maze_str);
+        maze_free(p_maze_str);
 
         maze_grid_cell_t          next_node      = p_path->p_path[idx];
         maze_cardinal_direction_t next_direction = maze_get_dir_from_to(
@@ -568,11 +576,13 @@ test_combined (const uint16_t *p_bitmask_array)
     }
 
     printf("Conducting navigation\n");
+    maze_free(p_path->p_path);
+    maze_free(p_path);
     a_star(&maze, navigator.p_current_node, navigator.p_end_node);
     p_path           = a_star_get_path(navigator.p_end_node);
     char *p_maze_str = a_star_get_path_str(&maze, p_path);
     printf("%s\n\n", p_maze_str);
-    free(p_maze_str);
+    maze_free(p_maze_str);
 
     printf("Moving navigator\n");
     for (size_t idx = 1; p_path->length > idx; idx++)
@@ -580,7 +590,7 @@ test_combined (const uint16_t *p_bitmask_array)
         char *p_maze_str = a_star_get_path_str(&maze, p_path);
         maze_insert_nav_str(&maze, &navigator, p_maze_str);
         printf("Path Step %u:\n%s\n\n", idx, p_maze_str);
-        free(p_maze_str);
+        maze_free(p_maze_str);
         maze_grid_cell_t          next_node      = p_path->p_path[idx];
         maze_cardinal_direction_t next_direction = maze_get_dir_from_to(
             &navigator.p_current_node->coordinates, &next_node.coordinates);
@@ -590,7 +600,7 @@ test_combined (const uint16_t *p_bitmask_array)
     p_maze_str = a_star_get_path_str(&maze, p_path);
     maze_insert_nav_str(&maze, &navigator, p_maze_str);
     printf("%s\n\n", p_maze_str);
-    free(p_maze_str);
+    maze_free(p_maze_str);
 
     if (navigator.p_end_node != navigator.p_current_node)
     {
@@ -603,10 +613,11 @@ test_combined (const uint16_t *p_bitmask_array)
     }
 
 end_return_to_start:
-    free(p_path->p_path);
-    free(p_path);
+    maze_free(p_path->p_path);
+    maze_free(p_path);
 
 end_mapping:
+    maze_free(map_bitmask.p_bitmask);
     maze_destroy(&maze);
 
     return ret_val;
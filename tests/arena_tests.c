@@ -0,0 +1,388 @@
+/**
+ * @file arena_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the pluggable allocator and the
+ * arena allocator.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_arena.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS       = 6,   ///< Number of rows in the grid.
+    GRID_COLS       = 4,   ///< Number of columns in the grid.
+    SMALL_WORKSPACE = 256, ///< Size of the small workspace in bytes.
+    WORKSPACE       = 8192 ///< Size of the workspace in bytes.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+/**
+ * @brief Workspace of the arena.
+ */
+static uint8_t g_workspace[WORKSPACE];
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_arena_blocks(void);
+static int test_arena_a_star(void);
+static int test_arena_floodfill(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint16_t explore_current_node(maze_grid_t              *p_grid,
+                                     maze_navigator_state_t   *p_navigator,
+                                     maze_cardinal_direction_t direction);
+static void     move_navigator(maze_navigator_state_t   *p_navigator,
+                               maze_cardinal_direction_t direction);
+
+/**
+ * @brief Runs the tests for the allocator.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+arena_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_arena_blocks();
+            break;
+        case 2:
+            ret_val = test_arena_a_star();
+            break;
+        case 3:
+            ret_val = test_arena_floodfill();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that blocks are aligned, that freed blocks at the top are
+ * given back, that the top block is resized in place and that the arena falls
+ * back to the heap when it is full.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_arena_blocks (void)
+{
+    int          ret_val = 0;
+    maze_arena_t arena;
+
+    // Step 1: Start from an unaligned address.
+    //
+    maze_arena_init(&arena, g_workspace + 1, SMALL_WORKSPACE);
+    maze_allocator_t allocator = maze_arena_get_allocator(&arena);
+    maze_allocator_t previous  = maze_allocator_set(&allocator);
+
+    uint8_t *p_first  = maze_malloc(3);
+    uint8_t *p_second = maze_calloc(4, sizeof(uint32_t));
+
+    if (0 != (uintptr_t)p_first % MAZE_ARENA_ALIGNMENT
+        || 0 != (uintptr_t)p_second % MAZE_ARENA_ALIGNMENT
+        || 2 != arena.num_allocs || 0 != arena.num_fallbacks)
+    {
+        printf("Blocks are not aligned or not from the arena.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 2: Freeing a block below the top only marks it, and freeing the top
+    // gives back both.
+    //
+    maze_free(p_first);
+
+    if (arena.peak != arena.used)
+    {
+        printf("Block below the top was given back.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    maze_free(p_second);
+
+    if (0 != arena.used)
+    {
+        printf("Arena still uses %zu bytes.\n", arena.used);
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 3: The top block grows in place.
+    //
+    p_first          = maze_malloc(8);
+    uint8_t *p_grown = maze_realloc(p_first, 64);
+
+    if (p_first != p_grown)
+    {
+        printf("Top block was moved.\n");
+        ret_val = -1;
+        maze_free(p_grown);
+        goto end;
+    }
+
+    // Step 4: A block too large for the workspace falls back to the heap.
+    //
+    uint8_t *p_large = maze_malloc(SMALL_WORKSPACE);
+
+    if (1 != arena.num_fallbacks)
+    {
+        printf("Large block did not fall back to the heap.\n");
+        ret_val = -1;
+    }
+
+    maze_free(p_large);
+    maze_free(p_grown);
+
+    if (0 != arena.used)
+    {
+        printf("Arena still uses %zu bytes.\n", arena.used);
+        ret_val = -1;
+    }
+
+end:
+    maze_allocator_set(&previous);
+    printf("Peak arena use is %zu bytes.\n", arena.peak);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that repeated A* queries use the arena only, and that every
+ * query has the same peak.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_arena_a_star (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_grid_t grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+
+    maze_arena_t arena;
+    maze_arena_init(&arena, g_workspace, sizeof(g_workspace));
+    maze_allocator_t allocator = maze_arena_get_allocator(&arena);
+    maze_allocator_t previous  = maze_allocator_set(&allocator);
+
+    size_t first_peak = 0;
+
+    for (uint8_t query = 0; 3 > query; query++)
+    {
+        a_star(&grid, p_start, p_end);
+        a_star_path_t *p_path = a_star_get_path(p_end);
+
+        if (NULL == p_path || 0 == p_path->length)
+        {
+            printf("Query %u found no path.\n", query);
+            ret_val = -1;
+            break;
+        }
+
+        maze_free(p_path->p_path);
+        maze_free(p_path);
+
+        if (0 != arena.used)
+        {
+            printf("Query %u left %zu bytes in use.\n", query, arena.used);
+            ret_val = -1;
+            break;
+        }
+
+        if (0 == query)
+        {
+            first_peak = arena.peak;
+        }
+        else if (first_peak != arena.peak)
+        {
+            printf("Peak grew from %zu to %zu bytes.\n",
+                   first_peak,
+                   arena.peak);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    maze_allocator_set(&previous);
+
+    if (0 != arena.num_fallbacks)
+    {
+        printf("%zu blocks fell back to the heap.\n", arena.num_fallbacks);
+        ret_val = -1;
+    }
+
+    printf("Peak arena use is %zu bytes over %zu blocks.\n",
+           arena.peak,
+           arena.num_allocs);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a whole floodfill mapping run is done in the arena.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_arena_floodfill (void)
+{
+    int         ret_val = 0;
+    maze_grid_t grid    = maze_create(GRID_ROWS, GRID_COLS);
+    floodfill_init_maze_nowall(&grid);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    maze_navigator_state_t navigator = { p_start, p_start, p_end, MAZE_NORTH };
+
+    maze_arena_t arena;
+    maze_arena_init(&arena, g_workspace, sizeof(g_workspace));
+    maze_allocator_t allocator = maze_arena_get_allocator(&arena);
+    maze_allocator_t previous  = maze_allocator_set(&allocator);
+
+    floodfill_map_maze(
+        &grid, p_end, &navigator, &explore_current_node, &move_navigator);
+
+    maze_allocator_set(&previous);
+
+    if (navigator.p_current_node != p_end)
+    {
+        printf("Navigator did not reach the end cell.\n");
+        ret_val = -1;
+    }
+
+    if (0 != arena.num_fallbacks || 0 != arena.used || 0 == arena.peak)
+    {
+        printf("Mapping run used %zu bytes and %zu heap blocks.\n",
+               arena.used,
+               arena.num_fallbacks);
+        ret_val = -1;
+    }
+
+    printf("Peak arena use is %zu bytes over %zu blocks.\n",
+           arena.peak,
+           arena.num_allocs);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Explores the current node using the global bitmask array.
+ *
+ * @param[in,out] p_grid Pointer to the maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to explore in.
+ * @return uint16_t Bitmask of the walls of the current node.
+ */
+static uint16_t
+explore_current_node (maze_grid_t              *p_grid,
+                      maze_navigator_state_t   *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    maze_grid_cell_t *p_current_node = p_navigator->p_current_node;
+    uint8_t           bitmask        = MAZE_INVERT_BITMASK(
+        g_bitmask_array[p_current_node->coordinates.y * p_grid->columns
+                        + p_current_node->coordinates.x]);
+
+    p_navigator->orientation = direction;
+    maze_nav_modify_walls(p_grid, p_navigator, bitmask, true, false);
+    return bitmask;
+}
+
+/**
+ * @brief Moves the navigator to the next node.
+ *
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to move.
+ */
+static void
+move_navigator (maze_navigator_state_t   *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->p_current_node
+        = p_navigator->p_current_node->p_next[direction];
+    p_navigator->orientation = direction;
+}
+
+// End of arena_tests.c
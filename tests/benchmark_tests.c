@@ -0,0 +1,1825 @@
+/**
+ * @file benchmark_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains benchmarks that compare the maze backends on the
+ * test mazes and on large generated mazes. The backends must agree on the
+ * results, and the timings are printed for comparison.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_padded.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/a_star_bidirectional.h"
+#include "pathfinding/a_star_batch.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/binary_heap.h"
+#include "pathfinding/bucket_queue.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/d_star_lite.h"
+#include "pathfinding/maze_graph.h"
+#include "pathfinding/maze_landmarks.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the benchmarks.
+ */
+typedef enum
+{
+    GRID_ROWS          = 6,      ///< Number of rows in the test maze.
+    GRID_COLS          = 4,      ///< Number of columns in the test maze.
+    LARGE_GRID_ROWS    = 250,    ///< Number of rows in the generated maze.
+    LARGE_GRID_COLS    = 250,    ///< Number of columns in the generated maze.
+    NUM_LOOKUPS        = 4000000, ///< Neighbour lookups per measurement.
+    NUM_TRAVERSAL_REPS = 20,     ///< Full traversals per measurement.
+    MIN_SEARCH_SIZE    = 32,     ///< Side of the smallest searched maze.
+    MAX_SEARCH_SIZE    = 512,    ///< Side of the largest searched maze.
+    MIN_MAPPING_SIZE   = 16,     ///< Side of the smallest mapped maze.
+    MAX_MAPPING_SIZE   = 64,     ///< Side of the largest mapped maze.
+    MIN_JPS_SIZE       = 64,     ///< Side of the smallest maze for JPS.
+    MAX_JPS_SIZE       = 256,    ///< Side of the largest maze for JPS.
+    NUM_JPS_REPS       = 20,     ///< Searches per measurement for JPS.
+    SPARSE_WALL_SHARE  = 15,     ///< Percentage of cells of the sparse maze
+                                 ///< that a wall is added to.
+    NUM_LANDMARKS      = 8,      ///< Landmarks of the ALT benchmark.
+    NUM_ALT_QUERIES    = 16,     ///< Searches per maze of the ALT benchmark.
+    BATCH_GRID_SIZE    = 128,    ///< Side of the maze of the batch benchmark.
+    NUM_BATCH_QUERIES  = 2000,   ///< Queries of the batch benchmark.
+    MAX_BATCH_THREADS  = 8,      ///< Most threads of the batch benchmark.
+    MAZE_SEED          = 2004    ///< Seed of the generated maze.
+} constants_t;
+
+/**
+ * @brief This struct contains the backends built from the same bitmask.
+ */
+typedef struct benchmark_mazes
+{
+    maze_grid_t    grid;    ///< Pointer-based grid maze.
+    maze_compact_t compact; ///< Compact wall-bitmask maze.
+    maze_padded_t  padded;  ///< Sentinel-padded maze.
+} benchmark_mazes_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+/**
+ * @brief Bitmask array of the maze that the mapping runs explore.
+ */
+static const maze_gap_bitmask_t *gp_true_bitmask = NULL;
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_neighbour_lookup(void);
+static int test_traversal(void);
+static int test_heap_search(void);
+static int test_open_sets(void);
+static int test_mapping(void);
+static int test_jps_expansions(void);
+static int test_bidirectional(void);
+static int test_junction_graph(void);
+static int test_landmarks(void);
+static int test_batch(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_gap_bitmask_t generate_maze(uint16_t rows, uint16_t columns);
+
+static void braid_maze(maze_gap_bitmask_t *p_bitmask);
+
+static maze_gap_bitmask_t generate_open_maze(uint16_t rows,
+                                             uint16_t columns,
+                                             uint32_t wall_share);
+
+static benchmark_mazes_t create_mazes(maze_gap_bitmask_t *p_bitmask);
+
+static void destroy_mazes(benchmark_mazes_t *p_mazes);
+
+static int benchmark_lookups(benchmark_mazes_t *p_mazes, const char *p_name);
+
+static int benchmark_traversal(benchmark_mazes_t *p_mazes, const char *p_name);
+
+static int benchmark_heap(uint16_t size);
+
+static int benchmark_open_sets(uint16_t size);
+
+static int benchmark_mapping(uint16_t size);
+
+static int benchmark_jps(maze_gap_bitmask_t *p_bitmask, const char *p_name);
+
+static int benchmark_bidirectional(uint16_t size);
+
+static int benchmark_junction_graph(maze_gap_bitmask_t *p_bitmask,
+                                    const char         *p_name);
+
+static int benchmark_landmarks(maze_gap_bitmask_t *p_bitmask,
+                               const char         *p_name);
+
+static uint16_t explore_true_maze(maze_grid_t              *p_grid,
+                                  maze_navigator_state_t   *p_navigator,
+                                  maze_cardinal_direction_t direction);
+
+static void move_navigator(maze_navigator_state_t   *p_navigator,
+                           maze_cardinal_direction_t direction);
+
+static uint64_t search_heap(maze_grid_t *p_grid, uint32_t *p_dist);
+
+static uint64_t search_bucket(maze_grid_t *p_grid, uint32_t *p_dist);
+
+static uint64_t traverse_grid(maze_grid_t *p_grid, maze_grid_cell_t **p_queue);
+
+static uint64_t traverse_compact(const maze_compact_t *p_maze,
+                                 maze_idx_t           *p_queue,
+                                 uint8_t              *p_visited);
+
+static uint64_t traverse_padded(const maze_padded_t *p_maze,
+                                maze_idx_t          *p_queue,
+                                uint8_t             *p_visited);
+
+static double get_elapsed_ns(clock_t start, clock_t end, uint32_t num_ops);
+
+static double get_wall_time_ms(void);
+
+/**
+ * @brief Runs the benchmarks of the maze backends.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+benchmark_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(MAZE_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_neighbour_lookup();
+            break;
+        case 2:
+            ret_val = test_traversal();
+            break;
+        case 3:
+            ret_val = test_heap_search();
+            break;
+        case 4:
+            ret_val = test_open_sets();
+            break;
+        case 5:
+            ret_val = test_mapping();
+            break;
+        case 6:
+            ret_val = test_jps_expansions();
+            break;
+        case 7:
+            ret_val = test_bidirectional();
+            break;
+        case 8:
+            ret_val = test_junction_graph();
+            break;
+        case 9:
+            ret_val = test_landmarks();
+            break;
+        case 10:
+            ret_val = test_batch();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Times looking up the adjacent cell in every direction, regardless of
+ * walls, on the test maze and on a generated maze.
+ *
+ * @return int 0 if the backends agree, -1 otherwise.
+ */
+static int
+test_neighbour_lookup (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    benchmark_mazes_t small = create_mazes(&gap_bitmask);
+    ret_val = benchmark_lookups(&small, "6x4 test maze");
+    destroy_mazes(&small);
+
+    if (0 != ret_val)
+    {
+        return ret_val;
+    }
+
+    maze_gap_bitmask_t large_bitmask
+        = generate_maze(LARGE_GRID_ROWS, LARGE_GRID_COLS);
+    benchmark_mazes_t large = create_mazes(&large_bitmask);
+    ret_val = benchmark_lookups(&large, "250x250 generated maze");
+    destroy_mazes(&large);
+    free(large_bitmask.p_bitmask);
+
+    return ret_val;
+}
+
+/**
+ * @brief Times a breadth-first traversal of every reachable cell, following
+ * the gaps, on the test maze and on a generated maze.
+ *
+ * @return int 0 if the backends agree, -1 otherwise.
+ */
+static int
+test_traversal (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    benchmark_mazes_t small = create_mazes(&gap_bitmask);
+    ret_val = benchmark_traversal(&small, "6x4 test maze");
+    destroy_mazes(&small);
+
+    if (0 != ret_val)
+    {
+        return ret_val;
+    }
+
+    maze_gap_bitmask_t large_bitmask
+        = generate_maze(LARGE_GRID_ROWS, LARGE_GRID_COLS);
+    benchmark_mazes_t large = create_mazes(&large_bitmask);
+    ret_val = benchmark_traversal(&large, "250x250 generated maze");
+    destroy_mazes(&large);
+    free(large_bitmask.p_bitmask);
+
+    return ret_val;
+}
+
+/**
+ * @brief Times A* across braided mazes from 32x32 to 512x512 with the
+ * indexed open set, and with the linear scan it replaced.
+ *
+ * @return int 0 if both open sets find paths of the same length, -1
+ * otherwise.
+ */
+static int
+test_heap_search (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_SEARCH_SIZE;
+         MAX_SEARCH_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        // Maps above the range of the cell indices need PATHFINDING_LARGE_MAP.
+        //
+        if ((uint32_t)size * size > MAZE_IDX_MAX)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        ret_val = benchmark_heap(size);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Times a unit-cost search of every cell of braided mazes from 32x32 to
+ * 512x512 with the binary heap and with the bucket queue, whichever of the two
+ * the open set is built with.
+ *
+ * @return int 0 if both queues find the same distances, -1 otherwise.
+ */
+static int
+test_open_sets (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_SEARCH_SIZE;
+         MAX_SEARCH_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        if ((uint32_t)size * size > BUCKET_QUEUE_NOT_QUEUED)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        ret_val = benchmark_open_sets(size);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Times mapping braided mazes from 16x16 to 64x64 by flooding the maze
+ * after every move, and by repairing the distances with D* Lite.
+ *
+ * @return int 0 if both runs reach the end node, -1 otherwise.
+ */
+static int
+test_mapping (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_MAPPING_SIZE;
+         MAX_MAPPING_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        ret_val = benchmark_mapping(size);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Counts the nodes expanded by A* and by Jump Point Search across open,
+ * sparse and dense mazes from 64x64 to 256x256.
+ *
+ * @return int 0 if both searches find paths of the same length, -1 otherwise.
+ */
+static int
+test_jps_expansions (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_JPS_SIZE; MAX_JPS_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        if ((uint32_t)size * size > MAZE_IDX_MAX)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        maze_gap_bitmask_t bitmasks[3] = {
+            generate_open_maze(size, size, 0),
+            generate_open_maze(size, size, SPARSE_WALL_SHARE),
+            generate_maze(size, size),
+        };
+        const char *p_names[3] = { "open", "sparse", "dense" };
+
+        braid_maze(&bitmasks[2]);
+        printf("A* and JPS across the %ux%u mazes:\n", size, size);
+
+        for (uint8_t kind = 0; 3 > kind; kind++)
+        {
+            if (0 == ret_val)
+            {
+                ret_val = benchmark_jps(&bitmasks[kind], p_names[kind]);
+            }
+
+            free(bitmasks[kind].p_bitmask);
+        }
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Times A* and the bidirectional search, on one thread and on two,
+ * across braided mazes from 32x32 to 512x512.
+ *
+ * @return int 0 if the searches find paths of the same length, -1 otherwise.
+ */
+static int
+test_bidirectional (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_SEARCH_SIZE;
+         MAX_SEARCH_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        if ((uint32_t)size * size > MAZE_IDX_MAX)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        ret_val = benchmark_bidirectional(size);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Counts the nodes expanded by A* on the grid and on the junction graph,
+ * across perfect and braided mazes from 32x32 to 512x512.
+ *
+ * @return int 0 if both searches find paths of the same length, -1 otherwise.
+ */
+static int
+test_junction_graph (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_SEARCH_SIZE;
+         MAX_SEARCH_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        if ((uint32_t)size * size > MAZE_IDX_MAX)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        maze_gap_bitmask_t bitmasks[2] = {
+            generate_maze(size, size),
+            generate_maze(size, size),
+        };
+        const char *p_names[2] = { "perfect", "braided" };
+
+        braid_maze(&bitmasks[1]);
+        printf("A* on the grid and on the junction graph of the %ux%u "
+               "mazes:\n",
+               size,
+               size);
+
+        for (uint8_t kind = 0; 2 > kind; kind++)
+        {
+            if (0 == ret_val)
+            {
+                ret_val
+                    = benchmark_junction_graph(&bitmasks[kind], p_names[kind]);
+            }
+
+            free(bitmasks[kind].p_bitmask);
+        }
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Counts the nodes expanded by A* with the Manhattan distance and with
+ * the ALT heuristic, across sparse and braided mazes from 32x32 to 512x512.
+ *
+ * @return int 0 if both searches find paths of the same length, -1 otherwise.
+ */
+static int
+test_landmarks (void)
+{
+    int ret_val = 0;
+
+    for (uint16_t size = MIN_SEARCH_SIZE;
+         MAX_SEARCH_SIZE >= size && 0 == ret_val;
+         size *= 2)
+    {
+        if ((uint32_t)size * size > MAZE_IDX_MAX)
+        {
+            printf("Skipping %ux%u, which needs 32-bit cell indices.\n",
+                   size,
+                   size);
+            break;
+        }
+
+        maze_gap_bitmask_t bitmasks[2] = {
+            generate_open_maze(size, size, SPARSE_WALL_SHARE),
+            generate_maze(size, size),
+        };
+        const char *p_names[2] = { "sparse", "braided" };
+
+        braid_maze(&bitmasks[1]);
+        printf("A* with the Manhattan distance and with %u landmarks across "
+               "the %ux%u mazes:\n",
+               NUM_LANDMARKS,
+               size,
+               size);
+
+        for (uint8_t kind = 0; 2 > kind; kind++)
+        {
+            if (0 == ret_val)
+            {
+                ret_val = benchmark_landmarks(&bitmasks[kind], p_names[kind]);
+            }
+
+            free(bitmasks[kind].p_bitmask);
+        }
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Times a batch of random queries on a braided maze on 1 to 8 threads.
+ * The time is wall-clock time, so the throughput scales with the threads up
+ * to the number of cores.
+ *
+ * @return int 0 if every run finds the same paths, -1 otherwise.
+ */
+static int
+test_batch (void)
+{
+    int                ret_val = 0;
+    maze_gap_bitmask_t bitmask
+        = generate_maze(BATCH_GRID_SIZE, BATCH_GRID_SIZE);
+    maze_grid_t grid = maze_create(BATCH_GRID_SIZE, BATCH_GRID_SIZE);
+    braid_maze(&bitmask);
+    maze_deserialise(&grid, &bitmask);
+
+    a_star_query_t *p_queries
+        = malloc(sizeof(a_star_query_t) * NUM_BATCH_QUERIES);
+    a_star_path_t **pp_paths
+        = malloc(sizeof(a_star_path_t *) * NUM_BATCH_QUERIES);
+    uint64_t first_total_length = 0;
+    double   first_elapsed_ms   = 0;
+
+    for (uint32_t query = 0; NUM_BATCH_QUERIES > query; query++)
+    {
+        p_queries[query].p_start_node
+            = &grid.p_grid_array[get_random() % MAZE_GRID_CELLS(&grid)];
+        p_queries[query].p_end_node
+            = &grid.p_grid_array[get_random() % MAZE_GRID_CELLS(&grid)];
+    }
+
+    printf("Batch of %u queries across the %ux%u braided maze:\n",
+           NUM_BATCH_QUERIES,
+           BATCH_GRID_SIZE,
+           BATCH_GRID_SIZE);
+
+    for (uint8_t num_threads = 1; MAX_BATCH_THREADS >= num_threads;
+         num_threads *= 2)
+    {
+        double   start_ms  = get_wall_time_ms();
+        uint32_t num_found = a_star_batch(
+            &grid, NULL, p_queries, NUM_BATCH_QUERIES, pp_paths, num_threads);
+        double   elapsed_ms   = get_wall_time_ms() - start_ms;
+        uint64_t total_length = 0;
+
+        for (uint32_t query = 0; NUM_BATCH_QUERIES > query; query++)
+        {
+            if (NULL != pp_paths[query])
+            {
+                total_length += pp_paths[query]->length;
+                maze_free(pp_paths[query]->p_path);
+                maze_free(pp_paths[query]);
+            }
+        }
+
+        if (1 == num_threads)
+        {
+            first_total_length = total_length;
+            first_elapsed_ms   = elapsed_ms;
+        }
+
+        printf("    %u threads: %5u paths %10.3f ms, %10.0f queries/s, "
+               "%5.2fx\n",
+               num_threads,
+               num_found,
+               elapsed_ms,
+               NUM_BATCH_QUERIES * 1e3 / elapsed_ms,
+               first_elapsed_ms / elapsed_ms);
+
+        if (first_total_length != total_length)
+        {
+            printf("Batches disagree on the path lengths.\n");
+            ret_val = -1;
+        }
+    }
+
+    free(p_queries);
+    free(pp_paths);
+    maze_destroy(&grid);
+    free(bitmask.p_bitmask);
+
+    return ret_val;
+}
+
+// Private function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Generates a perfect maze with a randomised depth-first search, so
+ * that every cell is reachable.
+ *
+ * @param[in] rows Number of rows.
+ * @param[in] columns Number of columns.
+ * @return maze_gap_bitmask_t Bitmask array of maze gaps. This must be freed.
+ */
+static maze_gap_bitmask_t
+generate_maze (uint16_t rows, uint16_t columns)
+{
+    uint32_t           num_cells = (uint32_t)rows * columns;
+    maze_gap_bitmask_t bitmask   = {
+          .p_bitmask = calloc(num_cells, sizeof(uint16_t)),
+          .rows      = rows,
+          .columns   = columns,
+    };
+
+    uint32_t *p_stack   = malloc(sizeof(uint32_t) * num_cells);
+    uint8_t  *p_visited = calloc(num_cells, sizeof(uint8_t));
+    uint32_t  stack_top = 0;
+
+    set_random_seed(MAZE_SEED);
+
+    p_stack[stack_top++] = 0;
+    p_visited[0]         = 1;
+
+    while (0 < stack_top)
+    {
+        uint32_t cell_idx = p_stack[stack_top - 1];
+        uint32_t row      = cell_idx / columns;
+        uint32_t col      = cell_idx % columns;
+        uint32_t next_idx[4];
+        uint8_t  next_dir[4];
+        uint8_t  num_next = 0;
+
+        // Step 1: Collect the unvisited neighbours.
+        //
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            if ((MAZE_NORTH == direction && 0 == row)
+                || (MAZE_EAST == direction && columns - 1u == col)
+                || (MAZE_SOUTH == direction && rows - 1u == row)
+                || (MAZE_WEST == direction && 0 == col))
+            {
+                continue;
+            }
+
+            uint32_t idx = MAZE_NORTH == direction  ? cell_idx - columns
+                           : MAZE_EAST == direction ? cell_idx + 1u
+                           : MAZE_SOUTH == direction ? cell_idx + columns
+                                                     : cell_idx - 1u;
+
+            if (!p_visited[idx])
+            {
+                next_idx[num_next]   = idx;
+                next_dir[num_next++] = direction;
+            }
+        }
+
+        if (0 == num_next)
+        {
+            stack_top--;
+            continue;
+        }
+
+        // Step 2: Carve a gap to a random unvisited neighbour.
+        //
+        uint8_t choice = get_random() % num_next;
+
+        bitmask.p_bitmask[cell_idx] |= 1u << next_dir[choice];
+        bitmask.p_bitmask[next_idx[choice]]
+            |= 1u << ((next_dir[choice] + 2) % 4);
+        p_visited[next_idx[choice]] = 1;
+        p_stack[stack_top++]        = next_idx[choice];
+    }
+
+    free(p_stack);
+    free(p_visited);
+    return bitmask;
+}
+
+/**
+ * @brief Generates a maze with every gap open, then closes a random gap of a
+ * share of the cells, like a large room with a few obstacles.
+ *
+ * @param[in] rows Number of rows.
+ * @param[in] columns Number of columns.
+ * @param[in] wall_share Percentage of cells to close a gap of.
+ * @return maze_gap_bitmask_t Bitmask array of maze gaps. This must be freed.
+ */
+static maze_gap_bitmask_t
+generate_open_maze (uint16_t rows, uint16_t columns, uint32_t wall_share)
+{
+    uint32_t           num_cells = (uint32_t)rows * columns;
+    maze_gap_bitmask_t bitmask   = {
+          .p_bitmask = malloc(sizeof(uint16_t) * num_cells),
+          .rows      = rows,
+          .columns   = columns,
+    };
+
+    for (uint32_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        uint32_t row = cell_idx / columns;
+        uint32_t col = cell_idx % columns;
+
+        bitmask.p_bitmask[cell_idx]
+            = ((0 < row) ? 1u << MAZE_NORTH : 0)
+              | ((columns - 1u > col) ? 1u << MAZE_EAST : 0)
+              | ((rows - 1u > row) ? 1u << MAZE_SOUTH : 0)
+              | ((0 < col) ? 1u << MAZE_WEST : 0);
+    }
+
+    for (uint32_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        if (get_random() % 100 >= wall_share)
+        {
+            continue;
+        }
+
+        // Close the gap on both of its sides.
+        //
+        uint8_t direction = get_random() % 4;
+        int32_t offsets[4] = { -(int32_t)columns, 1, (int32_t)columns, -1 };
+
+        if (0 != (bitmask.p_bitmask[cell_idx] & (1u << direction)))
+        {
+            bitmask.p_bitmask[cell_idx] &= ~(1u << direction);
+            bitmask.p_bitmask[(int32_t)cell_idx + offsets[direction]]
+                &= ~(1u << ((direction + 2) % 4));
+        }
+    }
+
+    return bitmask;
+}
+
+/**
+ * @brief Opens half of the inner east and south walls of a generated maze, so
+ * that there are many routes between two cells, like a partly mapped course.
+ *
+ * @param[in,out] p_bitmask Pointer to the bitmask array of maze gaps.
+ */
+static void
+braid_maze (maze_gap_bitmask_t *p_bitmask)
+{
+    uint16_t rows    = p_bitmask->rows;
+    uint16_t columns = p_bitmask->columns;
+
+    for (uint32_t cell_idx = 0; (uint32_t)rows * columns > cell_idx; cell_idx++)
+    {
+        uint32_t row = cell_idx / columns;
+        uint32_t col = cell_idx % columns;
+
+        if (columns - 1u > col && 0 == get_random() % 2)
+        {
+            p_bitmask->p_bitmask[cell_idx] |= 1u << MAZE_EAST;
+            p_bitmask->p_bitmask[cell_idx + 1u] |= 1u << MAZE_WEST;
+        }
+        if (rows - 1u > row && 0 == get_random() % 2)
+        {
+            p_bitmask->p_bitmask[cell_idx] |= 1u << MAZE_SOUTH;
+            p_bitmask->p_bitmask[cell_idx + columns] |= 1u << MAZE_NORTH;
+        }
+    }
+}
+
+/**
+ * @brief Creates every backend from the same bitmask array.
+ *
+ * @param[in] p_bitmask Pointer to the bitmask array of maze gaps.
+ * @return benchmark_mazes_t Backends. These must be destroyed.
+ */
+static benchmark_mazes_t
+create_mazes (maze_gap_bitmask_t *p_bitmask)
+{
+    benchmark_mazes_t mazes = {
+        .grid    = maze_create(p_bitmask->rows, p_bitmask->columns),
+        .compact = maze_compact_create(p_bitmask->rows, p_bitmask->columns),
+        .padded  = maze_padded_create(p_bitmask->rows, p_bitmask->columns),
+    };
+
+    maze_deserialise(&mazes.grid, p_bitmask);
+    maze_compact_deserialise(&mazes.compact, p_bitmask);
+    maze_padded_deserialise(&mazes.padded, p_bitmask);
+
+    return mazes;
+}
+
+/**
+ * @brief Destroys every backend.
+ *
+ * @param[in,out] p_mazes Pointer to the backends.
+ */
+static void
+destroy_mazes (benchmark_mazes_t *p_mazes)
+{
+    maze_destroy(&p_mazes->grid);
+    maze_compact_destroy(&p_mazes->compact);
+    maze_padded_destroy(&p_mazes->padded);
+}
+
+/**
+ * @brief Times the adjacent cell lookups of every backend. Each backend counts
+ * the lookups that land in the maze, and the counts must match.
+ *
+ * @param[in] p_mazes Pointer to the backends.
+ * @param[in] p_name Name of the maze to print.
+ * @return int 0 if the backends agree, -1 otherwise.
+ */
+static int
+benchmark_lookups (benchmark_mazes_t *p_mazes, const char *p_name)
+{
+    uint16_t rows      = p_mazes->grid.rows;
+    uint16_t columns   = p_mazes->grid.columns;
+    uint32_t num_cells = (uint32_t)rows * columns;
+    uint32_t num_reps  = NUM_LOOKUPS / (num_cells * 4u) + 1u;
+    uint32_t num_ops   = num_reps * num_cells * 4u;
+    uint64_t counts[3] = { 0, 0, 0 };
+    clock_t  start     = clock();
+
+    // Step 1: Pointer-based grid.
+    //
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        for (uint32_t idx = 0; num_cells > idx; idx++)
+        {
+            maze_grid_cell_t *p_cell = &p_mazes->grid.p_grid_array[idx];
+
+            for (uint8_t direction = 0; 4 > direction; direction++)
+            {
+                counts[0] += NULL
+                             != maze_get_cell_in_dir(
+                                 &p_mazes->grid, p_cell, direction);
+            }
+        }
+    }
+
+    clock_t grid_end = clock();
+
+    // Step 2: Compact backend.
+    //
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        for (maze_idx_t idx = 0; num_cells > idx; idx++)
+        {
+            for (uint8_t direction = 0; 4 > direction; direction++)
+            {
+                counts[1] += MAZE_COMPACT_NO_CELL
+                             != maze_compact_get_idx_in_dir(
+                                 &p_mazes->compact, idx, direction);
+            }
+        }
+    }
+
+    clock_t compact_end = clock();
+
+    // Step 3: Padded backend. The sentinels stand in for the bounds checks.
+    //
+    const maze_padded_t *p_padded = &p_mazes->padded;
+
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        for (uint16_t row = 0; rows > row; row++)
+        {
+            maze_idx_t idx = (maze_idx_t)(row + 1u) * p_padded->stride + 1u;
+
+            for (uint16_t col = 0; columns > col; col++, idx++)
+            {
+                for (uint8_t direction = 0; 4 > direction; direction++)
+                {
+                    maze_idx_t next_idx = idx + p_padded->offsets[direction];
+
+                    counts[2] += !(p_padded->p_cells[next_idx]
+                                   & MAZE_PADDED_SENTINEL);
+                }
+            }
+        }
+    }
+
+    clock_t padded_end = clock();
+
+    printf("Neighbour lookups on the %s (%u lookups):\n", p_name, num_ops);
+    printf("    grid:    %8.2f ns/lookup\n",
+           get_elapsed_ns(start, grid_end, num_ops));
+    printf("    compact: %8.2f ns/lookup\n",
+           get_elapsed_ns(grid_end, compact_end, num_ops));
+    printf("    padded:  %8.2f ns/lookup\n",
+           get_elapsed_ns(compact_end, padded_end, num_ops));
+
+    if (counts[0] != counts[1] || counts[0] != counts[2])
+    {
+        printf("Backends disagree on neighbours: %llu, %llu, %llu.\n",
+               (unsigned long long)counts[0],
+               (unsigned long long)counts[1],
+               (unsigned long long)counts[2]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Times the traversal of every backend from the top-left cell. The
+ * number of reached cells must match.
+ *
+ * @param[in] p_mazes Pointer to the backends.
+ * @param[in] p_name Name of the maze to print.
+ * @return int 0 if the backends agree, -1 otherwise.
+ */
+static int
+benchmark_traversal (benchmark_mazes_t *p_mazes, const char *p_name)
+{
+    uint32_t num_cells   = (uint32_t)p_mazes->grid.rows * p_mazes->grid.columns;
+    uint32_t num_padded  = maze_padded_get_num_cells(&p_mazes->padded);
+    uint32_t num_reps    = NUM_TRAVERSAL_REPS * (LARGE_GRID_ROWS
+                                              * LARGE_GRID_COLS / num_cells);
+    uint64_t counts[3]   = { 0, 0, 0 };
+    uint8_t *p_visited   = malloc(num_padded);
+    void    *p_queue     = malloc(sizeof(maze_grid_cell_t *) * num_padded);
+    clock_t  start       = clock();
+
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        counts[0] += traverse_grid(&p_mazes->grid, p_queue);
+    }
+
+    clock_t grid_end = clock();
+
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        counts[1] += traverse_compact(&p_mazes->compact, p_queue, p_visited);
+    }
+
+    clock_t compact_end = clock();
+
+    for (uint32_t rep = 0; num_reps > rep; rep++)
+    {
+        counts[2] += traverse_padded(&p_mazes->padded, p_queue, p_visited);
+    }
+
+    clock_t padded_end = clock();
+
+    uint32_t num_ops = (uint32_t)counts[0];
+
+    printf("Traversals of the %s (%u cells):\n", p_name, num_ops);
+    printf("    grid:    %8.2f ns/cell\n",
+           get_elapsed_ns(start, grid_end, num_ops));
+    printf("    compact: %8.2f ns/cell\n",
+           get_elapsed_ns(grid_end, compact_end, num_ops));
+    printf("    padded:  %8.2f ns/cell\n",
+           get_elapsed_ns(compact_end, padded_end, num_ops));
+
+    free(p_visited);
+    free(p_queue);
+
+    if (counts[0] != counts[1] || counts[0] != counts[2])
+    {
+        printf("Backends disagree on reached cells: %llu, %llu, %llu.\n",
+               (unsigned long long)counts[0],
+               (unsigned long long)counts[1],
+               (unsigned long long)counts[2]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Times A* from the top-left to the bottom-right cell of a braided
+ * maze. The linear scan is timed by running the same context without its
+ * position map. The bucket queue has no linear scan, so only the first search
+ * is run when the open set is built with it.
+ *
+ * @param[in] size Number of rows and columns of the maze.
+ * @return int 0 if both open sets find paths of the same length, -1
+ * otherwise.
+ */
+static int
+benchmark_heap (uint16_t size)
+{
+    maze_gap_bitmask_t bitmask = generate_maze(size, size);
+    maze_grid_t        grid    = maze_create(size, size);
+    braid_maze(&bitmask);
+    maze_deserialise(&grid, &bitmask);
+
+    maze_point_t      start_point = { 0, 0 };
+    maze_point_t      end_point   = { size - 1, size - 1 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &end_point);
+    maze_idx_t        end_idx = maze_get_cell_idx(&grid, p_end);
+
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    uint32_t lengths[2];
+    clock_t  times[3];
+
+    // Step 1: Indexed open set.
+    //
+    times[0] = clock();
+    a_star_ctx(&grid, &context, p_start, p_end);
+    lengths[0] = context.p_g[end_idx];
+    times[1]   = clock();
+
+#ifdef MAZE_BUCKET_QUEUE
+    lengths[1] = lengths[0];
+    printf("A* across the %ux%u braided maze:\n", size, size);
+    printf("    bucket:  %10.3f ms\n",
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC);
+#else
+    // Step 2: The same search with a linear scan of the open set.
+    //
+    maze_idx_t *p_positions      = context.open_set.p_positions;
+    context.open_set.p_positions = NULL;
+    a_star_ctx(&grid, &context, p_start, p_end);
+    lengths[1] = context.p_g[end_idx];
+    times[2]   = clock();
+    context.open_set.p_positions = p_positions;
+
+    printf("A* across the %ux%u braided maze:\n", size, size);
+    printf("    indexed: %10.3f ms\n",
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC);
+    printf("    linear:  %10.3f ms\n",
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC);
+#endif
+
+    search_context_destroy(&context);
+    maze_destroy(&grid);
+    free(bitmask.p_bitmask);
+
+    if (lengths[0] != lengths[1])
+    {
+        printf("Open sets disagree on the path length: %u, %u.\n",
+               lengths[0],
+               lengths[1]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Times a unit-cost search of every cell of a braided maze from the
+ * top-left cell with each queue.
+ *
+ * @param[in] size Number of rows and columns of the maze.
+ * @return int 0 if both queues find the same distances, -1 otherwise.
+ */
+static int
+benchmark_open_sets (uint16_t size)
+{
+    maze_gap_bitmask_t bitmask = generate_maze(size, size);
+    maze_grid_t        grid    = maze_create(size, size);
+    braid_maze(&bitmask);
+    maze_deserialise(&grid, &bitmask);
+
+    uint32_t *p_dist = malloc(sizeof(uint32_t) * MAZE_GRID_CELLS(&grid));
+    uint64_t  totals[2];
+    clock_t   times[3];
+
+    times[0]  = clock();
+    totals[0] = search_heap(&grid, p_dist);
+    times[1]  = clock();
+    totals[1] = search_bucket(&grid, p_dist);
+    times[2]  = clock();
+
+    printf("Unit-cost search of the %ux%u braided maze:\n", size, size);
+    printf("    heap:    %10.3f ms\n",
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC);
+    printf("    bucket:  %10.3f ms\n",
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC);
+
+    free(p_dist);
+    maze_destroy(&grid);
+    free(bitmask.p_bitmask);
+
+    if (totals[0] != totals[1])
+    {
+        printf("Queues disagree on the distances: %llu, %llu.\n",
+               (unsigned long long)totals[0],
+               (unsigned long long)totals[1]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Maps a braided maze from its bottom-left cell to its top-right cell,
+ * once with a flood after every move and once with D* Lite.
+ *
+ * @param[in] size Side of the maze.
+ * @return int 0 if both runs reach the end node, -1 otherwise.
+ */
+static int
+benchmark_mapping (uint16_t size)
+{
+    maze_gap_bitmask_t bitmask = generate_maze(size, size);
+    braid_maze(&bitmask);
+    gp_true_bitmask = &bitmask;
+
+    maze_point_t start_point = { 0, size - 1 };
+    maze_point_t end_point   = { size - 1, 0 };
+    bool         is_reached[2];
+    clock_t      times[3];
+
+    for (uint8_t run = 0; 2 > run; run++)
+    {
+        maze_grid_t grid = maze_create(size, size);
+        floodfill_init_maze_nowall(&grid);
+
+        maze_grid_cell_t *p_start
+            = maze_get_cell_at_coords(&grid, &start_point);
+        maze_grid_cell_t *p_end = maze_get_cell_at_coords(&grid, &end_point);
+        maze_navigator_state_t navigator
+            = { p_start, p_start, p_end, MAZE_NORTH };
+
+        times[run] = clock();
+
+        if (0 == run)
+        {
+            floodfill_map_maze(
+                &grid, p_end, &navigator, &explore_true_maze, &move_navigator);
+        }
+        else
+        {
+            d_star_lite_map_maze(
+                &grid, p_end, &navigator, &explore_true_maze, &move_navigator);
+        }
+
+        times[run + 1]  = clock();
+        is_reached[run] = navigator.p_current_node == p_end;
+        maze_destroy(&grid);
+    }
+
+    printf("Mapping the %ux%u braided maze:\n", size, size);
+    printf("    floodfill:   %10.3f ms\n",
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC);
+    printf("    D* Lite:     %10.3f ms\n",
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC);
+
+    gp_true_bitmask = NULL;
+    free(bitmask.p_bitmask);
+
+    if (!is_reached[0] || !is_reached[1])
+    {
+        printf("A mapping run did not reach the end node.\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Adds the walls of the true maze around the navigator to the mapped
+ * maze.
+ *
+ * @param[in,out] p_grid Pointer to the mapped maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Cardinal direction to explore.
+ * @return uint16_t Bitmask of the walls.
+ */
+static uint16_t
+explore_true_maze (maze_grid_t              *p_grid,
+                   maze_navigator_state_t   *p_navigator,
+                   maze_cardinal_direction_t direction)
+{
+    maze_idx_t cell_idx
+        = maze_get_cell_idx(p_grid, p_navigator->p_current_node);
+    uint16_t bitmask = 0xF & ~gp_true_bitmask->p_bitmask[cell_idx];
+
+    p_navigator->orientation = direction;
+    maze_nav_modify_walls(p_grid, p_navigator, bitmask, true, false);
+
+    return bitmask;
+}
+
+/**
+ * @brief Moves the navigator to the adjacent node.
+ *
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Cardinal direction to move.
+ */
+static void
+move_navigator (maze_navigator_state_t   *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->p_current_node
+        = p_navigator->p_current_node->p_next[direction];
+    p_navigator->orientation = direction;
+}
+
+/**
+ * @brief Searches from the top-left to the bottom-right cell of a maze with
+ * A* and with Jump Point Search, and prints the nodes that each expanded and
+ * the mean time of a search. A* reuses one search context, while JPS
+ * allocates its arrays on every search as its API requires.
+ *
+ * @param[in] p_bitmask Pointer to the bitmask array of maze gaps.
+ * @param[in] p_name Name of the maze to print.
+ * @return int 0 if both searches find paths of the same length, -1 otherwise.
+ */
+static int
+benchmark_jps (maze_gap_bitmask_t *p_bitmask, const char *p_name)
+{
+    maze_grid_t grid = maze_create(p_bitmask->rows, p_bitmask->columns);
+    maze_deserialise(&grid, p_bitmask);
+
+    maze_grid_cell_t *p_start = &grid.p_grid_array[0];
+    maze_grid_cell_t *p_end
+        = &grid.p_grid_array[MAZE_GRID_CELLS(&grid) - 1u];
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    uint32_t jps_expanded = 0;
+    uint32_t lengths[2]   = { 0, 0 };
+    clock_t  times[3];
+
+    times[0] = clock();
+
+    for (uint32_t rep = 0; NUM_JPS_REPS > rep; rep++)
+    {
+        if (a_star_ctx(&grid, &context, p_start, p_end))
+        {
+            lengths[0] = context.p_g[maze_get_cell_idx(&grid, p_end)] + 1u;
+        }
+    }
+
+    times[1] = clock();
+
+    for (uint32_t rep = 0; NUM_JPS_REPS > rep; rep++)
+    {
+        a_star_path_t *p_path
+            = a_star_jps(&grid, p_start, p_end, &jps_expanded);
+
+        if (NULL != p_path)
+        {
+            lengths[1] = p_path->length;
+            maze_free(p_path->p_path);
+            maze_free(p_path);
+        }
+    }
+
+    times[2] = clock();
+
+    printf("    %-6s A*: %7u expanded %8.3f ms, JPS: %7u expanded %8.3f ms\n",
+           p_name,
+           context.num_expanded,
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC
+               / NUM_JPS_REPS,
+           jps_expanded,
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC
+               / NUM_JPS_REPS);
+
+    search_context_destroy(&context);
+    maze_destroy(&grid);
+
+    if (lengths[0] != lengths[1])
+    {
+        printf("Searches disagree on the path length: %u, %u.\n",
+               lengths[0],
+               lengths[1]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Searches from the top-left to the bottom-right cell of a maze with A*
+ * on the grid, and on its junction graph.
+ *
+ * @param[in] p_bitmask Pointer to the bitmask array of the maze.
+ * @param[in] p_name Name of the maze to print.
+ * @return int 0 if the searches find paths of the same length, -1 otherwise.
+ */
+static int
+benchmark_junction_graph (maze_gap_bitmask_t *p_bitmask, const char *p_name)
+{
+    maze_grid_t grid = maze_create(p_bitmask->rows, p_bitmask->columns);
+    maze_deserialise(&grid, p_bitmask);
+
+    maze_grid_cell_t *p_start = &grid.p_grid_array[0];
+    maze_grid_cell_t *p_end
+        = &grid.p_grid_array[MAZE_GRID_CELLS(&grid) - 1u];
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    uint32_t graph_expanded = 0;
+    uint32_t lengths[2]     = { 0, 0 };
+    clock_t  times[4];
+
+    times[0] = clock();
+
+    if (a_star_ctx(&grid, &context, p_start, p_end))
+    {
+        lengths[0] = context.p_g[maze_get_cell_idx(&grid, p_end)] + 1u;
+    }
+
+    times[1]           = clock();
+    maze_graph_t graph = maze_graph_create(&grid);
+    times[2]           = clock();
+    a_star_path_t *p_path
+        = maze_graph_find_path(&graph, p_start, p_end, &graph_expanded);
+    times[3] = clock();
+
+    if (NULL != p_path)
+    {
+        lengths[1] = p_path->length;
+        free(p_path->p_path);
+        free(p_path);
+    }
+
+    printf("    %-7s A*: %7u expanded %8.3f ms, graph: %6u nodes built "
+           "%8.3f ms, %7u expanded %8.3f ms\n",
+           p_name,
+           context.num_expanded,
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC,
+           graph.num_nodes,
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC,
+           graph_expanded,
+           (double)(times[3] - times[2]) * 1e3 / CLOCKS_PER_SEC);
+
+    maze_graph_destroy(&graph);
+    search_context_destroy(&context);
+    maze_destroy(&grid);
+
+    if (lengths[0] != lengths[1])
+    {
+        printf("Searches disagree on the path length: %u, %u.\n",
+               lengths[0],
+               lengths[1]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Searches between random cells of a maze with A*, first with the
+ * Manhattan distance and then with the ALT heuristic.
+ *
+ * @param[in] p_bitmask Pointer to the bitmask array of the maze.
+ * @param[in] p_name Name of the maze to print.
+ * @return int 0 if the searches find paths of the same length, -1 otherwise.
+ */
+static int
+benchmark_landmarks (maze_gap_bitmask_t *p_bitmask, const char *p_name)
+{
+    int         ret_val = 0;
+    maze_grid_t grid    = maze_create(p_bitmask->rows, p_bitmask->columns);
+    maze_deserialise(&grid, p_bitmask);
+
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    maze_landmarks_t landmarks = maze_landmarks_create(&grid, NUM_LANDMARKS);
+    uint64_t         expanded[2]   = { 0, 0 };
+    double           elapsed_ms[3] = { 0, 0, 0 };
+    clock_t          start_time    = clock();
+
+    maze_landmarks_update(&landmarks);
+    elapsed_ms[0] = (double)(clock() - start_time) * 1e3 / CLOCKS_PER_SEC;
+
+    for (uint8_t query = 0; NUM_ALT_QUERIES > query && 0 == ret_val; query++)
+    {
+        maze_grid_cell_t *p_start
+            = &grid.p_grid_array[get_random() % MAZE_GRID_CELLS(&grid)];
+        maze_grid_cell_t *p_end
+            = &grid.p_grid_array[get_random() % MAZE_GRID_CELLS(&grid)];
+        maze_idx_t end_idx    = maze_get_cell_idx(&grid, p_end);
+        uint32_t   lengths[2] = { 0, 0 };
+
+        start_time = clock();
+
+        if (a_star_ctx(&grid, &context, p_start, p_end))
+        {
+            lengths[0] = context.p_g[end_idx] + 1u;
+        }
+
+        elapsed_ms[1] += (double)(clock() - start_time) * 1e3 / CLOCKS_PER_SEC;
+        expanded[0] += context.num_expanded;
+        start_time = clock();
+
+        if (a_star_ctx_alt(&grid, &context, &landmarks, p_start, p_end))
+        {
+            lengths[1] = context.p_g[end_idx] + 1u;
+        }
+
+        elapsed_ms[2] += (double)(clock() - start_time) * 1e3 / CLOCKS_PER_SEC;
+        expanded[1] += context.num_expanded;
+
+        if (lengths[0] != lengths[1])
+        {
+            printf("Searches disagree on the path length: %u, %u.\n",
+                   lengths[0],
+                   lengths[1]);
+            ret_val = -1;
+        }
+    }
+
+    printf("    %-7s A*: %9llu expanded %8.3f ms, ALT: built %8.3f ms, "
+           "%9llu expanded %8.3f ms\n",
+           p_name,
+           (unsigned long long)expanded[0],
+           elapsed_ms[1],
+           elapsed_ms[0],
+           (unsigned long long)expanded[1],
+           elapsed_ms[2]);
+
+    maze_landmarks_destroy(&landmarks);
+    search_context_destroy(&context);
+    maze_destroy(&grid);
+
+    return ret_val;
+}
+
+/**
+ * @brief Searches from the top-left to the bottom-right cell of a braided
+ * maze with A*, and with the bidirectional search on one thread and on two.
+ *
+ * @param[in] size Number of rows and columns of the maze.
+ * @return int 0 if the searches find paths of the same length, -1 otherwise.
+ */
+static int
+benchmark_bidirectional (uint16_t size)
+{
+    maze_gap_bitmask_t bitmask = generate_maze(size, size);
+    maze_grid_t        grid    = maze_create(size, size);
+    braid_maze(&bitmask);
+    maze_deserialise(&grid, &bitmask);
+
+    maze_grid_cell_t *p_start = &grid.p_grid_array[0];
+    maze_grid_cell_t *p_end
+        = &grid.p_grid_array[MAZE_GRID_CELLS(&grid) - 1u];
+    search_context_t forward
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    search_context_t backward
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&grid));
+    uint32_t lengths[3]  = { 0, 0, 0 };
+    uint32_t expanded[3] = { 0, 0, 0 };
+    clock_t  times[4];
+
+    // Step 1: A* from the start node.
+    //
+    times[0] = clock();
+
+    if (a_star_ctx(&grid, &forward, p_start, p_end))
+    {
+        lengths[0] = forward.p_g[maze_get_cell_idx(&grid, p_end)] + 1u;
+    }
+
+    expanded[0] = forward.num_expanded;
+    times[1]    = clock();
+
+    // Step 2: Both ends, on one thread and then on two.
+    //
+    for (uint8_t is_threaded = 0; 2 > is_threaded; is_threaded++)
+    {
+        a_star_path_t *p_path = a_star_bidirectional(
+            &grid, &forward, &backward, p_start, p_end, is_threaded);
+        times[is_threaded + 2] = clock();
+
+        if (NULL != p_path)
+        {
+            lengths[is_threaded + 1] = p_path->length;
+            free(p_path->p_path);
+            free(p_path);
+        }
+
+        expanded[is_threaded + 1]
+            = forward.num_expanded + backward.num_expanded;
+    }
+
+    printf("A* and bidirectional A* across the %ux%u braided maze:\n",
+           size,
+           size);
+    printf("    A*:                %7u expanded %10.3f ms\n",
+           expanded[0],
+           (double)(times[1] - times[0]) * 1e3 / CLOCKS_PER_SEC);
+    printf("    bidirectional:     %7u expanded %10.3f ms\n",
+           expanded[1],
+           (double)(times[2] - times[1]) * 1e3 / CLOCKS_PER_SEC);
+    printf("    on two threads:    %7u expanded %10.3f ms (CPU time)\n",
+           expanded[2],
+           (double)(times[3] - times[2]) * 1e3 / CLOCKS_PER_SEC);
+
+    search_context_destroy(&forward);
+    search_context_destroy(&backward);
+    maze_destroy(&grid);
+    free(bitmask.p_bitmask);
+
+    if (lengths[0] != lengths[1] || lengths[0] != lengths[2])
+    {
+        printf("Searches disagree on the path length: %u, %u, %u.\n",
+               lengths[0],
+               lengths[1],
+               lengths[2]);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Finds the distance of every cell from the top-left cell with the
+ * indexed binary heap.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[out] p_dist Distance of each cell.
+ * @return uint64_t Sum of the distances.
+ */
+static uint64_t
+search_heap (maze_grid_t *p_grid, uint32_t *p_dist)
+{
+    maze_idx_t    num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    binary_heap_t heap      = binary_heap_create(num_cells);
+    uint64_t      total     = 0;
+
+    for (maze_idx_t idx = 0; num_cells > idx; idx++)
+    {
+        p_dist[idx] = UINT32_MAX;
+    }
+
+    p_dist[0] = 0;
+    binary_heap_decrease_key_idx(&heap, 0, 0);
+
+    while (0 < heap.size)
+    {
+        maze_idx_t current_idx = binary_heap_peek(&heap).cell_idx;
+        binary_heap_delete_min(&heap);
+        total += p_dist[current_idx];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_grid_cell_t *p_next
+                = p_grid->p_grid_array[current_idx].p_next[direction];
+
+            if (NULL == p_next)
+            {
+                continue;
+            }
+
+            maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+            if (p_dist[current_idx] + 1 < p_dist[next_idx])
+            {
+                p_dist[next_idx] = p_dist[current_idx] + 1;
+                binary_heap_decrease_key_idx(
+                    &heap, next_idx, (maze_priority_t)p_dist[next_idx]);
+            }
+        }
+    }
+
+    binary_heap_destroy(&heap);
+    return total;
+}
+
+/**
+ * @brief Finds the distance of every cell from the top-left cell with the
+ * bucket queue.
+ *
+ * @param[in] p_grid Pointer to the grid maze.
+ * @param[out] p_dist Distance of each cell.
+ * @return uint64_t Sum of the distances.
+ */
+static uint64_t
+search_bucket (maze_grid_t *p_grid, uint32_t *p_dist)
+{
+    maze_idx_t     num_cells = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    bucket_queue_t queue     = bucket_queue_create(num_cells);
+    uint64_t       total     = 0;
+
+    for (maze_idx_t idx = 0; num_cells > idx; idx++)
+    {
+        p_dist[idx] = UINT32_MAX;
+    }
+
+    p_dist[0] = 0;
+    bucket_queue_push(&queue, 0, 0);
+
+    while (0 < queue.size)
+    {
+        maze_idx_t current_idx = bucket_queue_pop(&queue);
+        total += p_dist[current_idx];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_grid_cell_t *p_next
+                = p_grid->p_grid_array[current_idx].p_next[direction];
+
+            if (NULL == p_next)
+            {
+                continue;
+            }
+
+            maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+
+            if (p_dist[current_idx] + 1 < p_dist[next_idx])
+            {
+                p_dist[next_idx] = p_dist[current_idx] + 1;
+                bucket_queue_push(
+                    &queue, next_idx, (maze_priority_t)p_dist[next_idx]);
+            }
+        }
+    }
+
+    bucket_queue_destroy(&queue);
+    return total;
+}
+
+/**
+ * @brief Traverses the grid maze breadth-first from the top-left cell.
+ *
+ * @param[in,out] p_grid Pointer to the grid maze. The visited flags are used.
+ * @param[out] p_queue Queue with room for every cell.
+ * @return uint64_t Number of reached cells.
+ */
+static uint64_t
+traverse_grid (maze_grid_t *p_grid, maze_grid_cell_t **p_queue)
+{
+    uint32_t num_cells = (uint32_t)p_grid->rows * p_grid->columns;
+    uint32_t head      = 0;
+    uint32_t tail      = 0;
+
+    for (uint32_t idx = 0; num_cells > idx; idx++)
+    {
+        p_grid->p_grid_array[idx].is_visited = false;
+    }
+
+    p_queue[tail++]                       = &p_grid->p_grid_array[0];
+    p_grid->p_grid_array[0].is_visited    = true;
+
+    while (head < tail)
+    {
+        maze_grid_cell_t *p_cell = p_queue[head++];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL != p_next && !p_next->is_visited)
+            {
+                p_next->is_visited = true;
+                p_queue[tail++]    = p_next;
+            }
+        }
+    }
+
+    return tail;
+}
+
+/**
+ * @brief Traverses the compact maze breadth-first from the top-left cell.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[out] p_queue Queue with room for every cell.
+ * @param[out] p_visited Visited flags with room for every cell.
+ * @return uint64_t Number of reached cells.
+ */
+static uint64_t
+traverse_compact (const maze_compact_t *p_maze,
+                  maze_idx_t           *p_queue,
+                  uint8_t              *p_visited)
+{
+    uint32_t head = 0;
+    uint32_t tail = 0;
+
+    memset(p_visited, 0, (size_t)p_maze->rows * p_maze->columns);
+    p_queue[tail++] = 0;
+    p_visited[0]    = 1;
+
+    while (head < tail)
+    {
+        maze_idx_t cell_idx = p_queue[head++];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t next_idx
+                = maze_compact_get_next_idx(p_maze, cell_idx, direction);
+
+            if (MAZE_COMPACT_NO_CELL != next_idx && !p_visited[next_idx])
+            {
+                p_visited[next_idx] = 1;
+                p_queue[tail++]     = next_idx;
+            }
+        }
+    }
+
+    return tail;
+}
+
+/**
+ * @brief Traverses the padded maze breadth-first from the top-left cell.
+ *
+ * @param[in] p_maze Pointer to the padded maze.
+ * @param[out] p_queue Queue with room for every cell.
+ * @param[out] p_visited Visited flags with room for every padded cell.
+ * @return uint64_t Number of reached cells.
+ */
+static uint64_t
+traverse_padded (const maze_padded_t *p_maze,
+                 maze_idx_t          *p_queue,
+                 uint8_t             *p_visited)
+{
+    uint32_t     head       = 0;
+    uint32_t     tail       = 0;
+    maze_point_t start      = { 0, 0 };
+    maze_idx_t   start_idx  = maze_padded_get_idx(p_maze, &start);
+
+    memset(p_visited, 0, maze_padded_get_num_cells(p_maze));
+    p_queue[tail++]      = start_idx;
+    p_visited[start_idx] = 1;
+
+    while (head < tail)
+    {
+        maze_idx_t cell_idx = p_queue[head++];
+        uint8_t    walls    = p_maze->p_cells[cell_idx];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t next_idx = cell_idx + p_maze->offsets[direction];
+
+            if (!((walls >> direction) & 1u) && !p_visited[next_idx])
+            {
+                p_visited[next_idx] = 1;
+                p_queue[tail++]     = next_idx;
+            }
+        }
+    }
+
+    return tail;
+}
+
+/**
+ * @brief Gets the time per operation between two clock readings.
+ *
+ * @param[in] start Clock reading before the operations.
+ * @param[in] end Clock reading after the operations.
+ * @param[in] num_ops Number of operations.
+ * @return double Nanoseconds per operation.
+ */
+static double
+get_elapsed_ns (clock_t start, clock_t end, uint32_t num_ops)
+{
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / num_ops;
+}
+
+/**
+ * @brief Gets the wall-clock time, which unlike the CPU time of clock() does
+ * not add up across threads.
+ *
+ * @return double Time in milliseconds from an arbitrary start.
+ */
+static double
+get_wall_time_ms (void)
+{
+#ifdef CLOCK_MONOTONIC
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec * 1e3 + (double)now.tv_nsec / 1e6;
+#else
+    return (double)clock() * 1e3 / CLOCKS_PER_SEC;
+#endif
+}
+
+// End of benchmark_tests.c
@@ -0,0 +1,623 @@
+/**
+ * @file chunked_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the growable chunked maze backend
+ * and the algorithms that run on it.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/maze_chunked.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/dfs.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS       = 6,   ///< Number of rows in the grid.
+    GRID_COLS       = 4,   ///< Number of columns in the grid.
+    STAIRCASE_STEPS = 255, ///< Number of steps in the staircase corridor.
+    MAX_NUM_BLOCKS  = 8    ///< Most blocks that one search allocates at once.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+static uint32_t g_num_blocks_left = 0; // Blocks left to the limited allocator.
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_chunked_neighbours(void);
+static int test_chunked_memory(void);
+static int test_chunked_a_star(void);
+static int test_chunked_dfs(void);
+static int test_chunked_out_of_memory(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_chunked_point_t to_chunked_point(const maze_point_t *p_point);
+
+static void load_test_maze(maze_chunked_t *p_maze);
+
+static uint16_t explore_current_cell(maze_chunked_t           *p_maze,
+                                     maze_chunked_navigator_t *p_navigator,
+                                     maze_cardinal_direction_t direction);
+
+static void move_navigator(maze_chunked_t           *p_maze,
+                           maze_chunked_navigator_t *p_navigator,
+                           maze_cardinal_direction_t direction);
+
+static void *alloc_limited(void *p_state, size_t size);
+static void *realloc_limited(void *p_state, void *p_block, size_t size);
+static void  free_limited(void *p_state, void *p_block);
+
+/**
+ * @brief Runs the tests for the chunked maze backend.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+chunked_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_chunked_neighbours();
+            break;
+        case 2:
+            ret_val = test_chunked_memory();
+            break;
+        case 3:
+            ret_val = test_chunked_a_star();
+            break;
+        case 4:
+            ret_val = test_chunked_dfs();
+            break;
+        case 5:
+            ret_val = test_chunked_out_of_memory();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that chunks are allocated when a gap is sensed, that negative
+ * coordinates work and that walls are shared across chunk borders.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_chunked_neighbours (void)
+{
+    int            ret_val = 0;
+    maze_chunked_t maze    = maze_chunked_create();
+
+    maze_chunked_point_t origin     = { 0, 0 };
+    maze_chunked_point_t west       = { -1, 0 };
+    maze_idx_t           origin_idx = maze_chunked_get_idx(&maze, &origin);
+
+    if (1 != maze.num_chunks
+        || MAZE_CHUNKED_NO_CELL != maze_chunked_get_idx(&maze, &west))
+    {
+        printf("Only the chunk of the origin should be allocated.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 1: Sensing a gap to the west allocates the chunk behind it.
+    //
+    maze_chunked_unset_wall(&maze, origin_idx, MAZE_WEST);
+
+    maze_idx_t west_idx = maze_chunked_get_idx(&maze, &west);
+
+    if (2 != maze.num_chunks || MAZE_CHUNKED_NO_CELL == west_idx
+        || west_idx != maze_chunked_get_next_idx(&maze, origin_idx, MAZE_WEST)
+        || origin_idx != maze_chunked_get_next_idx(&maze, west_idx, MAZE_EAST))
+    {
+        printf("Gap across the chunk border is not shared.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 2: Every cell maps back to its coordinates.
+    //
+    for (int16_t y = -9; 9 > y; y++)
+    {
+        for (int16_t x = -9; 9 > x; x++)
+        {
+            maze_chunked_point_t point = { x, y };
+            maze_idx_t cell_idx = maze_chunked_add_cell(&maze, &point);
+            maze_chunked_point_t result
+                = maze_chunked_get_point(&maze, cell_idx);
+
+            if (x != result.x || y != result.y)
+            {
+                printf(
+                    "(%d, %d) maps to (%d, %d).\n", x, y, result.x, result.y);
+                ret_val = -1;
+                goto end;
+            }
+
+            // The cell to the north is one row up, even across chunks.
+            //
+            maze_chunked_point_t north = { x, (int16_t)(y - 1) };
+
+            if (-9 < y
+                && maze_chunked_get_idx(&maze, &north)
+                       != maze_chunked_get_idx_in_dir(
+                           &maze, cell_idx, MAZE_NORTH))
+            {
+                printf("North of (%d, %d) is wrong.\n", x, y);
+                ret_val = -1;
+                goto end;
+            }
+        }
+    }
+
+    // Step 3: Walls set on one side are seen from the other.
+    //
+    maze_chunked_set_wall(&maze, west_idx, MAZE_EAST);
+
+    if (!maze_chunked_is_wall(&maze, origin_idx, MAZE_WEST))
+    {
+        printf("Wall is not shared between adjacent cells.\n");
+        ret_val = -1;
+    }
+
+end:
+    maze_chunked_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that memory grows with the explored area instead of the
+ * bounding box, using a staircase corridor from (0, 0) to the south-east.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_chunked_memory (void)
+{
+    int            ret_val  = 0;
+    maze_chunked_t maze     = maze_chunked_create();
+    maze_idx_t     cell_idx = 0;
+
+    for (uint16_t step = 0; STAIRCASE_STEPS > step; step++)
+    {
+        maze_chunked_unset_wall(&maze, cell_idx, MAZE_EAST);
+        cell_idx = maze_chunked_get_next_idx(&maze, cell_idx, MAZE_EAST);
+        maze_chunked_unset_wall(&maze, cell_idx, MAZE_SOUTH);
+        cell_idx = maze_chunked_get_next_idx(&maze, cell_idx, MAZE_SOUTH);
+    }
+
+    maze_chunked_point_t end_point = maze_chunked_get_point(&maze, cell_idx);
+    maze_compact_t bounding_box    = maze_compact_create(STAIRCASE_STEPS + 1,
+                                                      STAIRCASE_STEPS + 1);
+
+    size_t chunked_size = maze_chunked_get_size(&maze);
+    size_t compact_size = maze_compact_get_size(&bounding_box);
+
+    printf("Staircase uses %u chunks and %u bytes, its bounding box uses %u "
+           "bytes as a compact maze.\n",
+           (unsigned)maze.num_chunks,
+           (unsigned)chunked_size,
+           (unsigned)compact_size);
+
+    if (STAIRCASE_STEPS != end_point.x || STAIRCASE_STEPS != end_point.y)
+    {
+        printf("Staircase ends at (%d, %d).\n", end_point.x, end_point.y);
+        ret_val = -1;
+    }
+    else if ((STAIRCASE_STEPS / MAZE_CHUNK_SIZE + 1u) * 2u < maze.num_chunks
+             || compact_size <= chunked_size)
+    {
+        printf("Chunked maze grew with the bounding box.\n");
+        ret_val = -1;
+    }
+
+    maze_compact_destroy(&bounding_box);
+    maze_chunked_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that A* on a chunked maze around the origin finds a path as
+ * short as A* on the grid maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_chunked_a_star (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    // Step 1: Load the maze so that the start cell is at the origin.
+    //
+    maze_chunked_t maze = maze_chunked_create();
+    load_test_maze(&maze);
+
+    maze_chunked_point_t start = to_chunked_point(&g_start_point);
+    maze_chunked_point_t end   = to_chunked_point(&g_end_point);
+
+    // Step 2: Search both mazes.
+    //
+    maze_grid_t grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    a_star(&grid, p_start, p_end);
+    a_star_path_t *p_grid_path = a_star_get_path(p_end);
+
+    a_star_path_t *p_path = a_star_chunked(&maze,
+                                           maze_chunked_get_idx(&maze, &start),
+                                           maze_chunked_get_idx(&maze, &end));
+
+    if (NULL == p_path)
+    {
+        printf("Path is NULL.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    if (p_path->length != p_grid_path->length)
+    {
+        printf("Chunked path length %u differs from grid path length %u.\n",
+               p_path->length,
+               p_grid_path->length);
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 3: The path is in the frame of the bounding box of the chunks.
+    //
+    maze_chunked_point_t min_point;
+    maze_chunked_point_t max_point;
+    maze_chunked_get_bounds(&maze, &min_point, &max_point);
+
+    maze_point_t *p_last = &p_path->p_path[p_path->length - 1].coordinates;
+
+    if (end.x - min_point.x != p_last->x || end.y - min_point.y != p_last->y)
+    {
+        printf("Path ends at (%u, %u).\n", p_last->x, p_last->y);
+        ret_val = -1;
+    }
+
+end:
+    if (NULL != p_path)
+    {
+        free(p_path->p_path);
+        free(p_path);
+    }
+
+    free(p_grid_path->p_path);
+    free(p_grid_path);
+    maze_destroy(&grid);
+    maze_chunked_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that depth first search maps a maze of unknown size, starting
+ * from an empty chunked maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_chunked_dfs (void)
+{
+    int                  ret_val   = 0;
+    maze_chunked_t       maze      = maze_chunked_create();
+    maze_chunked_point_t origin    = { 0, 0 };
+    maze_idx_t           start_idx = maze_chunked_get_idx(&maze, &origin);
+
+    maze_chunked_navigator_t navigator
+        = { start_idx, start_idx, MAZE_CHUNKED_NO_CELL, MAZE_NORTH };
+
+    dfs_depth_first_search_chunked(
+        &maze, &navigator, &explore_current_cell, &move_navigator);
+
+    for (uint16_t row = 0; GRID_ROWS > row; row++)
+    {
+        for (uint16_t col = 0; GRID_COLS > col; col++)
+        {
+            maze_point_t         point         = { col, row };
+            maze_chunked_point_t chunked_point = to_chunked_point(&point);
+            maze_idx_t cell_idx = maze_chunked_get_idx(&maze, &chunked_point);
+            uint16_t   expected = g_bitmask_array[row * GRID_COLS + col];
+
+            if (MAZE_CHUNKED_NO_CELL == cell_idx
+                || !maze_chunked_is_visited(&maze, cell_idx)
+                || expected != maze_chunked_get_gap_bitmask(&maze, cell_idx))
+            {
+                printf("Maze is not correct at (%u, %u).\n", col, row);
+                ret_val = -1;
+                goto end;
+            }
+        }
+    }
+
+    printf("Mapped the maze with %u chunks.\n", (unsigned)maze.num_chunks);
+
+end:
+    maze_chunked_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that A* and depth first search on a chunked maze stop cleanly
+ * when the allocator fails after a number of blocks.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_chunked_out_of_memory (void)
+{
+    int            ret_val = 0;
+    maze_chunked_t maze    = maze_chunked_create();
+    load_test_maze(&maze);
+
+    maze_chunked_point_t start     = to_chunked_point(&g_start_point);
+    maze_chunked_point_t end       = to_chunked_point(&g_end_point);
+    maze_idx_t           start_idx = maze_chunked_get_idx(&maze, &start);
+    maze_idx_t           end_idx   = maze_chunked_get_idx(&maze, &end);
+
+    maze_allocator_t limited = {
+        .p_alloc   = &alloc_limited,
+        .p_realloc = &realloc_limited,
+        .p_free    = &free_limited,
+        .p_state   = NULL,
+    };
+
+    for (uint32_t num_blocks = 0; MAX_NUM_BLOCKS >= num_blocks; num_blocks++)
+    {
+        // Step 1: Search the maze. A path must only be missing if the
+        // allocator ran out of blocks.
+        //
+        g_num_blocks_left = num_blocks;
+
+        maze_allocator_t previous = maze_allocator_set(&limited);
+        a_star_path_t   *p_path   = a_star_chunked(&maze, start_idx, end_idx);
+        maze_allocator_set(&previous);
+
+        if (NULL != p_path)
+        {
+            maze_free(p_path->p_path);
+            maze_free(p_path);
+        }
+        else if (MAX_NUM_BLOCKS == num_blocks)
+        {
+            printf("No path with %u blocks.\n", num_blocks);
+            ret_val = -1;
+        }
+
+        // Step 2: Map a new maze, which cannot grow once the blocks run out.
+        //
+        maze_chunked_t       map_maze = maze_chunked_create();
+        maze_chunked_point_t origin   = { 0, 0 };
+        maze_idx_t origin_idx = maze_chunked_get_idx(&map_maze, &origin);
+
+        maze_chunked_navigator_t navigator
+            = { origin_idx, origin_idx, MAZE_CHUNKED_NO_CELL, MAZE_NORTH };
+        g_num_blocks_left = num_blocks;
+
+        previous = maze_allocator_set(&limited);
+        dfs_depth_first_search_chunked(
+            &map_maze, &navigator, &explore_current_cell, &move_navigator);
+        maze_allocator_set(&previous);
+
+        maze_chunked_destroy(&map_maze);
+    }
+
+    maze_chunked_destroy(&maze);
+    return ret_val;
+}
+
+// Private function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Converts a point of the test maze to a point relative to the start.
+ *
+ * @param[in] p_point Pointer to the point in the test maze.
+ * @return maze_chunked_point_t Point relative to the start point.
+ */
+static maze_chunked_point_t
+to_chunked_point (const maze_point_t *p_point)
+{
+    maze_chunked_point_t point = { (int16_t)(p_point->x - g_start_point.x),
+                                   (int16_t)(p_point->y - g_start_point.y) };
+    return point;
+}
+
+/**
+ * @brief Loads the test maze into a chunked maze, so that the start cell is at
+ * the origin.
+ *
+ * @param[in,out] p_maze Pointer to the chunked maze.
+ */
+static void
+load_test_maze (maze_chunked_t *p_maze)
+{
+    for (uint16_t row = 0; GRID_ROWS > row; row++)
+    {
+        for (uint16_t col = 0; GRID_COLS > col; col++)
+        {
+            maze_point_t         point         = { col, row };
+            maze_chunked_point_t chunked_point = to_chunked_point(&point);
+            maze_idx_t cell_idx = maze_chunked_add_cell(p_maze, &chunked_point);
+
+            maze_chunked_modify_walls(p_maze,
+                                      cell_idx,
+                                      g_bitmask_array[row * GRID_COLS + col],
+                                      true,
+                                      true);
+        }
+    }
+}
+
+/**
+ * @brief Explores the current cell by returning the walls of the test maze.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to explore.
+ * @return uint16_t Bitmask of the walls, aligned to MAZE_NORTH.
+ */
+static uint16_t
+explore_current_cell (maze_chunked_t           *p_maze,
+                      maze_chunked_navigator_t *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    maze_chunked_point_t point
+        = maze_chunked_get_point(p_maze, p_navigator->current_idx);
+    uint16_t col = (uint16_t)(point.x + g_start_point.x);
+    uint16_t row = (uint16_t)(point.y + g_start_point.y);
+
+    p_navigator->orientation = direction;
+    return MAZE_INVERT_BITMASK(g_bitmask_array[row * GRID_COLS + col]);
+}
+
+/**
+ * @brief Moves the navigator to the next cell.
+ *
+ * @param[in] p_maze Pointer to the chunked maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to move.
+ */
+static void
+move_navigator (maze_chunked_t           *p_maze,
+                maze_chunked_navigator_t *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->orientation = direction;
+    p_navigator->current_idx = maze_chunked_get_next_idx(
+        p_maze, p_navigator->current_idx, direction);
+}
+
+/**
+ * @brief Allocates a block from the heap until the blocks left run out.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] size Size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+alloc_limited (void *p_state, size_t size)
+{
+    (void)p_state;
+
+    if (0 == g_num_blocks_left)
+    {
+        return NULL;
+    }
+
+    g_num_blocks_left--;
+    return malloc(size);
+}
+
+/**
+ * @brief Resizes a block on the heap, which takes one of the blocks left.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ * @param[in] size New size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+realloc_limited (void *p_state, void *p_block, size_t size)
+{
+    (void)p_state;
+
+    if (0 == g_num_blocks_left)
+    {
+        return NULL;
+    }
+
+    g_num_blocks_left--;
+    return realloc(p_block, size);
+}
+
+/**
+ * @brief Frees a block on the heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ */
+static void
+free_limited (void *p_state, void *p_block)
+{
+    (void)p_state;
+    free(p_block);
+}
+
+// End of file tests/chunked_tests.c
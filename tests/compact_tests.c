@@ -0,0 +1,694 @@
+/**
+ * @file compact_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the compact wall-bitmask maze
+ * backend and the algorithms that run on it.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_compact.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/dfs.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS       = 6,  ///< Number of rows in the grid.
+    GRID_COLS       = 4,  ///< Number of columns in the grid.
+    LARGE_GRID_ROWS = 64, ///< Number of rows in the large grid.
+    LARGE_GRID_COLS = 64, ///< Number of columns in the large grid.
+    MAX_NUM_BLOCKS  = 8,  ///< Most blocks that one search allocates at once.
+    NUM_DFS_BLOCKS  = 3   ///< Blocks that the depth first search allocates.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+static uint32_t g_num_blocks_left = 0; // Blocks left to the limited allocator.
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_shared_walls(void);
+static int test_compact_serialisation(void);
+static int test_compact_a_star(void);
+static int test_compact_floodfill(void);
+static int test_compact_dfs(void);
+static int test_compact_large_maze(void);
+static int test_compact_out_of_memory(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint16_t explore_current_cell(maze_compact_t           *p_maze,
+                                     maze_compact_navigator_t *p_navigator,
+                                     maze_cardinal_direction_t direction);
+
+static void move_navigator(maze_compact_t           *p_maze,
+                           maze_compact_navigator_t *p_navigator,
+                           maze_cardinal_direction_t direction);
+
+static bool is_path_valid(const maze_compact_t *p_maze,
+                          const a_star_path_t  *p_path);
+
+static void *alloc_limited(void *p_state, size_t size);
+static void *realloc_limited(void *p_state, void *p_block, size_t size);
+static void  free_limited(void *p_state, void *p_block);
+
+/**
+ * @brief Runs the tests for the compact maze backend.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+compact_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_shared_walls();
+            break;
+        case 2:
+            ret_val = test_compact_serialisation();
+            break;
+        case 3:
+            ret_val = test_compact_a_star();
+            break;
+        case 4:
+            ret_val = test_compact_floodfill();
+            break;
+        case 5:
+            ret_val = test_compact_dfs();
+            break;
+        case 6:
+            ret_val = test_compact_large_maze();
+            break;
+        case 7:
+            ret_val = test_compact_out_of_memory();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that walls are shared between adjacent cells and that the
+ * border cannot be opened.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_shared_walls (void)
+{
+    int            ret_val = 0;
+    maze_compact_t maze    = maze_compact_create(GRID_ROWS, GRID_COLS);
+
+    maze_compact_init_nowall(&maze);
+
+    // The wall east of (0, 0) is the wall west of (1, 0).
+    //
+    maze_compact_set_wall(&maze, 0, MAZE_EAST);
+
+    if (!maze_compact_is_wall(&maze, 1, MAZE_WEST))
+    {
+        printf("Wall is not shared between adjacent cells.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    maze_compact_unset_wall(&maze, 1, MAZE_WEST);
+
+    if (MAZE_COMPACT_NO_CELL == maze_compact_get_next_idx(&maze, 0, MAZE_EAST))
+    {
+        printf("Wall was not unset for both cells.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // The outer border must stay walled.
+    //
+    maze_compact_unset_wall(&maze, 0, MAZE_NORTH);
+
+    if (!maze_compact_is_wall(&maze, 0, MAZE_NORTH))
+    {
+        printf("Border wall was unset.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    maze_point_t point = maze_compact_get_point(&maze, 7);
+
+    if (3 != point.x || 1 != point.y
+        || 7 != maze_compact_get_idx(&maze, &point))
+    {
+        printf("Index 7 maps to (%u, %u).\n", point.x, point.y);
+        ret_val = -1;
+    }
+
+end:
+    maze_compact_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the compact maze serialises to the same bitmask as the
+ * grid maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_serialisation (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_compact_t maze = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t    grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_compact_deserialise(&maze, &gap_bitmask);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_gap_bitmask_t compact_bitmask = maze_compact_serialise(&maze);
+    maze_gap_bitmask_t grid_bitmask    = maze_serialise(&grid);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (compact_bitmask.p_bitmask[idx] != grid_bitmask.p_bitmask[idx]
+            || compact_bitmask.p_bitmask[idx] != g_bitmask_array[idx])
+        {
+            printf("Bitmask at %u is %x when it should be %x.\n",
+                   idx,
+                   compact_bitmask.p_bitmask[idx],
+                   g_bitmask_array[idx]);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    printf("Compact maze uses %u bytes, grid maze uses %u bytes.\n",
+           (unsigned)maze_compact_get_size(&maze),
+           (unsigned)(sizeof(maze_grid_cell_t) * GRID_ROWS * GRID_COLS));
+
+    free(compact_bitmask.p_bitmask);
+    free(grid_bitmask.p_bitmask);
+    maze_compact_destroy(&maze);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that A* on the compact maze finds a path as short as A* on the
+ * grid maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_a_star (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_compact_t maze = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t    grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_compact_deserialise(&maze, &gap_bitmask);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    a_star(&grid, p_start, p_end);
+    a_star_path_t *p_grid_path = a_star_get_path(p_end);
+
+    a_star_path_t *p_path
+        = a_star_compact(&maze,
+                         maze_compact_get_idx(&maze, &g_start_point),
+                         maze_compact_get_idx(&maze, &g_end_point));
+
+    if (NULL == p_path)
+    {
+        printf("Path is NULL.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    if (p_path->length != p_grid_path->length)
+    {
+        printf("Compact path length %u differs from grid path length %u.\n",
+               p_path->length,
+               p_grid_path->length);
+        ret_val = -1;
+        goto end;
+    }
+
+    if (!is_path_valid(&maze, p_path))
+    {
+        ret_val = -1;
+        goto end;
+    }
+
+    char *p_maze_str = a_star_get_path_str(&grid, p_path);
+    printf("%s\n\n", p_maze_str);
+    free(p_maze_str);
+
+end:
+    if (NULL != p_path)
+    {
+        free(p_path->p_path);
+        free(p_path);
+    }
+    free(p_grid_path->p_path);
+    free(p_grid_path);
+    maze_compact_destroy(&maze);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the floodfill algorithm reaches the end cell of the
+ * compact maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_floodfill (void)
+{
+    int            ret_val = 0;
+    maze_compact_t maze    = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_compact_init_nowall(&maze);
+
+    uint16_t start_idx = maze_compact_get_idx(&maze, &g_start_point);
+    uint16_t end_idx   = maze_compact_get_idx(&maze, &g_end_point);
+    maze_compact_navigator_t navigator
+        = { start_idx, start_idx, end_idx, MAZE_NORTH };
+
+    floodfill_map_maze_compact(
+        &maze, &navigator, &explore_current_cell, &move_navigator);
+
+    if (navigator.current_idx != navigator.end_idx)
+    {
+        printf("Navigator did not reach the end cell.\n");
+        ret_val = -1;
+    }
+
+    maze_compact_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the depth first search maps the compact maze correctly.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_dfs (void)
+{
+    int            ret_val = 0;
+    maze_compact_t maze    = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_compact_init_nowall(&maze);
+
+    uint16_t start_idx = maze_compact_get_idx(&maze, &g_start_point);
+    uint16_t end_idx   = maze_compact_get_idx(&maze, &g_end_point);
+    maze_compact_navigator_t navigator
+        = { start_idx, start_idx, end_idx, MAZE_NORTH };
+
+    dfs_depth_first_search_compact(
+        &maze, &navigator, &explore_current_cell, &move_navigator);
+
+    maze_gap_bitmask_t map_bitmask = maze_compact_serialise(&maze);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (map_bitmask.p_bitmask[idx] != g_bitmask_array[idx])
+        {
+            printf("Maze is not correct at %u: %x instead of %x.\n",
+                   idx,
+                   map_bitmask.p_bitmask[idx],
+                   g_bitmask_array[idx]);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    free(map_bitmask.p_bitmask);
+    maze_compact_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a 64x64 compact maze is small and can be searched.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_large_maze (void)
+{
+    int            ret_val = 0;
+    maze_compact_t maze = maze_compact_create(LARGE_GRID_ROWS, LARGE_GRID_COLS);
+    maze_compact_init_nowall(&maze);
+
+    size_t maze_size = maze_compact_get_size(&maze);
+    printf("64x64 compact maze uses %u bytes.\n", (unsigned)maze_size);
+
+    if (2048u < maze_size)
+    {
+        printf("Compact maze is larger than expected.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Build a wall across every other row with a gap at alternating ends, so
+    // that the only path snakes through the whole maze.
+    //
+    for (uint16_t row = 1; LARGE_GRID_ROWS > row; row += 2)
+    {
+        for (uint16_t col = 0; LARGE_GRID_COLS > col; col++)
+        {
+            bool is_gap = (3 == row % 4) ? (0 == col)
+                                         : (LARGE_GRID_COLS - 1 == col);
+            if (!is_gap)
+            {
+                maze_compact_set_wall(
+                    &maze, row * LARGE_GRID_COLS + col, MAZE_NORTH);
+            }
+        }
+    }
+
+    a_star_path_t *p_path = a_star_compact(
+        &maze, 0, (LARGE_GRID_ROWS - 1) * LARGE_GRID_COLS);
+
+    if (NULL == p_path || !is_path_valid(&maze, p_path))
+    {
+        printf("No valid path through the large maze.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    printf("Path length: %u\n", p_path->length);
+    free(p_path->p_path);
+    free(p_path);
+
+end:
+    maze_compact_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the searches on a compact maze stop cleanly when the
+ * allocator fails after a number of blocks, and succeed once there are enough.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_compact_out_of_memory (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_compact_t maze     = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_compact_t map_maze = maze_compact_create(GRID_ROWS, GRID_COLS);
+    maze_compact_deserialise(&maze, &gap_bitmask);
+
+    uint16_t start_idx = maze_compact_get_idx(&maze, &g_start_point);
+    uint16_t end_idx   = maze_compact_get_idx(&maze, &g_end_point);
+
+    maze_allocator_t limited = {
+        .p_alloc   = &alloc_limited,
+        .p_realloc = &realloc_limited,
+        .p_free    = &free_limited,
+        .p_state   = NULL,
+    };
+
+    for (uint32_t num_blocks = 0; MAX_NUM_BLOCKS >= num_blocks; num_blocks++)
+    {
+        // Step 1: Search the maze. The path must be valid if one is returned.
+        //
+        g_num_blocks_left = num_blocks;
+
+        maze_allocator_t previous = maze_allocator_set(&limited);
+        a_star_path_t   *p_path   = a_star_compact(&maze, start_idx, end_idx);
+        maze_allocator_set(&previous);
+
+        if (NULL != p_path)
+        {
+            if (!is_path_valid(&maze, p_path))
+            {
+                ret_val = -1;
+            }
+
+            maze_free(p_path->p_path);
+            maze_free(p_path);
+        }
+        else if (MAX_NUM_BLOCKS == num_blocks)
+        {
+            printf("No path with %u blocks.\n", num_blocks);
+            ret_val = -1;
+        }
+
+        // Step 2: Map the maze with floodfill. The navigator must not move if
+        // the flood arrays could not be allocated.
+        //
+        maze_compact_init_nowall(&map_maze);
+        maze_compact_navigator_t navigator
+            = { start_idx, start_idx, end_idx, MAZE_NORTH };
+        g_num_blocks_left = num_blocks;
+
+        previous       = maze_allocator_set(&limited);
+        bool is_mapped = floodfill_map_maze_compact(
+            &map_maze, &navigator, &explore_current_cell, &move_navigator);
+        maze_allocator_set(&previous);
+
+        if (is_mapped ? (navigator.current_idx != end_idx)
+                      : (navigator.current_idx != start_idx))
+        {
+            printf("Floodfill with %u blocks left the navigator at %u.\n",
+                   num_blocks,
+                   navigator.current_idx);
+            ret_val = -1;
+        }
+
+        // Step 3: Map the maze with the depth first search, which must still
+        // stop when its arrays cannot be allocated. They are allocated once,
+        // so it takes the same number of blocks however many steps it makes.
+        //
+        maze_compact_init_nowall(&map_maze);
+        navigator.current_idx = start_idx;
+        g_num_blocks_left     = num_blocks;
+
+        previous = maze_allocator_set(&limited);
+        dfs_depth_first_search_compact(
+            &map_maze, &navigator, &explore_current_cell, &move_navigator);
+        maze_allocator_set(&previous);
+
+        if (0 == num_blocks && navigator.current_idx != start_idx)
+        {
+            printf("DFS moved the navigator without any blocks.\n");
+            ret_val = -1;
+        }
+
+        if (MAX_NUM_BLOCKS == num_blocks
+            && MAX_NUM_BLOCKS - NUM_DFS_BLOCKS != g_num_blocks_left)
+        {
+            printf("DFS took %u blocks.\n",
+                   MAX_NUM_BLOCKS - g_num_blocks_left);
+            ret_val = -1;
+        }
+    }
+
+    maze_compact_destroy(&map_maze);
+    maze_compact_destroy(&maze);
+    return ret_val;
+}
+
+// Private function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Explores the current cell using the global bitmask array.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to explore in.
+ * @return uint16_t Bitmask of the walls of the current cell.
+ */
+static uint16_t
+explore_current_cell (maze_compact_t           *p_maze,
+                      maze_compact_navigator_t *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    (void)p_maze;
+    p_navigator->orientation = direction;
+    return MAZE_INVERT_BITMASK(g_bitmask_array[p_navigator->current_idx]);
+}
+
+/**
+ * @brief Moves the navigator to the next cell.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to move.
+ */
+static void
+move_navigator (maze_compact_t           *p_maze,
+                maze_compact_navigator_t *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->orientation = direction;
+    p_navigator->current_idx = maze_compact_get_next_idx(
+        p_maze, p_navigator->current_idx, direction);
+}
+
+/**
+ * @brief Checks that every step of a path moves to an adjacent cell without
+ * passing through a wall.
+ *
+ * @param[in] p_maze Pointer to the compact maze.
+ * @param[in] p_path Pointer to the path.
+ * @return true The path is valid.
+ * @return false The path is not valid.
+ */
+static bool
+is_path_valid (const maze_compact_t *p_maze, const a_star_path_t *p_path)
+{
+    for (uint32_t idx = 1; p_path->length > idx; idx++)
+    {
+        maze_cardinal_direction_t direction
+            = maze_get_dir_from_to(&p_path->p_path[idx - 1].coordinates,
+                                   &p_path->p_path[idx].coordinates);
+        uint16_t cell_idx = maze_compact_get_idx(
+            p_maze, &p_path->p_path[idx - 1].coordinates);
+
+        if (MAZE_NONE == direction
+            || maze_compact_is_wall(p_maze, cell_idx, direction))
+        {
+            printf("Path is invalid at step %u.\n", idx);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Allocates a block from the heap until the blocks left run out.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] size Size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+alloc_limited (void *p_state, size_t size)
+{
+    (void)p_state;
+
+    if (0 == g_num_blocks_left)
+    {
+        return NULL;
+    }
+
+    g_num_blocks_left--;
+    return malloc(size);
+}
+
+/**
+ * @brief Resizes a block on the heap, which takes one of the blocks left.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ * @param[in] size New size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+realloc_limited (void *p_state, void *p_block, size_t size)
+{
+    (void)p_state;
+
+    if (0 == g_num_blocks_left)
+    {
+        return NULL;
+    }
+
+    g_num_blocks_left--;
+    return realloc(p_block, size);
+}
+
+/**
+ * @brief Frees a block on the heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ */
+static void
+free_limited (void *p_state, void *p_block)
+{
+    (void)p_state;
+    free(p_block);
+}
+
+// End of file tests/compact_tests.c
@@ -0,0 +1,350 @@
+/**
+ * @file d_star_lite_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the D* Lite incremental planner.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "pathfinding/d_star_lite.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS        = 5,    ///< Number of rows in the test maze.
+    GRID_COLS        = 5,    ///< Number of columns in the test maze.
+    OPEN_GRID_SIZE   = 16,   ///< Side of the grid that walls are added to.
+    NUM_WALL_UPDATES = 150,  ///< Number of wall changes in the replan test.
+    WALL_SEED        = 2004  ///< Seed of the wall changes.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_map_maze(void);
+static int test_replan(void);
+static int test_unreachable(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint16_t explore_current_node(maze_grid_t              *p_grid,
+                                     maze_navigator_state_t   *p_navigator,
+                                     maze_cardinal_direction_t direction);
+static void     move_navigator(maze_navigator_state_t   *p_navigator,
+                               maze_cardinal_direction_t direction);
+
+/**
+ * @brief Runs the tests for the D* Lite planner.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+d_star_lite_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(WALL_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_map_maze();
+            break;
+        case 2:
+            ret_val = test_replan();
+            break;
+        case 3:
+            ret_val = test_unreachable();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that a mapping run with D* Lite reaches the end node, and that
+ * the mapped maze agrees with the true maze along the way.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_map_maze (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(GRID_ROWS, GRID_COLS);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 4, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+    maze_navigator_state_t navigator = { p_start, p_start, p_end, MAZE_NORTH };
+
+    d_star_lite_map_maze(
+        &maze, p_end, &navigator, &explore_current_node, &move_navigator);
+
+    if (navigator.p_current_node != p_end)
+    {
+        printf("Navigator stopped at (%u, %u).\n",
+               navigator.p_current_node->coordinates.x,
+               navigator.p_current_node->coordinates.y);
+        ret_val = -1;
+    }
+
+    char *p_maze_str = maze_get_string(&maze);
+    maze_insert_nav_str(&maze, &navigator, p_maze_str);
+    printf("%s\n\n", p_maze_str);
+    free(p_maze_str);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that after walls are added and the navigator moves, the
+ * repaired distance is the breadth-first distance, and that repairs expand
+ * fewer nodes than planning from scratch.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_replan (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(OPEN_GRID_SIZE, OPEN_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_point_t      start_point = { 0, OPEN_GRID_SIZE - 1 };
+    maze_point_t      end_point   = { OPEN_GRID_SIZE - 1, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    d_star_lite_t planner = d_star_lite_create(&maze, p_start, p_end);
+    d_star_lite_plan(&planner);
+    uint32_t first_expanded = planner.num_expanded;
+    uint32_t repair_expanded = 0;
+
+    for (uint32_t update = 0; NUM_WALL_UPDATES > update; update++)
+    {
+        // Step 1: Wall off the way towards the end node from a random node,
+        // so that distances change, and sometimes move the navigator along
+        // its plan.
+        //
+        maze_grid_cell_t *p_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_end, MAZE_NORTH };
+        uint8_t  wall_bitmask = 1u << (get_random() % 4);
+        uint32_t min_g        = UINT32_MAX;
+
+        for (uint8_t i = 0; 4 > i; i++)
+        {
+            if (NULL == p_node->p_next[i])
+            {
+                continue;
+            }
+
+            maze_idx_t neighbour_idx
+                = maze_get_cell_idx(&maze, p_node->p_next[i]);
+
+            if (planner.p_g[neighbour_idx] < min_g)
+            {
+                min_g        = planner.p_g[neighbour_idx];
+                wall_bitmask = 1u << i;
+            }
+        }
+
+        maze_nav_modify_walls(&maze, &wall_setter, wall_bitmask, true, false);
+        d_star_lite_update_walls(&planner, p_node);
+
+        bool is_reachable = d_star_lite_plan(&planner);
+        repair_expanded += planner.num_expanded;
+
+        maze_cardinal_direction_t direction
+            = d_star_lite_get_next_dir(&planner);
+
+        if (is_reachable && MAZE_NONE != direction && 0 == update % 4)
+        {
+            p_start = p_start->p_next[direction];
+            d_star_lite_move(&planner, p_start);
+            is_reachable = d_star_lite_plan(&planner);
+            repair_expanded += planner.num_expanded;
+        }
+
+        // Step 2: Check the distance against a breadth-first search.
+        //
+        uint32_t expected = get_bfs_dist(&maze, p_start, p_end);
+        uint32_t actual   = planner.p_g[maze_get_cell_idx(&maze, p_start)];
+
+        if (expected != actual || is_reachable != (UINT32_MAX != expected))
+        {
+            printf("Update %u: distance is %u when it should be %u.\n",
+                   update,
+                   actual,
+                   expected);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    printf("First plan expanded %u nodes, and %u repairs expanded %u.\n",
+           first_expanded,
+           NUM_WALL_UPDATES,
+           repair_expanded);
+
+    if (0 == ret_val && repair_expanded >= first_expanded * NUM_WALL_UPDATES)
+    {
+        printf("Repairs expanded as many nodes as planning from scratch.\n");
+        ret_val = -1;
+    }
+
+    d_star_lite_destroy(&planner);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the planner reports an end node that has been walled off.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_unreachable (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(GRID_ROWS, GRID_COLS);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 2, 2 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    d_star_lite_t planner = d_star_lite_create(&maze, p_start, p_end);
+
+    if (!d_star_lite_plan(&planner))
+    {
+        printf("End node is unreachable before it is walled off.\n");
+        ret_val = -1;
+    }
+
+    maze_navigator_state_t wall_setter = { p_end, p_end, p_end, MAZE_NORTH };
+    maze_nav_modify_walls(&maze, &wall_setter, 0xF, true, false);
+    d_star_lite_update_walls(&planner, p_end);
+
+    if (d_star_lite_plan(&planner)
+        || MAZE_NONE != d_star_lite_get_next_dir(&planner))
+    {
+        printf("End node is reachable after it is walled off.\n");
+        ret_val = -1;
+    }
+
+    d_star_lite_destroy(&planner);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Explores the current node using the global bitmask array.
+ *
+ * @param[in,out] p_grid Pointer to the maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to explore in.
+ * @return uint16_t Bitmask of the walls of the current node.
+ */
+static uint16_t
+explore_current_node (maze_grid_t              *p_grid,
+                      maze_navigator_state_t   *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    maze_grid_cell_t *p_current_node = p_navigator->p_current_node;
+    uint8_t           bitmask        = MAZE_INVERT_BITMASK(
+        g_bitmask_array[p_current_node->coordinates.y * GRID_COLS
+                        + p_current_node->coordinates.x]);
+
+    p_navigator->orientation = direction;
+    maze_nav_modify_walls(p_grid, p_navigator, bitmask, true, false);
+    return bitmask;
+}
+
+/**
+ * @brief Moves the navigator to the next node.
+ *
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to move.
+ */
+static void
+move_navigator (maze_navigator_state_t   *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->p_current_node
+        = p_navigator->p_current_node->p_next[direction];
+    p_navigator->orientation = direction;
+}
+
+// End of d_star_lite_tests.c
@@ -42,8 +42,9 @@
  */
 typedef enum
 {
-    GRID_ROWS = 5, ///< Number of rows in the grid.
-    GRID_COLS = 5  ///< Number of columns in the grid.
+    GRID_ROWS  = 5,  ///< Number of rows in the grid.
+    GRID_COLS  = 5,  ///< Number of columns in the grid.
+    LARGE_SIDE = 300 ///< Rows and columns of the large serpentine maze.
 } constants_t;
 
 // Global variables.
@@ -69,12 +70,32 @@ static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
 volatile maze_grid_t g_true_grid
     = { .p_grid_array = NULL, .rows = GRID_ROWS, .columns = GRID_COLS };
 
+/**
+ * @brief Global true grid of the large map test.
+ *
+ */
+static maze_grid_t g_large_grid;
+
+/**
+ * @brief Number of moves of the navigator in the large map test.
+ *
+ */
+static uint32_t g_num_moves;
+
+/**
+ * @brief Set when the navigator of the large map test walks into a wall or
+ * runs out of moves.
+ *
+ */
+static bool g_is_lost;
+
 // Test function prototypes.
 // ----------------------------------------------------------------------------
 //
 
 static int test_initialise_empty_maze_nowall(void);
 static int test_floodfill(void);
+static int test_floodfill_large_map(void);
 
 /**
  * @brief Runs the tests for the floodfill algorithm.
@@ -110,6 +131,9 @@ floodfill_tests (int argc, char *argv[])
         case 2:
             ret_val = test_floodfill();
             break;
+        case 3:
+            ret_val = test_floodfill_large_map();
+            break;
         default:
             printf("Invalid choice. Terminating.\n");
             ret_val = -1;
@@ -228,4 +252,164 @@ test_floodfill (void)
     return 0;
 }
 
+/**
+ * @brief Explores the current node by copying its walls from the large true
+ * grid, without printing the maze.
+ *
+ * @param p_grid Pointer to the maze.
+ * @param p_navigator Pointer to the navigator.
+ * @param direction Cardinal direction to explore.
+ * @return uint16_t Bitmask of the walls.
+ */
+static uint16_t
+explore_large_node (maze_grid_t              *p_grid,
+                    maze_navigator_state_t   *p_navigator,
+                    maze_cardinal_direction_t direction)
+{
+    const maze_grid_cell_t *p_true_node = &g_large_grid.p_grid_array
+                              [maze_get_cell_idx(p_grid,
+                                                 p_navigator->p_current_node)];
+    uint8_t bitmask = 0;
+
+    for (uint8_t i = 0; 4 > i; i++)
+    {
+        if (NULL == p_true_node->p_next[i])
+        {
+            bitmask |= 1u << i;
+        }
+    }
+
+    p_navigator->orientation = direction;
+    maze_nav_modify_walls(p_grid, p_navigator, bitmask, true, false);
+
+    return bitmask;
+}
+
+/**
+ * @brief Moves the navigator to the next node and counts the move. If a wall
+ * is in the way, or the navigator has moved twice as often as there are cells,
+ * it is lost and put on the end node to stop the run.
+ *
+ * @param p_navigator Pointer to the navigator.
+ * @param direction Cardinal direction to move.
+ */
+static void
+move_large_navigator (maze_navigator_state_t   *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    maze_grid_cell_t *p_next = p_navigator->p_current_node->p_next[direction];
+
+    g_num_moves++;
+
+    if (NULL == p_next || 2u * LARGE_SIDE * LARGE_SIDE < g_num_moves)
+    {
+        g_is_lost = true;
+        p_next    = p_navigator->p_end_node;
+    }
+
+    p_navigator->p_current_node = p_next;
+    p_navigator->orientation    = direction;
+}
+
+/**
+ * @brief Tests the floodfill algorithm on a serpentine maze whose goal is more
+ * than UINT16_MAX steps from the start, so its distances do not fit in 16
+ * bits. Only runs when the library is built with 32-bit cell indices.
+ *
+ * @return int 0 if successful, -1 otherwise.
+ */
+static int
+test_floodfill_large_map (void)
+{
+#if 32 == MAZE_IDX_WIDTH
+    int ret_val = 0;
+
+    // Step 1: Build the serpentine maze. Every row is open from end to end,
+    // and each row joins the next one at alternating ends.
+    //
+    uint32_t           num_cells   = (uint32_t)LARGE_SIDE * LARGE_SIDE;
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = calloc(num_cells, sizeof(uint16_t)),
+        .rows      = LARGE_SIDE,
+        .columns   = LARGE_SIDE,
+    };
+
+    g_large_grid = maze_create(LARGE_SIDE, LARGE_SIDE);
+
+    for (uint32_t row = 0; LARGE_SIDE > row; row++)
+    {
+        uint32_t link_col = (0 == row % 2) ? LARGE_SIDE - 1 : 0;
+
+        for (uint32_t col = 0; LARGE_SIDE > col; col++)
+        {
+            uint16_t *p_gaps = &gap_bitmask.p_bitmask[row * LARGE_SIDE + col];
+
+            if (0 < col)
+            {
+                *p_gaps |= 1u << MAZE_WEST;
+            }
+
+            if (LARGE_SIDE - 1 > col)
+            {
+                *p_gaps |= 1u << MAZE_EAST;
+            }
+
+            if (LARGE_SIDE - 1 > row && link_col == col)
+            {
+                *p_gaps |= 1u << MAZE_SOUTH;
+            }
+
+            if (0 < row && (LARGE_SIDE - 1 - link_col) == col)
+            {
+                *p_gaps |= 1u << MAZE_NORTH;
+            }
+        }
+    }
+
+    maze_deserialise(&g_large_grid, &gap_bitmask);
+
+    // Step 2: Map the maze from the first cell of the serpentine to its last
+    // cell, which is 89999 steps away.
+    //
+    maze_grid_t maze = maze_create(LARGE_SIDE, LARGE_SIDE);
+    floodfill_init_maze_nowall(&maze);
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t start_point = { 0, 0 };
+    maze_point_t end_point   = { 0, LARGE_SIDE - 1 };
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+    maze_navigator_state_t navigator = { p_start, p_start, p_end, MAZE_NORTH };
+
+    g_num_moves = 0;
+    g_is_lost   = false;
+
+    bool is_reached = floodfill_map_maze(&maze,
+                                         p_end,
+                                         &navigator,
+                                         &explore_large_node,
+                                         &move_large_navigator);
+
+    // Step 3: Every move must follow a gap, and the navigator must not wander
+    // much further than the length of the serpentine.
+    //
+    if (!is_reached || g_is_lost || p_end != navigator.p_current_node)
+    {
+        printf("The navigator got lost after %u moves.\n",
+               (unsigned)g_num_moves);
+        ret_val = -1;
+    }
+
+    free(gap_bitmask.p_bitmask);
+    maze_destroy(&maze);
+    maze_destroy(&g_large_grid);
+
+    return ret_val;
+#else
+    printf("Skipped, MAZE_IDX_WIDTH is %d.\n", MAZE_IDX_WIDTH);
+    return 0;
+#endif
+}
+
 // End of file tests/floodfill_tests.c
@@ -0,0 +1,522 @@
+/**
+ * @file maze_dist_cache_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the cache of goal distance fields.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "pathfinding/maze_dist_cache.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS        = 5,   ///< Number of rows in the test maze.
+    GRID_COLS        = 5,   ///< Number of columns in the test maze.
+    UPDATE_GRID_SIZE = 16,  ///< Side of the grid that walls are changed in.
+    NUM_GOALS        = 3,   ///< Number of goals kept while walls change.
+    NUM_WALL_UPDATES = 400, ///< Number of wall changes in the repair test.
+    MAX_TEST_COST    = 9,   ///< Highest cell cost in the weighted test.
+    DIST_CACHE_SEED  = 2022 ///< Seed of the wall changes.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_flood_field(void);
+static int test_repair_field(void);
+static int test_evict_field(void);
+static int test_repair_weighted_field(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static bool     is_field_exact(const maze_grid_t       *p_grid,
+                               const maze_dist_field_t *p_field);
+
+/**
+ * @brief Runs the tests for the cache of distance fields.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+maze_dist_cache_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(DIST_CACHE_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_flood_field();
+            break;
+        case 2:
+            ret_val = test_repair_field();
+            break;
+        case 3:
+            ret_val = test_evict_field();
+            break;
+        case 4:
+            ret_val = test_repair_weighted_field();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that the field of a goal in the test maze holds the
+ * breadth-first distance to every cell, and that following its best moves
+ * gives a shortest path.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_flood_field (void)
+{
+    int                ret_val     = 0;
+    maze_grid_t        maze        = maze_create(GRID_ROWS, GRID_COLS);
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = (uint16_t *)g_bitmask_array,
+        .rows      = GRID_ROWS,
+        .columns   = GRID_COLS,
+    };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 4, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    maze_dist_cache_t        cache   = maze_dist_cache_create(&maze, 1);
+    const maze_dist_field_t *p_field = maze_dist_cache_get(&cache, p_end);
+
+    // Step 1: Check the distances and the best move at the goal.
+    //
+    if (!is_field_exact(&maze, p_field))
+    {
+        ret_val = -1;
+    }
+
+    if (MAZE_NONE != maze_dist_cache_get_next_dir(&cache, p_field, p_end))
+    {
+        printf("The goal has a next move.\n");
+        ret_val = -1;
+    }
+
+    // Step 2: Check that the path is as short as the one A* finds, and that
+    // each of its cells leads into the next.
+    //
+    a_star_path_t *p_path
+        = maze_dist_cache_get_path(&cache, p_field, p_start);
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&maze));
+    a_star_ctx(&maze, &context, p_start, p_end);
+    a_star_path_t *p_expected = a_star_ctx_get_path(&maze, &context, p_end);
+
+    if (NULL == p_path || p_expected->length != p_path->length)
+    {
+        printf("Path of length %u, expected %u.\n",
+               (NULL == p_path) ? 0 : p_path->length,
+               p_expected->length);
+        ret_val = -1;
+    }
+    else
+    {
+        for (uint32_t index = 1; p_path->length > index; index++)
+        {
+            maze_point_t *p_from = &p_path->p_path[index - 1].coordinates;
+            maze_point_t *p_to   = &p_path->p_path[index].coordinates;
+
+            if (1 != maze_manhattan_dist(p_from, p_to))
+            {
+                printf("Path jumps from (%u, %u) to (%u, %u).\n",
+                       p_from->x,
+                       p_from->y,
+                       p_to->x,
+                       p_to->y);
+                ret_val = -1;
+            }
+        }
+
+        if (p_path->p_path[p_path->length - 1].coordinates.x != end_point.x
+            || p_path->p_path[p_path->length - 1].coordinates.y
+                   != end_point.y)
+        {
+            printf("Path does not end at the goal.\n");
+            ret_val = -1;
+        }
+
+        free(p_path->p_path);
+        free(p_path);
+    }
+
+    free(p_expected->p_path);
+    free(p_expected);
+    search_context_destroy(&context);
+    maze_dist_cache_destroy(&cache);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that repaired fields match a fresh flood after walls are added
+ * and removed, without flooding any field again.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_repair_field (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(UPDATE_GRID_SIZE, UPDATE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_dist_cache_t cache = maze_dist_cache_create(&maze, NUM_GOALS);
+    maze_grid_cell_t *p_goals[NUM_GOALS];
+
+    for (uint8_t goal = 0; NUM_GOALS > goal; goal++)
+    {
+        p_goals[goal]
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_dist_cache_get(&cache, p_goals[goal]);
+    }
+
+    for (uint32_t update = 0; NUM_WALL_UPDATES > update && 0 == ret_val;
+         update++)
+    {
+        // Step 1: Add a wall, or every so often remove one, and repair the
+        // fields.
+        //
+        maze_grid_cell_t *p_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+        bool is_set = 0 != get_random() % 3;
+
+        maze_nav_modify_walls(
+            &maze, &wall_setter, 1u << (get_random() % 4), is_set, !is_set);
+        maze_dist_cache_update_walls(&cache, p_node);
+
+        // Step 2: Check every field.
+        //
+        for (uint8_t goal = 0; NUM_GOALS > goal; goal++)
+        {
+            if (!is_field_exact(&maze,
+                                maze_dist_cache_get(&cache, p_goals[goal])))
+            {
+                printf("Field %u is wrong after update %u.\n", goal, update);
+                ret_val = -1;
+                break;
+            }
+        }
+    }
+
+    if (NUM_GOALS != cache.num_floods)
+    {
+        printf("Fields were flooded %u times, expected %u.\n",
+               cache.num_floods,
+               NUM_GOALS);
+        ret_val = -1;
+    }
+
+    maze_dist_cache_destroy(&cache);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the least recently used field is evicted for a new goal,
+ * and that invalidated fields are flooded again.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_evict_field (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(UPDATE_GRID_SIZE, UPDATE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_dist_cache_t cache = maze_dist_cache_create(&maze, 2);
+    maze_grid_cell_t *p_a   = &maze.p_grid_array[0];
+    maze_grid_cell_t *p_b   = &maze.p_grid_array[1];
+    maze_grid_cell_t *p_c   = &maze.p_grid_array[2];
+
+    // Goals got in order, and the number of floods expected after each. C
+    // evicts B, which was used less recently than A, and the invalidation
+    // makes A stale.
+    //
+    maze_grid_cell_t *p_order[] = { p_a, p_b, p_a, p_c, p_a, p_b, NULL, p_b };
+    uint32_t          expected_floods[] = { 1, 2, 2, 3, 3, 4, 4, 5 };
+
+    for (uint8_t step = 0; sizeof(p_order) / sizeof(p_order[0]) > step;
+         step++)
+    {
+        if (NULL == p_order[step])
+        {
+            maze_dist_cache_invalidate(&cache);
+        }
+        else if (!is_field_exact(&maze,
+                                 maze_dist_cache_get(&cache, p_order[step])))
+        {
+            ret_val = -1;
+        }
+
+        if (expected_floods[step] != cache.num_floods)
+        {
+            printf("%u floods after step %u, expected %u.\n",
+                   cache.num_floods,
+                   step,
+                   expected_floods[step]);
+            ret_val = -1;
+        }
+    }
+
+    maze_dist_cache_destroy(&cache);
+
+    if (NULL != maze_dist_cache_get(&cache, p_a))
+    {
+        printf("A destroyed cache gives a field.\n");
+        ret_val = -1;
+    }
+
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the fields stay exact on a maze with cell costs while
+ * walls and costs change, without any field being flooded again.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_repair_weighted_field (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(UPDATE_GRID_SIZE, UPDATE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    for (size_t cell_idx = 0; MAZE_GRID_CELLS(&maze) > cell_idx; cell_idx++)
+    {
+        maze_set_cell_cost(&maze,
+                           &maze.p_grid_array[cell_idx],
+                           1 + get_random() % MAX_TEST_COST);
+    }
+
+    maze_dist_cache_t cache = maze_dist_cache_create(&maze, NUM_GOALS);
+    maze_grid_cell_t *p_goals[NUM_GOALS];
+
+    for (uint8_t goal = 0; NUM_GOALS > goal; goal++)
+    {
+        p_goals[goal]
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+        if (!is_field_exact(&maze, maze_dist_cache_get(&cache, p_goals[goal])))
+        {
+            printf("Field %u is wrong after flooding.\n", goal);
+            ret_val = -1;
+        }
+    }
+
+    for (uint32_t update = 0; NUM_WALL_UPDATES > update && 0 == ret_val;
+         update++)
+    {
+        // Step 1: Change the cost of a node, or add or remove a wall, and
+        // repair the fields.
+        //
+        maze_grid_cell_t *p_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+        bool is_set = 0 != get_random() % 3;
+
+        if (0 == update % 2)
+        {
+            maze_set_cell_cost(&maze, p_node, 1 + get_random() % MAX_TEST_COST);
+        }
+        else
+        {
+            maze_nav_modify_walls(
+                &maze, &wall_setter, 1u << (get_random() % 4), is_set, !is_set);
+        }
+
+        maze_dist_cache_update_walls(&cache, p_node);
+
+        // Step 2: Check every field.
+        //
+        for (uint8_t goal = 0; NUM_GOALS > goal; goal++)
+        {
+            if (!is_field_exact(&maze,
+                                maze_dist_cache_get(&cache, p_goals[goal])))
+            {
+                printf("Field %u is wrong after update %u.\n", goal, update);
+                ret_val = -1;
+                break;
+            }
+        }
+    }
+
+    if (NUM_GOALS != cache.num_floods)
+    {
+        printf("Fields were flooded %u times, expected %u.\n",
+               cache.num_floods,
+               NUM_GOALS);
+        ret_val = -1;
+    }
+
+    maze_dist_cache_destroy(&cache);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Checks that a field holds the cost of the cheapest path from every
+ * cell to its goal, or unreachable. The costs are lowered through the
+ * neighbours of each cell until none changes.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_field Pointer to the field.
+ * @return true If every distance is exact.
+ * @return false Otherwise.
+ */
+static bool
+is_field_exact (const maze_grid_t *p_grid, const maze_dist_field_t *p_field)
+{
+    size_t    num_cells  = MAZE_GRID_CELLS(p_grid);
+    uint32_t *p_dist     = malloc(sizeof(uint32_t) * num_cells);
+    bool      is_changed = true;
+    bool      is_exact   = true;
+
+    for (size_t idx = 0; num_cells > idx; idx++)
+    {
+        p_dist[idx] = UINT32_MAX;
+    }
+
+    p_dist[p_field->goal_idx] = 0;
+
+    while (is_changed)
+    {
+        is_changed = false;
+
+        for (size_t idx = 0; num_cells > idx; idx++)
+        {
+            const maze_grid_cell_t *p_cell = &p_grid->p_grid_array[idx];
+
+            // Moving from a neighbour into this cell costs this cell's cost.
+            //
+            for (uint8_t direction = 0;
+                 UINT32_MAX != p_dist[idx] && 4 > direction;
+                 direction++)
+            {
+                const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+                if (NULL == p_next)
+                {
+                    continue;
+                }
+
+                maze_idx_t next_idx = maze_get_cell_idx(p_grid, p_next);
+                uint32_t   dist = p_dist[idx] + MAZE_CELL_COST(p_grid, idx);
+
+                if (dist < p_dist[next_idx])
+                {
+                    p_dist[next_idx] = dist;
+                    is_changed       = true;
+                }
+            }
+        }
+    }
+
+    for (size_t idx = 0; num_cells > idx && is_exact; idx++)
+    {
+        maze_dist_t stored = p_field->p_dists[idx];
+
+        if ((UINT32_MAX == p_dist[idx]
+             && MAZE_DIST_CACHE_UNREACHABLE != stored)
+            || (UINT32_MAX != p_dist[idx] && p_dist[idx] != stored))
+        {
+            printf("Cell %u is %u from the goal, not %u.\n",
+                   (unsigned)idx,
+                   (unsigned)stored,
+                   p_dist[idx]);
+            is_exact = false;
+        }
+    }
+
+    free(p_dist);
+
+    return is_exact;
+}
+
+// End of maze_dist_cache_tests.c
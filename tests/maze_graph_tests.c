@@ -0,0 +1,528 @@
+/**
+ * @file maze_graph_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the junction graph of a grid maze.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "pathfinding/maze_graph.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS        = 5,    ///< Number of rows in the test maze.
+    GRID_COLS        = 5,    ///< Number of columns in the test maze.
+    NUM_RANDOM_MAZES = 300,  ///< Number of random mazes in the path test.
+    MAX_RANDOM_SIZE  = 24,   ///< Largest side of the random mazes.
+    NUM_QUERIES      = 8,    ///< Number of paths found in each random maze.
+    UPDATE_GRID_SIZE = 16,   ///< Side of the grid that walls are changed in.
+    NUM_WALL_UPDATES = 400,  ///< Number of wall changes in the update test.
+    GRAPH_SEED       = 2004  ///< Seed of the random mazes and wall changes.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_build_graph(void);
+static int test_find_path(void);
+static int test_update_walls(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static bool     is_graph_valid(const maze_graph_t *p_graph);
+static int      check_path(maze_grid_t        *p_grid,
+                           const maze_graph_t *p_graph,
+                           maze_grid_cell_t   *p_start_node,
+                           maze_grid_cell_t   *p_end_node);
+
+/**
+ * @brief Runs the tests for the junction graph.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+maze_graph_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(GRAPH_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_build_graph();
+            break;
+        case 2:
+            ret_val = test_find_path();
+            break;
+        case 3:
+            ret_val = test_update_walls();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that the graph of the test maze covers every gap once, and that
+ * the turns stored on the edges are the turns along the corridors.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_build_graph (void)
+{
+    int                ret_val     = 0;
+    maze_grid_t        maze        = maze_create(GRID_ROWS, GRID_COLS);
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_graph_t graph = maze_graph_create(&maze);
+
+    if (!is_graph_valid(&graph))
+    {
+        ret_val = -1;
+    }
+
+    // A corridor cell turns if its two gaps are not opposite each other.
+    //
+    uint32_t expected_turns = 0;
+    uint32_t actual_turns   = 0;
+
+    for (maze_idx_t cell_idx = 0; GRID_ROWS * GRID_COLS > cell_idx; cell_idx++)
+    {
+        const maze_grid_cell_t *p_cell = &maze.p_grid_array[cell_idx];
+
+        if (!graph.p_is_node[cell_idx]
+            && (NULL == p_cell->p_next[MAZE_NORTH]
+                || NULL == p_cell->p_next[MAZE_SOUTH])
+            && (NULL == p_cell->p_next[MAZE_EAST]
+                || NULL == p_cell->p_next[MAZE_WEST]))
+        {
+            expected_turns++;
+        }
+    }
+
+    for (maze_idx_t cell_idx = 0; GRID_ROWS * GRID_COLS > cell_idx; cell_idx++)
+    {
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t edge_idx = graph.p_node_edges[cell_idx * 4u + direction];
+
+            if (MAZE_GRAPH_NO_EDGE != edge_idx
+                && cell_idx == graph.p_edges[edge_idx].from_idx
+                && direction == graph.p_edges[edge_idx].from_dir)
+            {
+                actual_turns += graph.p_edges[edge_idx].num_turns;
+            }
+        }
+    }
+
+    printf("%u nodes, %u edges, %u turns.\n",
+           graph.num_nodes,
+           graph.num_edges,
+           actual_turns);
+
+    if (expected_turns != actual_turns)
+    {
+        printf("Edges have %u turns when they should have %u.\n",
+               actual_turns,
+               expected_turns);
+        ret_val = -1;
+    }
+
+    maze_point_t start_point = { 0, 4 };
+    maze_point_t end_point   = { 4, 0 };
+
+    if (0 != check_path(&maze,
+                        &graph,
+                        maze_get_cell_at_coords(&maze, &start_point),
+                        maze_get_cell_at_coords(&maze, &end_point)))
+    {
+        ret_val = -1;
+    }
+
+    maze_graph_destroy(&graph);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the paths found on the graph of random mazes are valid
+ * and as short as the breadth-first distance, between nodes that are anywhere
+ * along the corridors.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_find_path (void)
+{
+    int      ret_val     = 0;
+    uint64_t total_cells = 0;
+    uint64_t total_nodes = 0;
+
+    for (uint32_t maze_num = 0; NUM_RANDOM_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Add walls to an open grid until most of it is corridors.
+        //
+        uint16_t    rows = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        uint16_t    cols = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        maze_grid_t maze = maze_create(rows, cols);
+        floodfill_init_maze_nowall(&maze);
+
+        for (uint32_t wall = 0; (uint32_t)rows * cols * 3 / 2 > wall; wall++)
+        {
+            maze_grid_cell_t *p_node
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+            maze_navigator_state_t wall_setter
+                = { p_node, p_node, p_node, MAZE_NORTH };
+            maze_nav_modify_walls(
+                &maze, &wall_setter, 1u << (get_random() % 4), true, false);
+        }
+
+        maze_graph_t graph = maze_graph_create(&maze);
+        total_cells += MAZE_GRID_CELLS(&maze);
+        total_nodes += graph.num_nodes;
+
+        if (!is_graph_valid(&graph))
+        {
+            ret_val = -1;
+        }
+
+        // Step 2: Find paths between random nodes.
+        //
+        for (uint8_t query = 0; NUM_QUERIES > query && 0 == ret_val; query++)
+        {
+            maze_grid_cell_t *p_start
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+            maze_grid_cell_t *p_end
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+            ret_val = check_path(&maze, &graph, p_start, p_end);
+        }
+
+        maze_graph_destroy(&graph);
+        maze_destroy(&maze);
+    }
+
+    printf("The graphs have %llu nodes for %llu cells.\n",
+           (unsigned long long)total_nodes,
+           (unsigned long long)total_cells);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a graph repaired after each wall change stays valid, and
+ * that its paths are as short as the breadth-first distance.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_update_walls (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(UPDATE_GRID_SIZE, UPDATE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    maze_graph_t graph = maze_graph_create(&maze);
+
+    for (uint32_t update = 0; NUM_WALL_UPDATES > update && 0 == ret_val;
+         update++)
+    {
+        // Step 1: Add a wall, or every so often remove one.
+        //
+        maze_grid_cell_t *p_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+        bool is_set = 0 != get_random() % 4;
+
+        maze_nav_modify_walls(
+            &maze, &wall_setter, 1u << (get_random() % 4), is_set, !is_set);
+        maze_graph_update_walls(&graph, p_node);
+
+        // Step 2: Check the repaired graph, and a path through it.
+        //
+        if (!is_graph_valid(&graph))
+        {
+            printf("Graph is invalid after update %u.\n", update);
+            ret_val = -1;
+            break;
+        }
+
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_grid_cell_t *p_end
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+        ret_val = check_path(&maze, &graph, p_start, p_end);
+    }
+
+    // Step 3: Compare the size of the repaired graph with a graph built from
+    // scratch. The repaired graph may keep the node of a loop that was cut.
+    //
+    maze_graph_t fresh_graph = maze_graph_create(&maze);
+    printf("Repaired graph has %u nodes and %u edges, a new one has %u and "
+           "%u.\n",
+           graph.num_nodes,
+           graph.num_edges,
+           fresh_graph.num_nodes,
+           fresh_graph.num_edges);
+
+    maze_graph_destroy(&fresh_graph);
+    maze_graph_destroy(&graph);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Checks that every gap of the maze lies on exactly one edge, and that
+ * every corridor cell is on the edge that it points to.
+ *
+ * @param[in] p_graph Pointer to the graph.
+ * @return true If the graph is valid.
+ * @return false Otherwise.
+ */
+static bool
+is_graph_valid (const maze_graph_t *p_graph)
+{
+    const maze_grid_t *p_grid       = p_graph->p_grid;
+    maze_idx_t         num_cells    = (maze_idx_t)MAZE_GRID_CELLS(p_grid);
+    uint32_t           num_gaps     = 0;
+    uint32_t           total_length = 0;
+    maze_idx_t         num_edges    = 0;
+
+    for (maze_idx_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        const maze_grid_cell_t *p_cell = &p_grid->p_grid_array[cell_idx];
+        uint8_t                 gaps   = 0;
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            gaps += NULL != p_cell->p_next[direction];
+        }
+
+        num_gaps += gaps;
+
+        if (!p_graph->p_is_node[cell_idx]
+            && (2 != gaps
+                || MAZE_GRAPH_NO_EDGE == p_graph->p_cell_edges[cell_idx]))
+        {
+            printf("Cell (%u, %u) is not on an edge.\n",
+                   p_cell->coordinates.x,
+                   p_cell->coordinates.y);
+            return false;
+        }
+
+        if (!p_graph->p_is_node[cell_idx])
+        {
+            continue;
+        }
+
+        // Each gap of a node leaves on an edge that starts or ends there.
+        //
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            maze_idx_t edge_idx
+                = p_graph->p_node_edges[cell_idx * 4u + direction];
+
+            if ((NULL == p_cell->p_next[direction])
+                != (MAZE_GRAPH_NO_EDGE == edge_idx))
+            {
+                printf("Node (%u, %u) has the wrong edges.\n",
+                       p_cell->coordinates.x,
+                       p_cell->coordinates.y);
+                return false;
+            }
+
+            if (MAZE_GRAPH_NO_EDGE == edge_idx)
+            {
+                continue;
+            }
+
+            const maze_graph_edge_t *p_edge = &p_graph->p_edges[edge_idx];
+
+            if (p_edge->from_idx == cell_idx && p_edge->from_dir == direction)
+            {
+                total_length += p_edge->length;
+                num_edges++;
+            }
+            else if (p_edge->to_idx != cell_idx || p_edge->to_dir != direction)
+            {
+                printf("Edge %u does not leave node (%u, %u).\n",
+                       edge_idx,
+                       p_cell->coordinates.x,
+                       p_cell->coordinates.y);
+                return false;
+            }
+        }
+    }
+
+    if (num_gaps / 2 != total_length || num_edges != p_graph->num_edges)
+    {
+        printf("Edges cover %u of %u gaps, and %u of %u edges are used.\n",
+               total_length,
+               num_gaps / 2,
+               num_edges,
+               p_graph->num_edges);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks a path found on the graph against a breadth-first search.
+ *
+ * @param[in,out] p_grid Pointer to the maze.
+ * @param[in] p_graph Pointer to the graph of the maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return int 0 if the path is valid and shortest, -1 otherwise.
+ */
+static int
+check_path (maze_grid_t        *p_grid,
+            const maze_graph_t *p_graph,
+            maze_grid_cell_t   *p_start_node,
+            maze_grid_cell_t   *p_end_node)
+{
+    uint32_t       expected = get_bfs_dist(p_grid, p_start_node, p_end_node);
+    a_star_path_t *p_path
+        = maze_graph_find_path(p_graph, p_start_node, p_end_node, NULL);
+    uint32_t actual = (NULL == p_path) ? UINT32_MAX : p_path->length - 1;
+    bool     is_valid = true;
+
+    // Consecutive cells of the path must be adjacent and have no wall between
+    // them.
+    //
+    for (uint32_t idx = 0; NULL != p_path && p_path->length > idx; idx++)
+    {
+        const maze_point_t *p_point  = &p_path->p_path[idx].coordinates;
+        const maze_point_t *p_target = (0 == idx)
+                                           ? &p_start_node->coordinates
+                                           : &p_path->p_path[idx - 1]
+                                                  .coordinates;
+        maze_cardinal_direction_t direction
+            = maze_get_dir_from_to(p_target, p_point);
+
+        if (0 == idx)
+        {
+            is_valid = p_point->x == p_target->x && p_point->y == p_target->y;
+        }
+        else if (MAZE_NONE == direction
+                 || NULL
+                        == maze_get_cell_at_coords(p_grid, p_target)
+                               ->p_next[direction])
+        {
+            is_valid = false;
+        }
+
+        if (!is_valid)
+        {
+            break;
+        }
+    }
+
+    if (NULL != p_path
+        && (p_path->p_path[actual].coordinates.x != p_end_node->coordinates.x
+            || p_path->p_path[actual].coordinates.y
+                   != p_end_node->coordinates.y))
+    {
+        is_valid = false;
+    }
+
+    if (NULL != p_path)
+    {
+        maze_free(p_path->p_path);
+        maze_free(p_path);
+    }
+
+    if (expected != actual || !is_valid)
+    {
+        printf("Path from (%u, %u) to (%u, %u) is %s with length %u when it "
+               "should be %u.\n",
+               p_start_node->coordinates.x,
+               p_start_node->coordinates.y,
+               p_end_node->coordinates.x,
+               p_end_node->coordinates.y,
+               is_valid ? "valid" : "invalid",
+               actual,
+               expected);
+        return -1;
+    }
+
+    return 0;
+}
+
+// End of maze_graph_tests.c
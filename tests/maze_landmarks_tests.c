@@ -0,0 +1,433 @@
+/**
+ * @file maze_landmarks_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the landmark tables of the ALT
+ * heuristic.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS        = 5,    ///< Number of rows in the test maze.
+    GRID_COLS        = 5,    ///< Number of columns in the test maze.
+    NUM_LANDMARKS    = 4,    ///< Number of landmarks of each table.
+    NUM_RANDOM_MAZES = 200,  ///< Number of random mazes in the search test.
+    MAX_RANDOM_SIZE  = 24,   ///< Largest side of the random mazes.
+    NUM_QUERIES      = 8,    ///< Number of searches in each random maze.
+    UPDATE_GRID_SIZE = 16,   ///< Side of the grid that walls are changed in.
+    NUM_WALL_UPDATES = 200,  ///< Number of wall changes in the update test.
+    LANDMARKS_SEED   = 2004  ///< Seed of the random mazes and wall changes.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_place_landmarks(void);
+static int test_alt_search(void);
+static int test_invalidate(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static bool     is_table_exact(maze_grid_t            *p_grid,
+                               const maze_landmarks_t *p_landmarks);
+static int      check_search(maze_grid_t            *p_grid,
+                             search_context_t       *p_context,
+                             const maze_landmarks_t *p_landmarks,
+                             maze_grid_cell_t       *p_start_node,
+                             maze_grid_cell_t       *p_end_node);
+
+/**
+ * @brief Runs the tests for the landmark tables.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+maze_landmarks_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(LANDMARKS_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_place_landmarks();
+            break;
+        case 2:
+            ret_val = test_alt_search();
+            break;
+        case 3:
+            ret_val = test_invalidate();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that the landmarks of the test maze are distinct cells, and
+ * that their tables hold the breadth-first distance to every cell.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_place_landmarks (void)
+{
+    int                ret_val     = 0;
+    maze_grid_t        maze        = maze_create(GRID_ROWS, GRID_COLS);
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = (uint16_t *)g_bitmask_array,
+        .rows      = GRID_ROWS,
+        .columns   = GRID_COLS,
+    };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_landmarks_t landmarks = maze_landmarks_create(&maze, NUM_LANDMARKS);
+
+    // Step 1: Check that the tables give no bound before they are measured.
+    //
+    if (0 != maze_landmarks_get_bound(&landmarks, 0, GRID_ROWS * GRID_COLS - 1))
+    {
+        printf("Unmeasured tables give a bound.\n");
+        ret_val = -1;
+    }
+
+    // Step 2: Place the landmarks and check them.
+    //
+    maze_landmarks_update(&landmarks);
+
+    for (uint8_t landmark = 0; landmarks.num_landmarks > landmark; landmark++)
+    {
+        const maze_point_t *p_point
+            = &maze.p_grid_array[landmarks.cells[landmark]].coordinates;
+        printf(
+            "Landmark %u is at (%u, %u).\n", landmark, p_point->x, p_point->y);
+
+        for (uint8_t other = 0; landmark > other; other++)
+        {
+            if (landmarks.cells[landmark] == landmarks.cells[other])
+            {
+                printf("Landmarks %u and %u are the same cell.\n",
+                       other,
+                       landmark);
+                ret_val = -1;
+            }
+        }
+    }
+
+    if (!is_table_exact(&maze, &landmarks))
+    {
+        ret_val = -1;
+    }
+
+    maze_landmarks_destroy(&landmarks);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the ALT bound never exceeds the breadth-first distance,
+ * and that A* with it finds paths as short as A* without it, across random
+ * mazes.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_alt_search (void)
+{
+    int      ret_val        = 0;
+    uint64_t total_expanded = 0;
+    uint64_t alt_expanded   = 0;
+
+    for (uint32_t maze_num = 0; NUM_RANDOM_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Add walls to an open grid until most of it is corridors.
+        //
+        uint16_t    rows = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        uint16_t    cols = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        maze_grid_t maze = maze_create(rows, cols);
+        floodfill_init_maze_nowall(&maze);
+
+        for (uint32_t wall = 0; (uint32_t)rows * cols * 3 / 2 > wall; wall++)
+        {
+            maze_grid_cell_t *p_node
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+            maze_navigator_state_t wall_setter
+                = { p_node, p_node, p_node, MAZE_NORTH };
+            maze_nav_modify_walls(
+                &maze, &wall_setter, 1u << (get_random() % 4), true, false);
+        }
+
+        search_context_t context
+            = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&maze));
+        maze_landmarks_t landmarks
+            = maze_landmarks_create(&maze, NUM_LANDMARKS);
+        maze_landmarks_update(&landmarks);
+
+        // Step 2: Search between random cells with and without landmarks.
+        //
+        for (uint8_t query = 0; NUM_QUERIES > query && 0 == ret_val; query++)
+        {
+            maze_grid_cell_t *p_start
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+            maze_grid_cell_t *p_end
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+            a_star_ctx(&maze, &context, p_start, p_end);
+            total_expanded += context.num_expanded;
+
+            ret_val = check_search(&maze, &context, &landmarks, p_start, p_end);
+            alt_expanded += context.num_expanded;
+        }
+
+        maze_landmarks_destroy(&landmarks);
+        search_context_destroy(&context);
+        maze_destroy(&maze);
+    }
+
+    printf("A* expanded %llu nodes, and %llu with landmarks.\n",
+           (unsigned long long)total_expanded,
+           (unsigned long long)alt_expanded);
+
+    if (alt_expanded > total_expanded)
+    {
+        printf("Landmarks made the searches expand more nodes.\n");
+        ret_val = -1;
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that invalidated tables give no bound until they are updated,
+ * and that updated tables match the maze after walls are added and removed.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_invalidate (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(UPDATE_GRID_SIZE, UPDATE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+
+    search_context_t context
+        = search_context_create((maze_idx_t)MAZE_GRID_CELLS(&maze));
+    maze_landmarks_t landmarks = maze_landmarks_create(&maze, NUM_LANDMARKS);
+    maze_landmarks_update(&landmarks);
+
+    for (uint32_t update = 0; NUM_WALL_UPDATES > update && 0 == ret_val;
+         update++)
+    {
+        // Step 1: Add a wall, or every so often remove one, and invalidate
+        // the tables.
+        //
+        maze_grid_cell_t *p_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+        bool is_set = 0 != get_random() % 4;
+
+        maze_nav_modify_walls(
+            &maze, &wall_setter, 1u << (get_random() % 4), is_set, !is_set);
+        maze_landmarks_invalidate(&landmarks);
+
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_grid_cell_t *p_end
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+        if (0
+            != maze_landmarks_get_bound(&landmarks,
+                                        maze_get_cell_idx(&maze, p_start),
+                                        maze_get_cell_idx(&maze, p_end)))
+        {
+            printf("Invalidated tables give a bound after update %u.\n",
+                   update);
+            ret_val = -1;
+            break;
+        }
+
+        // Step 2: Update the tables every few changes, and check them.
+        //
+        if (0 == update % 8)
+        {
+            maze_landmarks_update(&landmarks);
+
+            if (!is_table_exact(&maze, &landmarks))
+            {
+                printf("Tables are wrong after update %u.\n", update);
+                ret_val = -1;
+                break;
+            }
+        }
+
+        ret_val = check_search(&maze, &context, &landmarks, p_start, p_end);
+    }
+
+    maze_landmarks_destroy(&landmarks);
+    search_context_destroy(&context);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Checks that the tables hold the breadth-first distance from each
+ * landmark to every cell, or unreachable.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_landmarks Pointer to the tables.
+ * @return true If every distance is exact.
+ * @return false Otherwise.
+ */
+static bool
+is_table_exact (maze_grid_t *p_grid, const maze_landmarks_t *p_landmarks)
+{
+    for (uint8_t landmark = 0; p_landmarks->num_landmarks > landmark;
+         landmark++)
+    {
+        maze_grid_cell_t *p_landmark
+            = &p_grid->p_grid_array[p_landmarks->cells[landmark]];
+
+        for (size_t cell_idx = 0; MAZE_GRID_CELLS(p_grid) > cell_idx;
+             cell_idx++)
+        {
+            uint32_t dist = get_bfs_dist(
+                p_grid, p_landmark, &p_grid->p_grid_array[cell_idx]);
+            uint16_t stored
+                = p_landmarks->p_dists[cell_idx * p_landmarks->num_landmarks
+                                       + landmark];
+
+            if ((UINT32_MAX == dist && MAZE_LANDMARKS_UNREACHABLE != stored)
+                || (UINT32_MAX != dist && dist != stored))
+            {
+                printf("Landmark %u is %u from cell %u, not %u.\n",
+                       landmark,
+                       stored,
+                       (unsigned)cell_idx,
+                       dist);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks that the ALT bound between two cells is at most their
+ * breadth-first distance, and that A* with it finds a path of that length.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in,out] p_context Pointer to the search context.
+ * @param[in] p_landmarks Pointer to the tables.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return int 0 if the check passes, -1 otherwise.
+ */
+static int
+check_search (maze_grid_t            *p_grid,
+              search_context_t       *p_context,
+              const maze_landmarks_t *p_landmarks,
+              maze_grid_cell_t       *p_start_node,
+              maze_grid_cell_t       *p_end_node)
+{
+    maze_idx_t end_idx  = maze_get_cell_idx(p_grid, p_end_node);
+    uint32_t   bfs_dist = get_bfs_dist(p_grid, p_start_node, p_end_node);
+    uint32_t   bound    = maze_landmarks_get_bound(
+        p_landmarks, maze_get_cell_idx(p_grid, p_start_node), end_idx);
+
+    if (UINT32_MAX != bfs_dist && bound > bfs_dist)
+    {
+        printf("Bound of %u is above the distance of %u.\n", bound, bfs_dist);
+        return -1;
+    }
+
+    bool is_found = a_star_ctx_alt(
+        p_grid, p_context, p_landmarks, p_start_node, p_end_node);
+
+    if (is_found != (UINT32_MAX != bfs_dist)
+        || (is_found && bfs_dist != p_context->p_g[end_idx]))
+    {
+        printf("ALT search found %u, but the distance is %u.\n",
+               is_found ? p_context->p_g[end_idx] : UINT32_MAX,
+               bfs_dist);
+        return -1;
+    }
+
+    return 0;
+}
+
+// End of maze_landmarks_tests.c
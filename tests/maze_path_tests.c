@@ -0,0 +1,374 @@
+/**
+ * @file maze_path_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the compact path.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "pathfinding/maze_path.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/search_context.h"
+#include "pathfinding/maze.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS = 5, ///< Number of rows in the test maze.
+    GRID_COLS = 5, ///< Number of columns in the test maze.
+    NUM_STEPS = 9  ///< Number of steps in the packing test.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+/**
+ * @brief Steps of the packing test, which spill into a third byte.
+ */
+static const maze_cardinal_direction_t g_steps[NUM_STEPS] = {
+    MAZE_EAST, MAZE_SOUTH, MAZE_EAST, MAZE_EAST, MAZE_SOUTH,
+    MAZE_WEST, MAZE_SOUTH, MAZE_EAST, MAZE_NORTH,
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_pack_steps(void);
+static int test_from_context(void);
+static int test_path_str(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static maze_grid_t create_test_maze(void);
+static bool        is_same_path(const maze_path_t   *p_path,
+                                const a_star_path_t *p_cell_path);
+
+/**
+ * @brief Runs the tests for the compact path.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+maze_path_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_pack_steps();
+            break;
+        case 2:
+            ret_val = test_from_context();
+            break;
+        case 3:
+            ret_val = test_path_str();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that steps read back as they were written, and that the
+ * iterator visits the cells they lead to.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_pack_steps (void)
+{
+    int          ret_val     = 0;
+    maze_point_t start_point = { 1, 0 };
+    maze_path_t  path        = maze_path_create(&start_point, NUM_STEPS);
+
+    // Write the steps out of order, so that setting one step cannot disturb
+    // the steps packed next to it.
+    //
+    for (uint32_t step = NUM_STEPS; 0 < step; step--)
+    {
+        maze_path_set_step(&path, step - 1u, g_steps[step - 1u]);
+    }
+
+    maze_path_set_step(&path, 4, MAZE_NORTH);
+    maze_path_set_step(&path, 4, g_steps[4]);
+
+    maze_path_iter_t iter     = maze_path_iter_begin(&path);
+    maze_point_t     expected = start_point;
+
+    for (uint32_t step = 0; NUM_STEPS > step; step++)
+    {
+        if (g_steps[step] != maze_path_get_step(&path, step))
+        {
+            printf("Step %u is %u when it should be %u.\n",
+                   step,
+                   maze_path_get_step(&path, step),
+                   g_steps[step]);
+            ret_val = -1;
+        }
+
+        expected.x
+            += (MAZE_EAST == g_steps[step]) - (MAZE_WEST == g_steps[step]);
+        expected.y
+            += (MAZE_SOUTH == g_steps[step]) - (MAZE_NORTH == g_steps[step]);
+
+        if (!maze_path_iter_next(&iter) || expected.x != iter.point.x
+            || expected.y != iter.point.y)
+        {
+            printf("Iterator is at (%u, %u) when it should be at (%u, %u).\n",
+                   iter.point.x,
+                   iter.point.y,
+                   expected.x,
+                   expected.y);
+            ret_val = -1;
+        }
+    }
+
+    maze_point_t end_point = maze_path_get_end(&path);
+
+    if (maze_path_iter_next(&iter) || expected.x != end_point.x
+        || expected.y != end_point.y)
+    {
+        printf("Path does not end at (%u, %u).\n", expected.x, expected.y);
+        ret_val = -1;
+    }
+
+    printf("%u steps take %u bytes.\n",
+           NUM_STEPS,
+           (unsigned)MAZE_PATH_GET_NUM_BYTES(NUM_STEPS));
+
+    maze_path_destroy(&path);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the compact path of a search matches the path of cells,
+ * through both conversions, and that no path is made to an unreached node.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_from_context (void)
+{
+    int               ret_val     = 0;
+    maze_grid_t       maze        = create_test_maze();
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 4, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+    search_context_t  context = search_context_create(GRID_ROWS * GRID_COLS);
+    maze_path_t       path    = { .start = { 0, 0 }, .num_steps = 0 };
+
+    // Step 1: Compare the compact path with the path of cells.
+    //
+    a_star_ctx(&maze, &context, p_start, p_end);
+    a_star_path_t *p_cell_path = a_star_ctx_get_path(&maze, &context, p_end);
+
+    if (!maze_path_from_context(&maze, &context, p_end, &path)
+        || !is_same_path(&path, p_cell_path))
+    {
+        printf("Compact path does not match the path of cells.\n");
+        ret_val = -1;
+    }
+
+    printf("Path of %u cells takes %u bytes instead of %u.\n",
+           p_cell_path->length,
+           (unsigned)MAZE_PATH_GET_NUM_BYTES(path.num_steps),
+           (unsigned)(sizeof(maze_grid_cell_t) * p_cell_path->length));
+
+    // Step 2: Convert it both ways.
+    //
+    maze_path_t    converted_path = maze_path_from_a_star_path(p_cell_path);
+    a_star_path_t *p_round_trip   = maze_path_to_a_star_path(&maze, &path);
+
+    if (!is_same_path(&converted_path, p_cell_path)
+        || !is_same_path(&path, p_round_trip)
+        || p_round_trip->p_path[p_round_trip->length - 1u].p_came_from
+               != &p_round_trip->p_path[p_round_trip->length - 2u])
+    {
+        printf("Converted paths do not match.\n");
+        ret_val = -1;
+    }
+
+    maze_path_destroy(&converted_path);
+    maze_free(p_round_trip->p_path);
+    maze_free(p_round_trip);
+    maze_free(p_cell_path->p_path);
+    maze_free(p_cell_path);
+    maze_path_destroy(&path);
+
+    // Step 3: Wall off the end node.
+    //
+    maze_navigator_state_t wall_setter = { p_end, p_end, p_end, MAZE_NORTH };
+    maze_nav_modify_walls(&maze, &wall_setter, 0xF, true, false);
+    a_star_ctx(&maze, &context, p_start, p_end);
+
+    if (maze_path_from_context(&maze, &context, p_end, &path))
+    {
+        printf("Compact path was made to a walled off node.\n");
+        maze_path_destroy(&path);
+        ret_val = -1;
+    }
+
+    search_context_destroy(&context);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a compact path is drawn the same as its path of cells.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_path_str (void)
+{
+    int               ret_val     = 0;
+    maze_grid_t       maze        = create_test_maze();
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 4, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+    search_context_t  context = search_context_create(GRID_ROWS * GRID_COLS);
+    maze_path_t       path    = { .start = { 0, 0 }, .num_steps = 0 };
+
+    a_star_ctx(&maze, &context, p_start, p_end);
+    maze_path_from_context(&maze, &context, p_end, &path);
+    a_star_path_t *p_cell_path = a_star_ctx_get_path(&maze, &context, p_end);
+
+    char *p_expected_str = a_star_get_path_str(&maze, p_cell_path);
+    char *p_actual_str   = maze_path_get_str(&maze, &path);
+
+    printf("%s\n", p_actual_str);
+
+    if (0 != strcmp(p_expected_str, p_actual_str))
+    {
+        printf("Compact path is drawn differently:\n%s\n", p_expected_str);
+        ret_val = -1;
+    }
+
+    maze_free(p_expected_str);
+    maze_free(p_actual_str);
+    maze_free(p_cell_path->p_path);
+    maze_free(p_cell_path);
+    maze_path_destroy(&path);
+    search_context_destroy(&context);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Creates the test maze from the global bitmask array.
+ *
+ * @return maze_grid_t Test maze.
+ */
+static maze_grid_t
+create_test_maze (void)
+{
+    maze_grid_t        maze        = maze_create(GRID_ROWS, GRID_COLS);
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = (uint16_t *)g_bitmask_array,
+        .rows      = GRID_ROWS,
+        .columns   = GRID_COLS,
+    };
+
+    maze_deserialise(&maze, &gap_bitmask);
+
+    return maze;
+}
+
+/**
+ * @brief Checks that a compact path visits the same cells as a path of cells.
+ *
+ * @param[in] p_path Pointer to the compact path.
+ * @param[in] p_cell_path Pointer to the path of cells.
+ * @return true If the paths visit the same cells.
+ * @return false Otherwise.
+ */
+static bool
+is_same_path (const maze_path_t *p_path, const a_star_path_t *p_cell_path)
+{
+    if (p_path->num_steps + 1u != p_cell_path->length)
+    {
+        return false;
+    }
+
+    maze_path_iter_t iter = maze_path_iter_begin(p_path);
+
+    do
+    {
+        const maze_point_t *p_point
+            = &p_cell_path->p_path[iter.step].coordinates;
+
+        if (p_point->x != iter.point.x || p_point->y != iter.point.y)
+        {
+            return false;
+        }
+    } while (maze_path_iter_next(&iter));
+
+    return true;
+}
+
+// End of maze_path_tests.c
@@ -0,0 +1,736 @@
+/**
+ * @file maze_tour_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the tour planner.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "pathfinding/maze_tour.h"
+#include "pathfinding/maze_dist_cache.h"
+#include "pathfinding/maze_path.h"
+#include "pathfinding/floodfill.h"
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS        = 5,   ///< Number of rows in the test maze.
+    GRID_COLS        = 5,   ///< Number of columns in the test maze.
+    NUM_RANDOM_MAZES = 100, ///< Number of random mazes in the exact test.
+    MAX_RANDOM_SIZE  = 16,  ///< Largest side of the random mazes.
+    MAX_BRUTE_FORCE  = 7,   ///< Most waypoints checked against every order.
+    LARGE_GRID_SIZE  = 32,  ///< Side of the maze of the 2-opt test.
+    NUM_LARGE_TOURS  = 10,  ///< Number of tours in the 2-opt test.
+    MAX_LARGE_WAYPTS = 40,  ///< Most waypoints of a 2-opt tour.
+    CORRIDOR_LENGTH  = 300, ///< Cells of the corridor of the saturation test.
+    TOUR_SEED        = 2023 ///< Seed of the random mazes and waypoints.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x2, 0xE, 0xA, 0xC, 0x4, // Top Row
+    0x6, 0xB, 0xC, 0x3, 0x9, // 2nd row
+    0x3, 0x8, 0x7, 0x8, 0x4, // 3rd row
+    0x4, 0x4, 0x7, 0xA, 0xD, // 4th row
+    0x3, 0xB, 0x9, 0x2, 0x9  // last row
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_plan_tour(void);
+static int test_exact_tours(void);
+static int test_two_opt_tours(void);
+static int test_saturated_tours(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void     add_random_walls(maze_grid_t *p_grid);
+static bool     is_tour_valid(maze_grid_t                   *p_grid,
+                              const maze_path_t             *p_path,
+                              const maze_grid_cell_t        *p_start,
+                              const maze_grid_cell_t *const *pp_waypoints,
+                              uint8_t                        num_waypoints,
+                              const maze_grid_cell_t        *p_exit);
+static uint32_t get_shortest_tour(maze_grid_t                   *p_grid,
+                                  const maze_grid_cell_t        *p_start,
+                                  const maze_grid_cell_t *const *pp_waypoints,
+                                  uint8_t                        num_waypoints,
+                                  const maze_grid_cell_t        *p_exit);
+static uint32_t get_shortest_rest(const uint32_t *p_dists,
+                                  uint8_t         num_waypoints,
+                                  uint8_t         from,
+                                  uint32_t        visited);
+static uint32_t get_ordered_tour(maze_grid_t                   *p_grid,
+                                 const maze_grid_cell_t        *p_start,
+                                 const maze_grid_cell_t *const *pp_waypoints,
+                                 uint8_t                        num_waypoints,
+                                 const maze_grid_cell_t        *p_exit);
+static void     fill_bfs_dists(maze_grid_t            *p_grid,
+                               const maze_grid_cell_t *p_start_node,
+                               uint32_t               *p_dists);
+
+/**
+ * @brief Runs the tests for the tour planner.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+maze_tour_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    set_random_seed(TOUR_SEED);
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_plan_tour();
+            break;
+        case 2:
+            ret_val = test_exact_tours();
+            break;
+        case 3:
+            ret_val = test_two_opt_tours();
+            break;
+        case 4:
+            ret_val = test_saturated_tours();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests a tour of three waypoints in the test maze against every
+ * order of visiting them.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_plan_tour (void)
+{
+    int                ret_val     = 0;
+    maze_grid_t        maze        = maze_create(GRID_ROWS, GRID_COLS);
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = (uint16_t *)g_bitmask_array,
+        .rows      = GRID_ROWS,
+        .columns   = GRID_COLS,
+    };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t            points[] = { { 4, 4 }, { 0, 0 }, { 2, 2 } };
+    maze_point_t            start    = { 0, 4 };
+    maze_point_t            exit     = { 4, 0 };
+    const maze_grid_cell_t *p_waypoints[3];
+    uint8_t                 order[3];
+    maze_path_t             path;
+
+    for (uint8_t waypoint = 0; 3 > waypoint; waypoint++)
+    {
+        p_waypoints[waypoint]
+            = maze_get_cell_at_coords(&maze, &points[waypoint]);
+    }
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start);
+    maze_grid_cell_t *p_exit  = maze_get_cell_at_coords(&maze, &exit);
+
+    if (MAZE_TOUR_PLANNED
+        != maze_tour_plan(
+            &maze, p_start, p_waypoints, 3, p_exit, order, &path))
+    {
+        printf("No tour was planned.\n");
+        maze_destroy(&maze);
+        return -1;
+    }
+
+    printf("Waypoints visited in the order %u, %u, %u.\n",
+           order[0],
+           order[1],
+           order[2]);
+
+    char *p_path_str = maze_path_get_str(&maze, &path);
+    printf("%s\n", p_path_str);
+    free(p_path_str);
+
+    uint32_t shortest
+        = get_shortest_tour(&maze, p_start, p_waypoints, 3, p_exit);
+
+    if (!is_tour_valid(&maze, &path, p_start, p_waypoints, 3, p_exit)
+        || shortest != path.num_steps)
+    {
+        printf("Tour of %u steps, expected %u.\n", path.num_steps, shortest);
+        ret_val = -1;
+    }
+
+    maze_path_destroy(&path);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that exact tours in random mazes are as short as the best of
+ * every order, and that tours to unreachable waypoints are refused.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_exact_tours (void)
+{
+    int ret_val = 0;
+
+    for (uint32_t maze_num = 0; NUM_RANDOM_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        uint16_t    rows = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        uint16_t    cols = 2 + get_random() % (MAX_RANDOM_SIZE - 1);
+        maze_grid_t maze = maze_create(rows, cols);
+        floodfill_init_maze_nowall(&maze);
+        add_random_walls(&maze);
+
+        const maze_grid_cell_t *p_waypoints[MAX_BRUTE_FORCE];
+        uint8_t num_waypoints = get_random() % (MAX_BRUTE_FORCE + 1);
+        maze_path_t path;
+
+        for (uint8_t waypoint = 0; num_waypoints > waypoint; waypoint++)
+        {
+            p_waypoints[waypoint]
+                = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        }
+
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+        maze_grid_cell_t *p_exit
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+
+        uint32_t shortest = get_shortest_tour(
+            &maze, p_start, p_waypoints, num_waypoints, p_exit);
+        maze_tour_result_t result = maze_tour_plan(
+            &maze, p_start, p_waypoints, num_waypoints, p_exit, NULL, &path);
+        bool is_planned = MAZE_TOUR_PLANNED == result;
+
+        if (result
+            != ((UINT32_MAX != shortest) ? MAZE_TOUR_PLANNED
+                                         : MAZE_TOUR_UNREACHABLE))
+        {
+            printf("Maze %u: tour result is %d, but reachable is %d.\n",
+                   maze_num,
+                   (int)result,
+                   UINT32_MAX != shortest);
+            ret_val = -1;
+        }
+        else if (is_planned)
+        {
+            if (!is_tour_valid(&maze,
+                               &path,
+                               p_start,
+                               p_waypoints,
+                               num_waypoints,
+                               p_exit)
+                || shortest != path.num_steps)
+            {
+                printf("Maze %u: tour of %u steps through %u waypoints, "
+                       "expected %u.\n",
+                       maze_num,
+                       path.num_steps,
+                       num_waypoints,
+                       shortest);
+                ret_val = -1;
+            }
+
+            maze_path_destroy(&path);
+        }
+
+        maze_destroy(&maze);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that tours with too many waypoints to solve exactly still
+ * visit every waypoint, and are no longer than visiting them in the order
+ * given.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_two_opt_tours (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(LARGE_GRID_SIZE, LARGE_GRID_SIZE);
+    floodfill_init_maze_nowall(&maze);
+    add_random_walls(&maze);
+
+    uint32_t *p_dists = malloc(sizeof(uint32_t) * MAZE_GRID_CELLS(&maze));
+    maze_grid_cell_t *p_start = &maze.p_grid_array[0];
+    fill_bfs_dists(&maze, p_start, p_dists);
+
+    for (uint32_t tour = 0; NUM_LARGE_TOURS > tour && 0 == ret_val; tour++)
+    {
+        // Step 1: Pick waypoints and an exit that the start can reach.
+        //
+        const maze_grid_cell_t *p_stops[MAX_LARGE_WAYPTS + 1];
+        uint8_t                 num_waypoints
+            = MAZE_TOUR_MAX_EXACT + 1 + tour * 3;
+        maze_path_t path;
+
+        for (uint8_t stop = 0; num_waypoints >= stop; stop++)
+        {
+            size_t cell_idx = 0;
+
+            do
+            {
+                cell_idx = get_random() % MAZE_GRID_CELLS(&maze);
+            } while (UINT32_MAX == p_dists[cell_idx]);
+
+            p_stops[stop] = &maze.p_grid_array[cell_idx];
+        }
+
+        // Step 2: Plan the tour, and compare it with the order given.
+        //
+        const maze_grid_cell_t *p_exit = p_stops[num_waypoints];
+        uint32_t                ordered_length = get_ordered_tour(
+            &maze, p_start, p_stops, num_waypoints, p_exit);
+
+        if (MAZE_TOUR_PLANNED
+            != maze_tour_plan(
+                &maze, p_start, p_stops, num_waypoints, p_exit, NULL, &path))
+        {
+            printf("No tour was planned through %u waypoints.\n",
+                   num_waypoints);
+            ret_val = -1;
+            break;
+        }
+
+        printf("Tour of %u steps through %u waypoints, %u in the order "
+               "given.\n",
+               path.num_steps,
+               num_waypoints,
+               ordered_length);
+
+        if (!is_tour_valid(
+                &maze, &path, p_start, p_stops, num_waypoints, p_exit)
+            || ordered_length < path.num_steps)
+        {
+            ret_val = -1;
+        }
+
+        maze_path_destroy(&path);
+    }
+
+    free(p_dists);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a tour with a leg too expensive for the distance fields is
+ * reported as too far rather than unreachable. In the 16-bit build a corridor
+ * of cells that cost 255 is too long, while in the 32-bit build it is
+ * planned. A stop that is walled off is unreachable in both builds.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_saturated_tours (void)
+{
+    int         ret_val = 0;
+    maze_grid_t maze    = maze_create(1, CORRIDOR_LENGTH);
+    maze_path_t path;
+
+    floodfill_init_maze_nowall(&maze);
+
+    for (uint16_t col = 0; CORRIDOR_LENGTH > col; col++)
+    {
+        maze_set_cell_cost(&maze, &maze.p_grid_array[col], UINT8_MAX);
+    }
+
+    const maze_grid_cell_t *p_start    = &maze.p_grid_array[0];
+    const maze_grid_cell_t *p_waypoint = &maze.p_grid_array[1];
+    maze_grid_cell_t       *p_exit
+        = &maze.p_grid_array[CORRIDOR_LENGTH - 1];
+
+    // Step 1: Walk the corridor. The leg from the waypoint to the exit costs
+    // more than a 16-bit field holds.
+    //
+    uint32_t           leg_cost = (uint32_t)(CORRIDOR_LENGTH - 2) * UINT8_MAX;
+    maze_tour_result_t expected = (MAZE_DIST_CACHE_UNREACHABLE > leg_cost)
+                                      ? MAZE_TOUR_PLANNED
+                                      : MAZE_TOUR_TOO_FAR;
+    maze_tour_result_t result
+        = maze_tour_plan(&maze, p_start, &p_waypoint, 1, p_exit, NULL, &path);
+
+    if (expected != result)
+    {
+        printf("Corridor tour result is %d, expected %d.\n",
+               (int)result,
+               (int)expected);
+        ret_val = -1;
+    }
+    else if (MAZE_TOUR_PLANNED == result)
+    {
+        if (CORRIDOR_LENGTH - 1 != path.num_steps)
+        {
+            printf("Corridor tour of %u steps, expected %u.\n",
+                   path.num_steps,
+                   CORRIDOR_LENGTH - 1);
+            ret_val = -1;
+        }
+
+        maze_path_destroy(&path);
+    }
+
+    // Step 2: Wall off the exit, which makes it unreachable however long the
+    // other legs are.
+    //
+    maze_navigator_state_t wall_setter = { p_exit, p_exit, p_exit, MAZE_NORTH };
+    maze_nav_modify_walls(&maze, &wall_setter, 1u << MAZE_WEST, true, false);
+
+    result
+        = maze_tour_plan(&maze, p_start, &p_waypoint, 1, p_exit, NULL, &path);
+
+    if (MAZE_TOUR_UNREACHABLE != result)
+    {
+        printf("Walled-off tour result is %d, expected %d.\n",
+               (int)result,
+               (int)MAZE_TOUR_UNREACHABLE);
+        ret_val = -1;
+    }
+
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Adds walls to an open grid until most of it is corridors. Some
+ * cells may be walled off.
+ *
+ * @param[in,out] p_grid Pointer to the maze.
+ */
+static void
+add_random_walls (maze_grid_t *p_grid)
+{
+    size_t num_cells = MAZE_GRID_CELLS(p_grid);
+
+    for (size_t wall = 0; num_cells * 3 / 2 > wall; wall++)
+    {
+        maze_grid_cell_t *p_node
+            = &p_grid->p_grid_array[get_random() % num_cells];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+        maze_nav_modify_walls(
+            p_grid, &wall_setter, 1u << (get_random() % 4), true, false);
+    }
+}
+
+/**
+ * @brief Checks that a tour starts at the start, only steps through open
+ * walls, visits every waypoint and ends at the exit.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_path Pointer to the path of the tour.
+ * @param[in] p_start Pointer to the start node.
+ * @param[in] pp_waypoints Array of pointers to the waypoints.
+ * @param[in] num_waypoints Number of waypoints.
+ * @param[in] p_exit Pointer to the exit node.
+ * @return true If the tour is valid.
+ * @return false Otherwise.
+ */
+static bool
+is_tour_valid (maze_grid_t                   *p_grid,
+               const maze_path_t             *p_path,
+               const maze_grid_cell_t        *p_start,
+               const maze_grid_cell_t *const *pp_waypoints,
+               uint8_t                        num_waypoints,
+               const maze_grid_cell_t        *p_exit)
+{
+    bool is_visited[UINT8_MAX] = { false };
+
+    if (p_path->start.x != p_start->coordinates.x
+        || p_path->start.y != p_start->coordinates.y)
+    {
+        printf("Tour does not begin at the start.\n");
+        return false;
+    }
+
+    maze_path_iter_t        iter   = maze_path_iter_begin(p_path);
+    const maze_grid_cell_t *p_cell = p_start;
+
+    do
+    {
+        p_cell = maze_get_cell_at_coords(p_grid, &iter.point);
+
+        for (uint8_t waypoint = 0; num_waypoints > waypoint; waypoint++)
+        {
+            is_visited[waypoint] |= pp_waypoints[waypoint] == p_cell;
+        }
+
+        if (p_path->num_steps > iter.step
+            && NULL == p_cell->p_next[maze_path_get_step(p_path, iter.step)])
+        {
+            printf("Tour walks through a wall at (%u, %u).\n",
+                   iter.point.x,
+                   iter.point.y);
+            return false;
+        }
+    } while (maze_path_iter_next(&iter));
+
+    for (uint8_t waypoint = 0; num_waypoints > waypoint; waypoint++)
+    {
+        if (!is_visited[waypoint])
+        {
+            printf("Tour misses waypoint %u.\n", waypoint);
+            return false;
+        }
+    }
+
+    if (p_exit != p_cell)
+    {
+        printf("Tour does not end at the exit.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gets the length of the shortest tour by trying every order.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_start Pointer to the start node.
+ * @param[in] pp_waypoints Array of pointers to the waypoints.
+ * @param[in] num_waypoints Number of waypoints, at most @ref MAX_BRUTE_FORCE.
+ * @param[in] p_exit Pointer to the exit node.
+ * @return uint32_t Length of the tour, UINT32_MAX if a stop is unreachable.
+ */
+static uint32_t
+get_shortest_tour (maze_grid_t                   *p_grid,
+                   const maze_grid_cell_t        *p_start,
+                   const maze_grid_cell_t *const *pp_waypoints,
+                   uint8_t                        num_waypoints,
+                   const maze_grid_cell_t        *p_exit)
+{
+    // Distances between the stops, numbered with the waypoints first, then
+    // the start, then the exit.
+    //
+    uint8_t   num_stops  = num_waypoints + 2u;
+    uint32_t *p_dists    = malloc(sizeof(uint32_t) * num_stops * num_stops);
+    uint32_t *p_cell_dists
+        = malloc(sizeof(uint32_t) * MAZE_GRID_CELLS(p_grid));
+
+    for (uint8_t from = 0; num_stops > from; from++)
+    {
+        const maze_grid_cell_t *p_from
+            = (num_waypoints > from)    ? pp_waypoints[from]
+              : (num_waypoints == from) ? p_start
+                                        : p_exit;
+        fill_bfs_dists(p_grid, p_from, p_cell_dists);
+
+        for (uint8_t to = 0; num_stops > to; to++)
+        {
+            const maze_grid_cell_t *p_to
+                = (num_waypoints > to)    ? pp_waypoints[to]
+                  : (num_waypoints == to) ? p_start
+                                          : p_exit;
+            p_dists[from * num_stops + to]
+                = p_cell_dists[maze_get_cell_idx(p_grid, p_to)];
+        }
+    }
+
+    uint32_t length
+        = get_shortest_rest(p_dists, num_waypoints, num_waypoints, 0);
+
+    free(p_cell_dists);
+    free(p_dists);
+
+    return length;
+}
+
+/**
+ * @brief Gets the length of the shortest walk from a stop through every
+ * waypoint not yet visited to the exit.
+ *
+ * @param[in] p_dists Table of distances between the stops.
+ * @param[in] num_waypoints Number of waypoints.
+ * @param[in] from Stop the walk starts at.
+ * @param[in] visited Bitmask of the waypoints visited.
+ * @return uint32_t Length of the walk, UINT32_MAX if a stop is unreachable.
+ */
+static uint32_t
+get_shortest_rest (const uint32_t *p_dists,
+                   uint8_t         num_waypoints,
+                   uint8_t         from,
+                   uint32_t        visited)
+{
+    uint8_t  num_stops = num_waypoints + 2u;
+    uint32_t shortest  = UINT32_MAX;
+
+    if ((1u << num_waypoints) - 1u == visited)
+    {
+        return p_dists[from * num_stops + num_waypoints + 1u];
+    }
+
+    for (uint8_t next = 0; num_waypoints > next; next++)
+    {
+        uint32_t dist = p_dists[from * num_stops + next];
+
+        if (0 != (visited & (1u << next)) || UINT32_MAX == dist)
+        {
+            continue;
+        }
+
+        uint32_t rest = get_shortest_rest(
+            p_dists, num_waypoints, next, visited | (1u << next));
+
+        if (UINT32_MAX != rest && dist + rest < shortest)
+        {
+            shortest = dist + rest;
+        }
+    }
+
+    return shortest;
+}
+
+/**
+ * @brief Gets the length of the tour that visits the waypoints in the order
+ * given.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_start Pointer to the start node.
+ * @param[in] pp_waypoints Array of pointers to the waypoints.
+ * @param[in] num_waypoints Number of waypoints.
+ * @param[in] p_exit Pointer to the exit node.
+ * @return uint32_t Length of the tour.
+ */
+static uint32_t
+get_ordered_tour (maze_grid_t                   *p_grid,
+                  const maze_grid_cell_t        *p_start,
+                  const maze_grid_cell_t *const *pp_waypoints,
+                  uint8_t                        num_waypoints,
+                  const maze_grid_cell_t        *p_exit)
+{
+    uint32_t *p_dists = malloc(sizeof(uint32_t) * MAZE_GRID_CELLS(p_grid));
+    uint32_t  length  = 0;
+    const maze_grid_cell_t *p_from = p_start;
+
+    for (uint8_t visit = 0; num_waypoints >= visit; visit++)
+    {
+        const maze_grid_cell_t *p_to
+            = (num_waypoints > visit) ? pp_waypoints[visit] : p_exit;
+
+        fill_bfs_dists(p_grid, p_from, p_dists);
+        length += p_dists[maze_get_cell_idx(p_grid, p_to)];
+        p_from = p_to;
+    }
+
+    free(p_dists);
+
+    return length;
+}
+
+/**
+ * @brief Fills the distance from a node to every cell with a breadth-first
+ * search.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[out] p_dists Array of the distance of each cell, UINT32_MAX if it is
+ * unreachable.
+ */
+static void
+fill_bfs_dists (maze_grid_t            *p_grid,
+                const maze_grid_cell_t *p_start_node,
+                uint32_t               *p_dists)
+{
+    size_t                   num_cells = MAZE_GRID_CELLS(p_grid);
+    const maze_grid_cell_t **p_queue   = malloc(sizeof(*p_queue) * num_cells);
+    size_t                   head      = 0;
+    size_t                   tail      = 0;
+
+    for (size_t idx = 0; num_cells > idx; idx++)
+    {
+        p_dists[idx] = UINT32_MAX;
+    }
+
+    p_dists[maze_get_cell_idx(p_grid, p_start_node)] = 0;
+    p_queue[tail++]                                  = p_start_node;
+
+    while (head < tail)
+    {
+        const maze_grid_cell_t *p_cell = p_queue[head++];
+        uint32_t dist = p_dists[maze_get_cell_idx(p_grid, p_cell)];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL != p_next
+                && UINT32_MAX == p_dists[maze_get_cell_idx(p_grid, p_next)])
+            {
+                p_dists[maze_get_cell_idx(p_grid, p_next)] = dist + 1;
+                p_queue[tail++]                            = p_next;
+            }
+        }
+    }
+
+    free(p_queue);
+}
+
+// End of maze_tour_tests.c
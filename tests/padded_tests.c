@@ -0,0 +1,306 @@
+/**
+ * @file padded_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the sentinel-padded maze backend.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_padded.h"
+#include "pathfinding/floodfill.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS = 6, ///< Number of rows in the grid.
+    GRID_COLS = 4  ///< Number of columns in the grid.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_padded_sentinels(void);
+static int test_padded_serialisation(void);
+static int test_padded_nowall(void);
+
+/**
+ * @brief Runs the tests for the padded maze backend.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+padded_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_padded_sentinels();
+            break;
+        case 2:
+            ret_val = test_padded_serialisation();
+            break;
+        case 3:
+            ret_val = test_padded_nowall();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that every cell on the border has a sentinel as its neighbour,
+ * that walls are kept symmetric and that the border cannot be opened.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_padded_sentinels (void)
+{
+    int           ret_val = 0;
+    maze_padded_t maze    = maze_padded_create(GRID_ROWS, GRID_COLS);
+
+    if (GRID_COLS + 2 != maze.stride
+        || (GRID_ROWS + 2) * (GRID_COLS + 2)
+               != maze_padded_get_num_cells(&maze))
+    {
+        printf("Padded maze has a stride of %u.\n", maze.stride);
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 1: Check the neighbours of every cell.
+    //
+    for (uint16_t row = 0; GRID_ROWS > row; row++)
+    {
+        for (uint16_t col = 0; GRID_COLS > col; col++)
+        {
+            maze_point_t point    = { col, row };
+            maze_idx_t   cell_idx = maze_padded_get_idx(&maze, &point);
+            maze_point_t result   = maze_padded_get_point(&maze, cell_idx);
+
+            if (col != result.x || row != result.y
+                || maze_padded_is_sentinel(&maze, cell_idx))
+            {
+                printf("(%u, %u) maps to (%u, %u).\n",
+                       col,
+                       row,
+                       result.x,
+                       result.y);
+                ret_val = -1;
+                goto end;
+            }
+
+            bool is_border[4] = { 0 == row,
+                                  GRID_COLS - 1 == col,
+                                  GRID_ROWS - 1 == row,
+                                  0 == col };
+
+            for (uint8_t direction = 0; 4 > direction; direction++)
+            {
+                maze_idx_t next_idx
+                    = maze_padded_get_idx_in_dir(&maze, cell_idx, direction);
+
+                if (is_border[direction]
+                    != maze_padded_is_sentinel(&maze, next_idx))
+                {
+                    printf("Neighbour %u of (%u, %u) is wrong.\n",
+                           direction,
+                           col,
+                           row);
+                    ret_val = -1;
+                    goto end;
+                }
+            }
+        }
+    }
+
+    // Step 2: The wall east of (0, 0) is the wall west of (1, 0).
+    //
+    maze_padded_init_nowall(&maze);
+
+    maze_point_t origin     = { 0, 0 };
+    maze_idx_t   origin_idx = maze_padded_get_idx(&maze, &origin);
+    maze_padded_set_wall(&maze, origin_idx, MAZE_EAST);
+
+    if (!maze_padded_is_wall(&maze, origin_idx + 1, MAZE_WEST))
+    {
+        printf("Wall is not set for both cells.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    maze_padded_unset_wall(&maze, origin_idx + 1, MAZE_WEST);
+
+    if (origin_idx + 1
+        != maze_padded_get_next_idx(&maze, origin_idx, MAZE_EAST))
+    {
+        printf("Wall was not unset for both cells.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 3: The outer border must stay walled.
+    //
+    maze_padded_unset_wall(&maze, origin_idx, MAZE_NORTH);
+
+    if (MAZE_PADDED_NO_CELL
+        != maze_padded_get_next_idx(&maze, origin_idx, MAZE_NORTH))
+    {
+        printf("Border wall was unset.\n");
+        ret_val = -1;
+    }
+
+end:
+    maze_padded_destroy(&maze);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the padded maze serialises to the same bitmask as the grid
+ * maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_padded_serialisation (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_padded_t maze = maze_padded_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t   grid = maze_create(GRID_ROWS, GRID_COLS);
+
+    if (0 != maze_padded_deserialise(&maze, &gap_bitmask))
+    {
+        printf("Could not deserialise the padded maze.\n");
+        maze_padded_destroy(&maze);
+        maze_destroy(&grid);
+        return -1;
+    }
+
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_gap_bitmask_t padded_bitmask = maze_padded_serialise(&maze);
+    maze_gap_bitmask_t grid_bitmask   = maze_serialise(&grid);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (padded_bitmask.p_bitmask[idx] != grid_bitmask.p_bitmask[idx]
+            || padded_bitmask.p_bitmask[idx] != g_bitmask_array[idx])
+        {
+            printf("Bitmask at %u is %x when it should be %x.\n",
+                   idx,
+                   padded_bitmask.p_bitmask[idx],
+                   g_bitmask_array[idx]);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    free(padded_bitmask.p_bitmask);
+    free(grid_bitmask.p_bitmask);
+    maze_padded_destroy(&maze);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that removing the interior walls gives the same maze as @ref
+ * floodfill_init_maze_nowall.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_padded_nowall (void)
+{
+    int           ret_val = 0;
+    maze_padded_t maze    = maze_padded_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t   grid    = maze_create(GRID_ROWS, GRID_COLS);
+
+    maze_padded_init_nowall(&maze);
+    floodfill_init_maze_nowall(&grid);
+
+    maze_gap_bitmask_t padded_bitmask = maze_padded_serialise(&maze);
+    maze_gap_bitmask_t grid_bitmask   = maze_serialise(&grid);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (padded_bitmask.p_bitmask[idx] != grid_bitmask.p_bitmask[idx])
+        {
+            printf("Bitmask at %u is %x when it should be %x.\n",
+                   idx,
+                   padded_bitmask.p_bitmask[idx],
+                   grid_bitmask.p_bitmask[idx]);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    free(padded_bitmask.p_bitmask);
+    free(grid_bitmask.p_bitmask);
+    maze_padded_destroy(&maze);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+// End of padded_tests.c
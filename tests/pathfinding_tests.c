@@ -13,8 +13,25 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+
+#ifdef MAZE_THREADS
+#include <pthread.h>
+#endif
+
 #include "pathfinding/a_star.h"
+#include "pathfinding/a_star_bidirectional.h"
+#include "pathfinding/a_star_batch.h"
+#include "pathfinding/a_star_ida.h"
+#include "pathfinding/maze_landmarks.h"
+#include "pathfinding/maze_dist_cache.h"
+#include "pathfinding/maze_graph.h"
+#include "pathfinding/d_star_lite.h"
+#include "pathfinding/floodfill.h"
 #include "pathfinding/maze.h"
+#include "pathfinding/maze_path.h"
+#include "pathfinding/maze_allocator.h"
+#include "project_test.h"
 
 // Definitions.
 // ----------------------------------------------------------------------------
@@ -25,8 +42,28 @@
  */
 typedef enum
 {
-    GRID_ROWS = 10, ///< Number of rows in the grid.
-    GRID_COLS = 10  ///< Number of columns in the grid.
+    GRID_ROWS               = 10,  ///< Number of rows in the grid.
+    GRID_COLS               = 10,  ///< Number of columns in the grid.
+    NUM_JPS_MAZES           = 500, ///< Random mazes searched with JPS.
+    NUM_BIDIRECTIONAL_MAZES = 300, ///< Random mazes searched from both ends.
+    NUM_ANYTIME_MAZES       = 100, ///< Random mazes searched a piece at a time.
+    ANYTIME_BUDGET          = 7,   ///< Nodes expanded in each piece.
+    ANYTIME_DEADLINE_US     = 2,   ///< Microseconds of each piece with a clock.
+    NUM_BATCH_MAZES         = 40,  ///< Random mazes searched in batches.
+    NUM_BATCH_QUERIES       = 64,  ///< Most queries in each batch.
+    MAX_BATCH_THREADS       = 4,   ///< Most threads that a batch runs on.
+    NUM_BATCH_LANDMARKS     = 4,   ///< Landmarks of the batches with ALT.
+    MAX_BATCH_BLOCKS        = 40,  ///< Most blocks allocated by a batch that
+                                   ///< runs out of memory.
+    NUM_WEIGHTED_MAZES      = 200, ///< Random mazes with random cell costs.
+    MAX_LOW_COST            = 4,   ///< Highest cost of most weighted cells.
+    HIGH_COST_SHARE         = 10,  ///< Percentage of cells that cost up to
+                                   ///< MAZE_CELL_COST_MAX.
+    NUM_IDA_MAZES           = 150, ///< Random mazes searched with IDA*.
+    MAX_IDA_SIZE            = 12,  ///< Largest side of the IDA* mazes.
+    IDA_BYTES_PER_CELL      = 32,  ///< Ceiling of IDA* with room to spare.
+    MAX_JPS_SIZE            = 24,  ///< Largest side of the random mazes.
+    JPS_SEED                = 2004 ///< Seed of the random mazes.
 } constants_t;
 
 /**
@@ -40,6 +77,24 @@ static const uint16_t g_bitmask_array[25] = {
     0x3, 0xB, 0x9, 0x2, 0x9  // last row
 };
 
+/**
+ * @brief Bitmask array of a maze with a short path that zigzags and a longer
+ * path with fewer turns, from the top-left cell to (2, 2).
+ */
+static const uint16_t g_detour_bitmask_array[16] = {
+    0x6, 0xC, 0x0, 0x0, // Top Row
+    0x5, 0x3, 0xC, 0x0, // 2nd row
+    0x5, 0x0, 0x5, 0x0, // 3rd row
+    0x3, 0xA, 0x9, 0x0  // last row
+};
+
+static uint64_t g_fake_time_us = 0; // Time of the fake clock.
+static uint32_t g_num_blocks_left = 0; // Blocks left to the limited allocator.
+#ifdef MAZE_THREADS
+// Guards the blocks left to the limited allocator.
+static pthread_mutex_t g_blocks_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 // Test function prototypes.
 // ----------------------------------------------------------------------------
 //
@@ -55,11 +110,43 @@ static int test_print_route(void);
 static int test_maze_deserialisation(void);
 static int test_maze_serialisation(void);
 static int test_complex_maze_pathfinding(void);
+static int test_large_maze_pathfinding(void);
+static int test_large_maze_buffer(void);
+static int test_search_epoch(void);
+static int test_search_context(void);
+static int test_turn_aware_detour(void);
+static int test_turn_aware_drive_cost(void);
+static int test_jump_point_search(void);
+static int test_bidirectional_search(void);
+static int test_anytime_search(void);
+static int test_batch_search(void);
+static int test_weighted_search(void);
+static int test_ida_search(void);
 
 // Private function prototypes.
 // ----------------------------------------------------------------------------
 //
 static maze_grid_t generate_col_maze(uint16_t rows, uint16_t cols);
+static maze_grid_t generate_random_maze(uint16_t rows,
+                                        uint16_t cols,
+                                        uint32_t wall_share);
+static uint32_t    get_drive_cost(const a_star_path_t       *p_path,
+                                  maze_cardinal_direction_t  orientation,
+                                  const a_star_turn_costs_t *p_costs);
+static bool        is_path_valid(const maze_grid_t      *p_grid,
+                                 const a_star_path_t    *p_path,
+                                 const maze_grid_cell_t *p_start_node,
+                                 const maze_grid_cell_t *p_end_node);
+static uint32_t    get_path_cost(const maze_grid_t   *p_grid,
+                                 const a_star_path_t *p_path);
+static uint32_t    get_weighted_dist(const maze_grid_t      *p_grid,
+                                     const maze_grid_cell_t *p_start_node,
+                                     const maze_grid_cell_t *p_end_node);
+static uint64_t    get_fake_time_us(void);
+static bool        take_limited_block(void);
+static void       *alloc_limited(void *p_state, size_t size);
+static void       *realloc_limited(void *p_state, void *p_block, size_t size);
+static void        free_limited(void *p_state, void *p_block);
 
 /**
  * @brief The main function for the pathfinding tests.
@@ -85,6 +172,8 @@ pathfinding_tests (int argc, char *argv[])
         }
     }
 
+    set_random_seed(JPS_SEED);
+
     int ret_val = 0;
     switch (choice)
     {
@@ -121,6 +210,42 @@ pathfinding_tests (int argc, char *argv[])
         case 11:
             ret_val = test_complex_maze_pathfinding();
             break;
+        case 12:
+            ret_val = test_large_maze_pathfinding();
+            break;
+        case 13:
+            ret_val = test_large_maze_buffer();
+            break;
+        case 14:
+            ret_val = test_search_epoch();
+            break;
+        case 15:
+            ret_val = test_search_context();
+            break;
+        case 16:
+            ret_val = test_turn_aware_detour();
+            break;
+        case 17:
+            ret_val = test_turn_aware_drive_cost();
+            break;
+        case 18:
+            ret_val = test_jump_point_search();
+            break;
+        case 19:
+            ret_val = test_bidirectional_search();
+            break;
+        case 20:
+            ret_val = test_anytime_search();
+            break;
+        case 21:
+            ret_val = test_batch_search();
+            break;
+        case 22:
+            ret_val = test_weighted_search();
+            break;
+        case 23:
+            ret_val = test_ida_search();
+            break;
         default:
             printf("Invalid Test #%d. Terminating.\n", choice);
             ret_val = -1;
@@ -621,39 +746,1475 @@ end: // Clean up all malloc'd memory.
     return ret_val;
 }
 
-// Private functions.
-// ----------------------------------------------------------------------------
-//
+/**
+ * @brief Tests the pathfinding algorithm on a serpentine maze with more than
+ * UINT16_MAX cells, where every cell is on the path. Only runs when the
+ * library is built with 32-bit cell indices.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_large_maze_pathfinding (void)
+{
+#if 32 == MAZE_IDX_WIDTH
+    int ret_val = 0;
+
+    const uint16_t rows      = 33;
+    const uint16_t cols      = 2048;
+    const uint32_t num_cells = (uint32_t)rows * cols;
+
+    // Step 1: Build the serpentine maze. Each row is an open corridor, joined
+    // to the next row at alternating ends.
+    //
+    maze_grid_t        maze        = maze_create(rows, cols);
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = calloc(num_cells, sizeof(uint16_t)),
+        .rows      = rows,
+        .columns   = cols,
+    };
+
+    for (uint16_t row = 0; rows > row; row++)
+    {
+        uint16_t join_col = (0 == row % 2) ? cols - 1 : 0;
+
+        for (uint16_t col = 0; cols > col; col++)
+        {
+            uint16_t *p_gaps
+                = &gap_bitmask.p_bitmask[(uint32_t)row * cols + col];
+
+            *p_gaps |= (0 < col) ? (1u << MAZE_WEST) : 0;
+            *p_gaps |= (cols - 1 > col) ? (1u << MAZE_EAST) : 0;
+
+            if (join_col == col && rows - 1 > row)
+            {
+                *p_gaps |= 1u << MAZE_SOUTH;
+                gap_bitmask.p_bitmask[(uint32_t)(row + 1) * cols + col]
+                    |= 1u << MAZE_NORTH;
+            }
+        }
+    }
+
+    maze_deserialise(&maze, &gap_bitmask);
+
+    // Step 2: Run the A* algorithm from one end of the serpentine to the
+    // other.
+    //
+    maze_point_t start_point = { 0, 0 };
+    maze_point_t end_point   = { cols - 1, rows - 1 };
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    a_star(&maze, p_start, p_end);
+
+    if (num_cells - 1 != p_end->g)
+    {
+        printf("End g-value is %u when it should be %u.\n",
+               p_end->g,
+               num_cells - 1);
+        ret_val = -1;
+        goto end;
+    }
+
+    a_star_path_t *p_path = a_star_get_path(p_end);
+
+    if (num_cells != p_path->length)
+    {
+        printf("Path length is %u when it should be %u.\n",
+               p_path->length,
+               num_cells);
+        ret_val = -1;
+    }
+
+    free(p_path->p_path);
+    free(p_path);
+
+end:
+    free(gap_bitmask.p_bitmask);
+    maze_destroy(&maze);
+
+    return ret_val;
+#else
+    printf("Skipped, MAZE_IDX_WIDTH is %d.\n", MAZE_IDX_WIDTH);
+    return 0;
+#endif
+}
 
 /**
- * @brief Generates a maze that is a single column that leads to the objective.
+ * @brief Tests that a maze with more than 255 cells is compressed into the
+ * buffer in full.
  *
- * @param[in] rows Number of rows in the maze.
- * @param[in] cols Number of columns in the maze.
- * @return maze_grid_t Generated maze.
+ * @return int 0 if the test passes, -1 otherwise.
  */
-static maze_grid_t
-generate_col_maze (uint16_t rows, uint16_t cols)
+static int
+test_large_maze_buffer (void)
 {
-    maze_grid_t maze = maze_create(rows, cols);
+    int ret_val = 0;
 
-    // Set the walls of the maze. Should just be a column that leads to the
-    // objective.
+    const uint16_t rows        = 20;
+    const uint16_t cols        = 21;
+    const size_t   num_cells   = (size_t)rows * cols;
+    const size_t   buffer_size = 4 + num_cells / 2 + num_cells % 2;
+
+    maze_gap_bitmask_t gap_bitmask = {
+        .p_bitmask = malloc(sizeof(uint16_t) * num_cells),
+        .rows      = rows,
+        .columns   = cols,
+    };
+
+    for (size_t cell = 0; num_cells > cell; cell++)
+    {
+        gap_bitmask.p_bitmask[cell] = (uint16_t)(cell % 16);
+    }
+
+    uint8_t *p_buffer = calloc(buffer_size, sizeof(uint8_t));
+
+    if (0 != maze_serialised_to_buffer(&gap_bitmask, p_buffer, buffer_size))
+    {
+        printf("Failed to serialise maze.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Each byte after the header holds two cells, the first in the MSBs.
     //
-    maze_grid_cell_t *p_current_node = &maze.p_grid_array[0];
+    for (size_t cell = 0; num_cells > cell; cell++)
+    {
+        uint8_t byte   = p_buffer[4 + cell / 2];
+        uint8_t nibble = (0 == cell % 2) ? (byte >> 4) : (byte & 0xF);
 
-    // Deal with the first node.
+        if (gap_bitmask.p_bitmask[cell] != nibble)
+        {
+            printf("Cell %zu is %x when it should be %x.\n",
+                   cell,
+                   nibble,
+                   gap_bitmask.p_bitmask[cell]);
+            ret_val = -1;
+            goto end;
+        }
+    }
+
+end:
+    free(p_buffer);
+    free(gap_bitmask.p_bitmask);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that search values from a previous search epoch are treated as
+ * UINT32_MAX, including after the epoch counter wraps around.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_search_epoch (void)
+{
+    int ret_val = 0;
+
+    maze_grid_t maze = maze_create(5, 5);
+
+    maze_gap_bitmask_t gap_bitmask
+        = { .p_bitmask = (uint16_t *)g_bitmask_array, .rows = 5, .columns = 5 };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    // Step 1: Search to the far corner, then search again to a closer cell.
+    // The second search must not see the g-values of the first.
     //
-    for (uint32_t row = 0; GRID_ROWS - 1 > row; row++)
+    maze_point_t start_point = { 0, 4 };
+    maze_point_t far_point   = { 4, 0 };
+    maze_point_t near_point  = { 1, 4 };
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_far   = maze_get_cell_at_coords(&maze, &far_point);
+    maze_grid_cell_t *p_near  = maze_get_cell_at_coords(&maze, &near_point);
+
+    a_star(&maze, p_start, p_far);
+    uint32_t far_g = p_far->g;
+
+    a_star(&maze, p_start, p_near);
+    maze_stamp_cell(&maze, p_far);
+
+    if (UINT32_MAX != p_far->g && far_g == p_far->g)
     {
-        // Conversion to ptrdiff_t is ok because the result is always positive.
-        p_current_node->p_next[MAZE_SOUTH]
-            = &maze.p_grid_array[(ptrdiff_t)((row + 1) * GRID_COLS)];
-        p_current_node->p_next[MAZE_SOUTH]->p_next[MAZE_NORTH] = p_current_node;
-        p_current_node = p_current_node->p_next[MAZE_SOUTH];
+        printf("Stale g-value %u survived a new search.\n", p_far->g);
+        ret_val = -1;
+        goto end;
     }
 
-    return maze;
+    // Step 2: Force the epoch counter to wrap around.
+    //
+    maze.epoch = UINT32_MAX;
+    maze_stamp_cell(&maze, p_start);
+    p_start->g = 0;
+    maze_new_epoch(&maze);
+    maze_stamp_cell(&maze, p_start);
+
+    if (UINT32_MAX != p_start->g || 0 == maze.epoch)
+    {
+        printf("Epoch wrap-around kept g-value %u.\n", p_start->g);
+        ret_val = -1;
+    }
+
+end:
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that two searches with their own contexts can be interleaved on
+ * the same maze without writing to it, and that they agree with A*.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_search_context (void)
+{
+    int ret_val = 0;
+
+    maze_grid_t maze = maze_create(5, 5);
+
+    maze_gap_bitmask_t gap_bitmask
+        = { .p_bitmask = (uint16_t *)g_bitmask_array, .rows = 5, .columns = 5 };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t start_point = { 0, 4 };
+    maze_point_t far_point   = { 4, 0 };
+    maze_point_t near_point  = { 1, 4 };
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_far   = maze_get_cell_at_coords(&maze, &far_point);
+    maze_grid_cell_t *p_near  = maze_get_cell_at_coords(&maze, &near_point);
+
+    // Step 1: Keep a copy of the maze to check that it is not written to.
+    //
+    size_t            grid_size = sizeof(maze_grid_cell_t) * 5 * 5;
+    maze_grid_cell_t *p_copy    = malloc(grid_size);
+    memcpy(p_copy, maze.p_grid_array, grid_size);
+
+    // Step 2: Run both searches, then read both paths.
+    //
+    search_context_t context_a = search_context_create(5 * 5);
+    search_context_t context_b = search_context_create(5 * 5);
+
+    bool is_far_found  = a_star_ctx(&maze, &context_a, p_start, p_far);
+    bool is_near_found = a_star_ctx(&maze, &context_b, p_start, p_near);
+
+    a_star_path_t *p_far_path  = a_star_ctx_get_path(&maze, &context_a, p_far);
+    a_star_path_t *p_near_path = a_star_ctx_get_path(&maze, &context_b, p_near);
+
+    if (!is_far_found || !is_near_found || NULL == p_far_path
+        || NULL == p_near_path)
+    {
+        printf("A search with a context did not find a path.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    if (0 != memcmp(p_copy, maze.p_grid_array, grid_size))
+    {
+        printf("A search with a context wrote to the maze.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 3: Compare the path lengths with A* on the maze itself.
+    //
+    a_star(&maze, p_start, p_far);
+    a_star_path_t *p_path = a_star_get_path(p_far);
+
+    if (p_path->length != p_far_path->length || 2 != p_near_path->length)
+    {
+        printf("Path lengths are %u and %u when they should be %u and 2.\n",
+               p_far_path->length,
+               p_near_path->length,
+               p_path->length);
+        ret_val = -1;
+    }
+
+    free(p_path->p_path);
+    free(p_path);
+
+end:
+    if (NULL != p_far_path)
+    {
+        free(p_far_path->p_path);
+        free(p_far_path);
+    }
+
+    if (NULL != p_near_path)
+    {
+        free(p_near_path->p_path);
+        free(p_near_path);
+    }
+
+    search_context_destroy(&context_a);
+    search_context_destroy(&context_b);
+    free(p_copy);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the turn-aware A* takes a longer path when its turns cost
+ * more than the extra cells, and the shortest path otherwise.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_turn_aware_detour (void)
+{
+    int                ret_val     = 0;
+    maze_grid_t        maze        = maze_create(4, 4);
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask
+                                       = (uint16_t *)g_detour_bitmask_array,
+                                       .rows    = 4,
+                                       .columns = 4 };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t      start_point = { 0, 0 };
+    maze_point_t      end_point   = { 2, 2 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    // Step 1: With the car's costs, four turns are cheaper than two more cells.
+    //
+    a_star_path_t *p_short_path
+        = a_star_turn(&maze, p_start, MAZE_SOUTH, p_end, NULL);
+
+    // Step 2: With slow turns, the path down and around is faster.
+    //
+    a_star_turn_costs_t slow_turns = { .move          = 25,
+                                       .turn_90_deg   = 100,
+                                       .turn_180_deg  = 200,
+                                       .center_offset = 5 };
+    a_star_path_t      *p_long_path
+        = a_star_turn(&maze, p_start, MAZE_SOUTH, p_end, &slow_turns);
+
+    if (NULL == p_short_path || NULL == p_long_path)
+    {
+        printf("Turn-aware A* did not find a path.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    uint32_t short_cost = p_short_path->p_path[p_short_path->length - 1].g;
+    uint32_t long_cost  = p_long_path->p_path[p_long_path->length - 1].g;
+
+    if (5 != p_short_path->length || 192 != short_cost
+        || 7 != p_long_path->length || 360 != long_cost)
+    {
+        printf("Paths have %u cells costing %u and %u cells costing %u when "
+               "they should have 5 costing 192 and 7 costing 360.\n",
+               p_short_path->length,
+               short_cost,
+               p_long_path->length,
+               long_cost);
+        ret_val = -1;
+    }
+
+    char *p_path_str = a_star_get_path_str(&maze, p_long_path);
+    printf("%s\n", p_path_str);
+    free(p_path_str);
+
+end:
+    if (NULL != p_short_path)
+    {
+        free(p_short_path->p_path);
+        free(p_short_path);
+    }
+
+    if (NULL != p_long_path)
+    {
+        free(p_long_path->p_path);
+        free(p_long_path);
+    }
+
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the cost of the turn-aware path is the cost of driving it,
+ * and that it is no more than the cost of driving the shortest path.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_turn_aware_drive_cost (void)
+{
+    int                 ret_val = 0;
+    maze_grid_t         maze    = maze_create(5, 5);
+    a_star_turn_costs_t costs   = a_star_turn_get_default_costs();
+    maze_gap_bitmask_t  gap_bitmask
+        = { .p_bitmask = (uint16_t *)g_bitmask_array, .rows = 5, .columns = 5 };
+    maze_deserialise(&maze, &gap_bitmask);
+
+    maze_point_t      start_point = { 0, 4 };
+    maze_point_t      end_point   = { 4, 0 };
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&maze, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&maze, &end_point);
+
+    a_star_path_t *p_turn_path
+        = a_star_turn(&maze, p_start, MAZE_NORTH, p_end, &costs);
+    a_star(&maze, p_start, p_end);
+    a_star_path_t *p_path = a_star_get_path(p_end);
+
+    if (NULL == p_turn_path)
+    {
+        printf("Turn-aware A* did not find a path.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    uint32_t turn_cost  = p_turn_path->p_path[p_turn_path->length - 1].g;
+    uint32_t drive_cost = get_drive_cost(p_turn_path, MAZE_NORTH, &costs);
+    uint32_t short_cost = get_drive_cost(p_path, MAZE_NORTH, &costs);
+
+    if (turn_cost != drive_cost || turn_cost > short_cost)
+    {
+        printf("Turn-aware path costs %u and drives in %u steps, and the "
+               "shortest path drives in %u steps.\n",
+               turn_cost,
+               drive_cost,
+               short_cost);
+        ret_val = -1;
+    }
+
+    free(p_turn_path->p_path);
+    free(p_turn_path);
+
+end:
+    free(p_path->p_path);
+    free(p_path);
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that Jump Point Search finds paths as short as A* on random
+ * mazes with few to many walls, that its paths only step through gaps, and
+ * that it expands fewer nodes than A* on an open maze.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_jump_point_search (void)
+{
+    int ret_val = 0;
+
+    for (uint32_t maze_num = 0; NUM_JPS_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Open every gap, then add walls to a random share of nodes.
+        // The first maze is left open.
+        //
+        uint16_t    rows       = 1 + get_random() % MAX_JPS_SIZE;
+        uint16_t    cols       = 1 + get_random() % MAX_JPS_SIZE;
+        uint32_t    num_cells  = (uint32_t)rows * cols;
+        uint32_t    wall_share = (0 == maze_num) ? 0 : get_random() % 80;
+        maze_grid_t maze       = generate_random_maze(rows, cols, wall_share);
+
+        // Step 2: Search between opposite corners of the open maze, and
+        // between random nodes otherwise.
+        //
+        maze_grid_cell_t *p_start = &maze.p_grid_array[0];
+        maze_grid_cell_t *p_end   = &maze.p_grid_array[num_cells - 1];
+
+        if (0 != maze_num)
+        {
+            p_start = &maze.p_grid_array[get_random() % num_cells];
+            p_end   = &maze.p_grid_array[get_random() % num_cells];
+        }
+
+        search_context_t context  = search_context_create(num_cells);
+        bool             is_found = a_star_ctx(&maze, &context, p_start, p_end);
+        uint32_t         jps_expanded = 0;
+        a_star_path_t   *p_jps_path
+            = a_star_jps(&maze, p_start, p_end, &jps_expanded);
+
+        // Step 3: Compare the paths with A*.
+        //
+        if (is_found != (NULL != p_jps_path))
+        {
+            printf("Maze %u: A* %s a path, but JPS %s.\n",
+                   maze_num,
+                   is_found ? "found" : "did not find",
+                   (NULL != p_jps_path) ? "did" : "did not");
+            ret_val = -1;
+        }
+        else if (is_found
+                 && (context.p_g[maze_get_cell_idx(&maze, p_end)] + 1u
+                         != p_jps_path->length
+                     || !is_path_valid(&maze, p_jps_path, p_start, p_end)))
+        {
+            printf("Maze %u: JPS found a path of %u cells when A* found one of "
+                   "%u cells.\n",
+                   maze_num,
+                   p_jps_path->length,
+                   context.p_g[maze_get_cell_idx(&maze, p_end)] + 1u);
+            ret_val = -1;
+        }
+        else if (0 == maze_num && 1 < num_cells
+                 && jps_expanded >= context.num_expanded)
+        {
+            printf("JPS expanded %u nodes of the open maze, and A* %u.\n",
+                   jps_expanded,
+                   context.num_expanded);
+            ret_val = -1;
+        }
+
+        if (NULL != p_jps_path)
+        {
+            free(p_jps_path->p_path);
+            free(p_jps_path);
+        }
+
+        search_context_destroy(&context);
+        maze_destroy(&maze);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that the bidirectional search finds paths as short as A* on
+ * random mazes, on one thread and on two, and that its paths only step
+ * through gaps.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_bidirectional_search (void)
+{
+    int ret_val = 0;
+
+    for (uint32_t maze_num = 0;
+         NUM_BIDIRECTIONAL_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Search between random nodes of a random maze with A*.
+        //
+        uint16_t    rows      = 1 + get_random() % MAX_JPS_SIZE;
+        uint16_t    cols      = 1 + get_random() % MAX_JPS_SIZE;
+        uint32_t    num_cells = (uint32_t)rows * cols;
+        maze_grid_t maze = generate_random_maze(rows, cols, get_random() % 80);
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % num_cells];
+        maze_grid_cell_t *p_end = &maze.p_grid_array[get_random() % num_cells];
+
+        search_context_t forward  = search_context_create(num_cells);
+        search_context_t backward = search_context_create(num_cells);
+        bool     is_found = a_star_ctx(&maze, &forward, p_start, p_end);
+        uint32_t length
+            = is_found ? forward.p_g[maze_get_cell_idx(&maze, p_end)] + 1u : 0;
+
+        // Step 2: Search from both ends, with and without a second thread, and
+        // compare the paths with A*.
+        //
+        for (uint8_t is_threaded = 0; 2 > is_threaded && 0 == ret_val;
+             is_threaded++)
+        {
+            a_star_path_t *p_path = a_star_bidirectional(
+                &maze, &forward, &backward, p_start, p_end, is_threaded);
+
+            if (is_found != (NULL != p_path)
+                || (is_found
+                    && (length != p_path->length
+                        || !is_path_valid(&maze, p_path, p_start, p_end))))
+            {
+                printf("Maze %u: the bidirectional search found a path of %u "
+                       "cells when A* found one of %u cells.\n",
+                       maze_num,
+                       (NULL != p_path) ? p_path->length : 0,
+                       length);
+                ret_val = -1;
+            }
+
+            if (NULL != p_path)
+            {
+                free(p_path->p_path);
+                free(p_path);
+            }
+        }
+
+        search_context_destroy(&forward);
+        search_context_destroy(&backward);
+        maze_destroy(&maze);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a search run a piece at a time, with an expansion budget
+ * or a deadline, expands the same nodes as one run to the end, and that the
+ * frontier path is valid whenever it pauses.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_anytime_search (void)
+{
+    int ret_val = 0;
+
+    for (uint32_t maze_num = 0; NUM_ANYTIME_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Search between random nodes of a random maze with A*.
+        //
+        uint16_t    rows      = 1 + get_random() % MAX_JPS_SIZE;
+        uint16_t    cols      = 1 + get_random() % MAX_JPS_SIZE;
+        uint32_t    num_cells = (uint32_t)rows * cols;
+        maze_grid_t maze = generate_random_maze(rows, cols, get_random() % 80);
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % num_cells];
+        maze_grid_cell_t *p_end = &maze.p_grid_array[get_random() % num_cells];
+
+        search_context_t whole    = search_context_create(num_cells);
+        search_context_t pieces   = search_context_create(num_cells);
+        bool             is_found = a_star_ctx(&maze, &whole, p_start, p_end);
+
+        // Step 2: Search again in pieces, alternating between a budget of
+        // expansions and a deadline on a clock that ticks on every read.
+        //
+        a_star_budget_t budget
+            = { .max_expanded = 0, .deadline_us = 0, .p_get_time_us = NULL };
+        a_star_status_t status     = A_STAR_STATUS_PAUSED;
+        uint32_t        num_pauses = 0;
+        uint32_t        last_f     = 0;
+
+        a_star_ctx_start(&maze, &pieces, p_start, p_end);
+
+        while (A_STAR_STATUS_PAUSED == status && 0 == ret_val)
+        {
+            bool is_timed        = 0 != num_pauses % 2;
+            budget.max_expanded  = is_timed ? 0 : ANYTIME_BUDGET;
+            budget.p_get_time_us = is_timed ? &get_fake_time_us : NULL;
+            budget.deadline_us   = g_fake_time_us + ANYTIME_DEADLINE_US;
+
+            uint32_t expanded_before = pieces.num_expanded;
+            status = a_star_ctx_resume(&maze, &pieces, p_end, &budget);
+
+            if (A_STAR_STATUS_PAUSED != status)
+            {
+                break;
+            }
+
+            // The frontier only gets worse as the search goes on, and its
+            // path always starts at the start node.
+            //
+            const maze_grid_cell_t *p_frontier
+                = a_star_ctx_get_frontier(&maze, &pieces);
+            a_star_path_t *p_path
+                = a_star_ctx_get_path(&maze, &pieces, p_frontier);
+            maze_idx_t frontier_idx = maze_get_cell_idx(&maze, p_frontier);
+
+            if (pieces.num_expanded == expanded_before
+                || (!is_timed
+                    && ANYTIME_BUDGET
+                           != pieces.num_expanded - expanded_before)
+                || last_f > pieces.p_f[frontier_idx]
+                || !is_path_valid(&maze, p_path, p_start, p_frontier))
+            {
+                printf("Maze %u: pause %u has an invalid frontier.\n",
+                       maze_num,
+                       num_pauses);
+                ret_val = -1;
+            }
+
+            last_f = pieces.p_f[frontier_idx];
+            num_pauses++;
+            free(p_path->p_path);
+            free(p_path);
+        }
+
+        // Step 3: Compare the finished search with the search run to the end.
+        //
+        if (0 == ret_val
+            && (is_found != (A_STAR_STATUS_FOUND == status)
+                || whole.num_expanded != pieces.num_expanded
+                || (is_found
+                    && whole.p_g[maze_get_cell_idx(&maze, p_end)]
+                           != pieces.p_g[maze_get_cell_idx(&maze, p_end)])))
+        {
+            printf("Maze %u: the search in %u pieces expanded %u nodes when "
+                   "the whole search expanded %u.\n",
+                   maze_num,
+                   num_pauses + 1u,
+                   pieces.num_expanded,
+                   whole.num_expanded);
+            ret_val = -1;
+        }
+
+        search_context_destroy(&whole);
+        search_context_destroy(&pieces);
+        maze_destroy(&maze);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a batch finds the same paths as A* run on each query in
+ * turn, on 1 to 4 threads, with and without landmarks, and that a batch that
+ * runs out of memory only leaves paths out.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_batch_search (void)
+{
+    int            ret_val = 0;
+    a_star_query_t queries[NUM_BATCH_QUERIES];
+    a_star_path_t *paths[NUM_BATCH_QUERIES];
+
+    for (uint32_t maze_num = 0; NUM_BATCH_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Pick random queries on a random maze. There may be fewer
+        // queries than threads.
+        //
+        uint16_t    rows        = 1 + get_random() % MAX_JPS_SIZE;
+        uint16_t    cols        = 1 + get_random() % MAX_JPS_SIZE;
+        uint32_t    num_cells   = (uint32_t)rows * cols;
+        maze_grid_t maze = generate_random_maze(rows, cols, get_random() % 80);
+        uint32_t    num_queries = get_random() % (NUM_BATCH_QUERIES + 1);
+        uint8_t     num_threads = 1 + maze_num % MAX_BATCH_THREADS;
+
+        for (uint32_t query = 0; num_queries > query; query++)
+        {
+            queries[query].p_start_node
+                = &maze.p_grid_array[get_random() % num_cells];
+            queries[query].p_end_node
+                = &maze.p_grid_array[get_random() % num_cells];
+        }
+
+        maze_landmarks_t landmarks
+            = maze_landmarks_create(&maze, NUM_BATCH_LANDMARKS);
+        maze_landmarks_update(&landmarks);
+
+        // Step 2: Run the batch, and compare each path with A*.
+        //
+        search_context_t context   = search_context_create(num_cells);
+        uint32_t         num_found = a_star_batch(
+            &maze,
+            (0 == maze_num % 2) ? &landmarks : NULL,
+            queries,
+            num_queries,
+            paths,
+            num_threads);
+        uint32_t num_expected = 0;
+
+        for (uint32_t query = 0; num_queries > query; query++)
+        {
+            const maze_grid_cell_t *p_start = queries[query].p_start_node;
+            const maze_grid_cell_t *p_end   = queries[query].p_end_node;
+            a_star_path_t          *p_path  = paths[query];
+            bool     is_found = a_star_ctx(&maze, &context, p_start, p_end);
+            uint32_t length
+                = is_found ? context.p_g[maze_get_cell_idx(&maze, p_end)] + 1u
+                           : 0;
+
+            num_expected += is_found;
+
+            if (is_found != (NULL != p_path)
+                || (is_found
+                    && (length != p_path->length
+                        || !is_path_valid(&maze, p_path, p_start, p_end))))
+            {
+                printf("Maze %u: query %u of the batch on %u threads found a "
+                       "path of %u cells when A* found one of %u cells.\n",
+                       maze_num,
+                       query,
+                       num_threads,
+                       (NULL != p_path) ? p_path->length : 0,
+                       length);
+                ret_val = -1;
+            }
+
+            if (NULL != p_path)
+            {
+                maze_free(p_path->p_path);
+                maze_free(p_path);
+            }
+        }
+
+        if (num_expected != num_found)
+        {
+            printf("Maze %u: the batch found %u paths instead of %u.\n",
+                   maze_num,
+                   num_found,
+                   num_expected);
+            ret_val = -1;
+        }
+
+        search_context_destroy(&context);
+        maze_landmarks_destroy(&landmarks);
+        maze_destroy(&maze);
+    }
+
+    // Step 3: Let the allocator fail after a number of blocks, so that the
+    // workers, some search contexts or some paths cannot be allocated.
+    //
+    maze_grid_t maze = generate_random_maze(MAX_JPS_SIZE, MAX_JPS_SIZE, 20);
+
+    maze_allocator_t limited = {
+        .p_alloc   = &alloc_limited,
+        .p_realloc = &realloc_limited,
+        .p_free    = &free_limited,
+        .p_state   = NULL,
+    };
+
+    for (uint32_t query = 0; NUM_BATCH_QUERIES > query; query++)
+    {
+        queries[query].p_start_node = &maze.p_grid_array[0];
+        queries[query].p_end_node
+            = &maze.p_grid_array[get_random() % MAZE_GRID_CELLS(&maze)];
+    }
+
+    for (uint32_t num_blocks = 0;
+         MAX_BATCH_BLOCKS >= num_blocks && 0 == ret_val;
+         num_blocks++)
+    {
+        g_num_blocks_left = num_blocks;
+
+        maze_allocator_t previous  = maze_allocator_set(&limited);
+        uint32_t         num_found = a_star_batch(
+            &maze, NULL, queries, NUM_BATCH_QUERIES, paths, MAX_BATCH_THREADS);
+        maze_allocator_set(&previous);
+
+        for (uint32_t query = 0; NUM_BATCH_QUERIES > query; query++)
+        {
+            a_star_path_t *p_path = paths[query];
+
+            if (NULL == p_path)
+            {
+                continue;
+            }
+
+            if (!is_path_valid(&maze,
+                               p_path,
+                               queries[query].p_start_node,
+                               queries[query].p_end_node))
+            {
+                printf("Query %u of a batch limited to %u blocks found an "
+                       "invalid path.\n",
+                       query,
+                       num_blocks);
+                ret_val = -1;
+            }
+
+            num_found--;
+            maze_free(p_path->p_path);
+            maze_free(p_path);
+        }
+
+        if (0 != num_found)
+        {
+            printf("A batch limited to %u blocks miscounted its paths.\n",
+                   num_blocks);
+            ret_val = -1;
+        }
+    }
+
+    maze_destroy(&maze);
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that every planner finds the cheapest path on random mazes
+ * with random cell costs: A* with and without landmarks, the bidirectional
+ * search, Jump Point Search, the junction graph, the distance fields and D*
+ * Lite.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_weighted_search (void)
+{
+    int ret_val = 0;
+
+    for (uint32_t maze_num = 0; NUM_WEIGHTED_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 1: Give a random maze random costs. Most cells are cheap, and a
+        // few cost up to the most.
+        //
+        uint16_t    rows      = 1 + get_random() % MAX_JPS_SIZE;
+        uint16_t    cols      = 1 + get_random() % MAX_JPS_SIZE;
+        uint32_t    num_cells = (uint32_t)rows * cols;
+        maze_grid_t maze = generate_random_maze(rows, cols, get_random() % 80);
+
+        for (uint32_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+        {
+            uint8_t cost = 1 + get_random() % MAX_LOW_COST;
+
+            if (get_random() % 100 < HIGH_COST_SHARE)
+            {
+                cost = 1 + get_random() % MAZE_CELL_COST_MAX;
+            }
+
+            maze_set_cell_cost(&maze, &maze.p_grid_array[cell_idx], cost);
+        }
+
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % num_cells];
+        maze_grid_cell_t *p_end = &maze.p_grid_array[get_random() % num_cells];
+        uint32_t expected = get_weighted_dist(&maze, p_start, p_end);
+        bool     is_found = UINT32_MAX != expected;
+
+        // Step 2: Search with each planner that returns a path, and check the
+        // cost of the path.
+        //
+        search_context_t forward  = search_context_create(num_cells);
+        search_context_t backward = search_context_create(num_cells);
+        maze_landmarks_t landmarks
+            = maze_landmarks_create(&maze, NUM_BATCH_LANDMARKS);
+        maze_landmarks_update(&landmarks);
+        maze_graph_t graph = maze_graph_create(&maze);
+
+        for (uint8_t planner = 0; 5 > planner && 0 == ret_val; planner++)
+        {
+            a_star_path_t *p_path = NULL;
+
+            if (0 == planner && a_star_ctx(&maze, &forward, p_start, p_end))
+            {
+                p_path = a_star_ctx_get_path(&maze, &forward, p_end);
+            }
+            else if (1 == planner
+                     && a_star_ctx_alt(
+                         &maze, &forward, &landmarks, p_start, p_end))
+            {
+                p_path = a_star_ctx_get_path(&maze, &forward, p_end);
+            }
+            else if (2 == planner)
+            {
+                p_path = a_star_bidirectional(
+                    &maze, &forward, &backward, p_start, p_end, false);
+            }
+            else if (3 == planner)
+            {
+                p_path = a_star_jps(&maze, p_start, p_end, NULL);
+            }
+            else if (4 == planner)
+            {
+                p_path = maze_graph_find_path(&graph, p_start, p_end, NULL);
+            }
+
+            if (is_found != (NULL != p_path)
+                || (is_found
+                    && (expected != get_path_cost(&maze, p_path)
+                        || !is_path_valid(&maze, p_path, p_start, p_end))))
+            {
+                printf("Maze %u: planner %u found a path of cost %u when the "
+                       "cheapest costs %u.\n",
+                       maze_num,
+                       planner,
+                       (NULL != p_path) ? get_path_cost(&maze, p_path) : 0,
+                       expected);
+                ret_val = -1;
+            }
+
+            if (NULL != p_path)
+            {
+                free(p_path->p_path);
+                free(p_path);
+            }
+        }
+
+        // Step 3: Check the distance of the start node to the end node in the
+        // distance field of the end node and in D* Lite.
+        //
+        maze_dist_cache_t        cache   = maze_dist_cache_create(&maze, 1);
+        const maze_dist_field_t *p_field = maze_dist_cache_get(&cache, p_end);
+        maze_dist_t field_dist
+            = p_field->p_dists[maze_get_cell_idx(&maze, p_start)];
+        a_star_path_t *p_path
+            = maze_dist_cache_get_path(&cache, p_field, p_start);
+        d_star_lite_t planner = d_star_lite_create(&maze, p_start, p_end);
+
+        if (0 == ret_val
+            && (is_found != d_star_lite_plan(&planner)
+                || (is_found
+                    && (expected
+                            != planner.p_g[maze_get_cell_idx(&maze, p_start)]
+                        || expected != field_dist
+                        || expected != get_path_cost(&maze, p_path)))))
+        {
+            printf("Maze %u: the distance field or D* Lite is not %u.\n",
+                   maze_num,
+                   expected);
+            ret_val = -1;
+        }
+
+        if (NULL != p_path)
+        {
+            free(p_path->p_path);
+            free(p_path);
+        }
+
+        d_star_lite_destroy(&planner);
+        maze_dist_cache_destroy(&cache);
+        maze_graph_destroy(&graph);
+        maze_landmarks_destroy(&landmarks);
+        search_context_destroy(&forward);
+        search_context_destroy(&backward);
+        maze_destroy(&maze);
+    }
+
+    return ret_val;
+}
+
+/**
+ * @brief Tests that IDA* finds the cheapest path on random weighted mazes in
+ * no more memory than its ceiling, and that a lower ceiling expands more nodes
+ * again.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_ida_search (void)
+{
+    int         ret_val        = 0;
+    uint32_t    roomy_reexpand = 0;
+    uint32_t    tight_reexpand = 0;
+    maze_grid_t maze           = maze_create(MAX_IDA_SIZE, MAX_IDA_SIZE);
+    maze_path_t path;
+
+    // Step 1: Check that a ceiling too small for the expanded bits fails.
+    //
+    if (a_star_ida(&maze,
+                   &maze.p_grid_array[0],
+                   &maze.p_grid_array[0],
+                   0,
+                   &path,
+                   NULL)
+        || 0 != path.num_steps)
+    {
+        printf("IDA* searched without any memory.\n");
+        ret_val = -1;
+    }
+
+    maze_destroy(&maze);
+
+    for (uint32_t maze_num = 0; NUM_IDA_MAZES > maze_num && 0 == ret_val;
+         maze_num++)
+    {
+        // Step 2: Give a random maze random costs.
+        //
+        uint16_t rows      = 1 + get_random() % MAX_IDA_SIZE;
+        uint16_t cols      = 1 + get_random() % MAX_IDA_SIZE;
+        uint32_t num_cells = (uint32_t)rows * cols;
+        maze = generate_random_maze(rows, cols, get_random() % 80);
+
+        for (uint32_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+        {
+            maze_set_cell_cost(&maze,
+                               &maze.p_grid_array[cell_idx],
+                               1 + get_random() % MAX_LOW_COST);
+        }
+
+        maze_grid_cell_t *p_start
+            = &maze.p_grid_array[get_random() % num_cells];
+        maze_grid_cell_t *p_end = &maze.p_grid_array[get_random() % num_cells];
+        uint32_t expected  = get_weighted_dist(&maze, p_start, p_end);
+        bool     is_found  = UINT32_MAX != expected;
+        size_t   max_bytes = (size_t)num_cells * IDA_BYTES_PER_CELL;
+
+        // Step 3: Search with room to spare, then with half of the memory
+        // that it used. A path is only allowed to be dearer than the
+        // cheapest, or missing, if the stack was too shallow.
+        //
+        for (uint8_t run = 0; 2 > run && 0 == ret_val; run++)
+        {
+            a_star_ida_stats_t stats;
+            bool               is_ida_found = a_star_ida(
+                &maze, p_start, p_end, max_bytes, &path, &stats);
+            a_star_path_t *p_path = maze_path_to_a_star_path(&maze, &path);
+
+            if (stats.num_bytes > max_bytes
+                || (is_ida_found
+                    && (stats.path_cost != get_path_cost(&maze, p_path)
+                        || !is_path_valid(&maze, p_path, p_start, p_end)))
+                || (!stats.is_truncated
+                    && (is_found != is_ida_found
+                        || (is_found && expected != stats.path_cost))))
+            {
+                printf("Maze %u: IDA* run %u in %u of %u bytes found a path "
+                       "of cost %u when the cheapest costs %u.\n",
+                       maze_num,
+                       run,
+                       (uint32_t)stats.num_bytes,
+                       (uint32_t)max_bytes,
+                       stats.path_cost,
+                       expected);
+                ret_val = -1;
+            }
+
+            if (0 == run && stats.is_truncated)
+            {
+                printf("Maze %u: IDA* ran out of stack with room to spare.\n",
+                       maze_num);
+                ret_val = -1;
+            }
+
+            if (0 == run)
+            {
+                roomy_reexpand += stats.num_reexpanded;
+                max_bytes = stats.num_bytes / 2u;
+            }
+            else
+            {
+                tight_reexpand += stats.num_reexpanded;
+            }
+
+            if (NULL != p_path)
+            {
+                free(p_path->p_path);
+                free(p_path);
+            }
+
+            maze_path_destroy(&path);
+        }
+
+        maze_destroy(&maze);
+    }
+
+    // Step 4: Check that the searches traded memory for expansions.
+    //
+    if (0 == ret_val && roomy_reexpand >= tight_reexpand)
+    {
+        printf("IDA* expanded %u nodes again with room to spare and %u in "
+               "half of the memory.\n",
+               roomy_reexpand,
+               tight_reexpand);
+        ret_val = -1;
+    }
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Gets the number of encoder steps to drive along a path, turning on
+ * the spot before moving into each cell.
+ *
+ * @param[in] p_path Pointer to the path.
+ * @param[in] orientation Orientation of the car at the first cell.
+ * @param[in] p_costs Pointer to the costs.
+ * @return uint32_t Number of encoder steps.
+ */
+static uint32_t
+get_drive_cost (const a_star_path_t       *p_path,
+                maze_cardinal_direction_t  orientation,
+                const a_star_turn_costs_t *p_costs)
+{
+    uint32_t cost = 0;
+
+    for (uint32_t idx = 1; p_path->length > idx; idx++)
+    {
+        maze_cardinal_direction_t direction
+            = maze_get_dir_from_to(&p_path->p_path[idx - 1].coordinates,
+                                   &p_path->p_path[idx].coordinates);
+
+        if (direction == (orientation + 2) % 4)
+        {
+            cost += p_costs->center_offset + p_costs->turn_180_deg;
+        }
+        else if (direction != orientation)
+        {
+            cost += p_costs->center_offset + p_costs->turn_90_deg;
+        }
+
+        cost += p_costs->move;
+        orientation = direction;
+    }
+
+    return cost;
+}
+
+/**
+ * @brief Checks that a path goes from the start node to the end node, and
+ * that each cell is through a gap from the previous one.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_path Pointer to the path.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return true If the path is valid.
+ * @return false Otherwise.
+ */
+static bool
+is_path_valid (const maze_grid_t      *p_grid,
+               const a_star_path_t    *p_path,
+               const maze_grid_cell_t *p_start_node,
+               const maze_grid_cell_t *p_end_node)
+{
+    const maze_point_t *p_first = &p_path->p_path[0].coordinates;
+    const maze_point_t *p_last
+        = &p_path->p_path[p_path->length - 1].coordinates;
+
+    if (p_first->x != p_start_node->coordinates.x
+        || p_first->y != p_start_node->coordinates.y
+        || p_last->x != p_end_node->coordinates.x
+        || p_last->y != p_end_node->coordinates.y)
+    {
+        return false;
+    }
+
+    for (uint32_t idx = 1; p_path->length > idx; idx++)
+    {
+        const maze_point_t *p_point = &p_path->p_path[idx - 1].coordinates;
+        maze_cardinal_direction_t direction = maze_get_dir_from_to(
+            p_point, &p_path->p_path[idx].coordinates);
+        const maze_grid_cell_t *p_node
+            = &p_grid->p_grid_array[p_point->y * MAZE_GRID_COLS(p_grid)
+                                    + p_point->x];
+
+        if (MAZE_NONE == direction || NULL == p_node->p_next[direction])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Gets the cost of a path: the cost of entering each cell after the
+ * first.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_path Pointer to the path.
+ * @return uint32_t Cost of the path.
+ */
+static uint32_t
+get_path_cost (const maze_grid_t *p_grid, const a_star_path_t *p_path)
+{
+    uint32_t cost = 0;
+
+    for (uint32_t idx = 1; p_path->length > idx; idx++)
+    {
+        const maze_point_t *p_point = &p_path->p_path[idx].coordinates;
+
+        cost += MAZE_CELL_COST(
+            p_grid, p_point->y * MAZE_GRID_COLS(p_grid) + p_point->x);
+    }
+
+    return cost;
+}
+
+/**
+ * @brief Gets the cost of the cheapest path between two nodes by lowering the
+ * cost of every node through its neighbours until none changes.
+ *
+ * @param[in] p_grid The grid maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return uint32_t Cost of the cheapest path, UINT32_MAX if there is none.
+ */
+static uint32_t
+get_weighted_dist (const maze_grid_t      *p_grid,
+                   const maze_grid_cell_t *p_start_node,
+                   const maze_grid_cell_t *p_end_node)
+{
+    size_t    num_cells  = MAZE_GRID_CELLS(p_grid);
+    uint32_t *p_dists    = malloc(sizeof(uint32_t) * num_cells);
+    bool      is_changed = true;
+
+    for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+    {
+        p_dists[cell_idx] = UINT32_MAX;
+    }
+
+    p_dists[maze_get_cell_idx(p_grid, p_start_node)] = 0;
+
+    while (is_changed)
+    {
+        is_changed = false;
+
+        for (size_t cell_idx = 0; num_cells > cell_idx; cell_idx++)
+        {
+            const maze_grid_cell_t *p_node = &p_grid->p_grid_array[cell_idx];
+
+            for (uint8_t direction = 0;
+                 UINT32_MAX != p_dists[cell_idx] && 4 > direction;
+                 direction++)
+            {
+                if (NULL == p_node->p_next[direction])
+                {
+                    continue;
+                }
+
+                maze_idx_t next_idx
+                    = maze_get_cell_idx(p_grid, p_node->p_next[direction]);
+                uint32_t dist
+                    = p_dists[cell_idx] + MAZE_CELL_COST(p_grid, next_idx);
+
+                if (dist < p_dists[next_idx])
+                {
+                    p_dists[next_idx] = dist;
+                    is_changed        = true;
+                }
+            }
+        }
+    }
+
+    uint32_t dist = p_dists[maze_get_cell_idx(p_grid, p_end_node)];
+    free(p_dists);
+
+    return dist;
+}
+
+/**
+ * @brief Reads a fake clock that moves forward 1 us every time it is read, so
+ * that searches with a deadline pause at the same place on every platform.
+ *
+ * @return uint64_t Time of the fake clock in microseconds.
+ */
+static uint64_t
+get_fake_time_us (void)
+{
+    return g_fake_time_us++;
+}
+
+/**
+ * @brief Generates a maze with every gap open, then adds a wall on a random
+ * side of a share of the nodes.
+ *
+ * @param[in] rows Number of rows in the maze.
+ * @param[in] cols Number of columns in the maze.
+ * @param[in] wall_share Percentage of nodes to add a wall to.
+ * @return maze_grid_t Generated maze.
+ */
+static maze_grid_t
+generate_random_maze (uint16_t rows, uint16_t cols, uint32_t wall_share)
+{
+    maze_grid_t maze = maze_create(rows, cols);
+    floodfill_init_maze_nowall(&maze);
+
+    for (uint32_t cell_idx = 0; (uint32_t)rows * cols > cell_idx; cell_idx++)
+    {
+        maze_grid_cell_t      *p_node = &maze.p_grid_array[cell_idx];
+        maze_navigator_state_t wall_setter
+            = { p_node, p_node, p_node, MAZE_NORTH };
+
+        if (get_random() % 100 < wall_share)
+        {
+            maze_nav_modify_walls(
+                &maze, &wall_setter, 1u << (get_random() % 4), true, false);
+        }
+    }
+
+    return maze;
+}
+
+/**
+ * @brief Generates a maze that is a single column that leads to the objective.
+ *
+ * @param[in] rows Number of rows in the maze.
+ * @param[in] cols Number of columns in the maze.
+ * @return maze_grid_t Generated maze.
+ */
+static maze_grid_t
+generate_col_maze (uint16_t rows, uint16_t cols)
+{
+    maze_grid_t maze = maze_create(rows, cols);
+
+    // Set the walls of the maze. Should just be a column that leads to the
+    // objective.
+    //
+    maze_grid_cell_t *p_current_node = &maze.p_grid_array[0];
+
+    // Deal with the first node.
+    //
+    for (uint32_t row = 0; GRID_ROWS - 1 > row; row++)
+    {
+        // Conversion to ptrdiff_t is ok because the result is always positive.
+        p_current_node->p_next[MAZE_SOUTH]
+            = &maze.p_grid_array[(ptrdiff_t)((row + 1) * GRID_COLS)];
+        p_current_node->p_next[MAZE_SOUTH]->p_next[MAZE_NORTH] = p_current_node;
+        p_current_node = p_current_node->p_next[MAZE_SOUTH];
+    }
+
+    return maze;
+}
+
+/**
+ * @brief Takes one of the blocks left to the limited allocator.
+ *
+ * @return true If a block was left.
+ * @return false Otherwise.
+ */
+static bool
+take_limited_block (void)
+{
+    bool is_taken = false;
+
+#ifdef MAZE_THREADS
+    pthread_mutex_lock(&g_blocks_mutex);
+#endif
+    if (0 < g_num_blocks_left)
+    {
+        g_num_blocks_left--;
+        is_taken = true;
+    }
+#ifdef MAZE_THREADS
+    pthread_mutex_unlock(&g_blocks_mutex);
+#endif
+
+    return is_taken;
+}
+
+/**
+ * @brief Allocates a block from the heap until the blocks left run out.
+ *
+ * @param[in] p_state Unused.
+ * @param[in] size Size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+alloc_limited (void *p_state, size_t size)
+{
+    (void)p_state;
+    return take_limited_block() ? malloc(size) : NULL;
+}
+
+/**
+ * @brief Resizes a block on the heap, which takes one of the blocks left.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ * @param[in] size New size of the block.
+ * @return void* Pointer to the block, NULL once no blocks are left.
+ */
+static void *
+realloc_limited (void *p_state, void *p_block, size_t size)
+{
+    (void)p_state;
+    return take_limited_block() ? realloc(p_block, size) : NULL;
+}
+
+/**
+ * @brief Frees a block on the heap.
+ *
+ * @param[in] p_state Unused.
+ * @param[in,out] p_block Pointer to the block.
+ */
+static void
+free_limited (void *p_state, void *p_block)
+{
+    (void)p_state;
+    free(p_block);
 }
 
 // End of file tests/tests.c
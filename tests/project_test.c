@@ -9,9 +9,15 @@
  *
  */
 
+#include <stddef.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "pathfinding/maze.h"
+#include "project_test.h"
+
+static uint32_t g_rng_state = 1; // State of the xorshift generator.
 
 void
 report_error (const char *p_msg,
@@ -25,4 +31,84 @@ report_error (const char *p_msg,
     {
         exit(-1);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Restarts the xorshift generator, so that each test sees the same
+ * numbers on every run.
+ *
+ * @param[in] seed Seed of the generator. It must not be 0.
+ */
+void
+set_random_seed (uint32_t seed)
+{
+    g_rng_state = seed;
+}
+
+/**
+ * @brief Gets the next number of a xorshift generator.
+ *
+ * @return uint32_t Pseudo-random number.
+ */
+uint32_t
+get_random (void)
+{
+    g_rng_state ^= g_rng_state << 13;
+    g_rng_state ^= g_rng_state >> 17;
+    g_rng_state ^= g_rng_state << 5;
+    return g_rng_state;
+}
+
+/**
+ * @brief Gets the distance between two nodes with a breadth-first search.
+ *
+ * @param[in] p_grid Pointer to the maze.
+ * @param[in] p_start_node Pointer to the start node.
+ * @param[in] p_end_node Pointer to the end node.
+ * @return uint32_t Distance, UINT32_MAX if the end node is unreachable.
+ */
+uint32_t
+get_bfs_dist (const maze_grid_t      *p_grid,
+              const maze_grid_cell_t *p_start_node,
+              const maze_grid_cell_t *p_end_node)
+{
+    size_t                   num_cells = MAZE_GRID_CELLS(p_grid);
+    const maze_grid_cell_t **p_queue   = malloc(sizeof(*p_queue) * num_cells);
+    uint32_t                *p_dist    = malloc(sizeof(uint32_t) * num_cells);
+    uint32_t                 head      = 0;
+    uint32_t                 tail      = 0;
+
+    for (size_t idx = 0; num_cells > idx; idx++)
+    {
+        p_dist[idx] = UINT32_MAX;
+    }
+
+    p_dist[maze_get_cell_idx(p_grid, p_start_node)] = 0;
+    p_queue[tail++]                                 = p_start_node;
+
+    while (head < tail)
+    {
+        const maze_grid_cell_t *p_cell = p_queue[head++];
+        uint32_t dist = p_dist[maze_get_cell_idx(p_grid, p_cell)];
+
+        for (uint8_t direction = 0; 4 > direction; direction++)
+        {
+            const maze_grid_cell_t *p_next = p_cell->p_next[direction];
+
+            if (NULL != p_next
+                && UINT32_MAX == p_dist[maze_get_cell_idx(p_grid, p_next)])
+            {
+                p_dist[maze_get_cell_idx(p_grid, p_next)] = dist + 1;
+                p_queue[tail++]                           = p_next;
+            }
+        }
+    }
+
+    uint32_t dist = p_dist[maze_get_cell_idx(p_grid, p_end_node)];
+    free(p_queue);
+    free(p_dist);
+
+    return dist;
+}
+
+// End of project_test.c
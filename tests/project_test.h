@@ -0,0 +1,41 @@
+/**
+ * @file project_test.h
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief Header file for the helpers shared by the tests: error reports, the
+ * pseudo-random generator of the random mazes and a breadth-first distance to
+ * check the planners against.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef PROJECT_TEST_H // Include guard.
+#define PROJECT_TEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pathfinding/maze.h"
+
+// Public function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+void report_error(const char *p_msg,
+                  const char *p_file,
+                  int         line,
+                  const char *p_func_name,
+                  bool        require);
+
+void set_random_seed(uint32_t seed);
+
+uint32_t get_random(void);
+
+uint32_t get_bfs_dist(const maze_grid_t      *p_grid,
+                      const maze_grid_cell_t *p_start_node,
+                      const maze_grid_cell_t *p_end_node);
+
+#endif // PROJECT_TEST_H
+
+// End of project_test.h
@@ -0,0 +1,361 @@
+/**
+ * @file render_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the maze renderer.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_arena.h"
+#include "pathfinding/maze_render.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS       = 6,    ///< Number of rows in the grid.
+    GRID_COLS       = 4,    ///< Number of columns in the grid.
+    LARGE_GRID_ROWS = 100,  ///< Number of rows in the large grid.
+    LARGE_GRID_COLS = 100,  ///< Number of columns in the large grid.
+    WORKSPACE       = 16384 ///< Size of the arena workspace in bytes.
+} constants_t;
+
+/**
+ * @brief This struct contains the state of the sink that checks each line.
+ */
+typedef struct line_checker
+{
+    const char *p_expected; ///< String the lines should match.
+    size_t      offset;     ///< Offset of the next line in the string.
+    uint32_t    num_lines;  ///< Number of lines received.
+    bool        is_match;   ///< Whether every line matched so far.
+} line_checker_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+/**
+ * @brief Workspace of the arena.
+ */
+static uint8_t g_workspace[WORKSPACE];
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_render_overlay(void);
+static int test_render_streaming(void);
+static int test_render_large(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static void check_line(void *p_context, const char *p_line, size_t length);
+
+/**
+ * @brief Runs the tests for the renderer.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+render_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_render_overlay();
+            break;
+        case 2:
+            ret_val = test_render_streaming();
+            break;
+        case 3:
+            ret_val = test_render_large();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that drawing the path and navigator in one pass gives the same
+ * string as drawing the path and then inserting the navigator.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_render_overlay (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_grid_t grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    a_star(&grid, p_start, p_end);
+    a_star_path_t *p_path = a_star_get_path(p_end);
+
+    maze_grid_cell_t *p_nav_cell
+        = maze_get_cell_at_coords(&grid, &p_path->p_path[2].coordinates);
+    maze_navigator_state_t navigator
+        = { p_nav_cell, p_start, p_end, MAZE_WEST };
+
+    char *p_expected = a_star_get_path_str(&grid, p_path);
+    maze_insert_nav_str(&grid, &navigator, p_expected);
+
+    maze_render_overlay_t overlay = {
+        .p_navigator = &navigator,
+        .p_path      = p_path->p_path,
+        .path_length = p_path->length,
+        .p_steps     = NULL,
+    };
+    char *p_result = maze_render_to_string(&grid, &overlay);
+
+    if (NULL == p_result || 0 != strcmp(p_expected, p_result))
+    {
+        printf("Expected:\n%s\nGot:\n%s\n", p_expected, p_result);
+        ret_val = -1;
+    }
+    else
+    {
+        printf("%s\n", p_result);
+    }
+
+    maze_free(p_result);
+    maze_free(p_expected);
+    maze_free(p_path->p_path);
+    maze_free(p_path);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that streaming gives the same lines as the string, and that it
+ * holds no more than one line and the path marks in memory.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_render_streaming (void)
+{
+    int         ret_val = 0;
+    maze_grid_t grid    = maze_create(LARGE_GRID_ROWS, LARGE_GRID_COLS);
+    floodfill_init_maze_nowall(&grid);
+
+    maze_point_t start_point = { 0, 0 };
+    maze_point_t end_point   = { LARGE_GRID_COLS - 1, LARGE_GRID_ROWS - 1 };
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &end_point);
+    a_star(&grid, p_start, p_end);
+    a_star_path_t *p_path = a_star_get_path(p_end);
+
+    maze_render_overlay_t overlay = {
+        .p_navigator = NULL,
+        .p_path      = p_path->p_path,
+        .path_length = p_path->length,
+        .p_steps     = NULL,
+    };
+    char *p_expected = a_star_get_path_str(&grid, p_path);
+
+    // Step 1: Stream the lines from an arena to measure the peak.
+    //
+    maze_arena_t arena;
+    maze_arena_init(&arena, g_workspace, sizeof(g_workspace));
+    maze_allocator_t allocator = maze_arena_get_allocator(&arena);
+    maze_allocator_t previous  = maze_allocator_set(&allocator);
+
+    line_checker_t checker = { p_expected, 0, 0, true };
+    int16_t render_ret = maze_render(&grid, &overlay, &check_line, &checker);
+
+    maze_allocator_set(&previous);
+
+    // Step 2: Compare the lines and the memory used.
+    //
+    size_t string_size = strlen(p_expected) + 1u;
+
+    if (0 != render_ret || !checker.is_match
+        || LARGE_GRID_ROWS * 2 + 1 != checker.num_lines)
+    {
+        printf("Streamed %u lines that match: %d.\n",
+               checker.num_lines,
+               checker.is_match);
+        ret_val = -1;
+    }
+
+    if (0 != arena.num_fallbacks || string_size <= arena.peak)
+    {
+        ret_val = -1;
+    }
+
+    printf("Streaming used %zu bytes for a %zu byte map.\n",
+           arena.peak,
+           string_size);
+
+    maze_free(p_expected);
+    maze_free(p_path->p_path);
+    maze_free(p_path);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that rendering a large map to a file takes time linear in the
+ * size of the map.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_render_large (void)
+{
+    int     ret_val = 0;
+    clock_t times[2];
+
+    for (uint8_t pass = 0; 2 > pass; pass++)
+    {
+        uint16_t    size = LARGE_GRID_ROWS * (pass + 1);
+        maze_grid_t grid = maze_create(size, size);
+        FILE       *p_file = tmpfile();
+        floodfill_init_maze_nowall(&grid);
+
+        if (NULL == p_file)
+        {
+            printf("Could not open a temporary file.\n");
+            maze_destroy(&grid);
+            return -1;
+        }
+
+        clock_t start = clock();
+
+        for (uint8_t repeat = 0; 10 > repeat; repeat++)
+        {
+            rewind(p_file);
+
+            if (0 != maze_render_to_file(&grid, NULL, p_file))
+            {
+                printf("Could not render to the file.\n");
+                ret_val = -1;
+            }
+        }
+
+        times[pass] = clock() - start;
+        printf("Rendered %ux%u in %.3f ms.\n",
+               size,
+               size,
+               (double)times[pass] * 100.0 / CLOCKS_PER_SEC);
+
+        fclose(p_file);
+        maze_destroy(&grid);
+    }
+
+    // Doubling the side quadruples the cells. A quadratic renderer would take
+    // 16 times as long.
+    //
+    if (times[1] > times[0] * 10 && CLOCKS_PER_SEC / 100 < times[1])
+    {
+        printf("Rendering is not linear.\n");
+        ret_val = -1;
+    }
+
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Sink that checks each line against the expected string.
+ *
+ * @param[in,out] p_context Pointer to the line checker.
+ * @param[in] p_line Characters of the line.
+ * @param[in] length Number of characters in the line.
+ */
+static void
+check_line (void *p_context, const char *p_line, size_t length)
+{
+    line_checker_t *p_checker  = p_context;
+    const char     *p_expected = &p_checker->p_expected[p_checker->offset];
+
+    p_checker->num_lines++;
+
+    if (!p_checker->is_match)
+    {
+        return;
+    }
+
+    if (0 != strncmp(p_expected, p_line, length)
+        || ('\n' != p_expected[length] && '\0' != p_expected[length]))
+    {
+        p_checker->is_match = false;
+    }
+
+    p_checker->offset += length + 1u;
+}
+
+// End of render_tests.c
@@ -0,0 +1,345 @@
+/**
+ * @file snapshot_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for versioned maps and their
+ * copy-on-write snapshots.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_snapshot.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS = 6, ///< Number of rows in the grid.
+    GRID_COLS = 4  ///< Number of columns in the grid.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_snapshot_frozen(void);
+static int test_snapshot_plan_while_mapping(void);
+static int test_snapshot_outlives_map(void);
+
+/**
+ * @brief Runs the tests for the snapshots.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+snapshot_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_snapshot_frozen();
+            break;
+        case 2:
+            ret_val = test_snapshot_plan_while_mapping();
+            break;
+        case 3:
+            ret_val = test_snapshot_outlives_map();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that a snapshot does not see later writes, and that only the
+ * rows written to are copied.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_snapshot_frozen (void)
+{
+    int              ret_val = 0;
+    maze_grid_t      grid    = maze_create(GRID_ROWS, GRID_COLS);
+    maze_versioned_t map;
+    floodfill_init_maze_nowall(&grid);
+
+    if (0 != maze_versioned_init(&map, &grid))
+    {
+        printf("Could not initialise the versioned map.\n");
+        maze_destroy(&grid);
+        return -1;
+    }
+
+    maze_snapshot_t *p_old = maze_versioned_snapshot(&map);
+
+    // Step 1: Set the wall south of (1, 2), which is also north of (1, 3).
+    //
+    maze_point_t           point     = { 1, 2 };
+    maze_point_t           below     = { 1, 3 };
+    maze_grid_cell_t      *p_cell    = maze_get_cell_at_coords(&grid, &point);
+    maze_navigator_state_t navigator = { p_cell, p_cell, p_cell, MAZE_NORTH };
+    uint8_t                old_gaps  = maze_snapshot_get_gaps(p_old, &point);
+
+    maze_versioned_modify_walls(
+        &map, &navigator, 1 << MAZE_SOUTH, true, false);
+
+    maze_snapshot_t *p_new = maze_versioned_snapshot(&map);
+
+    if (old_gaps != maze_snapshot_get_gaps(p_old, &point)
+        || 0 != (maze_snapshot_get_gaps(p_new, &point) & (1 << MAZE_SOUTH))
+        || 0 != (maze_snapshot_get_gaps(p_new, &below) & (1 << MAZE_NORTH)))
+    {
+        printf("Snapshots do not match the writes.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 2: Only rows 2 and 3 are copied, and the rest are still shared.
+    //
+    if (2 != map.num_copies || p_old->version == p_new->version)
+    {
+        printf("%u rows were copied.\n", map.num_copies);
+        ret_val = -1;
+        goto end;
+    }
+
+    for (uint16_t row = 0; GRID_ROWS > row; row++)
+    {
+        bool is_shared = p_old->p_rows[row] == p_new->p_rows[row];
+
+        if (is_shared == (2 == row || 3 == row))
+        {
+            printf("Row %u is shared: %d.\n", row, is_shared);
+            ret_val = -1;
+            goto end;
+        }
+    }
+
+    // Step 3: Writing again without an old snapshot copies nothing.
+    //
+    maze_snapshot_release(p_old);
+    maze_snapshot_release(p_new);
+    p_old = NULL;
+    p_new = NULL;
+    maze_versioned_modify_walls(
+        &map, &navigator, 1 << MAZE_SOUTH, false, true);
+
+    if (2 != map.num_copies)
+    {
+        printf("Unshared rows were copied.\n");
+        ret_val = -1;
+    }
+
+end:
+    maze_snapshot_release(p_old);
+    maze_snapshot_release(p_new);
+    maze_versioned_destroy(&map);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a planner can run A* and a serialiser can read a
+ * consistent map while the mapper keeps adding walls.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_snapshot_plan_while_mapping (void)
+{
+    int              ret_val = 0;
+    maze_grid_t      grid    = maze_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t      plan    = maze_create(GRID_ROWS, GRID_COLS);
+    maze_versioned_t map;
+    floodfill_init_maze_nowall(&grid);
+    maze_versioned_init(&map, &grid);
+
+    maze_snapshot_t *p_half = NULL;
+
+    // Step 1: Map the maze row by row, taking a snapshot halfway through.
+    //
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (GRID_ROWS * GRID_COLS / 2 == idx)
+        {
+            p_half = maze_versioned_snapshot(&map);
+        }
+
+        maze_navigator_state_t navigator
+            = { &grid.p_grid_array[idx], NULL, NULL, MAZE_NORTH };
+        maze_versioned_modify_walls(
+            &map, &navigator, g_bitmask_array[idx], true, true);
+    }
+
+    maze_snapshot_t *p_full = maze_versioned_snapshot(&map);
+
+    // Step 2: The full snapshot serialises to the true maze.
+    //
+    maze_gap_bitmask_t gap_bitmask = maze_snapshot_serialise(p_full);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        if (g_bitmask_array[idx] != gap_bitmask.p_bitmask[idx])
+        {
+            printf("Bitmask at %u is %x when it should be %x.\n",
+                   idx,
+                   gap_bitmask.p_bitmask[idx],
+                   g_bitmask_array[idx]);
+            ret_val = -1;
+            goto end;
+        }
+    }
+
+    // Step 3: A* on both snapshots. The half-mapped maze has fewer walls, so
+    // its path cannot be longer.
+    //
+    uint32_t lengths[2] = { 0, 0 };
+
+    for (uint8_t pass = 0; 2 > pass; pass++)
+    {
+        maze_snapshot_restore(0 == pass ? p_half : p_full, &plan);
+
+        maze_grid_cell_t *p_start
+            = maze_get_cell_at_coords(&plan, &g_start_point);
+        maze_grid_cell_t *p_end = maze_get_cell_at_coords(&plan, &g_end_point);
+        a_star(&plan, p_start, p_end);
+        a_star_path_t *p_path = a_star_get_path(p_end);
+
+        if (NULL == p_path)
+        {
+            printf("Pass %u found no path.\n", pass);
+            ret_val = -1;
+            goto end;
+        }
+
+        lengths[pass] = p_path->length;
+        maze_free(p_path->p_path);
+        maze_free(p_path);
+    }
+
+    if (lengths[0] > lengths[1])
+    {
+        printf("Half-mapped path is %u long and full path is %u long.\n",
+               lengths[0],
+               lengths[1]);
+        ret_val = -1;
+    }
+
+end:
+    maze_free(gap_bitmask.p_bitmask);
+    maze_snapshot_release(p_half);
+    maze_snapshot_release(p_full);
+    maze_versioned_destroy(&map);
+    maze_destroy(&plan);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a retained snapshot stays readable after the versioned
+ * map is destroyed.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_snapshot_outlives_map (void)
+{
+    int                ret_val     = 0;
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    maze_grid_t grid = maze_create(GRID_ROWS, GRID_COLS);
+    maze_deserialise(&grid, &gap_bitmask);
+
+    maze_versioned_t map;
+    maze_versioned_init(&map, &grid);
+
+    maze_snapshot_t *p_snapshot = maze_versioned_snapshot(&map);
+    maze_snapshot_retain(p_snapshot);
+    maze_versioned_destroy(&map);
+    maze_destroy(&grid);
+
+    // The first holder lets go, and the second can still read every cell.
+    //
+    maze_snapshot_release(p_snapshot);
+
+    for (uint16_t idx = 0; GRID_ROWS * GRID_COLS > idx; idx++)
+    {
+        maze_point_t point = { idx % GRID_COLS, idx / GRID_COLS };
+
+        if (g_bitmask_array[idx] != maze_snapshot_get_gaps(p_snapshot, &point))
+        {
+            printf("Cell %u differs after the map was destroyed.\n", idx);
+            ret_val = -1;
+            break;
+        }
+    }
+
+    maze_snapshot_release(p_snapshot);
+    return ret_val;
+}
+
+// End of snapshot_tests.c
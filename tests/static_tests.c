@@ -0,0 +1,306 @@
+/**
+ * @file static_tests.c
+ * @author Christopher Kok (chris@forcelightning.xyz)
+ * @brief This file contains the tests for the fixed-size build. It is compiled
+ * with MAZE_STATIC_ROWS=6 and MAZE_STATIC_COLS=4.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "pathfinding/maze.h"
+#include "pathfinding/maze_allocator.h"
+#include "pathfinding/maze_arena.h"
+#include "pathfinding/a_star.h"
+#include "pathfinding/floodfill.h"
+
+// Type definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief This enum contains constants used in the tests.
+ */
+typedef enum
+{
+    GRID_ROWS = MAZE_STATIC_ROWS, ///< Number of rows in the grid.
+    GRID_COLS = MAZE_STATIC_COLS  ///< Number of columns in the grid.
+} constants_t;
+
+// Global variables.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Global bitmask array of a maze for testing.
+ */
+static const uint16_t g_bitmask_array[GRID_ROWS * GRID_COLS] = {
+    0x6, 0xE, 0xC, 0x4, // First row.
+    0x5, 0x1, 0x3, 0x9, // Second row.
+    0x7, 0xA, 0xA, 0x8, // Third row.
+    0x5, 0x6, 0xA, 0xC, // Fourth row.
+    0x3, 0xD, 0x4, 0x1, // Fifth row.
+    0x2, 0xB, 0xB, 0x8  // Last row.
+};
+
+static const maze_point_t g_start_point = { 2, 5 }; // Start point is at (2, 5).
+static const maze_point_t g_end_point   = { 1, 0 }; // End point is at (1, 0).
+
+// Test function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static int test_static_a_star(void);
+static int test_static_floodfill(void);
+
+// Private function prototypes.
+// ----------------------------------------------------------------------------
+//
+
+static uint16_t explore_current_node(maze_grid_t              *p_grid,
+                                     maze_navigator_state_t   *p_navigator,
+                                     maze_cardinal_direction_t direction);
+static void     move_navigator(maze_navigator_state_t   *p_navigator,
+                               maze_cardinal_direction_t direction);
+
+/**
+ * @brief Runs the tests for the fixed-size build.
+ *
+ * @param argc Argument count.
+ * @param argv Argument vector.
+ * @return int 0 if successful, -1 otherwise.
+ */
+int
+static_tests (int argc, char *argv[])
+{
+    int default_choice = 1; // Default choice for the test to run.
+    int choice         = default_choice;
+
+    if (1 < argc)
+    {
+        // Unsafe conversion to int. This is ok because the input is controlled
+        // by ctest.
+        if (sscanf(argv[1], "%d", &choice) != 1)
+        {
+            printf("Could not parse argument. Terminating.\n");
+            return -1;
+        }
+    }
+
+    int ret_val = 0;
+
+    switch (choice)
+    {
+        case 1:
+            ret_val = test_static_a_star();
+            break;
+        case 2:
+            ret_val = test_static_floodfill();
+            break;
+        default:
+            printf("Invalid choice. Terminating.\n");
+            ret_val = -1;
+            break;
+    }
+
+    return ret_val;
+}
+
+// Test function definitions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Tests that grids come from the static pool, and that A* and the
+ * string functions run in the static workspace.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_static_a_star (void)
+{
+    int                ret_val     = 0;
+    maze_arena_t      *p_arena     = maze_allocator_get_static_arena();
+    maze_gap_bitmask_t gap_bitmask = { .p_bitmask = (uint16_t *)g_bitmask_array,
+                                       .rows      = GRID_ROWS,
+                                       .columns   = GRID_COLS };
+
+    // Step 1: Only grids of the course size can be created, and only as many
+    // as the pool holds.
+    //
+    maze_grid_t grid  = maze_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t wrong = maze_create(GRID_ROWS - 1, GRID_COLS + 1);
+    maze_grid_t other = maze_create(GRID_ROWS, GRID_COLS);
+    maze_grid_t extra = maze_create(GRID_ROWS, GRID_COLS);
+
+    if (NULL == grid.p_grid_array || NULL != wrong.p_grid_array
+        || NULL == other.p_grid_array || NULL != extra.p_grid_array)
+    {
+        printf("Static grid pool gave the wrong grids.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    // Step 2: Plan and print the path.
+    //
+    maze_deserialise(&grid, &gap_bitmask);
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    a_star(&grid, p_start, p_end);
+    a_star_path_t *p_path = a_star_get_path(p_end);
+
+    if (NULL == p_path || 0 == p_path->length)
+    {
+        printf("No path was found.\n");
+        ret_val = -1;
+        goto end;
+    }
+
+    char              *p_path_str = a_star_get_path_str(&grid, p_path);
+    maze_gap_bitmask_t serialised = maze_serialise(&grid);
+
+    if (NULL == p_path_str || NULL == serialised.p_bitmask
+        || 0
+               != memcmp(serialised.p_bitmask,
+                         g_bitmask_array,
+                         sizeof(g_bitmask_array)))
+    {
+        printf("Could not draw or serialise the maze.\n");
+        ret_val = -1;
+    }
+    else
+    {
+        printf("%s\n", p_path_str);
+    }
+
+    maze_free(serialised.p_bitmask);
+    maze_free(p_path_str);
+    maze_free(p_path->p_path);
+    maze_free(p_path);
+
+    // Step 3: Everything was given back, and nothing needed the heap.
+    //
+    if (0 != p_arena->used || 0 != p_arena->num_fallbacks)
+    {
+        printf("Static workspace has %zu bytes in use and %zu fallbacks.\n",
+               p_arena->used,
+               p_arena->num_fallbacks);
+        ret_val = -1;
+    }
+
+    printf("Peak static workspace use is %zu of %zu bytes.\n",
+           p_arena->peak,
+           p_arena->capacity);
+
+end:
+    maze_destroy(&other);
+    maze_destroy(&grid);
+
+    // A destroyed grid goes back to the pool.
+    //
+    grid = maze_create(GRID_ROWS, GRID_COLS);
+
+    if (NULL == grid.p_grid_array)
+    {
+        printf("Destroyed grid was not given back to the pool.\n");
+        ret_val = -1;
+    }
+
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+/**
+ * @brief Tests that a whole floodfill mapping run is done in the static
+ * workspace.
+ *
+ * @return int 0 if the test passes, -1 otherwise.
+ */
+static int
+test_static_floodfill (void)
+{
+    int           ret_val = 0;
+    maze_arena_t *p_arena = maze_allocator_get_static_arena();
+    maze_grid_t   grid    = maze_create(GRID_ROWS, GRID_COLS);
+    floodfill_init_maze_nowall(&grid);
+
+    maze_grid_cell_t *p_start = maze_get_cell_at_coords(&grid, &g_start_point);
+    maze_grid_cell_t *p_end   = maze_get_cell_at_coords(&grid, &g_end_point);
+    maze_navigator_state_t navigator = { p_start, p_start, p_end, MAZE_NORTH };
+
+    floodfill_map_maze(
+        &grid, p_end, &navigator, &explore_current_node, &move_navigator);
+
+    if (navigator.p_current_node != p_end)
+    {
+        printf("Navigator did not reach the end cell.\n");
+        ret_val = -1;
+    }
+
+    if (0 != p_arena->num_fallbacks || 0 != p_arena->used
+        || 0 == p_arena->peak)
+    {
+        printf("Mapping run used %zu bytes and %zu fallbacks.\n",
+               p_arena->used,
+               p_arena->num_fallbacks);
+        ret_val = -1;
+    }
+
+    printf("Peak static workspace use is %zu of %zu bytes.\n",
+           p_arena->peak,
+           p_arena->capacity);
+    maze_destroy(&grid);
+    return ret_val;
+}
+
+// Private functions.
+// ----------------------------------------------------------------------------
+//
+
+/**
+ * @brief Explores the current node using the global bitmask array.
+ *
+ * @param[in,out] p_grid Pointer to the maze.
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to explore in.
+ * @return uint16_t Bitmask of the walls of the current node.
+ */
+static uint16_t
+explore_current_node (maze_grid_t              *p_grid,
+                      maze_navigator_state_t   *p_navigator,
+                      maze_cardinal_direction_t direction)
+{
+    maze_grid_cell_t *p_current_node = p_navigator->p_current_node;
+    uint8_t           bitmask        = MAZE_INVERT_BITMASK(
+        g_bitmask_array[p_current_node->coordinates.y * GRID_COLS
+                        + p_current_node->coordinates.x]);
+
+    p_navigator->orientation = direction;
+    maze_nav_modify_walls(p_grid, p_navigator, bitmask, true, false);
+    return bitmask;
+}
+
+/**
+ * @brief Moves the navigator to the next node.
+ *
+ * @param[in,out] p_navigator Pointer to the navigator.
+ * @param[in] direction Direction to move.
+ */
+static void
+move_navigator (maze_navigator_state_t   *p_navigator,
+                maze_cardinal_direction_t direction)
+{
+    p_navigator->p_current_node
+        = p_navigator->p_current_node->p_next[direction];
+    p_navigator->orientation = direction;
+}
+
+// End of static_tests.c